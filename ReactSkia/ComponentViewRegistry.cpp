@@ -15,6 +15,7 @@ namespace react {
 ComponentViewRegistry::ComponentViewRegistry() {
   descriptorProviderRegistry_ =
       std::make_unique<ComponentDescriptorProviderRegistry>();
+  componentTable_ = std::make_unique<RSkComponentTable>();
 }
 
 ComponentDescriptorRegistry::Shared
@@ -29,21 +30,24 @@ void ComponentViewRegistry::Register(
     std::unique_ptr<RSkComponentProvider> provider) {
   auto descriptorProvider = provider->GetDescriptorProvider();
   descriptorProviderRegistry_->add(descriptorProvider);
+  provider->setComponentTable(componentTable_.get());
+  nameRegistry_.emplace(descriptorProvider.name, provider.get());
   registry_[descriptorProvider.handle] = std::move(provider);
 }
 
 void ComponentViewRegistry::Register(
     std::unique_ptr<RSkComponentProvider> provider,
     ComponentHandle handle) {
+  provider->setComponentTable(componentTable_.get());
+  nameRegistry_.emplace(provider->GetDescriptorProvider().name, provider.get());
   registry_[handle] = std::move(provider); //Dont have to add descriptorProvider to descriptorProviderRegistry_. Use other overloaded Register function for that
 }
 
 RSkComponentProvider *ComponentViewRegistry::GetProvider(
     ComponentName componentName) {
-  for (const auto &kv : registry_) {
-    if (strcmp(kv.second->GetDescriptorProvider().name, componentName) == 0) {
-      return kv.second.get();
-    }
+  auto it = nameRegistry_.find(componentName);
+  if (it != nameRegistry_.end()) {
+    return it->second;
   }
   return nullptr;
 }
@@ -59,13 +63,18 @@ RSkComponentProvider *ComponentViewRegistry::GetProvider(
 
 RSkComponentProvider *ComponentViewRegistry::GetProvider(
     int tag) {
-  for(const auto &kv : registry_) {
-    if ((strcmp(kv.second->GetDescriptorProvider().name, "RootView")) != 0) {
-      auto component = kv.second->GetComponent(tag);
-      if(component != nullptr) {
-        return kv.second.get();
-      }
-    }
+  auto entry = componentTable_->find(tag);
+  if (entry != nullptr) {
+    return entry->provider;
+  }
+  return nullptr;
+}
+
+std::shared_ptr<RSkComponent> ComponentViewRegistry::GetComponent(
+    Tag tag) {
+  auto entry = componentTable_->find(tag);
+  if (entry != nullptr) {
+    return entry->component;
   }
   return nullptr;
 }
@@ -7,7 +7,11 @@
 */
 #pragma once
 
+#include <string>
+#include <unordered_map>
+
 #include "ReactSkia/components/RSkComponentProvider.h"
+#include "ReactSkia/components/RSkComponentTable.h"
 
 #include "better/map.h"
 #include "react/renderer/componentregistry/ComponentDescriptorRegistry.h"
@@ -33,6 +37,9 @@ class ComponentViewRegistry {
   RSkComponentProvider *GetProvider(ComponentHandle componentHandle);
   RSkComponentProvider *GetProvider(int tag);
 
+  // O(1) lookup of mounted component from the tag table shared across providers
+  std::shared_ptr<RSkComponent> GetComponent(Tag tag);
+
   ComponentDescriptorProviderRegistry& providerRegistry() { return *descriptorProviderRegistry_; }
   const ComponentDescriptor* getComponentDescriptor(ComponentHandle componentHandle);
 
@@ -41,6 +48,8 @@ class ComponentViewRegistry {
       descriptorProviderRegistry_;
   ComponentDescriptorRegistry::Shared componentDescriptorRegistry_;
   better::map<ComponentHandle, std::unique_ptr<RSkComponentProvider>> registry_;
+  std::unordered_map<std::string, RSkComponentProvider *> nameRegistry_;
+  std::unique_ptr<RSkComponentTable> componentTable_; // Heap allocated, so that providers can keep pointer across move
 };
 
 } // namespace react
@@ -18,6 +18,7 @@
 #include "core_modules/RSkImageLoader.h"
 #include "core_modules/RSkKeyboardObserver.h"
 #include "core_modules/RSkLinkingManagerModule.h"
+#include "core_modules/RSkNativeAnimatedModule.h"
 #include "core_modules/RSkPlatform.h"
 #include "core_modules/RSkTimingModule.h"
 #include "modules/platform/nopoll/RSkWebSocketModule.h"
@@ -117,7 +118,7 @@ class UnimplementedTurboModule : public TurboModule {
 
 } // namespace
 
-JSITurboModuleManager::JSITurboModuleManager(Instance *bridgeInstance)
+JSITurboModuleManager::JSITurboModuleManager(Instance *bridgeInstance, ComponentViewRegistry *componentViewRegistry, RnsShell::AnimationDriver *animationDriver)
     : bridgeInstance_(bridgeInstance) {
   std::shared_ptr<CallInvoker> jsInvoker = bridgeInstance->getJSCallInvoker();
   auto staticModule =
@@ -143,6 +144,8 @@ JSITurboModuleManager::JSITurboModuleManager(Instance *bridgeInstance)
       std::make_shared<RSkDeviceInfoModule>("DeviceInfo", jsInvoker, bridgeInstance);
   modules_["ImageLoader"] =
       std::make_shared<RSkImageLoader>("ImageLoader", jsInvoker);
+  modules_["NativeAnimatedModule"] =
+      std::make_shared<RSkNativeAnimated>("NativeAnimatedModule", jsInvoker, componentViewRegistry, animationDriver, bridgeInstance);
 #if ENABLE(FEATURE_ALERT)
   modules_["AlertManager"] =
       std::make_shared<RSkAlertManager>("AlertManager", jsInvoker, bridgeInstance);
@@ -162,8 +165,6 @@ JSITurboModuleManager::JSITurboModuleManager(Instance *bridgeInstance)
       std::make_shared<UnimplementedTurboModule>("DevSettings", jsInvoker);
   modules_["StatusBarManager"] =
       std::make_shared<UnimplementedTurboModule>("StatusBarManager", jsInvoker);
-  modules_["NativeAnimatedModule"] =
-      std::make_shared<UnimplementedTurboModule>("NativeAnimatedModule", jsInvoker);
   modules_["SampleTurboModule"] =
       std::make_shared<UnimplementedTurboModule>("SampleTurboModule", jsInvoker);
   modules_["Vibration"] =
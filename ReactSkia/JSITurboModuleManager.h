@@ -4,14 +4,19 @@
 
 #include <unordered_map>
 
+namespace RnsShell {
+class AnimationDriver;
+}
+
 namespace facebook {
 namespace react {
 
+class ComponentViewRegistry;
 class Instance;
 
 class JSITurboModuleManager {
  public:
-  JSITurboModuleManager(Instance *bridgeInstance);
+  JSITurboModuleManager(Instance *bridgeInstance, ComponentViewRegistry *componentViewRegistry, RnsShell::AnimationDriver *animationDriver);
   JSITurboModuleManager(JSITurboModuleManager &&) = default;
 
   TurboModuleProviderFunctionType GetProvider();
@@ -10,8 +10,40 @@
 
 #include "RSkBaseEventEmitter.h"
 
+// Callable JS module emitting the params built through JSI, & the queue of those params
+#define RSK_JSI_EVENT_EMITTER_MODULE "RSkJSIEventEmitter"
+#define RSK_JSI_EVENT_PARAMS_QUEUE   "__rskJSIEventParams"
+
 namespace facebook {
 namespace react {
+
+// Returns the params queue of the runtime, registering the callable module along with it on first use
+static jsi::Object jsiEventParamsQueue(jsi::Runtime &rt) {
+    jsi::Object global = rt.global();
+    if (global.hasProperty(rt, RSK_JSI_EVENT_PARAMS_QUEUE)) {
+        return global.getPropertyAsObject(rt, RSK_JSI_EVENT_PARAMS_QUEUE);
+    }
+    global.setProperty(rt, RSK_JSI_EVENT_PARAMS_QUEUE, jsi::Array(rt, 0));
+
+    jsi::Object emitterModule(rt);
+    emitterModule.setProperty(rt, "emit", jsi::Function::createFromHostFunction(
+        rt, jsi::PropNameID::forAscii(rt, "emit"), 1,
+        [](jsi::Runtime &rt, const jsi::Value &thisValue, const jsi::Value *args, size_t count) -> jsi::Value {
+            jsi::Object queue = rt.global().getPropertyAsObject(rt, RSK_JSI_EVENT_PARAMS_QUEUE);
+            jsi::Value params = queue.getPropertyAsFunction(rt, "shift").callWithThis(rt, queue);
+            jsi::Object batchedBridge = rt.global().getPropertyAsObject(rt, "__fbBatchedBridge");
+            jsi::Object deviceEventEmitter = batchedBridge.getPropertyAsFunction(rt, "getCallableModule")
+                .callWithThis(rt, batchedBridge, "RCTDeviceEventEmitter").getObject(rt);
+            deviceEventEmitter.getPropertyAsFunction(rt, "emit")
+                .callWithThis(rt, deviceEventEmitter, jsi::Value(rt, args[0]), std::move(params));
+            return jsi::Value::undefined();
+        }));
+    jsi::Object batchedBridge = global.getPropertyAsObject(rt, "__fbBatchedBridge");
+    batchedBridge.getPropertyAsFunction(rt, "registerCallableModule")
+        .callWithThis(rt, batchedBridge, RSK_JSI_EVENT_EMITTER_MODULE, std::move(emitterModule));
+    return global.getPropertyAsObject(rt, RSK_JSI_EVENT_PARAMS_QUEUE);
+}
+
 RSkBaseEventEmitter::RSkBaseEventEmitter(
     Instance *bridgeInstance)
     :bridgeInstance_(bridgeInstance), 
@@ -46,6 +78,29 @@ void RSkBaseEventEmitter::sendEventWithName(std::string eventName, folly::dynami
 }
 
 
+void RSkBaseEventEmitter::sendEventWithJSIParams(std::string eventName, EmitterJSIParamsBuilder paramsBuilder) {
+    if (bridgeInstance_ == NULL) {
+        RNS_LOG_ERROR("EventEmitter not initialized with Bridge instance");
+        return;
+    }
+    if (listenerCount_ < 1) {
+        return;
+    }
+    // Params are queued in JS by the runtime executor, then emitted by a callJSFunction queued right after
+    // on the same JS queue. So the emit is a regular bridge call, ending its batch with onBatchComplete.
+    bridgeInstance_->getRuntimeExecutor()([eventName, paramsBuilder](jsi::Runtime &rt) {
+        jsi::Value params;
+        try {
+            params = paramsBuilder(rt);
+        } catch (const std::exception &error) {
+            RNS_LOG_ERROR("Failed to build params of " << eventName << " : " << error.what());
+        }
+        // Queued even when undefined, to stay in step with the emits
+        jsi::Object queue = jsiEventParamsQueue(rt);
+        queue.getPropertyAsFunction(rt, "push").callWithThis(rt, queue, std::move(params));
+    });
+    bridgeInstance_->callJSFunction(RSK_JSI_EVENT_EMITTER_MODULE, "emit", folly::dynamic::array(eventName));
+}
 
 void RSkBaseEventEmitter::removeListeners(int removeCount) {
 
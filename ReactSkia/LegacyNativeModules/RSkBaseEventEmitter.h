@@ -7,16 +7,22 @@
 
 #pragma once
 #include "cxxreact/Instance.h"
+#include "jsi/jsi.h"
 
 namespace facebook {
 namespace react {
 
 using EmitterCompleteVoidCallback = std::function<void()>;
+// Builds the event params on the JS thread, straight as JS values
+using EmitterJSIParamsBuilder = std::function<jsi::Value(jsi::Runtime &rt)>;
 
 class RSkBaseEventEmitter{
     public:
       RSkBaseEventEmitter(Instance *bridgeInstance);
       virtual void sendEventWithName(std::string eventName, folly::dynamic &&params, EmitterCompleteVoidCallback completeCallback=nullptr);
+      // For payloads like big strings & ArrayBuffer, which are not worth a round trip through folly::dynamic.
+      // Events are emitted through callJSFunction like sendEventWithName, so their order is kept.
+      virtual void sendEventWithJSIParams(std::string eventName, EmitterJSIParamsBuilder paramsBuilder);
       virtual void startObserving() = 0;
       virtual void stopObserving() = 0;
       void addListener(std::string);
@@ -179,7 +179,7 @@ void Uimanager::updateView(int Tag, std::string viewManagerName, dynamic props)
     return;
   }
   const ComponentDescriptor* componentDescriptor = componentViewRegistry_->getComponentDescriptor(provider->GetDescriptorProvider().handle);
-  auto component = provider->GetComponent(Tag);
+  auto component = componentViewRegistry_->GetComponent(Tag);
 
   if((componentDescriptor != nullptr) && (component != nullptr)) {
 
@@ -194,13 +194,12 @@ void Uimanager::updateView(int Tag, std::string viewManagerName, dynamic props)
 }
 
 std::shared_ptr<RSkComponent> Uimanager::getComponent(int Tag) {
-  RSkComponentProvider* provider = componentViewRegistry_->GetProvider(Tag);
+  auto component = componentViewRegistry_->GetComponent(Tag);
 
-  if(provider == nullptr) {
-    RNS_LOG_ERROR("Unable to get provider for tag (" << Tag << ") !!");
-    return nullptr;
+  if(component == nullptr) {
+    RNS_LOG_ERROR("Unable to get component for tag (" << Tag << ") !!");
   }
-  return(provider->GetComponent(Tag));
+  return component;
 }
 
 UimanagerModule::UimanagerModule(std::unique_ptr<Uimanager> uimanager)
@@ -6,16 +6,24 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <algorithm>
+#include <thread>
+
 #include <glog/logging.h>
+#include <folly/synchronization/Baton.h>
 
 #include "react/renderer/scheduler/Scheduler.h"
 
 #include "ReactSkia/MountingManager.h"
 #include "ReactSkia/RSkSurfaceWindow.h"
 
+#include "rns_shell/common/Performance.h"
 #include "rns_shell/compositor/RendererDelegate.h"
 #include "rns_shell/platform/linux/TaskLoop.h"
 
+#define MOUNTING_MIN_CONCURRENT_RECORDINGS 8 // Below this count, dispatching to workers costs more than recording
+#define MOUNTING_MAX_RECORDING_WORKERS 3
+
 namespace facebook {
 namespace react {
 
@@ -128,8 +136,11 @@ void MountingManager::ProcessMutations(
 
   RNS_LOG_DEBUG(" ProcessMutations mutations[" << mutations.size() <<"]");
 
+  RnsShell::InputLatency::JSUpdateScope jsUpdateScope; // Commit shows the JS handling of the keys dispatched till now
   nativeRenderDelegate_.begin();
 
+  PreprocessMutations(mutations);
+
   for (auto const &mutation : mutations) {
     RNS_LOG_DEBUG("\n============\n Mutation type : "<< mutation.type <<
                  "\n ParentShadowView" <<
@@ -167,6 +178,8 @@ void MountingManager::ProcessMutations(
     }
   }
 
+  RecordDirtyComponents();
+
 #if !defined(GOOGLE_STRIP_LOG) || (GOOGLE_STRIP_LOG <= INFO)
   static double prevTime = SkTime::GetMSecs();
   RNS_LOG_INFO_EVERY_N(60, "Calling Compositor Commit(" << std::this_thread::get_id()) << ") : after " << SkTime::GetMSecs() - prevTime << " ms";
@@ -176,6 +189,100 @@ void MountingManager::ProcessMutations(
 
 }
 
+void MountingManager::PreprocessMutations(
+    ShadowViewMutationList const &mutations) {
+
+  latestShadowViews_.clear();
+  insertedTags_.clear();
+  updatedTags_.clear();
+  dirtyComponentIndex_.clear();
+  dirtyComponents_.clear();
+
+  for (auto const &mutation : mutations) {
+    if(mutation.type == ShadowViewMutation::Insert || mutation.type == ShadowViewMutation::Update) {
+      auto &shadowView = mutation.newChildShadowView;
+      latestShadowViews_[shadowView.tag] = &shadowView;
+      if(mutation.type == ShadowViewMutation::Insert) {
+        insertedTags_.insert(shadowView.tag);
+      }
+    }
+  }
+}
+
+void MountingManager::MarkComponentDirty(
+    std::shared_ptr<RSkComponent> component,
+    RnsShell::LayerInvalidateMask invalidateMask) {
+
+  if(!component || (invalidateMask == RnsShell::LayerInvalidateNone)) return;
+
+  Tag tag = component->getComponentData().tag;
+  auto it = dirtyComponentIndex_.find(tag);
+  if(it != dirtyComponentIndex_.end()) {
+    auto &dirtyComponent = dirtyComponents_[it->second];
+    dirtyComponent.invalidateMask = static_cast<RnsShell::LayerInvalidateMask>(dirtyComponent.invalidateMask | invalidateMask);
+    return;
+  }
+  dirtyComponentIndex_[tag] = dirtyComponents_.size();
+  dirtyComponents_.push_back({component, invalidateMask});
+}
+
+void MountingManager::RecordDirtyComponents() {
+
+  std::vector<DirtyComponent *> concurrentRecordings;
+  for (auto &dirtyComponent : dirtyComponents_) {
+    if(!dirtyComponent.component) continue; // Deleted in the same transaction
+    if(dirtyComponent.component->canRecordConcurrently()) {
+      concurrentRecordings.push_back(&dirtyComponent);
+    } else {
+      dirtyComponent.component->drawAndSubmit(dirtyComponent.invalidateMask);
+    }
+  }
+
+  if(recordingWorkers_.empty() && concurrentRecordings.size() >= MOUNTING_MIN_CONCURRENT_RECORDINGS) {
+    unsigned int workerCount = std::min<unsigned int>(std::thread::hardware_concurrency(), MOUNTING_MAX_RECORDING_WORKERS + 1);
+    for(unsigned int index = 1; index < workerCount; index++) {
+      recordingWorkers_.push_back(std::make_unique<folly::ScopedEventBaseThread>("RecordingWorker"));
+    }
+  }
+
+  if(recordingWorkers_.empty() || concurrentRecordings.size() < MOUNTING_MIN_CONCURRENT_RECORDINGS) {
+    for (auto dirtyComponent : concurrentRecordings) {
+      dirtyComponent->component->drawAndSubmit(dirtyComponent->invalidateMask);
+    }
+  } else {
+    // Main thread records its share along with the workers. Workers only record into their
+    // DirtyComponent entry, layers are updated below on this (commit) thread once all are done.
+    size_t stride = recordingWorkers_.size() + 1;
+    auto recordShare = [&concurrentRecordings, stride](size_t share) {
+      for(size_t index = share; index < concurrentRecordings.size(); index += stride) {
+        auto dirtyComponent = concurrentRecordings[index];
+        dirtyComponent->pictures = dirtyComponent->component->recordPictures(dirtyComponent->invalidateMask);
+      }
+    };
+    std::unique_ptr<folly::Baton<>[]> recordingDone(new folly::Baton<>[recordingWorkers_.size()]);
+    for(size_t index = 0; index < recordingWorkers_.size(); index++) {
+      recordingWorkers_[index]->getEventBase()->runInEventBaseThread([&recordShare, &recordingDone, index]() {
+        recordShare(index + 1);
+        recordingDone[index].post();
+      });
+    }
+    recordShare(0);
+    for(size_t index = 0; index < recordingWorkers_.size(); index++) {
+      recordingDone[index].wait();
+    }
+    for (auto dirtyComponent : concurrentRecordings) {
+      dirtyComponent->component->submitPictures(dirtyComponent->invalidateMask, std::move(dirtyComponent->pictures));
+    }
+  }
+  RNS_LOG_DEBUG("Recorded " << dirtyComponents_.size() << " dirty components (" << concurrentRecordings.size() << " concurrently)");
+
+  latestShadowViews_.clear();
+  insertedTags_.clear();
+  updatedTags_.clear();
+  dirtyComponentIndex_.clear();
+  dirtyComponents_.clear();
+}
+
 void MountingManager::CreateMountInstruction(
     ShadowViewMutation const &mutation,
     SurfaceId surfaceId) {
@@ -191,12 +298,16 @@ void MountingManager::DeleteMountInstruction(
     ShadowViewMutation const &mutation,
     SurfaceId surfaceId) {
 
-  auto provider = GetProvider(mutation.oldChildShadowView);
+  // Component is going away, drop its pending recording
+  auto it = dirtyComponentIndex_.find(mutation.oldChildShadowView.tag);
+  if(it != dirtyComponentIndex_.end()) {
+    dirtyComponents_[it->second].component = nullptr;
+    dirtyComponentIndex_.erase(it);
+  }
+
+  auto provider = componentViewRegistry_->GetProvider(mutation.oldChildShadowView.tag);
   if (provider) {
-      std::shared_ptr<RSkComponent> component = provider->GetComponent(mutation.oldChildShadowView.tag);
-      if (component) {
-          provider->DeleteComponent(mutation.oldChildShadowView.tag);
-      }
+      provider->DeleteComponent(mutation.oldChildShadowView.tag);
   }
 }
 
@@ -204,10 +315,16 @@ void MountingManager::InsertMountInstruction(
     ShadowViewMutation const &mutation,
     SurfaceId surfaceId) {
 
+  Tag tag = mutation.newChildShadowView.tag;
   std::shared_ptr<RSkComponent> newChildComponent = GetComponent(mutation.newChildShadowView);
   std::shared_ptr<RSkComponent> parentComponent = GetComponent(mutation.parentShadowView);
-  if (newChildComponent) {
-      newChildComponent->updateComponentData(mutation.newChildShadowView,ComponentUpdateMaskAll,true);
+  // Updates of an inserted tag are folded into its first Insert, using the latest ShadowView of the transaction
+  if (newChildComponent && updatedTags_.insert(tag).second) {
+      auto latestShadowView = latestShadowViews_.find(tag);
+      ShadowView const &shadowView = (latestShadowView != latestShadowViews_.end()) ?
+                                         *latestShadowView->second : mutation.newChildShadowView;
+      MarkComponentDirty(newChildComponent,
+                         newChildComponent->updateComponentData(shadowView,ComponentUpdateMaskAll,true));
   }
 
   if (parentComponent) {
@@ -236,6 +353,12 @@ void MountingManager::UpdateMountInstruction(
   auto &oldChildShadowView = mutation.oldChildShadowView;
   auto &newChildShadowView = mutation.newChildShadowView;
   uint32_t updateMask = ComponentUpdateMaskNone;
+
+  if(insertedTags_.count(newChildShadowView.tag)) {
+    RNS_LOG_DEBUG("Update of tag[" << newChildShadowView.tag << "] folded into its Insert");
+    return;
+  }
+
   std::shared_ptr<RSkComponent> newChildComponent = GetComponent(mutation.newChildShadowView);
   if(newChildComponent) {
     if(oldChildShadowView.props != newChildShadowView.props)
@@ -248,7 +371,8 @@ void MountingManager::UpdateMountInstruction(
       updateMask |= ComponentUpdateMaskLayoutMetrics;
 
     if(updateMask != ComponentUpdateMaskNone)
-      newChildComponent->updateComponentData(mutation.newChildShadowView,updateMask,false);
+      MarkComponentDirty(newChildComponent,
+                         newChildComponent->updateComponentData(mutation.newChildShadowView,updateMask,false));
   }
 }
 
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <unordered_map>
+#include <unordered_set>
+
+#include <folly/io/async/ScopedEventBaseThread.h>
+
 #include "react/renderer/mounting/ShadowViewMutation.h"
 #include "react/renderer/scheduler/SchedulerDelegate.h"
 #include "ReactSkia/ComponentViewRegistry.h"
@@ -58,6 +63,17 @@ class MountingManager : public SchedulerDelegate {
       ShadowViewMutationList const &mutations,
       SurfaceId surfaceId);
 
+  // Groups the mutations per tag, to find the latest ShadowView of the tag and the tags to be inserted
+  void PreprocessMutations(ShadowViewMutationList const &mutations);
+
+  // Accumulates the invalidation of component, to be recorded once at the end of transaction
+  void MarkComponentDirty(
+      std::shared_ptr<RSkComponent> component,
+      RnsShell::LayerInvalidateMask invalidateMask);
+
+  // Records pictures of all the dirty components of the transaction, once per component
+  void RecordDirtyComponents();
+
   // `Create` instruction
   void CreateMountInstruction(
       ShadowViewMutation const &mutation,
@@ -88,6 +104,11 @@ class MountingManager : public SchedulerDelegate {
   }
 
   std::shared_ptr<RSkComponent> GetComponent (const ShadowView &shadowView) {
+      auto component = componentViewRegistry_->GetComponent(shadowView.tag);
+      if (component) {
+          return component;
+      }
+      // Components not tracked in the tag table (ex: RootView) are served by their provider
       auto provider = GetProvider(shadowView);
       if (provider) {
           return provider->GetComponent(shadowView.tag);
@@ -100,6 +121,20 @@ class MountingManager : public SchedulerDelegate {
   RendererDelegate& nativeRenderDelegate_;
   ComponentViewRegistry *componentViewRegistry_;
   RSkSurfaceWindow *surface_;
+
+  struct DirtyComponent {
+    std::shared_ptr<RSkComponent> component;
+    RnsShell::LayerInvalidateMask invalidateMask;
+    RSkComponent::RecordedPictures pictures; // Recorded on the workers, submitted on the commit thread
+  };
+  // Per transaction bookkeeping, only accessed from main TaskLoop
+  std::unordered_map<Tag, ShadowView const *> latestShadowViews_;
+  std::unordered_set<Tag> insertedTags_;
+  std::unordered_set<Tag> updatedTags_;
+  std::unordered_map<Tag, size_t> dirtyComponentIndex_;
+  std::vector<DirtyComponent> dirtyComponents_;
+  std::vector<std::unique_ptr<folly::ScopedEventBaseThread>> recordingWorkers_;
+
   std::atomic <bool> followUpTransactionRequired_{false};
   std::atomic <bool> transactionInFlight_{false};
 };
@@ -51,6 +51,7 @@
 #include "react/utils/ContextContainer.h"
 
 #include "rns_shell/compositor/RendererDelegate.h"
+#include "rns_shell/common/Performance.h"
 
 namespace facebook {
 namespace react {
@@ -72,6 +73,27 @@ class JSCExecutorFactory : public JSExecutorFactory {
     };
     react::bindNativePerformanceNow(runtime, rnsPerformanceNowBinder);
 
+    // Key press latency percentiles of each stage : nativeInputLatency().<stage>.p50 ...
+    runtime.global().setProperty(runtime, "nativeInputLatency", jsi::Function::createFromHostFunction(
+        runtime, jsi::PropNameID::forAscii(runtime, "nativeInputLatency"), 0,
+        [](jsi::Runtime &runtime, const jsi::Value &, const jsi::Value *, size_t) {
+          RnsShell::InputLatencySnapshot snapshot = RnsShell::InputLatency::snapshot();
+          jsi::Object result(runtime);
+          result.setProperty(runtime, "presentedCount", (double)snapshot.presentedCount);
+          result.setProperty(runtime, "droppedCount", (double)snapshot.droppedCount);
+          for(int stage = 0; stage < RnsShell::InputLatencyStageCount; stage++) {
+            RnsShell::InputLatencyHistogram &histogram = snapshot.stages[stage];
+            jsi::Object stageResult(runtime);
+            stageResult.setProperty(runtime, "sampleCount", (double)histogram.sampleCount);
+            stageResult.setProperty(runtime, "p50", histogram.p50Ms);
+            stageResult.setProperty(runtime, "p95", histogram.p95Ms);
+            stageResult.setProperty(runtime, "p99", histogram.p99Ms);
+            stageResult.setProperty(runtime, "max", histogram.maxMs);
+            result.setProperty(runtime, RnsShell::InputLatency::stageName(stage), stageResult);
+          }
+          return jsi::Value(runtime, result);
+        }));
+
     TurboModuleBinding::install(
           runtime, std::move(jsiTurboModuleManager->GetProvider()));
     };
@@ -124,7 +146,7 @@ RNInstance::RNInstance(RendererDelegate &rendererDelegate)
   , moduleMessageQueue_(std::make_shared<MessageQueueThreadImpl>())
   , componentViewRegistry_(std::make_unique<ComponentViewRegistry>()) {
 
-  InitializeJSCore();
+  InitializeJSCore(rendererDelegate);
   RegisterComponents();
   InitializeFabric(rendererDelegate);
 }
@@ -170,9 +192,9 @@ xplat::module::CxxModule* RNInstance::moduleForName(std::string moduleName) {
   return std::static_pointer_cast<LegacyNativeModuleRegistry>(moduleRegistry_)->moduleForName(moduleName);
 }
 
-void RNInstance::InitializeJSCore() {
+void RNInstance::InitializeJSCore(RendererDelegate &rendererDelegate) {
   turboModuleManager_ =
-      std::make_unique<JSITurboModuleManager>(instance_.get());
+      std::make_unique<JSITurboModuleManager>(instance_.get(), componentViewRegistry_.get(), rendererDelegate.animationDriver());
   auto cb = std::make_unique<InstanceCallback>();
   auto factory =
       std::make_shared<JSCExecutorFactory>(turboModuleManager_.get());
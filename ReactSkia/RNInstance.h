@@ -32,7 +32,7 @@ class RNInstance {
   static jsi::Runtime* RskJsRuntime();
 
  private:
-  void InitializeJSCore();
+  void InitializeJSCore(RendererDelegate &rendererDelegate);
   void InitializeFabric(RendererDelegate &rendererDelegate);
   void RegisterComponents();
   void Invalidate();
@@ -2,10 +2,23 @@
 
 #include "include/core/SkCanvas.h"
 #include "include/core/SkFont.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkSurface.h"
 #include "include/effects/SkGradientShader.h"
 
+#include "ReactSkia/sdk/RNSAssetManager.h"
+#include "ReactSkia/sdk/RNSMemoryPressureBroker.h"
+#if ENABLE(FEATURE_SUBWINDOW_OVERLAY)
+#include "ReactSkia/sdk/WindowDelegator.h"
+#endif
 #include "ReactSkia/views/common/RSkImageCacheManager.h"
+#if ENABLE(FEATURE_KEY_INJECTOR)
+#include "rns_shell/common/Performance.h"
+
+#define KEY_INJECTOR_KEY_COUNT      20
+#define KEY_INJECTOR_INTERVAL_MS    200
+#define KEY_INJECTOR_START_DELAY_MS 5000 // Let the bundle load & the first frame render
+#endif
 
 using namespace RnsShell;
 using namespace facebook::react;
@@ -24,17 +37,40 @@ ReactSkiaApp::ReactSkiaApp(int argc, char **argv) {
   surface_->setSize(viewPort());
 #ifdef RNS_SHELL_HAS_GPU_SUPPORT
   surface_->setDirectContext(graphicsDirectContext());
+#endif
+#if ENABLE(FEATURE_SUBWINDOW_OVERLAY)
+  rns::sdk::WindowDelegator::setOverlayHost(this); // Keyboard & alerts are composited within the main window
 #endif
   rnInstance_ = std::make_unique<facebook::react::RNInstance>(*this);
   rnInstance_->Start(surface_.get(), *this);
   setCurrentBridge(rnInstance_.get());
 
   RSkImageCacheManager::init();//Needs to be called after Gpu backend created,So calling here
+  rns::sdk::RNSAssetManager::instance();// Asset map is loaded at startup, not on the first image paint
+  // Glyphs of the shown text are cached again on the next frame, so font cache is dropped only on critical pressure
+  fontCacheClientId_ = rns::sdk::RNSMemoryPressureBroker::instance()->addClient("FontCache", [](rns::sdk::MemoryPressureLevel level) -> size_t {
+    if(level != rns::sdk::MemoryPressureCritical)
+      return 0;
+    size_t fontCacheUsed = SkGraphics::GetFontCacheUsed();
+    SkGraphics::PurgeFontCache();
+    size_t fontCacheUsedAfterPurge = SkGraphics::GetFontCacheUsed();
+    return (fontCacheUsed > fontCacheUsedAfterPurge) ? (fontCacheUsed - fontCacheUsedAfterPurge) : 0;
+  });
+#if ENABLE(FEATURE_KEY_INJECTOR)
+  std::vector<rnsKey> keys(KEY_INJECTOR_KEY_COUNT, RNS_KEY_Down);
+  keys.insert(keys.end(), KEY_INJECTOR_KEY_COUNT, RNS_KEY_Up);
+  RnsShell::InputLatency::injectKeys(keys, KEY_INJECTOR_INTERVAL_MS, KEY_INJECTOR_START_DELAY_MS);
+#endif
 }
 
 ReactSkiaApp::~ReactSkiaApp() {
+  rns::sdk::RNSMemoryPressureBroker::instance()->removeClient(fontCacheClientId_);
   rnInstance_->Stop(surface_.get());
   setCurrentBridge(nullptr);
+#if ENABLE(FEATURE_SUBWINDOW_OVERLAY)
+  rns::sdk::WindowDelegator::closeOverlays(); // Keyboard or alert still open is not to be rendered by this app anymore
+  rns::sdk::WindowDelegator::setOverlayHost(nullptr);
+#endif
 }
 
 void ReactSkiaApp::onIdle() {
@@ -30,6 +30,7 @@ class ReactSkiaApp : public RnsShell::Application {
  private:
   std::unique_ptr<facebook::react::RNInstance> rnInstance_;
   std::unique_ptr<facebook::react::RSkSurfaceWindow> surface_;
+  unsigned int fontCacheClientId_{0};
 };
 
 } // namespace react
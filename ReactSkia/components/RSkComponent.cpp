@@ -43,7 +43,7 @@ void RSkComponent::OnPaintBorder(SkCanvas *canvas) {
 
   /* apply view style props */
   auto borderMetrics= viewProps.resolveBorderMetrics(component_.layoutMetrics);
-  drawBorder(canvas,component_.layoutMetrics.frame,borderMetrics,layer_->backgroundColor);
+  drawBorder(canvas,component_.layoutMetrics.frame,borderMetrics,layer_->backgroundColor,&frameGeometryCache_);
 }
 
 void RSkComponent::OnPaintShadow(SkCanvas *canvas) {
@@ -113,66 +113,86 @@ RnsShell::LayerInvalidateMask RSkComponent::updateProps(SharedProps newViewProps
    auto const &newviewProps = *std::static_pointer_cast<ViewProps const>(newViewProps);
    auto const &oldviewProps = *std::static_pointer_cast<ViewProps const>(component_.props);
    RnsShell::LayerInvalidateMask updateMask=RnsShell::LayerInvalidateNone;
-   bool createShadowFilter=false;
-
+   bool createShadowImageFilter=false;
+   bool createShadowMaskFilter=false;
+   bool wasShadowVisible=layer_->isShadowVisible;
+
+   /* Invalidation classes :
+      Composite : Layer applies the prop while compositing (opacity, clip, ordering). Picture is reused.
+      Layout    : Layer geometry is recalculated (transform). Picture is reused.
+      Paint     : Prop is part of the recorded picture, needs re-recording.
+   */
    updateMask= updateComponentProps(newViewProps,forceUpdate);
   //opacity
    if((forceUpdate) || (oldviewProps.opacity != newviewProps.opacity)) {
-      layer_->opacity = ((newviewProps.opacity > 1.0)? 1.0:newviewProps.opacity)*MAX_8BIT;
-      /*TODO : To be tested and confirm updateMask need for this Prop*/
-      updateMask =static_cast<RnsShell::LayerInvalidateMask>(updateMask | RnsShell::LayerInvalidateAll);
+      float newOpacity = ((newviewProps.opacity > 1.0)? 1.0:newviewProps.opacity)*MAX_8BIT;
+      // Picture depends on opacity only through shadow painting, which clips shadow behind opaque frames
+      bool opacityAffectsPaint = (isOpaque(layer_->opacity) != isOpaque(newOpacity)) ||
+                                 ((layer_->opacity == 0) != (newOpacity == 0));
+      layer_->opacity = newOpacity;
+      updateMask =static_cast<RnsShell::LayerInvalidateMask>(updateMask | RnsShell::LayerCompositeInvalidate);
+      if(opacityAffectsPaint && layer_->isShadowVisible) {
+         updateMask =static_cast<RnsShell::LayerInvalidateMask>(updateMask | RnsShell::LayerPaintInvalidate);
+      }
    }
   //ShadowOpacity
    if ((forceUpdate) || (oldviewProps.shadowOpacity != newviewProps.shadowOpacity)) {
       layer_->shadowOpacity = ((newviewProps.shadowOpacity > 1.0) ? 1.0:newviewProps.shadowOpacity)*MAX_8BIT;
-      /*TODO : To be tested and confirm updateMask need for this Prop*/
-      updateMask =static_cast<RnsShell::LayerInvalidateMask>(updateMask | RnsShell::LayerInvalidateAll);
-      createShadowFilter=true;
+      // Shadow opacity is applied while painting, filters are not affected
+      updateMask =static_cast<RnsShell::LayerInvalidateMask>(updateMask | RnsShell::LayerPaintInvalidate);
    }
   //shadowRadius
    if ((forceUpdate) || (oldviewProps.shadowRadius != newviewProps.shadowRadius)) {
       layer_->shadowRadius = newviewProps.shadowRadius;
-      /*TODO : To be tested and confirm updateMask need for this Prop*/
+      // Shadow radius changes the paint bounds of layer as well
       updateMask =static_cast<RnsShell::LayerInvalidateMask>(updateMask | RnsShell::LayerInvalidateAll);
-      createShadowFilter=true;
+      createShadowImageFilter=true;
+      createShadowMaskFilter=true;
    }
   //shadowoffset
    if ((forceUpdate) || (oldviewProps.shadowOffset != newviewProps.shadowOffset)) {
       layer_->shadowOffset = RSkSkSizeFromSize(newviewProps.shadowOffset);
-      /*TODO : To be tested and confirm updateMask need for this Prop*/
+      // Shadow offset changes the paint bounds of layer as well
       updateMask =static_cast<RnsShell::LayerInvalidateMask>(updateMask | RnsShell::LayerInvalidateAll);
-      createShadowFilter=true;
+      createShadowImageFilter=true;
    }
   //shadowcolor
    if ((forceUpdate) || (oldviewProps.shadowColor != newviewProps.shadowColor)) {
       layer_->shadowColor = RSkColorFromSharedColor(newviewProps.shadowColor,SK_ColorBLACK);
-      /*TODO : To be tested and confirm updateMask need for this Prop*/
-      updateMask =static_cast<RnsShell::LayerInvalidateMask>(updateMask | RnsShell::LayerInvalidateAll);
-      createShadowFilter=true;
+      updateMask =static_cast<RnsShell::LayerInvalidateMask>(updateMask | RnsShell::LayerPaintInvalidate);
+      createShadowImageFilter=true;
    }
 
    layer_->isShadowVisible=needsShadowPainting();
+   if(wasShadowVisible != layer_->isShadowVisible) {
+      // Shadow appeared or disappeared, both picture and paint bounds are affected
+      updateMask =static_cast<RnsShell::LayerInvalidateMask>(updateMask | RnsShell::LayerInvalidateAll);
+   }
 
-   if( createShadowFilter ) {
 /*Creating both Skia's Mask & Image filters here.
-   Mask Flter will be used for Rect frames / Affine Frames.
+   Mask Flter will be used for Rect frames / Affine Frames, depends only on the blur radius.
+   Rect frames mostly draw from the shared shadow cache, mask filter being its blur description.
    Image Filter will be used for discrete frames such as path or frames with transparent pixels.
 */
-//TO DO : Need to Miantain only the filter needed , not the both always.
-
+   if( createShadowImageFilter ) {
        layer_->shadowImageFilter= SkImageFilters::DropShadowOnly(layer_->shadowOffset.width(),
                                        layer_->shadowOffset.height(),
                                        layer_->shadowRadius, layer_->shadowRadius,
                                        layer_->shadowColor, nullptr);
-
+   }
+   if( createShadowMaskFilter ) {
        layer_->shadowMaskFilter= SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, layer_->shadowRadius);
    }
 
   //backgroundColor
    if ((forceUpdate) || (oldviewProps.backgroundColor != newviewProps.backgroundColor)) {
       layer_->backgroundColor = RSkColorFromSharedColor(newviewProps.backgroundColor,SK_ColorTRANSPARENT);
-      /*TODO : To be tested and confirm updateMask need for this Prop*/
-      updateMask =static_cast<RnsShell::LayerInvalidateMask>(updateMask | RnsShell::LayerInvalidateAll);
+      updateMask =static_cast<RnsShell::LayerInvalidateMask>(updateMask | RnsShell::LayerPaintInvalidate);
+   }
+  //border
+   if ((forceUpdate) ||
+       (oldviewProps.resolveBorderMetrics(component_.layoutMetrics) != newviewProps.resolveBorderMetrics(component_.layoutMetrics))) {
+      updateMask =static_cast<RnsShell::LayerInvalidateMask>(updateMask | RnsShell::LayerPaintInvalidate);
    }
   //transform
    if ((forceUpdate) || (oldviewProps.transform != newviewProps.transform)) {
@@ -200,14 +220,13 @@ RnsShell::LayerInvalidateMask RSkComponent::updateProps(SharedProps newViewProps
   //overflow
    if ((forceUpdate) || (oldviewProps.getClipsContentToBounds() != newviewProps.getClipsContentToBounds())) {
       layer_->setMasksTotBounds(newviewProps.getClipsContentToBounds());
-      /*TODO : To be tested and confirm updateMask need for this Prop*/
-      updateMask =static_cast<RnsShell::LayerInvalidateMask>(updateMask | RnsShell::LayerInvalidateAll);
+      // Children are clipped while compositing
+      updateMask =static_cast<RnsShell::LayerInvalidateMask>(updateMask | RnsShell::LayerCompositeInvalidate);
    }
   //zIndex
    if ((forceUpdate) || (oldviewProps.zIndex != newviewProps.zIndex)) {
       component_.commonProps.zIndex = newviewProps.zIndex.value_or(0);
-      /*TODO : To be tested and confirm updateMask need for this Prop*/
-      updateMask =static_cast<RnsShell::LayerInvalidateMask>(updateMask | RnsShell::LayerInvalidateAll);
+      updateMask =static_cast<RnsShell::LayerInvalidateMask>(updateMask | RnsShell::LayerCompositeInvalidate);
    }
 #if defined(TARGET_OS_TV) && TARGET_OS_TV
    if((forceUpdate) || (oldviewProps.hasTVPreferredFocus != newviewProps.hasTVPreferredFocus)) {
@@ -219,9 +238,10 @@ RnsShell::LayerInvalidateMask RSkComponent::updateProps(SharedProps newViewProps
    }
    /* TODO Add TVOS remaining properties */
 #endif
-   /*TODO : Return UpdateMask instead of RnsShell::LayerInvalidateAll, once the shadow handling moved to layer
-            and all the layer & component props have been verfied*/
-   return RnsShell::LayerInvalidateAll;
+   if(forceUpdate) {
+      updateMask = RnsShell::LayerInvalidateAll;
+   }
+   return updateMask;
 }
 
 void RSkComponent::setNativeProps_DEPRECATED(SharedProps updatedViewProps) {
@@ -238,7 +258,7 @@ void RSkComponent::setNativeProps_DEPRECATED(SharedProps updatedViewProps) {
   drawAndSubmit(invalidateMask);
 }
 
-void RSkComponent::updateComponentData(const ShadowView &newShadowView,const uint32_t updateMask,bool forceUpdate) {
+RnsShell::LayerInvalidateMask RSkComponent::updateComponentData(const ShadowView &newShadowView,const uint32_t updateMask,bool forceUpdate) {
 
    RNS_LOG_ASSERT((layer_ && layer_.get()), "Layer Object cannot be null");
    RNS_LOG_DEBUG("->Update " << component_.componentName << " layer(" << layer_->layerId() << ")");
@@ -286,18 +306,40 @@ void RSkComponent::updateComponentData(const ShadowView &newShadowView,const uin
       setNeedFocusUpdate();
    }
 #endif
-   drawAndSubmit(invalidateMask);
+   return invalidateMask;
 }
 
 void RSkComponent::drawAndSubmit(RnsShell::LayerInvalidateMask invalidateMask) {
+   submitPictures(invalidateMask, recordPictures(invalidateMask));
+}
+
+RSkComponent::RecordedPictures RSkComponent::recordPictures(RnsShell::LayerInvalidateMask invalidateMask) {
+   RecordedPictures pictures;
+   // Composite & layout only changes are applied by layer, recorded picture is still valid
+   if(!layer_ || !(invalidateMask & RnsShell::LayerPaintInvalidate)) {
+     return pictures;
+   }
+   if(layerType_ == RnsShell::LAYER_TYPE_PICTURE) {
+     RNS_PROFILE_API_OFF(component_.componentName << " getPicture :", pictures.picture = getPicture());
+   } else if(layerType_ == RnsShell::LAYER_TYPE_SCROLL) {
+     RNS_PROFILE_API_OFF(component_.componentName << " getShadowPicture :", pictures.shadowPicture = getPicture(PictureTypeShadow));
+     RNS_PROFILE_API_OFF(component_.componentName << " getBorderPicture :", pictures.borderPicture = getPicture(PictureTypeBorder));
+   }
+   return pictures;
+}
+
+void RSkComponent::submitPictures(RnsShell::LayerInvalidateMask invalidateMask, RecordedPictures pictures) {
    if(layer_ && layer_.get()) {
      layer_->invalidate(invalidateMask);
-     if(layerType_ == RnsShell::LAYER_TYPE_PICTURE) {
-       RNS_PROFILE_API_OFF(component_.componentName << " getPicture :", static_cast<RnsShell::PictureLayer*>(layer_.get())->setPicture(getPicture()));
+     if(!(invalidateMask & RnsShell::LayerPaintInvalidate)) {
+       RNS_LOG_DEBUG(component_.componentName << " layer(" << layer_->layerId() << ") skip re-recording for mask : " << invalidateMask);
+     } else if(layerType_ == RnsShell::LAYER_TYPE_PICTURE) {
+       static_cast<RnsShell::PictureLayer*>(layer_.get())->setPicture(std::move(pictures.picture));
      } else if(layerType_ == RnsShell::LAYER_TYPE_SCROLL) {
-       RNS_PROFILE_API_OFF(component_.componentName << " getShadowPicture :", static_cast<RnsShell::ScrollLayer*>(layer_.get())->setShadowPicture(getPicture(PictureTypeShadow)));
-       RNS_PROFILE_API_OFF(component_.componentName << " getBorderPicture :", static_cast<RnsShell::ScrollLayer*>(layer_.get())->setBorderPicture(getPicture(PictureTypeBorder)));
+       static_cast<RnsShell::ScrollLayer*>(layer_.get())->setShadowPicture(std::move(pictures.shadowPicture));
+       static_cast<RnsShell::ScrollLayer*>(layer_.get())->setBorderPicture(std::move(pictures.borderPicture));
      }
+     OnSubmit();
    }
 }
 
@@ -307,6 +349,7 @@ void RSkComponent::mountChildComponent(
 
     if(newChildComponent) {
         newChildComponent->parent_ = this;
+        newChildComponent->isScreenFrameValid_ = false;
         RNS_LOG_ASSERT((this->layer_ && newChildComponent->layer_), "Layer Object cannot be null");
         if(this->layer_)
             this->layer_->insertChild(newChildComponent->layer_, index);
@@ -336,6 +379,7 @@ void RSkComponent::unmountChildComponent(
             containerRemoveFrom->removeComponent(oldChildComponent.get());
 
         oldChildComponent->parent_ = nullptr ;
+        oldChildComponent->isScreenFrameValid_ = false;
 
         RNS_LOG_ASSERT((this->layer_ && oldChildComponent->layer_), "Layer Object cannot be null");
         if(oldChildComponent->layer_)
@@ -374,19 +418,29 @@ bool RSkComponent::hasAncestor(const SpatialNavigator::Container* ancestor) {
 }
 
 const SkIRect RSkComponent::getScreenFrame() {
+  // Cached till any layer frame or scroll position changes, saves walking up the ancestors on every key press
+  uint64_t layoutGeneration = RnsShell::Layer::absoluteFrameGeneration();
+  uint64_t scrollGeneration = RnsShell::ScrollLayer::scrollPositionGeneration();
+  if(isScreenFrameValid_ && screenFrameLayoutGeneration_ == layoutGeneration && screenFrameScrollGeneration_ == scrollGeneration)
+    return screenFrame_;
+
   SpatialNavigator::Container* container = nearestAncestorContainer();
-  SkIRect absFrame = getLayerAbsoluteFrame();
+  screenFrame_ = getLayerAbsoluteFrame();
 
   /* If ancestor container is not scrollable,return absFrame*/
   /* else , returns containerScreenFrame + ( component absFrame - container scrollOffset)*/
-  if((container == nullptr) || (!container->isScrollable())) return absFrame;
-
-  SkIRect containerScreenFrame = static_cast<RSkComponent*>(container)->getScreenFrame();
-  SkPoint containerScrollOffset = container->getScrollOffset();
-  return absFrame.makeOffset(-containerScrollOffset.x(),
-                             -containerScrollOffset.y()).makeOffset(
-                              containerScreenFrame.x(),
-                              containerScreenFrame.y());
+  if(container && container->isScrollable()) {
+    SkIRect containerScreenFrame = static_cast<RSkComponent*>(container)->getScreenFrame();
+    SkPoint containerScrollOffset = container->getScrollOffset();
+    screenFrame_ = screenFrame_.makeOffset(-containerScrollOffset.x(),
+                                           -containerScrollOffset.y()).makeOffset(
+                                            containerScreenFrame.x(),
+                                            containerScreenFrame.y());
+  }
+  screenFrameLayoutGeneration_ = layoutGeneration;
+  screenFrameScrollGeneration_ = scrollGeneration;
+  isScreenFrameValid_ = true;
+  return screenFrame_;
 }
 
 bool RSkComponent::needsShadowPainting() {
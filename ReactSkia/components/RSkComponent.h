@@ -91,7 +91,8 @@ class RSkComponent : public SpatialNavigator::Container, public std::enable_shar
     std::shared_ptr<RSkComponent> oldChildComponent,
     const int index);
 
-  virtual void updateComponentData(const ShadowView &newShadowView , const uint32_t updateMask , bool forceUpdate);
+  // Updates the component data and returns the layer invalidation needed. Caller has to drawAndSubmit with the returned mask.
+  virtual RnsShell::LayerInvalidateMask updateComponentData(const ShadowView &newShadowView , const uint32_t updateMask , bool forceUpdate);
 
   virtual RnsShell::LayerInvalidateMask updateComponentProps(SharedProps newProps,bool forceUpadate) = 0;
 
@@ -103,6 +104,8 @@ class RSkComponent : public SpatialNavigator::Container, public std::enable_shar
   virtual void setNativeProps_DEPRECATED(SharedProps updatedViewProps);
   virtual void onHandleKey(rnsKey  eventKeyType, bool keyRepeat, rnsKeyAction keyAction,bool* stopPropagate){*stopPropagate=false;};
   virtual bool isContainer() const { return false; }
+  // Components whose paint only reads their own props & layer can be recorded in parallel on recording workers
+  virtual bool canRecordConcurrently() const { return false; }
   virtual void onHandleBlur() {RNS_LOG_DEBUG("[onHandleBlur] componentName "<<component_.componentName);};
   virtual void onHandleFocus() {RNS_LOG_DEBUG("[onHandleFocus]componentName "<<component_.componentName);};
   Component getComponentData() const { return component_;}
@@ -111,7 +114,17 @@ class RSkComponent : public SpatialNavigator::Container, public std::enable_shar
   const SkIRect getScreenFrame();
   RSkComponent *getParent() {return parent_; };
 
+  // Pictures recorded for a paint invalidation, applied to the layer with submitPictures
+  struct RecordedPictures {
+    sk_sp<SkPicture> picture;
+    sk_sp<SkPicture> shadowPicture;
+    sk_sp<SkPicture> borderPicture;
+  };
   void drawAndSubmit(RnsShell::LayerInvalidateMask invalidateMask);
+  // Records only, layer is left untouched : can run on the recording workers
+  RecordedPictures recordPictures(RnsShell::LayerInvalidateMask invalidateMask);
+  // Applies the invalidation & the recorded pictures to the layer, on the commit thread
+  void submitPictures(RnsShell::LayerInvalidateMask invalidateMask, RecordedPictures pictures);
   SpatialNavigator::Container *nearestAncestorContainer();
   bool hasAncestor(const SpatialNavigator::Container* ancestor);
   bool isFocusable();
@@ -124,7 +137,10 @@ class RSkComponent : public SpatialNavigator::Container, public std::enable_shar
   virtual void OnPaint(SkCanvas *canvas) = 0;
   virtual void OnPaintShadow(SkCanvas *canvas);
   virtual void OnPaintBorder(SkCanvas *canvas);
+  // Called on the commit thread once the layer got its pictures. Unlike paint, sub layers of the component can be changed here.
+  virtual void OnSubmit() {}
   sk_sp<SkPicture> getPicture(PictureType type=PictureTypeAll);
+  FrameGeometryCache *frameGeometryCache() { return &frameGeometryCache_; }
  private:
   // RnsShell::Layer implementations
   void onPaint(SkCanvas*);
@@ -134,6 +150,11 @@ class RSkComponent : public SpatialNavigator::Container, public std::enable_shar
   std::shared_ptr<RnsShell::Layer> layer_;
   RnsShell::LayerType layerType_{LAYER_TYPE_PICTURE};
   Component component_;
+  FrameGeometryCache frameGeometryCache_; // Reused by background & border painting across recordings
+  SkIRect screenFrame_;
+  uint64_t screenFrameLayoutGeneration_{0};
+  uint64_t screenFrameScrollGeneration_{0};
+  bool isScreenFrameValid_{false};
 };
 
 } // namespace react
@@ -11,7 +11,6 @@
 #include "react/renderer/components/rncore/Props.h"
 
 #include "ReactSkia/components/RSkComponentActivityIndicator.h"
-#include "ReactSkia/components/RSkComponentActivityIndicatorManager.h"
 
 #include "ReactSkia/views/common/RSkConversion.h"
 #include "ReactSkia/utils/RnsLog.h"
@@ -19,30 +18,69 @@
 #define ACTIVITY_INDICATOR_DEFAULT_ARC_COLOR            SkColorSetARGB(0xFF, 0x99, 0x99, 0x99) // As per IOS documentation
 #define ACTIVITY_INDICATOR_STROKE_WIDTH(x)              ((x * 12.5)/100) // WEB Reference
 #define ACTIVITY_INDICATOR_BACKGROUND_CRICLE_ALPHA(y)   ((y * 20)/100) // WEB Reference
+#define ACTIVITY_INDICATOR_SPIN_DURATION_MS             1000 // One revolution per second
 
 namespace facebook {
 namespace react {
 
 RSkComponentActivityIndicator::RSkComponentActivityIndicator(const ShadowView &shadowView)
-: RSkComponent(shadowView) {
-  actIndManager_ = RSkComponentActivityIndicatorManager::getActivityIndicatorManager();
+: RSkComponent(shadowView) {}
+
+void RSkComponentActivityIndicator::startSpinning() {
+  auto layerRef = layer();
+  if(spinAnimationId_ || !layerRef) {
+    return;
+  }
+  RnsShell::AnimationDriver *animationDriver = layerRef->client().animationDriver();
+  if(!animationDriver) {
+    RNS_LOG_ERROR("No animation driver for Activity Indicator layer(" << layerRef->layerId() << ")");
+    return;
+  }
+  // Rotation is advanced by the elapsed time, on top of the transform set by props
+  spinAnimationId_ = animationDriver->addAnimation(layerRef, RnsShell::LayerAnimatedTransform,
+    [previousFrameTimeMs = 0.0](RnsShell::Layer &layer, double frameTimeMs) mutable {
+      if(previousFrameTimeMs) {
+        layer.transformMatrix.preRotate(360 * (frameTimeMs - previousFrameTimeMs) / ACTIVITY_INDICATOR_SPIN_DURATION_MS);
+      }
+      previousFrameTimeMs = frameTimeMs;
+      return true;
+    });
+}
+
+void RSkComponentActivityIndicator::stopSpinning() {
+  auto layerRef = layer();
+  if(!spinAnimationId_ || !layerRef) {
+    return;
+  }
+  RnsShell::AnimationDriver *animationDriver = layerRef->client().animationDriver();
+  if(animationDriver) {
+    animationDriver->removeAnimation(spinAnimationId_);
+  }
+  spinAnimationId_ = 0;
 }
 
 RnsShell::LayerInvalidateMask  RSkComponentActivityIndicator::updateComponentProps(SharedProps newViewProps,bool forceUpdate) {
   auto component = getComponentData();
   auto const &activityIndicatorOldProps = *std::static_pointer_cast<ActivityIndicatorViewProps const>(component.props);
   auto const &activityIndicatorNewProps = *std::static_pointer_cast<ActivityIndicatorViewProps const>(newViewProps);
+  RnsShell::LayerInvalidateMask updateMask = RnsShell::LayerInvalidateNone;
 
   if((initialPropertiesParsed_ == false) || (activityIndicatorOldProps.animating != activityIndicatorNewProps.animating)){
     initialPropertiesParsed_ = true;
     
     if(activityIndicatorNewProps.animating == true){
-      actIndManager_->addComponent(this->weak_from_this());
+      startSpinning();
     }else {
-      actIndManager_->removeComponent(component.tag);
+      stopSpinning();
     }
+    updateMask = RnsShell::LayerPaintInvalidate;
+  }
+  if((forceUpdate) ||
+     (activityIndicatorOldProps.color != activityIndicatorNewProps.color) ||
+     (activityIndicatorOldProps.hidesWhenStopped != activityIndicatorNewProps.hidesWhenStopped)) {
+    updateMask = RnsShell::LayerPaintInvalidate;
   }
-  return RnsShell::LayerInvalidateNone;
+  return updateMask;
 }
 
 void RSkComponentActivityIndicator::OnPaint(SkCanvas *canvas) {
@@ -91,9 +129,7 @@ void RSkComponentActivityIndicator::OnPaint(SkCanvas *canvas) {
 }
 
 RSkComponentActivityIndicator::~RSkComponentActivityIndicator(){
-  auto component = getComponentData();
-  actIndManager_->removeComponent(component.tag);
-  actIndManager_ = nullptr;
+  stopSpinning();
   initialPropertiesParsed_ = false;
 }
 
@@ -9,10 +9,11 @@
 
 #include <ReactSkia/components/RSkComponent.h>
 
+#include "rns_shell/compositor/AnimationDriver.h"
+
 namespace facebook {
 namespace react {
 
-class RSkComponentActivityIndicatorManager;
 class RSkComponentActivityIndicator final : public RSkComponent{
  public:
   RSkComponentActivityIndicator(const ShadowView &shadowView);
@@ -25,8 +26,11 @@ class RSkComponentActivityIndicator final : public RSkComponent{
  protected:
   void OnPaint(SkCanvas *canvas) override;
  private:
-  RSkComponentActivityIndicatorManager* actIndManager_;
+  RnsShell::AnimationId spinAnimationId_{0}; // Spinning is driven natively by the compositor
   bool initialPropertiesParsed_{false};
+
+  void startSpinning();
+  void stopSpinning();
 };
 
 } // namespace react
@@ -7,13 +7,16 @@
 */
 
 #include "include/core/SkPaint.h"
+#include "include/core/SkPictureRecorder.h"
 #include "include/core/SkClipOp.h"
 #include "include/core/SkImageFilter.h"
 #include "include/core/SkMaskFilter.h"
 #include "include/effects/SkImageFilters.h"
 #include "src/core/SkMaskFilterBase.h"
 
+#include "rns_shell/compositor/AnimationDriver.h"
 #include "rns_shell/compositor/layers/PictureLayer.h"
+#include "rns_shell/compositor/layers/ScrollLayer.h"
 
 #include "react/renderer/components/image/ImageEventEmitter.h"
 
@@ -46,9 +49,15 @@ void RSkComponentImage::OnPaint(SkCanvas *canvas) {
       break;
     }
     if(imageProps.sources.empty()) break;
-    imageData = RSkImageCacheManager::getImageCacheManagerInstance()->findImageDataInCache(imageProps.sources[0].uri.c_str());
+    imageData = RSkImageCacheManager::getImageCacheManagerInstance()->findImageDataInCache(imageCacheKey(imageProps.sources[0].uri).c_str());
     if(imageData) break;
 
+    if(isDataUri(imageProps.sources[0].uri)) {
+      if(!isRequestInProgress_)
+        requestDataUriImageData(imageProps.sources[0].uri);
+      break;
+    }
+
     if (imageProps.sources[0].type == ImageSource::Type::Local) {
       imageData = getLocalImageData(imageProps.sources[0].uri);
     } else if(!isRequestInProgress_ && imageProps.sources[0].type == ImageSource::Type::Remote) {
@@ -107,8 +116,31 @@ void RSkComponentImage::OnPaint(SkCanvas *canvas) {
     }
     /* TODO: Handle filter quality based of configuration. Setting Low Filter Quality as default for now*/
     paint.setFilterQuality(DEFAULT_IMAGE_FILTER_QUALITY);
-    setPaintFilters(paint,imageProps,imageTargetRect,frameRect,false,imageData->isOpaque());
-    canvas->drawImageRect(imageData,imageTargetRect,&paint);
+    bool isAnimated = false;
+    {
+      std::scoped_lock lock(imageContentMutex_);
+      if(animatedImageUri_ != imageProps.sources[0].uri) {
+        // Frame count is checked once per source, first frame stays the cached image
+        animatedImageUri_ = imageProps.sources[0].uri;
+        animatedImage_ = RSkAnimatedImage::Make(imageData->refEncodedData());
+        animationStartTime_ = -1;
+        animationRequestId_++;
+        shownContentImage_ = nullptr; // Child layer shows the frame of the new source once decoded
+      }
+      // Frames are played by the animation driver, without it the first frame is drawn as a still image
+      isAnimated = animatedImage_ && layer()->client().animationDriver();
+      if(isAnimated) {
+        SkRect localFrameRect = frameRect.makeOffset(-frame.origin.x, -frame.origin.y);
+        computeContentRects(animatedImage_->dimensions());
+        contentPaint_ = paint;
+        setPaintFilters(contentPaint_,imageProps,contentTargetRect_,localFrameRect,false,imageData->isOpaque());
+      }
+      hasImageContent_ = isAnimated;
+    }
+    if(!isAnimated) {
+      setPaintFilters(paint,imageProps,imageTargetRect,frameRect,false,imageData->isOpaque());
+      canvas->drawImageRect(imageData,imageTargetRect,&paint);
+    }
     if(needClipAndRestore) {
       canvas->restore();
     }
@@ -118,8 +150,13 @@ void RSkComponentImage::OnPaint(SkCanvas *canvas) {
     if(hasToTriggerEvent_) sendSuccessEvents();
 
   } else {
+    {
+      // Download preview stays till the image is decoded
+      std::scoped_lock lock(imageContentMutex_);
+      hasImageContent_ = isRequestInProgress_;
+    }
   /* Emitting Image Load failed Event*/
-    if(imageProps.sources[0].type != ImageSource::Type::Remote) {
+    if(imageProps.sources[0].type != ImageSource::Type::Remote && !isRequestInProgress_) {
       if(!hasToTriggerEvent_) {
         imageEventEmitter_->onLoadStart();
         hasToTriggerEvent_ = true;
@@ -168,8 +205,8 @@ sk_sp<SkImage> RSkComponentImage::getLocalImageData(string sourceUri) {
 inline string RSkComponentImage::generateUriPath(string path) {
   if(path.substr(0, 14) == "file://assets/"){
     path = "./" + path.substr(7);
-  } else if( path.substr(0,5) == "data:" ){
-    RNS_LOG_NOT_IMPL;
+  } else if(path.substr(0, 7) == "file://"){
+    path = path.substr(7);
   }else {
     std::string ImagePath = RNSAssetManager::instance()->getAssetPath(path);
     path = ImagePath;
@@ -201,20 +238,35 @@ RnsShell::LayerInvalidateMask RSkComponentImage::updateComponentProps(SharedProp
         remoteCurlRequest_ = nullptr;
         //TODO - need to send the onEnd event to APP if it is abort.
         isRequestInProgress_=false;
+        if(progressiveDecoder_) {
+          progressiveDecoder_->cancel();
+          progressiveDecoder_ = nullptr;
+        }
+      } else if(isRequestInProgress_) {
+        // Data uri being decoded, its result is dropped as the source no longer matches
+        isRequestInProgress_=false;
       }
       networkImageData_.reset();
+      {
+        // Pending frame requests are dropped, child layer is removed on the next commit
+        std::scoped_lock lock(imageContentMutex_);
+        animatedImage_ = nullptr;
+        animatedImageUri_.clear();
+        animationRequestId_++;
+      }
       imageEventEmitter_->onLoadStart();
       hasToTriggerEvent_ = true;
+      updateMask =static_cast<RnsShell::LayerInvalidateMask>(updateMask | RnsShell::LayerPaintInvalidate);
+    }
+    if((forceUpdate) || (oldimageProps.blurRadius != newimageProps.blurRadius)) {
+      updateMask =static_cast<RnsShell::LayerInvalidateMask>(updateMask | RnsShell::LayerPaintInvalidate);
     }
     return updateMask;
 }
 
 void RSkComponentImage::drawAndSubmit() {
   layer()->client().notifyFlushBegin();
-  layer()->invalidate( RnsShell::LayerPaintInvalidate);
-  if (layer()->type() == RnsShell::LAYER_TYPE_PICTURE) {
-    RNS_PROFILE_API_OFF(getComponentData().componentName << " getPicture :", static_cast<RnsShell::PictureLayer*>(layer().get())->setPicture(getPicture()));
-  }
+  RSkComponent::drawAndSubmit(RnsShell::LayerPaintInvalidate); // Child layer is updated by OnSubmit
   layer()->client().notifyFlushRequired();
 }
 
@@ -387,8 +439,24 @@ void RSkComponentImage::requestNetworkImageData(string sourceUri) {
     return 0;
   };
 
+  // Image is decoded as it is received, previews are shown till the download completes
+  auto progressiveDecoder = std::make_shared<RSkProgressiveImageDecoder>(remoteCurlRequest_, [this, weakThis = this->weak_from_this()](sk_sp<SkImage> preview) {
+    auto isAlive = weakThis.lock();
+    if(isAlive) {
+      onPreviewImage(preview);
+    }
+  });
+  progressiveDecoder_ = progressiveDecoder;
+
+  // writecallback lambda fuction, called with the data received so far. Decoder reads it from the response buffer.
+  auto writeCallback = [progressiveDecoder](void* curlresponseData,void *userdata)->bool {
+    CurlResponse *responseData =  (CurlResponse *)curlresponseData;
+    progressiveDecoder->appendData(responseData->contentSize);
+    return true;
+  };
+
   // completioncallback lambda fuction
-  auto completionCallback =  [this, weakThis = this->weak_from_this()](void* curlresponseData,void *userdata)->bool {
+  auto completionCallback =  [this, weakThis = this->weak_from_this(), progressiveDecoder](void* curlresponseData,void *userdata)->bool {
     auto isAlive = weakThis.lock();
     if(!isAlive) {
       RNS_LOG_WARN("This object is already destroyed. ignoring the completion callback");
@@ -396,6 +464,7 @@ void RSkComponentImage::requestNetworkImageData(string sourceUri) {
     }
     CurlResponse *responseData =  (CurlResponse *)curlresponseData;
     CurlRequest * curlRequest = (CurlRequest *) userdata;
+    progressiveDecoder->cancel(); // Complete data is decoded below
     if((!responseData
         || !processImageData(curlRequest->URL.c_str(),responseData->responseBuffer,responseData->contentSize)) && (hasToTriggerEvent_)) {
       sendErrorEvents();
@@ -408,6 +477,7 @@ void RSkComponentImage::requestNetworkImageData(string sourceUri) {
   remoteCurlRequest_->curldelegator.delegatorData = remoteCurlRequest_.get();
   remoteCurlRequest_->curldelegator.CURLNetworkingHeaderCallback = headerCallback;
   remoteCurlRequest_->curldelegator.CURLNetworkingCompletionCallback=completionCallback;
+  remoteCurlRequest_->curldelegator.CURLNetworkingWriteCallback = writeCallback;
   if(!hasToTriggerEvent_) {
     imageEventEmitter_->onLoadStart();
     hasToTriggerEvent_ = true;
@@ -416,6 +486,239 @@ void RSkComponentImage::requestNetworkImageData(string sourceUri) {
   isRequestInProgress_ = true;
 }
 
+void RSkComponentImage::requestDataUriImageData(string sourceUri) {
+  if(!hasToTriggerEvent_) {
+    imageEventEmitter_->onLoadStart();
+    hasToTriggerEvent_ = true;
+  }
+  isRequestInProgress_ = true;
+  // Base64 payload is decoded on the image decode thread, not on the paint path
+  decodeDataUriAsync(sourceUri, [this, weakThis = this->weak_from_this(), sourceUri](sk_sp<SkData> data) {
+    auto isAlive = weakThis.lock();
+    if(!isAlive) {
+      RNS_LOG_WARN("This object is already destroyed. ignoring the data uri decode");
+      return;
+    }
+    sk_sp<SkImage> dataUriImageData = data ? SkImage::MakeFromEncoded(data) : nullptr;
+    if(dataUriImageData) {
+      decodedimageCacheData imageCacheData;
+      imageCacheData.imageData = dataUriImageData;
+      imageCacheData.expiryTime = (SkTime::GetMSecs() + DEFAULT_MAX_CACHE_EXPIRY_TIME);
+      RSkImageCacheManager::getImageCacheManagerInstance()->imageDataInsertInCache(imageCacheKey(sourceUri).c_str(), imageCacheData);
+    }
+
+    auto component = getComponentData();
+    auto const &imageProps = *std::static_pointer_cast<ImageProps const>(component.props);
+    if(imageProps.sources.empty() || imageProps.sources[0].uri != sourceUri)
+      return; // Source changed while decoding
+    isRequestInProgress_ = false;
+    if(!dataUriImageData) {
+      RNS_LOG_ERROR("Image not loaded from data uri");
+      if(hasToTriggerEvent_)
+        sendErrorEvents();
+      return;
+    }
+    networkImageData_ = dataUriImageData;
+    drawAndSubmit();
+  });
+}
+
+void RSkComponentImage::computeContentRects(SkISize imageSize) {
+  // Child layer content is recorded in image component local coordinates
+  Rect frame = getComponentData().layoutMetrics.frame;
+  contentClipRect_ = SkRect::MakeWH(frame.size.width, frame.size.height);
+  contentTargetRect_ = computeTargetRect({(Float)imageSize.width(), (Float)imageSize.height()}, contentClipRect_, imageProps.resizeMode);
+}
+
+void RSkComponentImage::updateImageContentLayer(sk_sp<SkImage> image) {
+  // Called with imageContentMutex_ held & layer tree locked
+  if(!image) {
+    return;
+  }
+  if(!imageContentLayer_) {
+    imageContentLayer_ = RnsShell::Layer::Create(layer()->client(), RnsShell::LAYER_TYPE_PICTURE);
+    layer()->appendChild(imageContentLayer_);
+  }
+  SkIRect contentFrame = contentClipRect_.roundOut();
+  SkPictureRecorder recorder;
+  SkCanvas *canvas = recorder.beginRecording(contentClipRect_);
+  canvas->clipRect(contentClipRect_, SkClipOp::kIntersect);
+  canvas->drawImageRect(image, contentTargetRect_, &contentPaint_);
+  static_cast<RnsShell::PictureLayer*>(imageContentLayer_.get())->setPicture(recorder.finishRecordingAsPicture());
+  if(contentFrame != imageContentLayer_->getFrame()) {
+    imageContentLayer_->setFrame(contentFrame);
+    imageContentLayer_->invalidate(RnsShell::LayerInvalidateAll);
+  } else {
+    imageContentLayer_->invalidate(RnsShell::LayerPaintInvalidate);
+  }
+  shownContentImage_ = image;
+}
+
+void RSkComponentImage::removeImageContentLayer() {
+  // Called with imageContentMutex_ held & layer tree locked
+  if(imageContentLayer_) {
+    imageContentLayer_->removeFromParent();
+    imageContentLayer_ = nullptr;
+  }
+  shownContentImage_ = nullptr;
+}
+
+void RSkComponentImage::OnSubmit() {
+  // Called on the commit thread with the layer tree locked, after the image component got its picture
+  std::scoped_lock lock(imageContentMutex_);
+  if(!hasImageContent_) {
+    removeImageContentLayer();
+    return;
+  }
+  if(!animatedImage_) {
+    return; // Download preview, shown by showPreviewImage
+  }
+  if(shownContentImage_) {
+    updateImageContentLayer(shownContentImage_); // Layout or paint props changed
+  }
+  if(animationStartTime_ < 0) {
+    animationStartTime_ = 0; // Set to the first frame time by the frame callback
+    requestAnimationFrame(++animationRequestId_);
+  } else if(isAnimationPaused_) {
+    isAnimationPaused_ = false; // Painted again, may be visible now
+    requestAnimationFrame(++animationRequestId_);
+  }
+}
+
+void RSkComponentImage::requestAnimationFrame(uint64_t requestId) {
+  // Called with imageContentMutex_ held. One frame is requested at a time, the next one at its start time.
+  RnsShell::AnimationDriver *animationDriver = layer()->client().animationDriver();
+  if(!animationDriver) {
+    return;
+  }
+  std::weak_ptr<RSkComponent> weakSelf = shared_from_this();
+  animationDriver->addFrameCallback([weakSelf, requestId](double frameTimeMs) {
+    auto self = std::static_pointer_cast<RSkComponentImage>(weakSelf.lock());
+    if(self) {
+      self->onAnimationFrame(requestId, frameTimeMs);
+    }
+    return false; // One shot
+  });
+}
+
+void RSkComponentImage::onAnimationFrame(uint64_t requestId, double frameTimeMs) {
+  // Called on the compositor thread with the layer tree locked
+  std::scoped_lock lock(imageContentMutex_);
+  if(requestId != animationRequestId_ || !animatedImage_) {
+    return; // Source changed or animation restarted meanwhile
+  }
+  if(!isImageOnScreen()) {
+    // Frame shown last stays on the child layer, playback time goes on while paused
+    isAnimationPaused_ = true;
+    pausedLayoutGeneration_ = RnsShell::Layer::absoluteFrameGeneration();
+    pausedScrollGeneration_ = RnsShell::ScrollLayer::scrollPositionGeneration();
+    std::weak_ptr<RSkComponent> weakSelf = shared_from_this();
+    runOnImageTimerThread([weakSelf, requestId]() {
+      auto self = std::static_pointer_cast<RSkComponentImage>(weakSelf.lock());
+      if(self) {
+        self->checkPausedAnimation(requestId);
+      }
+    }, ANIMATED_IMAGE_PAUSED_CHECK_MS);
+    return;
+  }
+  if(animationStartTime_ <= 0) {
+    animationStartTime_ = frameTimeMs;
+  }
+  bool isFinished = false;
+  double nextFrameDelayMs = 0;
+  sk_sp<SkImage> frameImage = animatedImage_->frameForTime(frameTimeMs - animationStartTime_, isFinished, nextFrameDelayMs);
+  if(frameImage && frameImage != shownContentImage_) {
+    updateImageContentLayer(frameImage);
+  }
+  if(isFinished) {
+    return;
+  }
+  std::weak_ptr<RSkComponent> weakSelf = shared_from_this();
+  runOnImageTimerThread([weakSelf, requestId]() {
+    auto self = std::static_pointer_cast<RSkComponentImage>(weakSelf.lock());
+    if(self) {
+      std::scoped_lock lock(self->imageContentMutex_);
+      if(requestId == self->animationRequestId_) {
+        self->requestAnimationFrame(requestId);
+      }
+    }
+  }, nextFrameDelayMs);
+}
+
+void RSkComponentImage::checkPausedAnimation(uint64_t requestId) {
+  // Called on the image timer thread. Visibility is checked again on a frame, once the geometry changed.
+  std::scoped_lock lock(imageContentMutex_);
+  if(requestId != animationRequestId_ || !isAnimationPaused_) {
+    return;
+  }
+  if(pausedLayoutGeneration_ != RnsShell::Layer::absoluteFrameGeneration() ||
+     pausedScrollGeneration_ != RnsShell::ScrollLayer::scrollPositionGeneration()) {
+    isAnimationPaused_ = false;
+    requestAnimationFrame(requestId);
+    return;
+  }
+  std::weak_ptr<RSkComponent> weakSelf = shared_from_this();
+  runOnImageTimerThread([weakSelf, requestId]() {
+    auto self = std::static_pointer_cast<RSkComponentImage>(weakSelf.lock());
+    if(self) {
+      self->checkPausedAnimation(requestId);
+    }
+  }, ANIMATED_IMAGE_PAUSED_CHECK_MS);
+}
+
+bool RSkComponentImage::isImageOnScreen() {
+  // Called with the layer tree locked
+  for(RnsShell::Layer *ancestor = layer().get(); ancestor; ancestor = ancestor->parent()) {
+    if(ancestor->opacity == 0) {
+      return false; // Hidden with an ancestor
+    }
+  }
+  // Detached layer is not on screen, the commit mounting it again restarts the animation
+  RnsShell::Layer *rootLayer = layer()->rootLayer();
+  return (rootLayer != layer().get()) && getScreenFrame().intersects(rootLayer->absoluteFrame());
+}
+
+void RSkComponentImage::onPreviewImage(sk_sp<SkImage> preview) {
+  // Called on the image decode thread, previews are coalesced into the next frame
+  {
+    std::scoped_lock lock(imageContentMutex_);
+    previewImage_ = preview;
+    if(previewUpdatePending_) {
+      return;
+    }
+    previewUpdatePending_ = true;
+  }
+  RnsShell::AnimationDriver *animationDriver = layer()->client().animationDriver();
+  if(!animationDriver) {
+    layer()->client().notifyFlushBegin();
+    showPreviewImage();
+    layer()->client().notifyFlushRequired();
+    return;
+  }
+  std::weak_ptr<RSkComponent> weakSelf = shared_from_this();
+  animationDriver->addFrameCallback([weakSelf](double frameTimeMs) {
+    auto self = std::static_pointer_cast<RSkComponentImage>(weakSelf.lock());
+    if(self) {
+      self->showPreviewImage();
+    }
+    return false; // One shot, next preview schedules again
+  });
+}
+
+void RSkComponentImage::showPreviewImage() {
+  // Layer tree is locked by the caller
+  std::scoped_lock lock(imageContentMutex_);
+  previewUpdatePending_ = false;
+  sk_sp<SkImage> preview = std::move(previewImage_);
+  if(!preview || !isRequestInProgress_ || networkImageData_) {
+    return; // Download completed meanwhile, the decoded image is painted instead
+  }
+  computeContentRects(preview->dimensions());
+  contentPaint_ = SkPaint();
+  contentPaint_.setFilterQuality(DEFAULT_IMAGE_FILTER_QUALITY);
+  updateImageContentLayer(preview);
+}
+
 inline void RSkComponentImage::sendErrorEvents() {
   imageEventEmitter_->onError();
   imageEventEmitter_->onLoadEnd();
@@ -437,6 +740,9 @@ RSkComponentImage::~RSkComponentImage(){
     CurlNetworking::sharedCurlNetworking()->abortRequest(remoteCurlRequest_);
     isRequestInProgress_=false;
   }
+  if(progressiveDecoder_) {
+    progressiveDecoder_->cancel();
+  }
 }
 
 } // namespace react
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <mutex>
+#include "include/core/SkPaint.h"
 #include "include/core/SkRect.h"
 
 #include "react/renderer/components/image/ImageShadowNode.h"
@@ -15,6 +16,7 @@
 #include "ReactSkia/components/RSkComponent.h"
 #include "ReactSkia/sdk/CurlNetworking.h"
 #include "ReactSkia/views/common/RSkImageCacheManager.h"
+#include "ReactSkia/views/common/RSkImageDecoder.h"
 
 #define DEFAULT_IMAGE_FILTER_QUALITY kLow_SkFilterQuality /*Skia's Defualt is kNone_SkFilterQuality*/
 #define DEFAULT_MAX_CACHE_EXPIRY_TIME 1800000 // 30mins in milliseconds 1800000
@@ -22,6 +24,7 @@
 #define RNS_NO_STORE_STR "no-store"
 #define RNS_MAX_AGE_0_STR "max-age=0"
 #define RNS_MAX_AGE_STR "max-age"
+#define ANIMATED_IMAGE_PAUSED_CHECK_MS 250 // Layout & scroll changes are polled at it, while an animated image is offscreen
 namespace facebook {
 namespace react {
 
@@ -51,6 +54,37 @@ class RSkComponentImage final : public RSkComponent {
   inline void setPaintFilters (SkPaint &paintObj,const ImageProps &imageProps,
                               SkRect targetRect,SkRect frameRect,
                               bool  filterForShadow, bool isOpaque);
+
+  /* Animated frames & download previews are drawn on a child layer, so they are
+     updated from the compositor thread without recording the image component again.
+     Child layer is added & removed on the commit path (OnSubmit), never while painting. */
+  std::mutex imageContentMutex_;
+  std::shared_ptr<RnsShell::Layer> imageContentLayer_{nullptr};
+  sk_sp<SkImage> shownContentImage_;
+  SkRect contentTargetRect_;
+  SkRect contentClipRect_;
+  SkPaint contentPaint_;
+  bool hasImageContent_{false}; // Set by paint when the child layer is needed, applied by OnSubmit
+  std::shared_ptr<RSkAnimatedImage> animatedImage_{nullptr};
+  std::string animatedImageUri_; // Source checked for multiple frames
+  double animationStartTime_{-1};
+  uint64_t animationRequestId_{0}; // Bumped to drop the frame requests still pending
+  bool isAnimationPaused_{false}; // Offscreen or hidden, no frame is requested till the layout or scroll changes
+  uint64_t pausedLayoutGeneration_{0};
+  uint64_t pausedScrollGeneration_{0};
+  std::shared_ptr<RSkProgressiveImageDecoder> progressiveDecoder_{nullptr};
+  sk_sp<SkImage> previewImage_;
+  bool previewUpdatePending_{false};
+
+  void computeContentRects(SkISize imageSize);
+  void updateImageContentLayer(sk_sp<SkImage> image);
+  void removeImageContentLayer();
+  void requestAnimationFrame(uint64_t requestId);
+  void onAnimationFrame(uint64_t requestId, double frameTimeMs);
+  void checkPausedAnimation(uint64_t requestId);
+  bool isImageOnScreen();
+  void onPreviewImage(sk_sp<SkImage> preview);
+  void showPreviewImage();
  protected:
   sk_sp<SkImage> networkImageData_;
   bool hasToTriggerEvent_{false};
@@ -59,6 +93,7 @@ class RSkComponentImage final : public RSkComponent {
 
   sk_sp<SkImage> getLocalImageData(string sourceUri);
   void requestNetworkImageData(string sourceUri);
+  void requestDataUriImageData(string sourceUri);
 
   inline string generateUriPath(string path);
   void drawAndSubmit();
@@ -66,6 +101,7 @@ class RSkComponentImage final : public RSkComponent {
   virtual inline void sendErrorEvents();
   virtual inline void sendSuccessEvents();
   void OnPaint(SkCanvas *canvas) override;
+  void OnSubmit() override;
 };
 
 } // namespace react
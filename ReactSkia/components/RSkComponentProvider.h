@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ReactSkia/components/RSkComponent.h"
+#include "ReactSkia/components/RSkComponentTable.h"
 #include "react/renderer/componentregistry/ComponentDescriptorProvider.h"
 #include "react/renderer/mounting/ShadowView.h"
 
@@ -18,30 +19,40 @@ class RSkComponentProvider {
       const ShadowView &shadowView) = 0;
 
   virtual std::shared_ptr<RSkComponent> GetComponent(Tag tag) {
-      auto it = registry_.find(tag);
-      if (it != registry_.end()) {
-          return it->second;
+      if(componentTable_ == nullptr) {
+          return nullptr;
+      }
+      auto entry = componentTable_->find(tag);
+      if (entry != nullptr && entry->provider == this) {
+          return entry->component;
       }
       return nullptr;
   }
 
   std::shared_ptr<RSkComponent> CreateAndAddComponent(const ShadowView &shadowView) {
       auto component = this->CreateComponent(shadowView);
-      registry_[shadowView.tag] = component;
+      RNS_LOG_ASSERT(componentTable_, "Provider must be registered to ComponentViewRegistry before creating components");
+      if(componentTable_) {
+          componentTable_->insert(shadowView.tag, component, this);
+      }
       return component;
   }
 
   void DeleteComponent(Tag tag) {
-      auto it = registry_.find(tag);
-      if (it != registry_.end()) {
-           auto component = it->second;
-           registry_.erase(tag);
-           component.reset();
+      if(componentTable_ == nullptr) {
+          return;
+      }
+      auto entry = componentTable_->find(tag);
+      if (entry != nullptr && entry->provider == this) {
+           componentTable_->erase(tag);
       }
   }
 
+  // Component table shared by all the providers of the registry, set by ComponentViewRegistry::Register
+  void setComponentTable(RSkComponentTable *componentTable) { componentTable_ = componentTable; }
+
  private:
-  better::map<Tag, std::shared_ptr<RSkComponent>> registry_;
+  RSkComponentTable *componentTable_{nullptr};
 
 };
 using RSkComponentProviderProtocol = RSkComponentProvider *(*)();
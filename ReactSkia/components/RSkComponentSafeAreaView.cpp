@@ -85,8 +85,8 @@ void RSkComponentSafeAreaView::OnPaint(SkCanvas *canvas) {
                     layerRef->shadowImageFilter,layerRef->shadowMaskFilter
                    );
   }
-  drawBackground(canvas,frame,borderMetrics,viewProps.backgroundColor);
-  drawBorder(canvas,frame,borderMetrics,viewProps.backgroundColor);
+  drawBackground(canvas,frame,borderMetrics,viewProps.backgroundColor,frameGeometryCache());
+  drawBorder(canvas,frame,borderMetrics,viewProps.backgroundColor,frameGeometryCache());
 }
 
 // Callback client
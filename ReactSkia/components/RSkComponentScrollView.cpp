@@ -9,6 +9,7 @@
 #include "include/core/SkPictureRecorder.h"
 
 #include "ReactSkia/components/RSkComponentScrollView.h"
+#include "ReactSkia/core_modules/RSkNativeAnimatedNodesManager.h"
 #include "ReactSkia/utils/RnsUtils.h"
 #include "ReactSkia/views/common/RSkConversion.h"
 
@@ -541,6 +542,16 @@ void RSkComponentScrollView::dispatchOnScrollEvent(SkPoint scrollPos) {
   //scrollMetrics.contentInset = contentInset_;
 
   std::static_pointer_cast<ScrollViewEventEmitter const>(getComponentData().eventEmitter)->onScroll(scrollMetrics);
+
+  // Animated.event(onScroll) with native driver, same payload as the JS event
+  Tag tag = getComponentData().tag;
+  if(RSkNativeAnimatedNodesManager::isAnimatedEventAttached(tag, "scroll")) {
+    RSkNativeAnimatedNodesManager::dispatchAnimatedEvent(tag, "scroll", folly::dynamic::object
+        ("contentOffset", folly::dynamic::object("x", scrollMetrics.contentOffset.x)("y", scrollMetrics.contentOffset.y))
+        ("contentSize", folly::dynamic::object("width", scrollMetrics.contentSize.width)("height", scrollMetrics.contentSize.height))
+        ("layoutMeasurement", folly::dynamic::object("width", scrollMetrics.containerSize.width)("height", scrollMetrics.containerSize.height))
+        ("zoomScale", scrollMetrics.zoomScale));
+  }
 }
 
 } // namespace react
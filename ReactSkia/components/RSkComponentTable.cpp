@@ -0,0 +1,112 @@
+/*
+* Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+*
+* This source code is licensed under the MIT license found in the
+* LICENSE file in the root directory of this source tree.
+*/
+
+#include "ReactSkia/components/RSkComponentTable.h"
+#include "ReactSkia/utils/RnsLog.h"
+
+#define RSK_COMPONENT_TABLE_INITIAL_CAPACITY 256 // Must be power of 2
+
+namespace facebook {
+namespace react {
+
+RSkComponentTable::RSkComponentTable()
+    : slots_(RSK_COMPONENT_TABLE_INITIAL_CAPACITY)
+    , mask_(RSK_COMPONENT_TABLE_INITIAL_CAPACITY - 1) {}
+
+inline size_t RSkComponentTable::slotFor(Tag tag) const {
+  // Fabric tags are mostly consecutive even numbers, scramble them so that they spread over all the slots
+  uint32_t hash = static_cast<uint32_t>(tag) * 2654435769u;
+  return (hash ^ (hash >> 16)) & mask_;
+}
+
+void RSkComponentTable::grow() {
+  std::vector<Entry> oldSlots(std::move(slots_));
+  slots_ = std::vector<Entry>(oldSlots.size() * 2);
+  mask_ = slots_.size() - 1;
+  count_ = 0;
+  for (auto &entry : oldSlots) {
+    if(entry.component) {
+      insert(entry.tag, std::move(entry.component), entry.provider);
+    }
+  }
+  RNS_LOG_DEBUG("Component table resized to " << slots_.size() << " slots for " << count_ << " components");
+}
+
+void RSkComponentTable::insert(Tag tag, std::shared_ptr<RSkComponent> component, RSkComponentProvider *provider) {
+  if(!component) {
+    RNS_LOG_ERROR("Invalid component for tag (" << tag << ")");
+    return;
+  }
+  // Keep load factor below 0.5, so that probe sequences stay short
+  if((count_ + 1) * 2 > slots_.size()) {
+    grow();
+  }
+
+  size_t index = slotFor(tag);
+  while(slots_[index].component) {
+    if(slots_[index].tag == tag) { // Replace existing entry
+      slots_[index].component = std::move(component);
+      slots_[index].provider = provider;
+      return;
+    }
+    index = (index + 1) & mask_;
+  }
+  slots_[index].tag = tag;
+  slots_[index].component = std::move(component);
+  slots_[index].provider = provider;
+  count_++;
+}
+
+const RSkComponentTable::Entry* RSkComponentTable::find(Tag tag) const {
+  size_t index = slotFor(tag);
+  while(slots_[index].component) {
+    if(slots_[index].tag == tag) {
+      return &slots_[index];
+    }
+    index = (index + 1) & mask_;
+  }
+  return nullptr;
+}
+
+void RSkComponentTable::erase(Tag tag) {
+  size_t index = slotFor(tag);
+  while(slots_[index].component && slots_[index].tag != tag) {
+    index = (index + 1) & mask_;
+  }
+  if(!slots_[index].component) {
+    return;
+  }
+  // Release the component only after the table is consistent again
+  std::shared_ptr<RSkComponent> removedComponent = std::move(slots_[index].component);
+
+  // Backward shift deletion : move up the following entries of the probe sequence to fill the hole,
+  // so that lookups never need tombstones.
+  size_t hole = index;
+  size_t next = (hole + 1) & mask_;
+  while(slots_[next].component) {
+    size_t home = slotFor(slots_[next].tag);
+    // Move the entry only if its home slot is not in the cyclic range (hole, next]
+    if(((next - home) & mask_) >= ((next - hole) & mask_)) {
+      slots_[hole] = std::move(slots_[next]);
+      hole = next;
+    }
+    next = (next + 1) & mask_;
+  }
+  slots_[hole] = Entry();
+  count_--;
+  removedComponent.reset();
+}
+
+void RSkComponentTable::clear() {
+  for (auto &entry : slots_) {
+    entry = Entry();
+  }
+  count_ = 0;
+}
+
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,53 @@
+/*
+* Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+*
+* This source code is licensed under the MIT license found in the
+* LICENSE file in the root directory of this source tree.
+*/
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "react/renderer/core/ReactPrimitives.h"
+
+namespace facebook {
+namespace react {
+
+class RSkComponent;
+class RSkComponentProvider;
+
+/*
+ * Tag indexed lookup table for all the mounted components, shared by every provider of a ComponentViewRegistry.
+ * React tags are small integers, so it is implemented as an open addressing hash table with linear probing,
+ * which gives O(1) lookup without walking the providers, and keeps the memory bounded to the live components
+ * even though tags are never reused.
+ */
+class RSkComponentTable {
+ public:
+  struct Entry {
+    Tag tag{0};
+    std::shared_ptr<RSkComponent> component{nullptr};
+    RSkComponentProvider *provider{nullptr};
+  };
+
+  RSkComponentTable();
+
+  void insert(Tag tag, std::shared_ptr<RSkComponent> component, RSkComponentProvider *provider);
+  void erase(Tag tag);
+  const Entry* find(Tag tag) const;
+  void clear();
+
+  size_t size() const { return count_; }
+
+ private:
+  size_t slotFor(Tag tag) const;
+  void grow();
+
+  std::vector<Entry> slots_; // Empty slot is identified by null component
+  size_t count_{0};
+  size_t mask_{0};
+};
+
+} // namespace react
+} // namespace facebook
@@ -6,6 +6,7 @@
  */
 
 #include "include/core/SkPaint.h"
+#include "include/core/SkPictureRecorder.h"
 #include "modules/skparagraph/src/ParagraphImpl.h"
 
 #include "ReactSkia/components/RSkComponentTextInput.h"
@@ -14,14 +15,12 @@
 #include "ReactSkia/sdk/RNSKeyCodeMapping.h"
 #include "ReactSkia/views/common/RSkConversion.h"
 #include "ReactSkia/views/common/RSkSdkConversion.h"
+#include "rns_shell/compositor/AnimationDriver.h"
 #include "rns_shell/compositor/layers/PictureLayer.h"
 
 #include <string.h>
+#include <algorithm>
 #include <iostream>
-#include <queue>
-#include <thread>
-#include <semaphore.h>
-#include <mutex>
 
 
 namespace facebook {
@@ -33,28 +32,17 @@ using namespace skia::textlayout;
 #define NUMBER_OF_LINES         1
 #define FONTSIZE_MULTIPLIER     1
 #define CURSOR_WIDTH 2
-
-std::queue<rnsKey> inputQueue;
-sem_t jsUpdateSem;
-std::mutex privateVarProtectorMutex;
-std::mutex inputQueueMutex;
-static bool isKeyRepeateOn;
-unsigned int keyRepeateStartIndex;
+#define ZERO_WIDTH_SPACE "\u200B"
 
 RSkComponentTextInput::RSkComponentTextInput(const ShadowView &shadowView)
     : RSkComponent(shadowView)
     ,isInEditingMode_(false)
-    ,isTextInputInFocus_(false)
     ,eventCount_(0)
-    ,cursor_({0,0})
-    ,paragraph_(nullptr){
+    ,cursor_({0,0}){
   RNS_LOG_DEBUG("RSkComponentTextInput called constructor");
   cursorPaint_.setColor(SK_ColorBLUE);
   cursorPaint_.setAntiAlias(true);
-  cursorPaint_.setStyle(SkPaint::kStroke_Style);
-  cursorPaint_.setStrokeWidth(CURSOR_WIDTH);
-  sem_init(&jsUpdateSem,0,0);
-  isKeyRepeateOn=false;
+  cursorPaint_.setStyle(SkPaint::kFill_Style);
 }
 
 void RSkComponentTextInput::drawAndSubmit(bool isFlushDisplay){
@@ -64,92 +52,225 @@ void RSkComponentTextInput::drawAndSubmit(bool isFlushDisplay){
   if (layer()->type() == RnsShell::LAYER_TYPE_PICTURE) {
     RNS_PROFILE_API_OFF(getComponentData().componentName << " getPicture :", static_cast<RnsShell::PictureLayer*>(layer().get())->setPicture(getPicture()));
   }
+  updateCursorLayer(getComponentData().layoutMetrics);
   if(isFlushDisplay)
     layer()->client().notifyFlushRequired();
 }
 
 void RSkComponentTextInput::drawTextInput(SkCanvas *canvas,
   LayoutMetrics layout,
-  const TextInputProps& props,
-  struct RSkSkTextLayout &textLayout) {
+  const TextInputProps& props) {
   Rect frame = layout.frame;
-  ParagraphStyle paraStyle;
-  float yOffset;
-
-  // setParagraphStyle
-  textLayout.paraStyle.setMaxLines(NUMBER_OF_LINES);
-  textLayout.paraStyle.setEllipsis(u"\u2026");
-  textLayout.builder->setParagraphStyle(textLayout.paraStyle);
-
-  // buildParagraph
-  paragraph_ = textLayout.builder->Build();
-  paragraph_->layout(layout.getContentFrame().size.width);
 
   // clipRect and backgroundColor
   canvas->clipRect(SkRect::MakeXYWH(frame.origin.x, frame.origin.y, frame.size.width, frame.size.height));
   canvas->drawColor(RSkColorFromSharedColor(props.backgroundColor, SK_ColorTRANSPARENT));
 
-  // paintParagraph
-  yOffset = (layout.getContentFrame().size.height - paragraph_->getHeight()) / 2;
-  paragraph_->paint(canvas, frame.origin.x + layout.contentInsets.left, frame.origin.y + layout.contentInsets.top + yOffset);
-  drawCursor(canvas, layout);
+  // paint laid out lines, lines out of the clip are skipped
+  lineParagraphs_.paint(canvas, frame.origin.x + layout.contentInsets.left, frame.origin.y + textTop(layout));
 
   //Notify OSK to update it's user input display String
   #if ENABLE(FEATURE_ONSCREEN_KEYBOARD)
-  if (0 == displayString_.size()) {
+  if (editBuffer_.empty()) {
     /*In case of Empty displayString,TextInput renders PlaceHolder Name in TI BOX. To avoid it, passing empty string here */
     OnScreenKeyboard::updatePlaceHolderString(std::string(),0);
   } else {
-    OnScreenKeyboard::updatePlaceHolderString((static_cast<ParagraphImpl*>(paragraph_.get()))->text().data(),(cursor_.end - cursor_.locationFromEnd));
+    std::string oskText = secureTextEntry_ ? std::string(editBuffer_.length(), '*') : editBuffer_.text();
+    OnScreenKeyboard::updatePlaceHolderString(oskText,(cursor_.end - cursor_.locationFromEnd));
   }
   #endif/*FEATURE_ONSCREEN_KEYBOARD*/
 }
-void RSkComponentTextInput::drawCursor(SkCanvas *canvas, LayoutMetrics layout){
-  // draw Cursor
-  Rect frame = layout.frame;
-  SkRect cursorRect;
-  float yOffset;
+
+void RSkComponentTextInput::layoutText(
+    const Component &component,
+    const TextInputProps& props) {
+  bool isPlaceholder = editBuffer_.empty();
+  float width = component.layoutMetrics.getContentFrame().size.width;
+  // Placeholder & the joined lines of a single line input are laid out from displayBuffer_, reset only when they change
+  RSkTextEditBuffer *displayedBuffer = &editBuffer_;
+  if (isPlaceholder || (!multiline_ && (editBuffer_.lineCount() > 1))) {
+    std::string displayText = isPlaceholder ? placeholderString_ : editBuffer_.text();
+    if (!isPlaceholder) {
+      std::replace(displayText.begin(), displayText.end(), '\n', ' ');
+    }
+    if (displayText != displayBuffer_.text()) {
+      displayBuffer_.reset(displayText);
+    }
+    displayedBuffer = &displayBuffer_;
+  }
+  // Laid out lines are kept until props, width, placeholder state or displayed buffer change, so that an edit lays out only the edited lines
+  if ((component.props != paragraphProps_) || (width != paragraphWidth_) || (isPlaceholder != paragraphIsPlaceholder_) ||
+      (displayedBuffer != paragraphBuffer_)) {
+    lineParagraphs_.clear();
+    paragraphProps_ = component.props;
+    paragraphWidth_ = width;
+    paragraphIsPlaceholder_ = isPlaceholder;
+    paragraphBuffer_ = displayedBuffer;
+  }
+  // Secure text is masked line by line, characters stay at the same positions
+  bool maskText = secureTextEntry_ && !isPlaceholder;
+  auto state = std::static_pointer_cast<TextInputShadowNode::ConcreteStateT const>(component.state);
+  auto data = state->getData();
+  TextAttributes textAttributes = props.getEffectiveTextAttributes(FONTSIZE_MULTIPLIER);
+  if (isPlaceholder) {
+    textAttributes.foregroundColor = placeholderColor_;
+  }
+  auto paragraphFactory = [&](const std::string &lineText) {
+    struct RSkSkTextLayout textLayout;
+    textLayout.builder = std::static_pointer_cast<skia::textlayout::ParagraphBuilder>(
+                            std::make_shared<skia::textlayout::ParagraphBuilderImpl>(
+                            textLayout.paraStyle, data.layoutManager->collection_));
+    // Empty line is laid out with a zero width space, which gives the line height & the cursor position
+    data.layoutManager->buildText(textLayout, props.backgroundColor, props.paragraphAttributes, textAttributes,
+                                  lineText.empty() ? ZERO_WIDTH_SPACE : (maskText ? std::string(lineText.length(), '*') : lineText), true);
+
+    // setParagraphStyle : lines of multiline input wrap, single line input is ellipsized
+    if (!multiline_) {
+      textLayout.paraStyle.setMaxLines(NUMBER_OF_LINES);
+      textLayout.paraStyle.setEllipsis(u"…");
+    }
+    textLayout.builder->setParagraphStyle(textLayout.paraStyle);
+
+    // buildParagraph
+    std::shared_ptr<Paragraph> paragraph = textLayout.builder->Build();
+    paragraph->layout(width);
+    return paragraph;
+  };
+  lineParagraphs_.layout(*displayedBuffer, paragraphFactory);
+}
+
+float RSkComponentTextInput::textTop(LayoutMetrics layout) {
+  // Single line is centered vertically, multiline starts from top & scrolls
+  if (multiline_) {
+    return layout.contentInsets.top - scrollOffset_;
+  }
+  return layout.contentInsets.top + (layout.getContentFrame().size.height - lineParagraphs_.height()) / 2;
+}
+
+SkRect RSkComponentTextInput::getCaretRect() {
+  // Caret rect in the coordinates of the laid out lines
+  auto &lines = lineParagraphs_.lines();
+  if (lines.empty()) {
+    return SkRect::MakeEmpty();
+  }
+  size_t position = paragraphIsPlaceholder_ ? 0 : cursor_.end - cursor_.locationFromEnd;
+  size_t line = 0;
+  size_t column = position;
+  if (lines.size() == editBuffer_.lineCount()) {
+    line = editBuffer_.lineOf(position);
+    column = position - editBuffer_.lineStart(line);
+  }
+  auto &paragraph = lines[line].paragraph;
+  SkScalar caretX = 0;
+  SkScalar caretTop = 0;
+  SkScalar caretBottom = paragraph->getHeight();
   std::vector<TextBox> rects;
-  if ( isInEditingMode_ && !caretHidden_ ) {
-    int position = cursor_.end - cursor_.locationFromEnd;
-    if (cursor_.locationFromEnd == cursor_.end) {
-      rects = paragraph_->getRectsForRange(0, position+1, RectHeightStyle::kTight, RectWidthStyle::kTight);
-      cursorRect.fLeft =  frame.origin.x + rects[0].rect.left() + layout.contentInsets.left;
-      cursorRect.fRight = cursorRect.fLeft;
-    } else {
-      rects = paragraph_->getRectsForRange(0, position, RectHeightStyle::kTight, RectWidthStyle::kTight);
-      cursorRect.fLeft =  frame.origin.x + rects[0].rect.right() + layout.contentInsets.left;
-      cursorRect.fRight = cursorRect.fLeft;
+  if (column == 0) {
+    rects = paragraph->getRectsForRange(0, 1, RectHeightStyle::kMax, RectWidthStyle::kTight);
+    if (!rects.empty()) caretX = rects.front().rect.left();
+  } else {
+    rects = paragraph->getRectsForRange(column - 1, column, RectHeightStyle::kMax, RectWidthStyle::kTight);
+    if (!rects.empty()) caretX = rects.back().rect.right();
+  }
+  if (multiline_ && !rects.empty()) {
+    // Wrapped line : caret spans its row only
+    caretTop = rects.back().rect.top();
+    caretBottom = rects.back().rect.bottom();
+  }
+  return SkRect::MakeLTRB(caretX - CURSOR_WIDTH / 2, lines[line].top + caretTop, caretX + CURSOR_WIDTH / 2, lines[line].top + caretBottom);
+}
+
+SkRect RSkComponentTextInput::getCursorRect(LayoutMetrics layout) {
+  // Cursor rect in the coordinates of textinput frame
+  if (!isInEditingMode_ || caretHidden_) {
+    return SkRect::MakeEmpty();
+  }
+  SkRect cursorRect = getCaretRect();
+  if (!cursorRect.isEmpty()) {
+    cursorRect.offset(layout.contentInsets.left, textTop(layout));
+  }
+  return cursorRect;
+}
+
+bool RSkComponentTextInput::scrollToCursor(LayoutMetrics layout) {
+  // Returns true when the text has to be recorded again at the new scroll offset
+  if (!multiline_) {
+    return false;
+  }
+  float viewportHeight = layout.getContentFrame().size.height;
+  float scrollOffset = scrollOffset_;
+  SkRect caretRect = getCaretRect();
+  if (!caretRect.isEmpty()) {
+    if (caretRect.bottom() > scrollOffset + viewportHeight) {
+      scrollOffset = caretRect.bottom() - viewportHeight;
+    }
+    if (caretRect.top() < scrollOffset) {
+      scrollOffset = caretRect.top();
     }
-    yOffset = (layout.getContentFrame().size.height - paragraph_->getHeight()) / 2;
-    cursorRect.fTop = frame.origin.y + yOffset + layout.contentInsets.top;
-    cursorRect.fBottom = cursorRect.fTop + paragraph_->getHeight();
+  }
+  scrollOffset = std::max(0.0f, std::min(scrollOffset, lineParagraphs_.height() - viewportHeight));
+  if (scrollOffset == scrollOffset_) {
+    return false;
+  }
+  scrollOffset_ = scrollOffset;
+  return true;
+}
+
+bool RSkComponentTextInput::moveCursorVertically(rnsKey eventKeyType) {
+  // Moves to the same column of the previous or next line, returns false on the first or last line
+  size_t position = cursor_.end - cursor_.locationFromEnd;
+  size_t line = editBuffer_.lineOf(position);
+  if (((eventKeyType == RNS_KEY_Up) && (line == 0)) ||
+      ((eventKeyType == RNS_KEY_Down) && (line + 1 >= editBuffer_.lineCount()))) {
+    return false;
+  }
+  size_t column = position - editBuffer_.lineStart(line);
+  size_t targetLine = (eventKeyType == RNS_KEY_Up) ? line - 1 : line + 1;
+  position = editBuffer_.lineStart(targetLine) + std::min(column, editBuffer_.lineLength(targetLine));
+  cursor_.locationFromEnd = cursor_.end - position;
+  return true;
+}
+
+void RSkComponentTextInput::updateCursorLayer(LayoutMetrics layout) {
+  /* Cursor is a child layer of the textinput, so moving or hiding it damages only the
+     old & new caret rects, text picture is not recorded again. Called on the commit path
+     with the layer tree locked, never from paint. */
+  std::scoped_lock lock(textMutex_);
+  SkRect cursorRect = getCursorRect(layout);
+  if (!cursorLayer_) {
+    if (cursorRect.isEmpty()) {
+      return;
+    }
+    cursorLayer_ = RnsShell::Layer::Create(layer()->client(), RnsShell::LAYER_TYPE_PICTURE);
+    layer()->appendChild(cursorLayer_);
+  }
+  SkIRect cursorFrame = cursorRect.roundOut();
+  if ((cursorFrame == cursorLayer_->getFrame()) && (cursorPaint_.getColor() == cursorColor_)) {
+    return;
+  }
+  if (!cursorFrame.isEmpty()) {
+    SkPictureRecorder recorder;
+    SkCanvas *canvas = recorder.beginRecording(SkRect::Make(cursorFrame));
     canvas->drawRect(cursorRect, cursorPaint_);
+    static_cast<RnsShell::PictureLayer*>(cursorLayer_.get())->setPicture(recorder.finishRecordingAsPicture());
   }
+  cursorColor_ = cursorPaint_.getColor();
+  cursorLayer_->setFrame(cursorFrame);
+  cursorLayer_->invalidate(RnsShell::LayerInvalidateAll);
+}
+
+void RSkComponentTextInput::OnSubmit() {
+  updateCursorLayer(getComponentData().layoutMetrics);
 }
+
 void RSkComponentTextInput::OnPaint(SkCanvas *canvas) {
   auto component = getComponentData();
   auto const &textInputProps = *std::static_pointer_cast<TextInputProps const>(component.props);
-  auto state = std::static_pointer_cast<TextInputShadowNode::ConcreteStateT const>(component.state);
-  auto data = state->getData();
   auto borderMetrics = textInputProps.resolveBorderMetrics(component.layoutMetrics);
+  std::scoped_lock lock(textMutex_);
   Rect frame = component.layoutMetrics.frame;
-  struct RSkSkTextLayout textLayout;
-  TextAttributes textAttributes = textInputProps.getEffectiveTextAttributes(FONTSIZE_MULTIPLIER);
-  textLayout.builder = std::static_pointer_cast<skia::textlayout::ParagraphBuilder>(
-                          std::make_shared<skia::textlayout::ParagraphBuilderImpl>(
-                          textLayout.paraStyle, data.layoutManager->collection_));
-  if (0 == displayString_.size()) {
-    textAttributes.foregroundColor = placeholderColor_;
-    data.layoutManager->buildText(textLayout, textInputProps.backgroundColor, textInputProps.paragraphAttributes, textAttributes, placeholderString_, true);
-  } else {
-    if (secureTextEntry_) {
-      std::string secureTextString(displayString_);
-      data.layoutManager->buildText(textLayout, textInputProps.backgroundColor, textInputProps.paragraphAttributes, textAttributes, secureTextString.replace( secureTextString.begin(), secureTextString.end(), secureTextString.size(), '*'), true);
-    } else {
-      data.layoutManager->buildText(textLayout, textInputProps.backgroundColor, textInputProps.paragraphAttributes, textAttributes, displayString_, true);
-    }
-  }
+  layoutText(component, textInputProps);
+  scrollToCursor(component.layoutMetrics);
   auto layerRef=layer();
   if(layerRef->isShadowVisible) {
     drawShadow(canvas, frame, borderMetrics,
@@ -159,7 +280,7 @@ void RSkComponentTextInput::OnPaint(SkCanvas *canvas) {
                 layerRef->shadowImageFilter,layerRef->shadowMaskFilter
               );
   }
-  drawTextInput(canvas, component.layoutMetrics, textInputProps, textLayout);
+  drawTextInput(canvas, component.layoutMetrics, textInputProps);
   if (textInputProps.underlineColorAndroid.has_value()){
     drawUnderline(canvas,frame,textInputProps.underlineColorAndroid.value());
   }
@@ -192,235 +313,189 @@ void RSkComponentTextInput::onHandleKey(rnsKey eventKeyType, bool keyRepeat, rns
     return;
   }
 
-  bool waitForupdateProps = false;
-  privateVarProtectorMutex.lock();
-  std::string textString = displayString_;
-  privateVarProtectorMutex.unlock();
-  KeyPressMetrics keyPressMetrics;
-  TextInputMetrics textInputMetrics;
-  auto component = getComponentData();
-  Rect frame = component.layoutMetrics.frame;
-  auto textInputEventEmitter = std::static_pointer_cast<TextInputEventEmitter const>(component.eventEmitter);
-  auto const &textInputProps = *std::static_pointer_cast<TextInputProps const>(component.props);
-  textInputMetrics.contentOffset.x = frame.origin.x;
-  textInputMetrics.contentOffset.y = frame.origin.y;
   if (isInEditingMode_ == false && eventKeyType == RNS_KEY_Select ) {
       requestForEditingMode();
   } else if (isInEditingMode_) {
-    // Logic to update the textinput string.
-    // Requirement: Textinput is in Editing mode.
-    // 1. Alphanumeric keys
-    // case 1: appending at end
-    // case 2: insert in mid
-    // Navigation Keys.
-    // 2. update relative location of cursor based
-    // on LEFT/RIGHT navigation keys.
-    // 3. Deleting character.
-    // case 1: Delete last update character by default.
-    // case 2: Base on absolute location of cursor.
-    // Always delete the immediate left character from
-    // the cursor position.
-      
-    if (textInputProps.value.has_value()) {
-      if (!isTextInputInFocus_) {
-        isTextInputInFocus_ = true;
-        isKeyRepeateOn = false;
-        keyRepeateStartIndex=0;
-        std::thread t(&RSkComponentTextInput::keyEventProcessingThread,this);
-        t.detach();
-        isTextInputInFocus_ = true;
-      }
-      // Logic to update the inputQueue on key repeat mode.
-      // based on the queue keyrepeatStartIndex.
-      // push all the key to temp queue and update the
-      // inputQueue with tempQueue.
-      inputQueueMutex.lock();
-      if(keyRepeat && !isKeyRepeateOn)
-        keyRepeateStartIndex = inputQueue.size();
-      if(isKeyRepeateOn && !keyRepeat ){
-        std::queue<rnsKey> temp;
-        isKeyRepeateOn = false;
-        RNS_LOG_DEBUG("[onHandleKey] update the queue with temp Queue... ");
-        while( keyRepeateStartIndex > 0 ){
-          temp.push(inputQueue.front());
-          keyRepeateStartIndex--;
-          inputQueue.pop();
-        }
-        RNS_LOG_DEBUG("[onHandleKey] temp.size " << temp.size()<< " inputQueue.size "<< inputQueue.size());
-        std::swap( inputQueue, temp );
-        RNS_LOG_DEBUG("[onHandleKey] temp.size " << temp.size()<< " inputQueue.size "<< inputQueue.size());
-        inputQueueMutex.unlock();
-        return;
-      }
-      isKeyRepeateOn = keyRepeat;
-      inputQueueMutex.unlock();
-      //We need to Handle the StopPrpagation & select in the onHandle.
-      if ((eventKeyType >= RNS_KEY_Up && eventKeyType <= RNS_KEY_Back)) {
-        *stopPropagation = true;
-        inputQueueMutex.lock();
-        inputQueue.push(eventKeyType);
-        inputQueueMutex.unlock();
-      } else if (eventKeyType ==  RNS_KEY_Select) {
-        *stopPropagation = true;
-        isTextInputInFocus_ = false;
-        std::queue<rnsKey> empty;
-        inputQueueMutex.lock();
-        std::swap( inputQueue, empty );
-        inputQueueMutex.unlock();
-        eventCount_++;
-        resignFromEditingMode();
-      }
-      return;
-    }
-    processEventKey(eventKeyType,stopPropagation,&waitForupdateProps,true);
-  }//else if (isInEditingMode_)
+    // Keys are applied to the local text right away, JS reconciles through mostRecentEventCount.
+    // Repeated keys arriving within a frame are rendered & notified together on the next frame.
+    processEventKey(eventKeyType,stopPropagation);
+  }
 }
 
-void RSkComponentTextInput::processEventKey (rnsKey eventKeyType,bool* stopPropagation,bool *waitForupdateProps, bool updateString) {
+void RSkComponentTextInput::processEventKey (rnsKey eventKeyType,bool* stopPropagation) {
   RNS_LOG_DEBUG("[processEventKey]  ENTRY");
   KeyPressMetrics keyPressMetrics;
-  TextInputMetrics textInputMetrics;
-  std::string textString = displayString_;
-  int textLengthBeforeEdit  = textString.length();
   auto component = getComponentData();
-  Rect frame = component.layoutMetrics.frame;
   auto textInputEventEmitter = std::static_pointer_cast<TextInputEventEmitter const>(component.eventEmitter);
-  auto const &textInputProps = *std::static_pointer_cast<TextInputProps const>(component.props);
   keyPressMetrics.text = RNSKeyMap[eventKeyType];
 
-    //Displayable Charector Range
-    if ((eventKeyType >= RNS_KEY_1 && eventKeyType <= RNS_KEY_Less)) {
-      if (cursor_.locationFromEnd != 0){
-        textString.insert(cursor_.end-cursor_.locationFromEnd,keyPressMetrics.text);
-      } else {
-        textString = textString+keyPressMetrics.text;
-      }
-      cursor_.end = textString.length();
-    } else {
-      switch(eventKeyType){
-        case RNS_KEY_Left:
-        case RNS_KEY_Right:
-          *stopPropagation = true;
-          *waitForupdateProps = false;
-          keyPressMetrics.eventCount = eventCount_;
+  // Logic to update the textinput string.
+  // 1. Alphanumeric keys : appended at end or inserted at cursor.
+  // 2. Navigation keys : update relative location of cursor.
+  // 3. Deleting character : always delete the immediate left character from the cursor.
+  // Edits go through the piece table, text after the cursor is not moved on each key.
+  std::unique_lock<std::mutex> lock(textMutex_);
+  size_t lengthBeforeEdit = editBuffer_.length();
+  size_t cursorPosition = cursor_.end - cursor_.locationFromEnd;
+  //Displayable Charector Range
+  if ((eventKeyType >= RNS_KEY_1 && eventKeyType <= RNS_KEY_Less)) {
+    if (!maxLength_ || ((lengthBeforeEdit + keyPressMetrics.text.length()) <= (size_t)maxLength_)) {
+      editBuffer_.insert(cursorPosition, keyPressMetrics.text);
+    }
+  } else {
+    switch(eventKeyType){
+      case RNS_KEY_Left:
+      case RNS_KEY_Right:
+        *stopPropagation = true;
+        keyPressMetrics.eventCount = eventCount_;
+        if ((RNS_KEY_Left == eventKeyType) && (cursor_.locationFromEnd < cursor_.end)) {
+          cursor_.locationFromEnd++;
+        } else if ((RNS_KEY_Right == eventKeyType) && (cursor_.locationFromEnd > 0)) {
+          cursor_.locationFromEnd--;
+        } else {
+          lock.unlock();
           textInputEventEmitter->onKeyPress(keyPressMetrics);
-          if (RNS_KEY_Left == eventKeyType) {
-            if(cursor_.locationFromEnd < cursor_.end ) {
-              RNS_LOG_DEBUG("[processEventKey]Left key pressed cursor_.locationFromEnd = "<<cursor_.locationFromEnd);
-              cursor_.locationFromEnd++; // locationFromEnd
-            } else {
-              return;
-            }
-          }
-          else {
-            if (cursor_.locationFromEnd>0) {
-              RNS_LOG_DEBUG("[processEventKey] Right key pressed cursor_.locationFromEnd = "<<cursor_.locationFromEnd);
-              cursor_.locationFromEnd--;
-            } else {
-              return;
-            }
-          }
-          
-          if (!caretHidden_) {
-            drawAndSubmit();
-          }
-          //currently selection is not supported selectionRange length is
-          //is always 0 & selectionRange.location always end
-          textInputMetrics.selectionRange.location = cursor_.end - cursor_.locationFromEnd;
-          textInputMetrics.selectionRange.length = 0;
-          textInputEventEmitter->onSelectionChange(textInputMetrics);
           return;
-        case RNS_KEY_Up:
-        case RNS_KEY_Down:
+        }
+        RNS_LOG_DEBUG("[processEventKey] Cursor moved, cursor_.locationFromEnd = "<<cursor_.locationFromEnd);
+        selectionChangePending_ = true;
+        lock.unlock();
+        textInputEventEmitter->onKeyPress(keyPressMetrics);
+        scheduleFrameUpdate();
+        return;
+      case RNS_KEY_Up:
+      case RNS_KEY_Down:
+        if (!multiline_) {
           *stopPropagation = true;
-          *waitForupdateProps = false;
           return;
-        case RNS_KEY_Back:
-        case RNS_KEY_Delete:
-          if (!textString.empty() && (cursor_.end!=cursor_.locationFromEnd)){
-            textString.erase(textString.begin()+(cursor_.end-cursor_.locationFromEnd-1)); //acts like a backspace.
-            cursor_.end = textString.length();
+        }
+        // Multiline moves across lines, on the first or last line the key goes on to navigate out
+        if (!moveCursorVertically(eventKeyType)) {
+          return;
+        }
+        *stopPropagation = true;
+        RNS_LOG_DEBUG("[processEventKey] Cursor moved, cursor_.locationFromEnd = "<<cursor_.locationFromEnd);
+        selectionChangePending_ = true;
+        lock.unlock();
+        scheduleFrameUpdate();
+        return;
+      case RNS_KEY_Back:
+      case RNS_KEY_Delete:
+        if (cursorPosition > 0){
+          editBuffer_.erase(cursorPosition - 1, 1); //acts like a backspace.
+        }
+        break;
+      case RNS_KEY_Select:
+        if (!blurOnSubmit_) {
+          // Multiline input without blurOnSubmit : select key breaks the line
+          if (!maxLength_ || (lengthBeforeEdit < (size_t)maxLength_)) {
+            editBuffer_.insert(cursorPosition, "\n");
+            keyPressMetrics.text = "\n";
           }
-          else
-            *waitForupdateProps = false;
-          RNS_LOG_DEBUG("[processEventKey] After removing a charector in string = "<<textString);
           break;
-        case RNS_KEY_Select:
-          eventCount_++;
-          *stopPropagation = true;
-          resignFromEditingMode();
-          return;
-        case RNS_KEY_Caps_Lock:
-        case RNS_KEY_Shift_L:
-        case RNS_KEY_Shift_R:
-          //capslock and shift should be consumed by Textinput.
-          *stopPropagation = true;
-        default:
-          *waitForupdateProps = false;
-          return;//noop
-      }
-    }
-  //currently selection is not supported selectionRange length is
-  //is always 0 & selectionRange.location always end
-  textInputMetrics.selectionRange.location = cursor_.end - cursor_.locationFromEnd;
-  textInputMetrics.selectionRange.length = 0;
-
-  int textLengthAfterEdit = textString.length();
-  if (updateString) {
-    if (displayString_ != textString) {
-      if ((maxLength_) && (textLengthAfterEdit > maxLength_) && (textLengthAfterEdit > textLengthBeforeEdit )) {
-        std::copy_n(textString.begin(), textLengthBeforeEdit , displayString_.begin());
-      } else {
-        displayString_ = textString;
-      }
+        }
+        eventCount_++;
+        lock.unlock();
+        *stopPropagation = true;
+        resignFromEditingMode();
+        return;
+      case RNS_KEY_Caps_Lock:
+      case RNS_KEY_Shift_L:
+      case RNS_KEY_Shift_R:
+        //capslock and shift should be consumed by Textinput.
+        *stopPropagation = true;
+      default:
+        return;//noop
     }
-    cursor_.end = displayString_.length();
-    drawAndSubmit();
   }
-  eventCount_++;
+
   *stopPropagation = true;
-  RNS_LOG_DEBUG("[processEventKey] TextInput text " << textString);
-  textInputMetrics.contentSize.width = paragraph_->getMaxIntrinsicWidth();
-  textInputMetrics.contentSize.height = paragraph_->getHeight();
-  textInputMetrics.text = textString;
-  textInputMetrics.eventCount = eventCount_;
+  bool textChanged = (editBuffer_.length() != lengthBeforeEdit);
+  if (textChanged) {
+    cursor_.end = editBuffer_.length();
+    eventCount_++;
+    lastEditEventCount_ = eventCount_;
+    textChangePending_ = true;
+  }
+  keyPressMetrics.eventCount = eventCount_;
+  lock.unlock();
+
+  RNS_LOG_DEBUG("[processEventKey] TextInput length " << cursor_.end);
   textInputEventEmitter->onKeyPress(keyPressMetrics);
-  if (!(maxLength_ && (textLengthAfterEdit > maxLength_))) {
-    textInputEventEmitter->onChange(textInputMetrics);
-    textInputEventEmitter->onContentSizeChange(textInputMetrics);
-    textInputEventEmitter->onSelectionChange(textInputMetrics);
+  if (textChanged) {
+    scheduleFrameUpdate();
   }
 }
 
-void RSkComponentTextInput::keyEventProcessingThread(){
-  std::string textString = {};
-  bool stopPropagation = false;
-  RNS_LOG_DEBUG("[keyEventProcessingThread] Creating the thread worker thread");
-  KeyPressMetrics keyPressMetrics;
+void RSkComponentTextInput::scheduleFrameUpdate() {
+  {
+    std::scoped_lock lock(textMutex_);
+    if(frameUpdatePending_) {
+      return; // Already coalesced into the next frame
+    }
+    frameUpdatePending_ = true;
+  }
+  RnsShell::AnimationDriver *animationDriver = layer()->client().animationDriver();
+  if(!animationDriver) {
+    layer()->client().notifyFlushBegin();
+    onFrameUpdate();
+    layer()->client().notifyFlushRequired();
+    return;
+  }
+  std::weak_ptr<RSkComponent> weakSelf = shared_from_this();
+  animationDriver->addFrameCallback([weakSelf](double frameTimeMs) {
+    auto self = std::static_pointer_cast<RSkComponentTextInput>(weakSelf.lock());
+    if(self) {
+      self->onFrameUpdate();
+    }
+    return false; // One shot, next edit schedules again
+  });
+}
+
+void RSkComponentTextInput::onFrameUpdate() {
+  // Layer tree is locked by the caller, edits since the last frame are rendered together
   TextInputMetrics textInputMetrics;
+  bool textChanged, selectionChanged, needsRecord;
   auto component = getComponentData();
-  bool waitForupdateProps = true;
-  auto textInputEventEmitter = std::static_pointer_cast<TextInputEventEmitter const>(component.eventEmitter);
-  while(isTextInputInFocus_) {
-    if(!inputQueue.empty()) {
-      privateVarProtectorMutex.lock();
-      textString = displayString_;
-      privateVarProtectorMutex.unlock();
-      inputQueueMutex.lock();
-      auto eventKeyType = inputQueue.front();
-      inputQueue.pop();
-      if ( keyRepeateStartIndex >0 )
-        keyRepeateStartIndex-- ;
-      inputQueueMutex.unlock();
-      processEventKey(eventKeyType,&stopPropagation,&waitForupdateProps, false);
-      if (waitForupdateProps)
-        sem_wait(&jsUpdateSem);
-    }
-    else{
-      RNS_LOG_DEBUG("[keyEventProcessingThread] ThreadAlive ");
-      usleep(5000);
+  {
+    std::scoped_lock lock(textMutex_);
+    frameUpdatePending_ = false;
+    textChanged = textChangePending_;
+    selectionChanged = textChangePending_ || selectionChangePending_;
+    textChangePending_ = selectionChangePending_ = false;
+    // Cursor move records the text again only when a multiline input scrolls to it
+    needsRecord = textChanged || (selectionChanged && scrollToCursor(component.layoutMetrics));
+  }
+  if (needsRecord) {
+    layer()->invalidate(RnsShell::LayerPaintInvalidate);
+    if (layer()->type() == RnsShell::LAYER_TYPE_PICTURE) {
+      static_cast<RnsShell::PictureLayer*>(layer().get())->setPicture(getPicture());
     }
   }
+  if (selectionChanged) {
+    updateCursorLayer(component.layoutMetrics);
+  }
+  {
+    std::scoped_lock lock(textMutex_);
+    textInputMetrics.text = editBuffer_.text();
+    textInputMetrics.eventCount = eventCount_;
+    //currently selection is not supported selectionRange length is
+    //is always 0 & selectionRange.location always end
+    textInputMetrics.selectionRange.location = cursor_.end - cursor_.locationFromEnd;
+    textInputMetrics.selectionRange.length = 0;
+    textInputMetrics.contentSize.width = lineParagraphs_.maxIntrinsicWidth();
+    textInputMetrics.contentSize.height = lineParagraphs_.height();
+  }
+  auto textInputEventEmitter = std::static_pointer_cast<TextInputEventEmitter const>(component.eventEmitter);
+  textInputMetrics.contentOffset.x = component.layoutMetrics.frame.origin.x;
+  textInputMetrics.contentOffset.y = component.layoutMetrics.frame.origin.y;
+  if (textChanged) {
+    textInputEventEmitter->onChange(textInputMetrics);
+    textInputEventEmitter->onContentSizeChange(textInputMetrics);
+  }
+  if (selectionChanged) {
+    textInputEventEmitter->onSelectionChange(textInputMetrics);
+  }
 }
 
 RnsShell::LayerInvalidateMask  RSkComponentTextInput::updateComponentProps(SharedProps newviewProps,bool forceUpdate){
@@ -431,28 +506,32 @@ RnsShell::LayerInvalidateMask  RSkComponentTextInput::updateComponentProps(Share
   textString = textInputProps.text;
   caretHidden_ = textInputProps.traits.caretHidden;
   maxLength_ = textInputProps.maxLength;
+  if ((multiline_ != textInputProps.traits.multiline) || (blurOnSubmit_ != (textInputProps.traits.blurOnSubmit || !textInputProps.traits.multiline))) {
+    multiline_ = textInputProps.traits.multiline;
+    blurOnSubmit_ = textInputProps.traits.blurOnSubmit || !multiline_;
+    mask |= LayerPaintInvalidate;
+  }
 
   /* Update display string in below conditions */
-  /* 1. If props has value defined */
+  /* 1. If props has value defined, and JS has seen the latest local edit (older text is stale) */
   /* 2. If props has defaultValue defined + its first time update */
-  if ((textString != displayString_)
-      && (textInputProps.value.has_value()
+  textMutex_.lock();
+  if ((textString != editBuffer_.text())
+      && ((textInputProps.value.has_value() && (textInputProps.mostRecentEventCount >= lastEditEventCount_))
            || (textInputProps.defaultValue.has_value() && forceUpdate))) {
-
-    privateVarProtectorMutex.lock();
-    displayString_ = textString;
+    editBuffer_.reset(textString);
     cursor_.end = textString.length();
-    privateVarProtectorMutex.unlock();
-    if (isTextInputInFocus_)
-      sem_post(&jsUpdateSem);
+    cursor_.locationFromEnd = std::min(cursor_.locationFromEnd, cursor_.end);
     mask |= LayerPaintInvalidate;
   }
+  bool isTextEmpty = editBuffer_.empty();
+  textMutex_.unlock();
   if ((textInputProps.placeholder.size())
       && ((placeholderString_) != (textInputProps.placeholder))
       &&(!textInputProps.value.has_value())) {
 
     placeholderString_ = textInputProps.placeholder.c_str();
-    if(!displayString_.size()) {
+    if(isTextEmpty) {
       mask |= LayerPaintInvalidate;
     }
   }
@@ -464,7 +543,7 @@ RnsShell::LayerInvalidateMask  RSkComponentTextInput::updateComponentProps(Share
 
   if(textInputProps.placeholderTextColor != placeholderColor_ ) {
     placeholderColor_ = textInputProps.placeholderTextColor;
-    if(!displayString_.size()) {
+    if(isTextEmpty) {
       mask |= LayerPaintInvalidate;
     }
   }
@@ -506,13 +585,17 @@ void RSkComponentTextInput::handleCommand(std::string commandName,folly::dynamic
   RNS_LOG_DEBUG("[handleCommand] commandName === "<< commandName);
   if (commandName == "setTextAndSelection") {
     RNS_LOG_DEBUG("[handleCommand] Calling Dyanic args"<<args[1].getString());
-    privateVarProtectorMutex.lock();
-    displayString_ = args[1].getString();
-    cursor_.end = displayString_.length();
-    privateVarProtectorMutex.unlock();
+    textMutex_.lock();
+    if(args[0].asInt() < lastEditEventCount_) {
+      // Issued before JS saw the latest local edit
+      textMutex_.unlock();
+      return;
+    }
+    editBuffer_.reset(args[1].getString());
+    cursor_.end = editBuffer_.length();
+    cursor_.locationFromEnd = std::min(cursor_.locationFromEnd, cursor_.end);
+    textMutex_.unlock();
     drawAndSubmit();
-    if(isTextInputInFocus_)
-      sem_post(&jsUpdateSem);
   }else if (commandName == "focus") {
     requestForEditingMode();
   }else if (commandName == "blur") {
@@ -538,23 +621,23 @@ void RSkComponentTextInput::requestForEditingMode(bool isFlushDisplay){
   Rect frame = candidateToFocus.layoutMetrics.frame;
   textInputMetrics.contentOffset.x = frame.origin.x;
   textInputMetrics.contentOffset.y = frame.origin.y;
-  if(paragraph_){
-    textInputMetrics.contentSize.width = paragraph_->getMaxIntrinsicWidth();
-    textInputMetrics.contentSize.height = paragraph_->getHeight();
-  }
+  textMutex_.lock();
+  textInputMetrics.contentSize.width = lineParagraphs_.maxIntrinsicWidth();
+  textInputMetrics.contentSize.height = lineParagraphs_.height();
+  textMutex_.unlock();
   //SpatialNavigtor API which is responsible
   //for changing focus to respective textinput.
   spatialNavigator->updateFocusCandidate(this);
   isInEditingMode_ = true;
   textInputEventEmitter->onFocus(textInputMetrics);
   if (!caretHidden_ || textInputProps.traits.clearTextOnFocus) {
-    privateVarProtectorMutex.lock();
-    if(textInputProps.traits.clearTextOnFocus && !displayString_.empty()){
-      displayString_.clear();
+    textMutex_.lock();
+    if(textInputProps.traits.clearTextOnFocus && !editBuffer_.empty()){
+      editBuffer_.reset({});
       cursor_.locationFromEnd = 0;
       cursor_.end = 0;
     }
-    privateVarProtectorMutex.unlock();
+    textMutex_.unlock();
     if (!caretHidden_) {
       drawAndSubmit(isFlushDisplay);
     }
@@ -563,7 +646,11 @@ void RSkComponentTextInput::requestForEditingMode(bool isFlushDisplay){
 
 #if ENABLE(FEATURE_ONSCREEN_KEYBOARD)
   if(showSoftInputOnFocus_){
-    OnScreenKeyboard::updatePlaceHolderString(displayString_,(cursor_.end - cursor_.locationFromEnd));
+    textMutex_.lock();
+    std::string oskText = secureTextEntry_ ? std::string(editBuffer_.length(), '*') : editBuffer_.text();
+    size_t oskCursor = cursor_.end - cursor_.locationFromEnd;
+    textMutex_.unlock();
+    OnScreenKeyboard::updatePlaceHolderString(oskText,oskCursor);
     OnScreenKeyboard::launch(oskLaunchConfig_);
     isOSKActive_=true;
   }
@@ -577,15 +664,10 @@ void RSkComponentTextInput::resignFromEditingMode(bool isFlushDisplay) {
     return;
   TextInputMetrics textInputMetrics;
   auto component = this->getComponentData();
-  if (this->isTextInputInFocus_){
-    this->isTextInputInFocus_ = false;
-    std::queue<rnsKey> empty;
-    inputQueueMutex.lock();
-    std::swap( inputQueue, empty );
-    inputQueueMutex.unlock();
-  }
-  textInputMetrics.text = this->displayString_;
+  textMutex_.lock();
+  textInputMetrics.text = editBuffer_.text();
   textInputMetrics.eventCount = this->eventCount_;
+  textMutex_.unlock();
   this->isInEditingMode_ = false;
   auto textInputEventEmitter = std::static_pointer_cast<TextInputEventEmitter const>(component.eventEmitter);
   textInputEventEmitter->onSubmitEditing(textInputMetrics);
@@ -603,9 +685,7 @@ void RSkComponentTextInput::resignFromEditingMode(bool isFlushDisplay) {
   RNS_LOG_DEBUG("[requestForEditingMode] *** END ***");
 }
 
-RSkComponentTextInput::~RSkComponentTextInput(){
-  sem_destroy(&jsUpdateSem);
-}
+RSkComponentTextInput::~RSkComponentTextInput(){}
 
 void RSkComponentTextInput::onHandleBlur(){
   RNS_LOG_DEBUG("[onHandleBlur] In TextInput");
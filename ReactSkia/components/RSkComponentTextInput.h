@@ -8,11 +8,13 @@
 #pragma once
 
 #include <atomic>
+#include <mutex>
 
 #include "modules/skparagraph/include/TextStyle.h"
 #include "react/renderer/components/textinput/TextInputShadowNode.h"
 #include "react/renderer/components/textinput/TextInputEventEmitter.h"
 #include "ReactSkia/components/RSkComponent.h"
+#include "ReactSkia/components/RSkTextEditBuffer.h"
 #include "ReactSkia/sdk/OnScreenKeyBoard.h"
 #include "ReactSkia/textlayoutmanager/RSkTextLayoutManager.h"
 
@@ -37,21 +39,36 @@ class RSkComponentTextInput final : public RSkComponent {
   void onHandleFocus()override;
  protected:
   void OnPaint(SkCanvas *canvas) override;
+  void OnSubmit() override;
  private:
   std::atomic<bool> isInEditingMode_;
   bool editable_ = true;
   bool caretHidden_ = false;
-  bool isTextInputInFocus_=false;
   bool secureTextEntry_=false;
   int eventCount_;
+  int lastEditEventCount_{0}; // Event count of the latest local text edit, JS text older than it is stale
   int maxLength_;
-  std::string displayString_{}; // Text to be displayed on screen
+  std::mutex textMutex_; // Guards text, laid out lines & cursor, edited from input thread and painted from compositor thread
+  bool frameUpdatePending_{false};
+  bool textChangePending_{false};
+  bool selectionChangePending_{false};
+  bool multiline_{false};
+  bool blurOnSubmit_{true}; // Select submits & blurs, else inserts a line break in multiline input
+  RSkTextEditBuffer editBuffer_; // Text to be displayed on screen
+  RSkTextEditBuffer displayBuffer_; // Displayed instead of editBuffer_ : placeholder or the joined lines of a single line input
   std::string placeholderString_{}; // Placeholder Text
   SharedColor placeholderColor_;  // Placeholder Text Color
   SharedColor selectionColor_;
   struct cursor cursor_;
   SkPaint cursorPaint_;
-  std::shared_ptr<skia::textlayout::Paragraph> paragraph_;
+  RSkTextLineParagraphs lineParagraphs_; // Laid out lines of the displayed text, one paragraph per line
+  Props::Shared paragraphProps_{}; // Props, width, placeholder state & buffer the lines were laid out for
+  float paragraphWidth_{0};
+  bool paragraphIsPlaceholder_{false};
+  const RSkTextEditBuffer *paragraphBuffer_{nullptr};
+  float scrollOffset_{0}; // Multiline input scrolls vertically to keep the cursor visible
+  std::shared_ptr<RnsShell::Layer> cursorLayer_{nullptr};
+  SkColor cursorColor_{SK_ColorBLUE};
 
 #if ENABLE(FEATURE_ONSCREEN_KEYBOARD)
   std::atomic<bool> showSoftInputOnFocus_=true;//To decide OnScreen KeyBoard to be used or not
@@ -62,13 +79,22 @@ class RSkComponentTextInput final : public RSkComponent {
   void drawTextInput(
       SkCanvas *canvas,
       LayoutMetrics layout,
-      const TextInputProps& props,
-      struct RSkSkTextLayout &textLayout);
-  void processEventKey(rnsKey eventKeyType,bool* stopPropagation,bool *waitForupdateProps, bool updateString);
-  void keyEventProcessingThread();
+      const TextInputProps& props);
+  void layoutText(
+      const Component &component,
+      const TextInputProps& props);
+  void processEventKey(rnsKey eventKeyType,bool* stopPropagation);
+  void scheduleFrameUpdate();
+  void onFrameUpdate();
   void requestForEditingMode(bool isFlushDisplay = true);
   void resignFromEditingMode(bool isFlushDisplay = true);
-  void drawCursor(SkCanvas *canvas, LayoutMetrics layout);
+  void updateCursorLayer(LayoutMetrics layout); // Commit path only, never from paint
+  // Below helpers are called with textMutex_ held
+  float textTop(LayoutMetrics layout);
+  SkRect getCaretRect();
+  SkRect getCursorRect(LayoutMetrics layout);
+  bool scrollToCursor(LayoutMetrics layout);
+  bool moveCursorVertically(rnsKey eventKeyType);
 };
 
 } // namespace react
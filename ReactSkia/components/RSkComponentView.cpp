@@ -42,8 +42,8 @@ void RSkComponentView::OnPaint(SkCanvas *canvas) {
                     layerRef->shadowImageFilter,layerRef->shadowMaskFilter
                    );
   }
-  drawBackground(canvas,frame,borderMetrics,viewProps.backgroundColor);
-  drawBorder(canvas,frame,borderMetrics,viewProps.backgroundColor);
+  drawBackground(canvas,frame,borderMetrics,viewProps.backgroundColor,frameGeometryCache());
+  drawBorder(canvas,frame,borderMetrics,viewProps.backgroundColor,frameGeometryCache());
 }
 
 } // namespace react
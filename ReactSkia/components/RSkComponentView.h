@@ -17,6 +17,7 @@ class RSkComponentView final : public RSkComponent {
  public:
   RSkComponentView(const ShadowView &shadowView);
   RnsShell::LayerInvalidateMask updateComponentProps(SharedProps newviewProps,bool forceUpdate) override;
+  bool canRecordConcurrently() const override { return true; }
  protected:
   void OnPaint(SkCanvas *canvas) override;
 };
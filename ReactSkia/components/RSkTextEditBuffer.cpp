@@ -0,0 +1,285 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include <algorithm>
+
+#include "ReactSkia/components/RSkTextEditBuffer.h"
+
+#define EDIT_BUFFER_MAX_PIECES  512 // Scattered edits are merged back into a single piece beyond it
+#define EDIT_BUFFER_MIN_COMPACT_SIZE  4096
+
+namespace facebook {
+namespace react {
+
+RSkTextEditBuffer::RSkTextEditBuffer(const std::string &text) {
+  reset(text);
+}
+
+void RSkTextEditBuffer::reset(const std::string &text) {
+  original_ = text;
+  added_.clear();
+  pieces_.clear();
+  if (!text.empty()) {
+    pieces_.push_back({false, 0, text.length()});
+  }
+  lineStarts_.assign(1, 0);
+  for (size_t index = 0; index < text.length(); index++) {
+    if (text[index] == '\n') {
+      lineStarts_.push_back(index + 1);
+    }
+  }
+  length_ = text.length();
+  lastInsertEnd_ = std::string::npos;
+  lineChanges_ = {0, 0};
+  text_ = text;
+  textValid_ = true;
+}
+
+void RSkTextEditBuffer::insert(size_t position, const std::string &text) {
+  if (text.empty()) {
+    return;
+  }
+  position = std::min(position, length_);
+  size_t line = lineOf(position);
+  size_t column = position - lineStarts_[line];
+  // Line keeps its text when the insert starts with a line break at its end or ends with one at its start
+  addLineChanges(((column == lineLength(line)) && (text.front() == '\n')) ? line + 1 : line,
+                 ((column == 0) && (text.back() == '\n')) ? line : line + 1);
+
+  size_t addedStart = added_.size();
+  added_ += text;
+
+  bool extended = false;
+  if (position == lastInsertEnd_) {
+    // Typing goes on at the cursor : last insert piece is extended, no piece is added
+    size_t offset = 0;
+    for (auto &piece : pieces_) {
+      offset += piece.length;
+      if (offset >= position) {
+        if ((offset == position) && piece.added && (piece.start + piece.length == addedStart)) {
+          piece.length += text.length();
+          extended = true;
+        }
+        break;
+      }
+    }
+  }
+  if (!extended) {
+    Piece newPiece{true, addedStart, text.length()};
+    size_t offset = 0;
+    auto it = pieces_.begin();
+    while ((it != pieces_.end()) && (offset + it->length <= position)) {
+      offset += it->length;
+      it++;
+    }
+    if ((it == pieces_.end()) || (offset == position)) {
+      pieces_.insert(it, newPiece);
+    } else {
+      // Split the piece holding the position around the new one
+      Piece tail{it->added, it->start + (position - offset), it->length - (position - offset)};
+      it->length = position - offset;
+      it = pieces_.insert(it + 1, newPiece);
+      pieces_.insert(it + 1, tail);
+    }
+  }
+
+  auto nextLine = std::upper_bound(lineStarts_.begin(), lineStarts_.end(), position);
+  for (auto it = nextLine; it != lineStarts_.end(); it++) {
+    *it += text.length();
+  }
+  std::vector<size_t> newLineStarts;
+  for (size_t index = 0; index < text.length(); index++) {
+    if (text[index] == '\n') {
+      newLineStarts.push_back(position + index + 1);
+    }
+  }
+  lineStarts_.insert(nextLine, newLineStarts.begin(), newLineStarts.end());
+
+  length_ += text.length();
+  lastInsertEnd_ = position + text.length();
+  textValid_ = false;
+}
+
+void RSkTextEditBuffer::erase(size_t position, size_t length) {
+  if (position >= length_) {
+    return;
+  }
+  length = std::min(length, length_ - position);
+  if (length == 0) {
+    return;
+  }
+  size_t eraseEnd = position + length;
+  size_t firstLine = lineOf(position);
+  size_t lastLine = lineOf(eraseEnd);
+  // Line after whole erased lines keeps its text
+  bool wholeLines = (position == lineStarts_[firstLine]) && (eraseEnd == lineStarts_[lastLine]) && (lastLine > firstLine);
+  addLineChanges(firstLine, wholeLines ? lastLine : lastLine + 1);
+
+  std::vector<Piece> pieces;
+  pieces.reserve(pieces_.size() + 1);
+  size_t offset = 0;
+  for (auto &piece : pieces_) {
+    size_t pieceEnd = offset + piece.length;
+    if ((pieceEnd <= position) || (offset >= eraseEnd)) {
+      pieces.push_back(piece);
+    } else {
+      if (offset < position) {
+        pieces.push_back({piece.added, piece.start, position - offset});
+      }
+      if (pieceEnd > eraseEnd) {
+        pieces.push_back({piece.added, piece.start + (eraseEnd - offset), pieceEnd - eraseEnd});
+      }
+    }
+    offset = pieceEnd;
+  }
+  pieces_ = std::move(pieces);
+
+  // Lines starting inside the erased range are merged to the line holding the position
+  auto first = std::upper_bound(lineStarts_.begin(), lineStarts_.end(), position);
+  auto last = std::upper_bound(first, lineStarts_.end(), eraseEnd);
+  for (auto it = last; it != lineStarts_.end(); it++) {
+    *it -= length;
+  }
+  lineStarts_.erase(first, last);
+
+  length_ -= length;
+  lastInsertEnd_ = std::string::npos;
+  textValid_ = false;
+  compactIfNeeded();
+}
+
+const std::string& RSkTextEditBuffer::text() const {
+  if (!textValid_) {
+    text_.clear();
+    text_.reserve(length_);
+    for (auto &piece : pieces_) {
+      text_.append(piece.added ? added_ : original_, piece.start, piece.length);
+    }
+    textValid_ = true;
+  }
+  return text_;
+}
+
+RSkTextEditBuffer::LineChanges RSkTextEditBuffer::takeLineChanges() {
+  LineChanges lineChanges = lineChanges_;
+  lineChanges_ = {lineCount(), lineCount()};
+  return lineChanges;
+}
+
+void RSkTextEditBuffer::addLineChanges(size_t firstChanged, size_t endChanged) {
+  lineChanges_.unchangedBefore = std::min(lineChanges_.unchangedBefore, firstChanged);
+  lineChanges_.unchangedAfter = std::min(lineChanges_.unchangedAfter, lineCount() - std::min(endChanged, lineCount()));
+}
+
+size_t RSkTextEditBuffer::lineOf(size_t position) const {
+  return std::upper_bound(lineStarts_.begin(), lineStarts_.end(), position) - lineStarts_.begin() - 1;
+}
+
+size_t RSkTextEditBuffer::lineLength(size_t line) const {
+  size_t lineEnd = (line + 1 < lineStarts_.size()) ? lineStarts_[line + 1] - 1 : length_;
+  return lineEnd - lineStarts_[line];
+}
+
+std::string RSkTextEditBuffer::lineText(size_t line) const {
+  return substr(lineStarts_[line], lineLength(line));
+}
+
+std::string RSkTextEditBuffer::substr(size_t position, size_t length) const {
+  if (textValid_) {
+    return text_.substr(position, length);
+  }
+  std::string result;
+  result.reserve(length);
+  size_t end = position + length;
+  size_t offset = 0;
+  for (auto &piece : pieces_) {
+    size_t pieceEnd = offset + piece.length;
+    if (pieceEnd > position && offset < end) {
+      size_t from = std::max(position, offset);
+      size_t to = std::min(end, pieceEnd);
+      result.append(piece.added ? added_ : original_, piece.start + (from - offset), to - from);
+    }
+    if (pieceEnd >= end) {
+      break;
+    }
+    offset = pieceEnd;
+  }
+  return result;
+}
+
+void RSkTextEditBuffer::compactIfNeeded() {
+  // Deleted text is never reclaimed from the buffers, nor are pieces merged, until compaction
+  if ((pieces_.size() > EDIT_BUFFER_MAX_PIECES) ||
+      (original_.size() + added_.size() > std::max<size_t>(4 * length_, EDIT_BUFFER_MIN_COMPACT_SIZE))) {
+    std::string text = this->text();
+    LineChanges lineChanges = lineChanges_; // Text is the same
+    reset(text);
+    lineChanges_ = lineChanges;
+  }
+}
+
+size_t RSkTextLineParagraphs::layout(RSkTextEditBuffer &buffer, const ParagraphFactory &factory) {
+  auto lineChanges = buffer.takeLineChanges();
+  size_t lineCount = buffer.lineCount();
+  size_t unchangedBefore = std::min({lineChanges.unchangedBefore, lines_.size(), lineCount});
+  size_t unchangedAfter = std::min({lineChanges.unchangedAfter, lines_.size() - unchangedBefore, lineCount - unchangedBefore});
+  size_t changedCount = lineCount - unchangedBefore - unchangedAfter;
+
+  lines_.erase(lines_.begin() + unchangedBefore, lines_.end() - unchangedAfter);
+  lines_.insert(lines_.begin() + unchangedBefore, changedCount, Line{});
+  float top = 0;
+  if (unchangedBefore > 0) {
+    auto &previous = lines_[unchangedBefore - 1];
+    top = previous.top + (previous.paragraph ? previous.paragraph->getHeight() : 0);
+  }
+  for (size_t index = unchangedBefore; index < lineCount; index++) {
+    auto &line = lines_[index];
+    if (index < unchangedBefore + changedCount) {
+      line.text = buffer.lineText(index);
+      line.paragraph = factory(line.text);
+    }
+    line.top = top; // Lines below the changed ones move along with their height
+    top += line.paragraph ? line.paragraph->getHeight() : 0;
+  }
+  return changedCount;
+}
+
+void RSkTextLineParagraphs::paint(SkCanvas *canvas, float x, float y) const {
+  SkRect clipBounds = canvas->getLocalClipBounds();
+  for (auto &line : lines_) {
+    if (!line.paragraph) {
+      continue;
+    }
+    float lineTop = y + line.top;
+    if (lineTop > clipBounds.bottom()) {
+      break;
+    }
+    if (lineTop + line.paragraph->getHeight() >= clipBounds.top()) {
+      line.paragraph->paint(canvas, x, lineTop);
+    }
+  }
+}
+
+float RSkTextLineParagraphs::height() const {
+  if (lines_.empty() || !lines_.back().paragraph) {
+    return 0;
+  }
+  return lines_.back().top + lines_.back().paragraph->getHeight();
+}
+
+float RSkTextLineParagraphs::maxIntrinsicWidth() const {
+  float width = 0;
+  for (auto &line : lines_) {
+    if (line.paragraph) {
+      width = std::max(width, line.paragraph->getMaxIntrinsicWidth());
+    }
+  }
+  return width;
+}
+
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "include/core/SkCanvas.h"
+#include "modules/skparagraph/include/Paragraph.h"
+
+namespace facebook {
+namespace react {
+
+/*
+ * Piece table holding the text edited by a TextInput. The initial text and the typed text live in two
+ * append only buffers, the text is the sequence of pieces of them. Typing at the cursor grows the last
+ * piece and deleting splits a piece, so an edit never moves the text after it. Line starts are kept
+ * up to date along with the edits, for the layout to work line by line, as is the range of lines edited
+ * since it was last taken.
+ */
+class RSkTextEditBuffer {
+ public:
+  explicit RSkTextEditBuffer(const std::string &text = {});
+
+  void reset(const std::string &text);
+  void insert(size_t position, const std::string &text);
+  void erase(size_t position, size_t length);
+
+  size_t length() const { return length_; }
+  bool empty() const { return length_ == 0; }
+  const std::string& text() const; // Materialized on demand, kept until the next edit
+
+  size_t lineCount() const { return lineStarts_.size(); }
+  size_t lineOf(size_t position) const;
+  size_t lineStart(size_t line) const { return lineStarts_[line]; }
+  size_t lineLength(size_t line) const; // Without the line break
+  std::string lineText(size_t line) const;
+
+  // Lines changed since the previous call : all but the first unchangedBefore & the last unchangedAfter
+  // ones, which hold the same text as then. Both ranges may overlap, when an edit only added lines.
+  struct LineChanges {
+    size_t unchangedBefore;
+    size_t unchangedAfter;
+  };
+  LineChanges takeLineChanges();
+
+ private:
+  struct Piece {
+    bool added; // From the typed text buffer, else from the initial one
+    size_t start;
+    size_t length;
+  };
+
+  std::string substr(size_t position, size_t length) const;
+  void compactIfNeeded();
+  void addLineChanges(size_t firstChanged, size_t endChanged); // Range of the lines before the edit
+
+
+  std::string original_;
+  std::string added_;
+  std::vector<Piece> pieces_;
+  std::vector<size_t> lineStarts_{0};
+  size_t length_{0};
+  LineChanges lineChanges_{0, 0};
+  size_t lastInsertEnd_{std::string::npos}; // Text position right after the latest insert, typing there grows the last piece
+  mutable std::string text_;
+  mutable bool textValid_{true};
+};
+
+/*
+ * Laid out paragraphs of the lines of an edit buffer, stacked from the top. Lines outside of the changes
+ * taken from the buffer keep their paragraph by index, so an edit lays out only the edited lines and
+ * never reads the rest of the text, also when lines above it were inserted or removed.
+ */
+class RSkTextLineParagraphs {
+ public:
+  using ParagraphFactory = std::function<std::shared_ptr<skia::textlayout::Paragraph>(const std::string &lineText)>;
+
+  struct Line {
+    std::string text;
+    std::shared_ptr<skia::textlayout::Paragraph> paragraph;
+    float top{0};
+  };
+
+  void clear() { lines_.clear(); } // Style, width or buffer has changed, all the lines are laid out again
+  // Returns the count of lines laid out. Lines are expected to be laid out from the same buffer each time.
+  size_t layout(RSkTextEditBuffer &buffer, const ParagraphFactory &factory);
+  void paint(SkCanvas *canvas, float x, float y) const;
+
+  const std::vector<Line>& lines() const { return lines_; }
+  float height() const;
+  float maxIntrinsicWidth() const;
+
+ private:
+  std::vector<Line> lines_;
+};
+
+} // namespace react
+} // namespace facebook
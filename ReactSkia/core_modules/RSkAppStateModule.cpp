@@ -6,6 +6,7 @@
  */
 
 #include "ReactSkia/core_modules/RSkAppStateModule.h"
+#include "ReactSkia/sdk/RNSMemoryPressureBroker.h"
 #include "ReactSkia/utils/RnsLog.h"
 
 namespace facebook {
@@ -91,9 +92,15 @@ void RSkAppStateModule::AppStateCallBackClient::onChange(string newAppState) {
   appStateModule_.sendEventWithName("appStateDidChange", folly::dynamic(appState));
 }
 
-void RSkAppStateModule::AppStateCallBackClient::onMemoryWarning() {
-  RNS_LOG_INFO("onMemoryWarningEventReceived");
-  appStateModule_.sendEventWithName("memoryWarning", folly::dynamic());
+void RSkAppStateModule::AppStateCallBackClient::onMemoryWarning(MemoryWarningLevel level) {
+  RNS_LOG_INFO("onMemoryWarningEventReceived level : " << level);
+  if(level == MemoryWarningLow) {
+    appStateModule_.sendEventWithName("memoryWarning", folly::dynamic());
+    return;
+  }
+  // Higher levels are handled natively, JS has already been warned through the low level
+  rns::sdk::RNSMemoryPressureBroker::instance()->notifyMemoryPressure(
+      (level == MemoryWarningCritical) ? rns::sdk::MemoryPressureCritical : rns::sdk::MemoryPressureModerate);
 }
 
 void RSkAppStateModule::AppStateCallBackClient::onFocus() {
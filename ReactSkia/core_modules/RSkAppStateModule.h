@@ -60,7 +60,7 @@ class RSkAppStateModule : public react::RSkEventEmitter {
     ~AppStateCallBackClient(){}
 
     void onChange(string appState) override;
-    void onMemoryWarning() override;
+    void onMemoryWarning(MemoryWarningLevel level) override;
     void onFocus() override;
     void onBlur() override;
 
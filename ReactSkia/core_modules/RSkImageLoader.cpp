@@ -4,8 +4,11 @@
 * This source code is licensed under the MIT license found in the
 * LICENSE file in the root directory of this source tree.
 */
+#include "include/codec/SkCodec.h"
 #include "include/core/SkImage.h"
+#include "include/core/SkStream.h"
 
+#include <algorithm>
 #include <cxxreact/JsArgumentHelpers.h>
 #include <filesystem>
 
@@ -13,6 +16,7 @@
 #include "ReactSkia/sdk/CurlNetworking.h"
 #include "ReactSkia/sdk/RNSAssetManager.h"
 #include "ReactSkia/utils/RnsLog.h"
+#include "ReactSkia/views/common/RSkImageUtils.h"
 #include "RSkImageLoader.h"
 
 using namespace folly;
@@ -24,12 +28,20 @@ using namespace xplat::module;
 namespace react {
 
 RSkImageLoaderModule::~RSkImageLoaderModule() {
-  if(imageRequestList_.size()!=0) {
+  {
+    std::scoped_lock lock(imageRequestListLock_);
     for(auto imageRequestList : imageRequestList_ ) {
       CurlNetworking::sharedCurlNetworking()->abortRequest(imageRequestList.second);
     }
     imageRequestList_.clear();
   }
+  std::scoped_lock lock(prefetchLock_);
+  for(auto prefetchRequest : prefetchRequests_) {
+    if(prefetchRequest.second->curlRequest)
+      CurlNetworking::sharedCurlNetworking()->abortRequest(prefetchRequest.second->curlRequest);
+  }
+  prefetchRequests_.clear();
+  prefetchQueue_.clear();
 }
 
 auto RSkImageLoaderModule::getConstants() -> std::map<std::string, folly::dynamic> {
@@ -46,12 +58,20 @@ auto RSkImageLoaderModule::getMethods() -> std::vector<Method> {
       Method(
           "getSizeWithHeaders",
           [this] (dynamic args, CxxModule::Callback resolveBlock, CxxModule::Callback rejectBlock) {
-            getImageSizeWithHeaders(jsArgAsString(args, 0), jsArgAsString(args, 1), resolveBlock, rejectBlock);
+            getImageSizeWithHeaders(jsArgAsString(args, 0), jsArgAsObject(args, 1), resolveBlock, rejectBlock);
           }),
       Method(
           "prefetchImage",
           [this] (dynamic args, CxxModule::Callback resolveBlock, CxxModule::Callback rejectBlock) {
-            prefetchImage(jsArgAsString(args, 0), resolveBlock, rejectBlock);
+            // Optional requestId (to abort the prefetch) & priority ("high" or "low")
+            int requestId = (args.size() > 1 && args[1].isNumber()) ? jsArgAsInt(args, 1) : 0;
+            bool isHighPriority = (args.size() > 2 && args[2].isString() && args[2].getString() == "high");
+            prefetchImage(jsArgAsString(args, 0), requestId, isHighPriority, resolveBlock, rejectBlock);
+          }),
+      Method(
+          "abortRequest",
+          [this] (dynamic args) {
+            abortPrefetch(jsArgAsInt(args, 0));
           }),
       Method(
           "queryCache",
@@ -65,86 +85,129 @@ std::string RSkImageLoaderModule::getName() {
   return "ImageLoader";
 }
 
+// Reads only the image header to get the dimensions, no pixel is decoded.
+static SkCodec::Result probeImageSize(std::unique_ptr<SkStream> stream, SkISize &imageSize) {
+  SkCodec::Result result = SkCodec::kInvalidInput;
+  if(!stream)
+    return result;
+  std::unique_ptr<SkCodec> codec = SkCodec::MakeFromStream(std::move(stream), &result);
+  if(codec) {
+    imageSize = codec->dimensions();
+    if(SkEncodedOriginSwapsWidthHeight(codec->getOrigin()))
+      imageSize = SkISize::Make(imageSize.height(), imageSize.width());
+  }
+  return result;
+}
+
 void RSkImageLoaderModule::getImageSize(std::string uri, CxxModule::Callback resolveBlock, CxxModule::Callback rejectBlock) {
+  requestImageSize(uri, nullptr, [this, resolveBlock](SkISize imageSize) {
+    handleResolveBlock(resolveBlock, imageSize);
+  }, rejectBlock);
+}
+
+void RSkImageLoaderModule::getImageSizeWithHeaders(std::string uri, folly::dynamic headers, CxxModule::Callback resolveBlock, CxxModule::Callback rejectBlock) {
+  requestImageSize(uri, headers, [resolveBlock](SkISize imageSize) {
+    resolveBlock({folly::dynamic::object("width", imageSize.width())("height", imageSize.height())});
+  }, rejectBlock);
+}
+
+void RSkImageLoaderModule::requestImageSize(std::string uri, folly::dynamic headers, ImageSizeCallback sizeCallback, CxxModule::Callback rejectBlock) {
   //TODO :currently supporting only http and https, in future if we want to support more schema, implement as inline function.
   std::string path;
-  sk_sp<SkImage> imageData{nullptr};
-  sk_sp<SkData> data;
-  decodedimageCacheData imageCacheData;
+  SkISize imageSize;
+
+  sk_sp<SkImage> imageData = RSkImageCacheManager::getImageCacheManagerInstance()->findImageDataInCache(RSkImageUtils::imageCacheKey(uri).c_str());
+  if(imageData) {
+    sizeCallback(imageData->dimensions());
+    return;
+  }
 
   if(RNS_UTILS_IS_HTTP_URL(uri)){
     auto sharedCurlNetworking = CurlNetworking::sharedCurlNetworking();
     std::shared_ptr<CurlRequest> remoteCurlRequest = std::make_shared<CurlRequest>(nullptr,uri,0,"GET");
+    auto isResolved = std::make_shared<bool>(false);
+
+    // Image header is probed as the data arrives, download is stopped as soon as the size is known
+    auto writeCallback = [sizeCallback, isResolved](void* curlresponseData, void *userdata)->bool {
+      CurlResponse *responseData =  (CurlResponse *)curlresponseData;
+      SkISize imageSize;
+      if(*isResolved || responseData->contentSize < IMAGE_SIZE_PROBE_MIN_BYTES)
+        return !(*isResolved);
+      SkCodec::Result result = probeImageSize(std::make_unique<SkMemoryStream>(responseData->responseBuffer, responseData->contentSize, false), imageSize);
+      if(result != SkCodec::kSuccess)
+        return true; // Header is incomplete, or to be reported on completion
+      *isResolved = true;
+      sizeCallback(imageSize);
+      return false;
+    };
 
-    auto completionCallback =  [this,remoteCurlRequest , resolveBlock , rejectBlock](void* curlresponseData,void *userdata)->bool {
+    auto completionCallback =  [this, sizeCallback, rejectBlock, isResolved](void* curlresponseData,void *userdata)->bool {
       CurlResponse *responseData =  (CurlResponse *)curlresponseData;
       CurlRequest * curlRequest = (CurlRequest *) userdata;
-      decodedimageCacheData imageCacheData;
-
-      if(responseData  && (responseData->responseBuffer!=nullptr) && (responseData->contentSize >0)) {
-        sk_sp<SkData> data = SkData::MakeWithCopy(responseData->responseBuffer,responseData->contentSize);
-        if (data){
-          sk_sp<SkImage> remoteImageData = SkImage::MakeFromEncoded(data);
-          if(remoteImageData) {
-            RNS_LOG_DEBUG("Network response received success");
-            handleResolveBlock(resolveBlock,remoteImageData);
-            imageCacheData.imageData = remoteImageData;
-            imageCacheData.expiryTime = (SkTime::GetMSecs() + DEFAULT_MAX_CACHE_EXPIRY_TIME);//convert sec to milisecond 60 *1000
-            RSkImageCacheManager::getImageCacheManagerInstance()->imageDataInsertInCache(curlRequest->URL.c_str(), imageCacheData);
-
-            //Reset the lamda callback so that curlRequest shared pointer dereffered from the lamda
-            // and gets auto destructored after the completion callback.
-            remoteCurlRequest->curldelegator.CURLNetworkingCompletionCallback = nullptr;
-            imageRequestList_.erase(curlRequest->URL);
-            return 0;
-          }
+      SkISize imageSize;
+      if(!(*isResolved)) {
+        // Complete response, either small or served from the network cache
+        if(responseData  && (responseData->responseBuffer!=nullptr) && (responseData->contentSize >0) &&
+           (probeImageSize(std::make_unique<SkMemoryStream>(responseData->responseBuffer, responseData->contentSize, false), imageSize) == SkCodec::kSuccess)) {
+          RNS_LOG_DEBUG("Network response received success");
+          sizeCallback(imageSize);
+        } else {
+          RNS_LOG_ERROR("Network response received error :"<<curlRequest->URL.c_str());
+          handleRejectBlock(rejectBlock);
         }
+        *isResolved = true;
       }
-      RNS_LOG_ERROR("Network response received error :"<<curlRequest->URL.c_str());
-      handleRejectBlock(rejectBlock);
-      imageRequestList_.erase(curlRequest->URL.c_str());
-      //Reset the lamda callback so that curlRequest shared pointer dereffered from the lamda
-      // and gets auto destructored after the completion callback.
-      remoteCurlRequest->curldelegator.CURLNetworkingCompletionCallback = nullptr;
+      std::scoped_lock lock(imageRequestListLock_);
+      imageRequestList_.erase(curlRequest->URL);
       return 0;
     };//end of completionCallback
 
     remoteCurlRequest->curldelegator.delegatorData = remoteCurlRequest.get();
+    remoteCurlRequest->curldelegator.CURLNetworkingWriteCallback = writeCallback;
     remoteCurlRequest->curldelegator.CURLNetworkingCompletionCallback = completionCallback;
+    {
+      std::scoped_lock lock(imageRequestListLock_);
+      imageRequestList_[uri] = remoteCurlRequest;
+    }
     RNS_LOG_DEBUG("Send Request to network");
-    sharedCurlNetworking->sendRequest(remoteCurlRequest,folly::dynamic::object());
-    imageRequestList_.insert(std::pair<std::string, std::shared_ptr<CurlRequest> >(uri,remoteCurlRequest));
-  } else if( uri.substr(0,5) == "data:" ){
-    RNS_LOG_NOT_IMPL;
-    handleRejectBlock(rejectBlock);
-    return;
+    folly::dynamic query = folly::dynamic::object();
+    if(headers.isObject())
+      query["headers"] = headers;
+    if(!sharedCurlNetworking->sendRequest(remoteCurlRequest, query)) {
+      {
+        std::scoped_lock lock(imageRequestListLock_);
+        imageRequestList_.erase(uri);
+      }
+      handleRejectBlock(rejectBlock);
+    }
+  } else if(RSkImageUtils::isDataUri(uri)){
+    sk_sp<SkData> data = RSkImageUtils::decodeDataUri(uri);
+    if(!data || probeImageSize(std::make_unique<SkMemoryStream>(data), imageSize) != SkCodec::kSuccess) {
+      handleRejectBlock(rejectBlock);
+      return;
+    }
+    sizeCallback(imageSize);
   } else {
     if(uri.substr(0,7) != "file://") {
       // Generate application specific path to fetch the Image data.
       std::string imagePath = RNSAssetManager::instance()->getAssetPath(uri);
       RNS_LOG_DEBUG(" Get Imagepath from assetManager"<< imagePath);
       path = imagePath;
+    } else {
+      path = uri.substr(7);
     }
-    data = SkData::MakeFromFileName(path.c_str());
-    if (!data) {
-      RNS_LOG_ERROR("Unable to make SkData for path : " << path.c_str());
+    if(probeImageSize(SkStream::MakeFromFile(path.c_str()), imageSize) != SkCodec::kSuccess) {
+      RNS_LOG_ERROR("Unable to read image header for path : " << path.c_str());
       handleRejectBlock(rejectBlock);
       return;
     }
-    imageData = SkImage::MakeFromEncoded(data);
-    if(imageData) {
-      imageCacheData.imageData = imageData;
-      imageCacheData.expiryTime = (SkTime::GetMSecs() + DEFAULT_MAX_CACHE_EXPIRY_TIME);//convert min to millisecond 30 min *60 sec *1000
-      RSkImageCacheManager::getImageCacheManagerInstance()->imageDataInsertInCache(uri.c_str(), imageCacheData);
-      handleResolveBlock(resolveBlock,imageData);
-      return;
-    }
+    sizeCallback(imageSize);
   }
 }
 
-inline void RSkImageLoaderModule::handleResolveBlock(CxxModule::Callback resolveBlock,sk_sp<SkImage> remoteImageData) {
+inline void RSkImageLoaderModule::handleResolveBlock(CxxModule::Callback resolveBlock,SkISize imageSize) {
   std::vector<dynamic> imageDimensions;
-  imageDimensions.push_back(folly::dynamic::array(remoteImageData->width(),remoteImageData->height()));
+  imageDimensions.push_back(folly::dynamic::array(imageSize.width(),imageSize.height()));
   resolveBlock(imageDimensions);
 }
 
@@ -154,16 +217,129 @@ inline void RSkImageLoaderModule::handleRejectBlock(CxxModule::Callback rejectBl
   rejectBlock(imageError);
 }
 
-void RSkImageLoaderModule::getImageSizeWithHeaders(std::string uri, folly::dynamic headers, CxxModule::Callback resolveBlock, CxxModule::Callback rejectBlock) {
-  RNS_LOG_NOT_IMPL;
+void RSkImageLoaderModule::prefetchImage(std::string uri, int requestId, bool isHighPriority, CxxModule::Callback resolveBlock, CxxModule::Callback rejectBlock) {
+  if(RSkImageCacheManager::getImageCacheManagerInstance()->findImageDataInCache(RSkImageUtils::imageCacheKey(uri).c_str())) {
+    resolveBlock({true});
+    return;
+  }
+  if(!RNS_UTILS_IS_HTTP_URL(uri)) {
+    // Local images are read on demand, nothing to warm up
+    RNS_LOG_DEBUG("Prefetch is supported only for network images : " << uri);
+    resolveBlock({true});
+    return;
+  }
+
+  std::scoped_lock lock(prefetchLock_);
+  auto prefetchRequest = std::make_shared<PrefetchRequest>();
+  prefetchRequest->requestId = requestId ? requestId : nextPrefetchRequestId_--;
+  prefetchRequest->uri = uri;
+  prefetchRequest->isHighPriority = isHighPriority;
+  prefetchRequest->resolveBlock = resolveBlock;
+  prefetchRequest->rejectBlock = rejectBlock;
+  prefetchRequests_[prefetchRequest->requestId] = prefetchRequest;
+  if(isHighPriority) {
+    // After the other high priority prefetches, which are all at the front
+    auto position = prefetchQueue_.begin();
+    while(position != prefetchQueue_.end() && (*position)->isHighPriority)
+      position++;
+    prefetchQueue_.insert(position, prefetchRequest);
+  } else {
+    prefetchQueue_.push_back(prefetchRequest);
+  }
+  startQueuedPrefetches();
+}
+
+void RSkImageLoaderModule::startQueuedPrefetches() {
+  // Called with prefetchLock_ held
+  while(activePrefetchCount_ < MAX_ACTIVE_PREFETCH_REQUESTS && !prefetchQueue_.empty()) {
+    std::shared_ptr<PrefetchRequest> prefetchRequest = prefetchQueue_.front();
+    prefetchQueue_.pop_front();
+    int requestId = prefetchRequest->requestId;
+
+    prefetchRequest->curlRequest = std::make_shared<CurlRequest>(nullptr, prefetchRequest->uri, 0, "GET");
+    prefetchRequest->curlRequest->curldelegator.delegatorData = prefetchRequest->curlRequest.get();
+    prefetchRequest->curlRequest->curldelegator.CURLNetworkingCompletionCallback = [this, requestId](void* curlresponseData, void *userdata)->bool {
+      onPrefetchComplete(requestId, (CurlResponse *)curlresponseData);
+      return 0;
+    };
+    activePrefetchCount_++;
+    if(!CurlNetworking::sharedCurlNetworking()->sendRequest(prefetchRequest->curlRequest, folly::dynamic::object())) {
+      activePrefetchCount_--;
+      prefetchRequests_.erase(requestId);
+      handleRejectBlock(prefetchRequest->rejectBlock);
+    }
+  }
 }
 
-void RSkImageLoaderModule::prefetchImage(std::string uri, CxxModule::Callback resolveBlock, CxxModule::Callback rejectBlock) {
-  RNS_LOG_NOT_IMPL;
+void RSkImageLoaderModule::onPrefetchComplete(int requestId, CurlResponse *responseData) {
+  std::shared_ptr<PrefetchRequest> prefetchRequest;
+  {
+    std::scoped_lock lock(prefetchLock_);
+    auto it = prefetchRequests_.find(requestId);
+    if(it == prefetchRequests_.end())
+      return; // Aborted
+    prefetchRequest = it->second;
+    prefetchRequests_.erase(it);
+    activePrefetchCount_--;
+    startQueuedPrefetches();
+  }
+
+  // Image is decoded lazily by Skia on its first draw, so prefetch only costs the download
+  sk_sp<SkImage> imageData;
+  if(responseData && responseData->responseBuffer && responseData->contentSize > 0) {
+    imageData = SkImage::MakeFromEncoded(SkData::MakeWithCopy(responseData->responseBuffer, responseData->contentSize));
+  }
+  if(!imageData) {
+    RNS_LOG_ERROR("Prefetch failed for : " << prefetchRequest->uri);
+    handleRejectBlock(prefetchRequest->rejectBlock);
+    return;
+  }
+  decodedimageCacheData imageCacheData;
+  imageCacheData.imageData = imageData;
+  imageCacheData.expiryTime = SkTime::GetMSecs() +
+      (prefetchRequest->curlRequest->shouldCacheData() ? responseData->cacheExpiryTime : DEFAULT_MAX_CACHE_EXPIRY_TIME);
+  RSkImageCacheManager::getImageCacheManagerInstance()->imageDataInsertInCache(prefetchRequest->uri.c_str(), imageCacheData);
+  prefetchRequest->resolveBlock({true});
+}
+
+void RSkImageLoaderModule::abortPrefetch(int requestId) {
+  std::scoped_lock lock(prefetchLock_);
+  auto it = prefetchRequests_.find(requestId);
+  if(it == prefetchRequests_.end())
+    return;
+  std::shared_ptr<PrefetchRequest> prefetchRequest = it->second;
+  prefetchRequests_.erase(it);
+  auto queuePosition = std::find(prefetchQueue_.begin(), prefetchQueue_.end(), prefetchRequest);
+  if(queuePosition != prefetchQueue_.end()) {
+    prefetchQueue_.erase(queuePosition);
+  } else if(prefetchRequest->curlRequest) {
+    CurlNetworking::sharedCurlNetworking()->abortRequest(prefetchRequest->curlRequest);
+    activePrefetchCount_--;
+    startQueuedPrefetches();
+  }
+  std::vector<dynamic> prefetchError;
+  prefetchError.push_back(folly::dynamic::array("Prefetch aborted"));
+  prefetchRequest->rejectBlock(prefetchError);
 }
 
 void RSkImageLoaderModule::queryCache(folly::dynamic uris, CxxModule::Callback resolveBlock, CxxModule::Callback rejectBlock) {
-  RNS_LOG_NOT_IMPL;
+  // Only lookups, nothing is fetched or decoded. Decoded images are in memory,
+  // network cache holds the encoded data, which is the closest to a disk cache here.
+  folly::dynamic cacheStatus = folly::dynamic::object();
+  auto sharedCurlNetworking = CurlNetworking::sharedCurlNetworking();
+  for(auto &uri : uris) {
+    if(!uri.isString())
+      continue;
+    bool inMemory = RSkImageCacheManager::getImageCacheManagerInstance()->findImageDataInCache(RSkImageUtils::imageCacheKey(uri.getString()).c_str()) != nullptr;
+    bool inDisk = RNS_UTILS_IS_HTTP_URL(uri.getString()) && sharedCurlNetworking->isAvailableInCache(uri.getString());
+    if(inMemory && inDisk)
+      cacheStatus[uri.getString()] = "disk/memory";
+    else if(inMemory)
+      cacheStatus[uri.getString()] = "memory";
+    else if(inDisk)
+      cacheStatus[uri.getString()] = "disk";
+  }
+  resolveBlock({cacheStatus});
 }
 
 RSkImageLoader::RSkImageLoader(
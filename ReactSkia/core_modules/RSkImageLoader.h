@@ -6,9 +6,14 @@
 */
 
 #include <better/map.h>
+#include <deque>
+#include "include/core/SkSize.h"
 #include "ReactCommon/TurboCxxModule.h"
 #include "ReactSkia/sdk/CurlNetworking.h"
 
+#define MAX_ACTIVE_PREFETCH_REQUESTS 2 // Prefetches are not allowed to starve the visible image downloads
+#define IMAGE_SIZE_PROBE_MIN_BYTES 64 // Image header is probed once this much data is received
+
 using namespace std;
 namespace facebook {
 using namespace xplat::module;
@@ -25,12 +30,34 @@ class RSkImageLoaderModule : public CxxModule {
 
  private:
   typedef better::map <std::string, std::shared_ptr<CurlRequest>> ImageSizeMap;
+  typedef std::function<void(SkISize imageSize)> ImageSizeCallback;
+  struct PrefetchRequest {
+    int requestId;
+    std::string uri;
+    bool isHighPriority;
+    std::shared_ptr<CurlRequest> curlRequest; // Set once the download is started
+    CxxModule::Callback resolveBlock;
+    CxxModule::Callback rejectBlock;
+  };
+  typedef better::map <int, std::shared_ptr<PrefetchRequest>> PrefetchRequestMap;
+
   ImageSizeMap imageRequestList_;
+  std::mutex imageRequestListLock_;
+  PrefetchRequestMap prefetchRequests_; // Queued & downloading prefetches
+  std::deque<std::shared_ptr<PrefetchRequest>> prefetchQueue_; // Waiting for a free download slot, high priority first
+  int activePrefetchCount_{0};
+  int nextPrefetchRequestId_{-1}; // Negative ids for the prefetches not tracked by JS
+  std::mutex prefetchLock_;
+
   void getImageSize(std::string uri, CxxModule::Callback resolveBlock, CxxModule::Callback rejectBlock);
   void getImageSizeWithHeaders(std::string uri, folly::dynamic headers, CxxModule::Callback resolveBlock, CxxModule::Callback rejectBlock);
+  void requestImageSize(std::string uri, folly::dynamic headers, ImageSizeCallback sizeCallback, CxxModule::Callback rejectBlock);
   inline void handleRejectBlock( CxxModule::Callback rejectBlock);
-  inline void handleResolveBlock(CxxModule::Callback resolveBlock,sk_sp<SkImage> remoteImageData);
-  void prefetchImage(std::string uri, CxxModule::Callback resolveBlock, CxxModule::Callback rejectBlock);
+  inline void handleResolveBlock(CxxModule::Callback resolveBlock,SkISize imageSize);
+  void prefetchImage(std::string uri, int requestId, bool isHighPriority, CxxModule::Callback resolveBlock, CxxModule::Callback rejectBlock);
+  void abortPrefetch(int requestId);
+  void startQueuedPrefetches();
+  void onPrefetchComplete(int requestId, CurlResponse *responseData);
   void queryCache(folly::dynamic uris, CxxModule::Callback resolveBlock, CxxModule::Callback rejectBlock);
 };
 
@@ -6,6 +6,19 @@
 */
 #include "RSkInputEventManager.h"
 #include "ReactSkia/components/RSkComponent.h"
+#include "rns_shell/common/Performance.h"
+#ifdef RNS_MEMORY_ACCOUNTING_DEBUG
+#include "rns_shell/common/MemoryAccounting.h"
+
+#define MEMORY_DUMP_DEBUG_KEY RNS_KEY_Help // Logs the render resource memory breakdown
+#endif
+
+#define KEY_REPEAT_MIN_INTERVAL_MS 16 // Auto repeats are not handled faster than a frame
+#define KEY_REPEAT_MAX_INTERVAL_MS 250 // Nor slower, however slow JS or rendering is
+#define KEY_REPEAT_MAX_COALESCED_COUNT 8 // Moves applied at once for a key
+#if ENABLE(FEATURE_KEY_THROTTLING)
+#define KEY_REPEAT_TURNAROUND_WEIGHT 0.25 // Weight of the latest JS turnaround in its running average
+#endif
 
 static bool keyRepeat;
 static rnsKey previousKeyType;
@@ -17,9 +30,7 @@ static unsigned int subWindowEventId_;
 
 RSkInputEventManager* RSkInputEventManager::sharedInputEventManager_{nullptr};
 RSkInputEventManager::RSkInputEventManager(){
-#if ENABLE(FEATURE_KEY_THROTTLING)
   keyQueue_ =  std::make_unique<ThreadSafeQueue<RSkKeyInput>>();
-#endif
   std::function<void(rnsKey, rnsKeyAction)> handler = std::bind(&RSkInputEventManager::keyHandler, this,
                                                               std::placeholders::_1, // rnsKey
                                                               std::placeholders::_2);
@@ -30,8 +41,8 @@ RSkInputEventManager::RSkInputEventManager(){
   spatialNavigator_ =  SpatialNavigator::RSkSpatialNavigator::sharedSpatialNavigator();
   keyRepeat=false;
   previousKeyType=RNS_KEY_UnKnown;
-#if ENABLE(FEATURE_KEY_THROTTLING)
   inputWorkerThread_ = std::thread(&RSkInputEventManager::inputWorkerThreadFunction, this);
+#if ENABLE(FEATURE_KEY_THROTTLING)
   sem_init(&keyEventPost_, 0, 1);
   completeCallback_ = std::bind(&RSkInputEventManager::onEventComplete, this);
 #else
@@ -48,41 +59,101 @@ RSkInputEventManager::~RSkInputEventManager(){
     NotificationCenter::subWindowCenter().removeListener(subWindowEventId_);
     subWindowEventId_ = 0;
   }
+  // Worker may be waiting on the queue or the throttling semaphore : wake it up & join it before destroying them
+  stopWorker_ = true;
 #if ENABLE(FEATURE_KEY_THROTTLING)
-  sem_destroy(&keyEventPost_);
+  sem_post(&keyEventPost_);
+#endif
   if(keyQueue_)
-    keyQueue_ = nullptr;
+    keyQueue_->push(RSkKeyInput(RNS_KEY_UnKnown, RNS_KEY_UnknownAction, false)); // Never processed
   if(inputWorkerThread_.joinable()) {
     inputWorkerThread_.join();
   }
+#if ENABLE(FEATURE_KEY_THROTTLING)
+  sem_destroy(&keyEventPost_);
 #endif
+  keyQueue_ = nullptr;
 }
 
-#if ENABLE(FEATURE_KEY_THROTTLING)
 void RSkInputEventManager::inputWorkerThreadFunction() {
   RSkKeyInput keyInput;
-  while(true) {
-    while(activeInputClients_ > 0) // If there are clients who are still processing previous key then wait..
+  std::vector<uint64_t> latencyIds; // Of the key & its coalesced repeats
+  while(!stopWorker_) {
+#if ENABLE(FEATURE_KEY_THROTTLING)
+    while(activeInputClients_ > 0 && !stopWorker_) // If there are clients who are still processing previous key then wait..
       sem_wait(&keyEventPost_);
-    keyQueue_->pop(keyInput); // Blocks if empty. TODO better to use timed pop to avoid unforseen block issues ??
-    RNS_LOG_DEBUG("Process input from queue,  Key : " << keyInput.key_ << " Action : " <<keyInput.action_ << ", Repeat : " <<keyInput.repeat_);
-    processKey(keyInput);
+#endif
+    keyQueue_->pop(keyInput); // Blocks if empty, the destructor pushes a key to wake it up
+    if(stopWorker_)
+      break;
+    latencyIds.assign(1, keyInput.latencyId_);
+    if(isCoalescableRepeat(keyInput)) {
+      paceRepeat();
+      coalesceRepeats(keyInput, latencyIds);
+    }
+    RNS_LOG_DEBUG("Process input from queue,  Key : " << keyInput.key_ << " Action : " <<keyInput.action_ << ", Repeat : " <<keyInput.repeat_ << ", Count : " << keyInput.repeatCount_);
+    processKey(keyInput, latencyIds);
   }
 }
 
+bool RSkInputEventManager::isCoalescableRepeat(const RSkKeyInput &keyInput) {
+  if(!keyInput.repeat_ || keyInput.action_ != RNS_KEY_Press)
+    return false;
+  return (keyInput.key_ == RNS_KEY_Up || keyInput.key_ == RNS_KEY_Down ||
+          keyInput.key_ == RNS_KEY_Left || keyInput.key_ == RNS_KEY_Right);
+}
+
+void RSkInputEventManager::paceRepeat() {
+  // Next repeat is handled once the update of the previous one could have reached the screen
+  double turnaroundMs = RnsShell::InputLatency::averageRenderTurnaroundMs();
+#if ENABLE(FEATURE_KEY_THROTTLING)
+  turnaroundMs = std::max(jsTurnaroundAverageMs_.load(), turnaroundMs);
+#endif
+  double intervalMs = std::min(std::max(turnaroundMs, (double)KEY_REPEAT_MIN_INTERVAL_MS), (double)KEY_REPEAT_MAX_INTERVAL_MS);
+  double elapsedMs = SkTime::GetMSecs() - lastRepeatTimeMs_;
+  if(elapsedMs < intervalMs) {
+    RNS_LOG_DEBUG("Pace the repeat by " << (intervalMs - elapsedMs) << " ms, Interval : " << intervalMs);
+    std::this_thread::sleep_for(std::chrono::milliseconds((int)(intervalMs - elapsedMs)));
+  }
+  lastRepeatTimeMs_ = SkTime::GetMSecs();
+}
+
+void RSkInputEventManager::coalesceRepeats(RSkKeyInput &keyInput, std::vector<uint64_t> &latencyIds) {
+  RSkKeyInput queuedInput;
+  auto isSameRepeat = [&keyInput](const RSkKeyInput &queued) {
+    return (queued.key_ == keyInput.key_ && queued.action_ == RNS_KEY_Press && queued.repeat_);
+  };
+  while(keyInput.repeatCount_ < KEY_REPEAT_MAX_COALESCED_COUNT && keyQueue_->tryPopIf(queuedInput, isSameRepeat)) {
+    keyInput.repeatCount_++;
+    RnsShell::InputLatency::markDequeued(queuedInput.latencyId_);
+    latencyIds.push_back(queuedInput.latencyId_);
+  }
+}
+
+#if ENABLE(FEATURE_KEY_THROTTLING)
 void RSkInputEventManager::onEventEmit() {
-  activeInputClients_++;
+  if(activeInputClients_++ == 0)
+    jsEmitTimeMs_ = SkTime::GetMSecs();
   RNS_LOG_DEBUG("++++++++++ On Key Event Emit ++++++++++ : Pending Events : " << activeInputClients_.load());
 }
 
 void RSkInputEventManager::onEventComplete() {
-  (activeInputClients_ > 0) ? ((--activeInputClients_ == 0) ? sem_post(&keyEventPost_) : false) : false;
+  if(activeInputClients_ > 0 && --activeInputClients_ == 0) {
+    double turnaroundMs = SkTime::GetMSecs() - jsEmitTimeMs_.load();
+    double averageMs = jsTurnaroundAverageMs_.load();
+    jsTurnaroundAverageMs_ = (averageMs == 0) ? turnaroundMs : (averageMs + KEY_REPEAT_TURNAROUND_WEIGHT * (turnaroundMs - averageMs));
+    sem_post(&keyEventPost_);
+  }
   RNS_LOG_DEBUG("---------- On Key Event Emit Complete ---------- : Pending Events : " << activeInputClients_.load());
 }
 #endif
 
 void RSkInputEventManager::keyHandler(rnsKey eventKeyType, rnsKeyAction eventKeyAction){
   RNS_LOG_DEBUG("[keyHandler] Key Repeat" << keyRepeat<<"  eventKeyType  " <<eventKeyType << " previousKeyType " <<previousKeyType <<"  eventKeyAction  " << eventKeyAction);
+#ifdef RNS_MEMORY_ACCOUNTING_DEBUG
+  if(eventKeyType == MEMORY_DUMP_DEBUG_KEY && eventKeyAction == RNS_KEY_Press)
+    RnsShell::MemoryAccounting::dump();
+#endif
 
   if(previousKeyType == eventKeyType  && eventKeyAction == RNS_KEY_Press){
     keyRepeat = true;
@@ -92,28 +163,29 @@ void RSkInputEventManager::keyHandler(rnsKey eventKeyType, rnsKeyAction eventKey
     previousKeyType = RNS_KEY_UnKnown;
     if(keyRepeat == true) {
       keyRepeat = false;
-#if ENABLE(FEATURE_KEY_THROTTLING)
       if(!keyQueue_->isEmpty())
         keyQueue_->clear(); // flush the queue
-#endif
     }
   } 
   RSkKeyInput keyInput(eventKeyType, eventKeyAction, keyRepeat);
+  keyInput.latencyId_ = RnsShell::InputLatency::beginEvent(eventKeyType, eventKeyAction);
   previousKeyType = eventKeyType;
-#if ENABLE(FEATURE_KEY_THROTTLING)
-    keyQueue_->push(keyInput);
-#else
-    processKey(keyInput);
-#endif
+  keyQueue_->push(keyInput); // Processed on the input worker thread, where auto repeats get coalesced
 }
 
-void RSkInputEventManager::processKey(RSkKeyInput &keyInput) {
+void RSkInputEventManager::processKey(RSkKeyInput &keyInput, const std::vector<uint64_t> &latencyIds) {
   bool stopPropagate = false;
   RNS_LOG_DEBUG("[Process Key] Key Repeat " << keyInput.repeat_ << " eventKeyType  " << keyInput.key_ << " previousKeyType " << previousKeyType);
+  RnsShell::InputLatency::markDequeued(keyInput.latencyId_);
   
   auto currentFocused = spatialNavigator_->getCurrentFocusElement();
+  // Dispatched before any handling, so the commit of the component or of the navigator is the one of the key
+  RnsShell::InputLatency::DispatchScope dispatchScope(latencyIds);
   if(currentFocused){ // send key to Focused component.
     currentFocused->onHandleKey(keyInput.key_, keyInput.repeat_,keyInput.action_, &stopPropagate);
+    // Component consuming the key gets each of the coalesced repeats
+    for(unsigned int count = 1; stopPropagate && count < keyInput.repeatCount_; count++)
+      currentFocused->onHandleKey(keyInput.key_, keyInput.repeat_,keyInput.action_, &stopPropagate);
     if(stopPropagate){
       return;//don't propagate key further
     }
@@ -123,9 +195,9 @@ void RSkInputEventManager::processKey(RSkKeyInput &keyInput) {
     sendNotificationWithEventType(
         RNSKeyMap[keyInput.key_],
         currentFocused ? currentFocused->getComponentData().tag : -1,
-        keyInput.action_, nullptr);
+        keyInput.action_, keyInput.repeatCount_, nullptr);
 #endif //TARGET_OS_TV
-    spatialNavigator_->handleKeyEvent(keyInput.key_, keyInput.action_);
+    spatialNavigator_->handleKeyEvent(keyInput.key_, keyInput.action_, keyInput.repeatCount_);
   }
   /*Sending Events to the registered callback*/
   eventCallbackMutex_.lock();
@@ -145,13 +217,15 @@ RSkInputEventManager* RSkInputEventManager::getInputKeyEventManager(){
 }
 
 #if defined(TARGET_OS_TV) && TARGET_OS_TV
-void RSkInputEventManager::sendNotificationWithEventType(std::string eventType, int tag, rnsKeyAction keyAction, NotificationCompleteVoidCallback completeCallback) {
+void RSkInputEventManager::sendNotificationWithEventType(std::string eventType, int tag, rnsKeyAction keyAction,
+                                                         unsigned int repeatCount, NotificationCompleteVoidCallback completeCallback) {
   if(eventType.c_str() == nullptr)
     return;
   RNS_LOG_DEBUG("Send : " << eventType  << " To ComponentTag : " << tag );
   NotificationCenter::defaultCenter().emit("RCTTVNavigationEventNotification",
       folly::dynamic(folly::dynamic::object("eventType", eventType.c_str())
       ("eventKeyAction", (int)keyAction)
+      ("repeatCount", repeatCount) // Auto repeats coalesced in to this key event
       ("tag", tag)
       ("target", tag)
       ), completeCallback);
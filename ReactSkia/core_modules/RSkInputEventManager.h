@@ -6,9 +6,11 @@
  */
 
 #pragma once
+#include <atomic>
 #include <map>
 #include <mutex>
 #include <semaphore.h>
+#include <vector>
 #include "ReactSkia/sdk/ThreadSafeQueue.h"
 #include "ReactSkia/core_modules/RSkSpatialNavigator.h"
 
@@ -28,6 +30,8 @@ struct RSkKeyInput {
   rnsKey key_;
   rnsKeyAction action_ {RNS_KEY_UnknownAction};
   bool repeat_ {false};
+  uint64_t latencyId_ {0}; // See RnsShell::InputLatency
+  unsigned int repeatCount_ {1}; // Auto repeats coalesced in to this key, to be applied at once
 };
 typedef std::function< void (RSkKeyInput)> inputEventClientCallback;
 
@@ -38,14 +42,23 @@ class RSkInputEventManager {
   std::map <int, inputEventClientCallback > eventCallbackMap_;
   static RSkInputEventManager *sharedInputEventManager_;
   RSkInputEventManager();
-#if ENABLE(FEATURE_KEY_THROTTLING)
   void inputWorkerThreadFunction();
   std::unique_ptr<ThreadSafeQueue<RSkKeyInput>> keyQueue_;
-  sem_t keyEventPost_;
   std::thread inputWorkerThread_;
+  std::atomic<bool> stopWorker_ {false}; // Set by the destructor, before it wakes up & joins the worker
+  // Auto repeats of the navigation keys are paced to the render (& JS, when throttled) turnaround,
+  // repeats queued meanwhile are coalesced
+  bool isCoalescableRepeat(const RSkKeyInput &keyInput);
+  void paceRepeat();
+  void coalesceRepeats(RSkKeyInput &keyInput, std::vector<uint64_t> &latencyIds);
+  double lastRepeatTimeMs_ {0};
+#if ENABLE(FEATURE_KEY_THROTTLING)
+  sem_t keyEventPost_;
   std::atomic<int> activeInputClients_ {0};
+  std::atomic<double> jsEmitTimeMs_ {0}; // Set & read on the JS completion & input threads
+  std::atomic<double> jsTurnaroundAverageMs_ {0};
 #endif
-  void processKey(RSkKeyInput &keyInput);
+  void processKey(RSkKeyInput &keyInput, const std::vector<uint64_t> &latencyIds);
   RSkSpatialNavigator* spatialNavigator_ {nullptr};
 
  public:
@@ -60,7 +73,8 @@ class RSkInputEventManager {
 #endif
 
 #if defined(TARGET_OS_TV) && TARGET_OS_TV
-  void sendNotificationWithEventType(std::string eventType, int tag, rnsKeyAction keyAction = RNS_KEY_UnknownAction, NotificationCompleteVoidCallback completeCallback = nullptr);
+  void sendNotificationWithEventType(std::string eventType, int tag, rnsKeyAction keyAction = RNS_KEY_UnknownAction,
+                                     unsigned int repeatCount = 1, NotificationCompleteVoidCallback completeCallback = nullptr);
 #endif //TARGET_OS_TV
 
   NotificationCompleteVoidCallback completeCallback_ {nullptr};
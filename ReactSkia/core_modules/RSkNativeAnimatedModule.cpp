@@ -0,0 +1,155 @@
+/*
+* Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+*
+* This source code is licensed under the MIT license found in the
+* LICENSE file in the root directory of this source tree.
+*/
+
+#include <cxxreact/JsArgumentHelpers.h>
+
+#include "ReactSkia/utils/RnsLog.h"
+#include "RSkNativeAnimatedModule.h"
+
+using namespace folly;
+
+namespace facebook {
+using namespace xplat;
+using namespace xplat::module;
+
+namespace react {
+
+RSkNativeAnimatedModule::RSkNativeAnimatedModule(ComponentViewRegistry *componentViewRegistry, RnsShell::AnimationDriver *animationDriver, Instance *bridgeInstance)
+  : nodesManager_(std::make_shared<RSkNativeAnimatedNodesManager>(componentViewRegistry, animationDriver)),
+    valueUpdateEmitter_(std::make_shared<ValueUpdateEmitter>(bridgeInstance)) {
+  nodesManager_->setValueUpdateCallback([emitter = valueUpdateEmitter_](Tag nodeTag, double value) {
+    emitter->sendEventWithName("onAnimatedValueUpdate", folly::dynamic::object("tag", nodeTag)("value", value));
+  });
+}
+
+auto RSkNativeAnimatedModule::getConstants() -> std::map<std::string, folly::dynamic> {
+  return {};
+}
+
+auto RSkNativeAnimatedModule::getMethods() -> std::vector<Method> {
+  return {
+      // Operations are applied as they come, graph is evaluated on the next compositor frame anyway
+      Method("startOperationBatch", [] (dynamic args) {}),
+      Method("finishOperationBatch", [] (dynamic args) {}),
+      Method(
+          "createAnimatedNode",
+          [this] (dynamic args) {
+            nodesManager_->createAnimatedNode(jsArgAsInt(args, 0), jsArgAsObject(args, 1));
+          }),
+      Method(
+          "getValue",
+          [this] (dynamic args, CxxModule::Callback saveValueCallback) {
+            saveValueCallback({nodesManager_->getValue(jsArgAsInt(args, 0))});
+          }),
+      Method(
+          "startListeningToAnimatedNodeValue",
+          [this] (dynamic args) {
+            nodesManager_->startListeningToAnimatedNodeValue(jsArgAsInt(args, 0));
+          }),
+      Method(
+          "stopListeningToAnimatedNodeValue",
+          [this] (dynamic args) {
+            nodesManager_->stopListeningToAnimatedNodeValue(jsArgAsInt(args, 0));
+          }),
+      Method(
+          "connectAnimatedNodes",
+          [this] (dynamic args) {
+            nodesManager_->connectAnimatedNodes(jsArgAsInt(args, 0), jsArgAsInt(args, 1));
+          }),
+      Method(
+          "disconnectAnimatedNodes",
+          [this] (dynamic args) {
+            nodesManager_->disconnectAnimatedNodes(jsArgAsInt(args, 0), jsArgAsInt(args, 1));
+          }),
+      Method(
+          "startAnimatingNode",
+          [this] (dynamic args, CxxModule::Callback endCallback) {
+            nodesManager_->startAnimatingNode(jsArgAsInt(args, 0), jsArgAsInt(args, 1), jsArgAsObject(args, 2), endCallback);
+          }),
+      Method(
+          "stopAnimation",
+          [this] (dynamic args) {
+            nodesManager_->stopAnimation(jsArgAsInt(args, 0));
+          }),
+      Method(
+          "setAnimatedNodeValue",
+          [this] (dynamic args) {
+            nodesManager_->setAnimatedNodeValue(jsArgAsInt(args, 0), jsArgAsDouble(args, 1));
+          }),
+      Method(
+          "setAnimatedNodeOffset",
+          [this] (dynamic args) {
+            nodesManager_->setAnimatedNodeOffset(jsArgAsInt(args, 0), jsArgAsDouble(args, 1));
+          }),
+      Method(
+          "flattenAnimatedNodeOffset",
+          [this] (dynamic args) {
+            nodesManager_->flattenAnimatedNodeOffset(jsArgAsInt(args, 0));
+          }),
+      Method(
+          "extractAnimatedNodeOffset",
+          [this] (dynamic args) {
+            nodesManager_->extractAnimatedNodeOffset(jsArgAsInt(args, 0));
+          }),
+      Method(
+          "connectAnimatedNodeToView",
+          [this] (dynamic args) {
+            nodesManager_->connectAnimatedNodeToView(jsArgAsInt(args, 0), jsArgAsInt(args, 1));
+          }),
+      Method(
+          "disconnectAnimatedNodeFromView",
+          [this] (dynamic args) {
+            nodesManager_->disconnectAnimatedNodeFromView(jsArgAsInt(args, 0), jsArgAsInt(args, 1));
+          }),
+      Method(
+          "restoreDefaultValues",
+          [this] (dynamic args) {
+            nodesManager_->restoreDefaultValues(jsArgAsInt(args, 0));
+          }),
+      Method(
+          "dropAnimatedNode",
+          [this] (dynamic args) {
+            nodesManager_->dropAnimatedNode(jsArgAsInt(args, 0));
+          }),
+      Method(
+          "addAnimatedEventToView",
+          [this] (dynamic args) {
+            nodesManager_->addAnimatedEventToView(jsArgAsInt(args, 0), jsArgAsString(args, 1), jsArgAsObject(args, 2));
+          }),
+      Method(
+          "removeAnimatedEventFromView",
+          [this] (dynamic args) {
+            nodesManager_->removeAnimatedEventFromView(jsArgAsInt(args, 0), jsArgAsString(args, 1), jsArgAsInt(args, 2));
+          }),
+      Method(
+          "addListener",
+          [this] (dynamic args) {
+            valueUpdateEmitter_->addListener(jsArgAsString(args, 0));
+          }),
+      Method(
+          "removeListeners",
+          [this] (dynamic args) {
+            valueUpdateEmitter_->removeListeners(jsArgAsInt(args, 0));
+          }),
+  };
+}
+
+std::string RSkNativeAnimatedModule::getName() {
+  return "NativeAnimatedModule";
+}
+
+RSkNativeAnimated::RSkNativeAnimated(
+    const std::string &name,
+    std::shared_ptr<CallInvoker> jsInvoker,
+    ComponentViewRegistry *componentViewRegistry,
+    RnsShell::AnimationDriver *animationDriver,
+    Instance *bridgeInstance)
+    : TurboCxxModule(std::make_unique<RSkNativeAnimatedModule>(componentViewRegistry, animationDriver, bridgeInstance), jsInvoker) {
+}
+
+}// namespace react
+}//namespace facebook
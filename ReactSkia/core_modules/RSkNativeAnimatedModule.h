@@ -0,0 +1,52 @@
+/*
+* Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+*
+* This source code is licensed under the MIT license found in the
+* LICENSE file in the root directory of this source tree.
+*/
+#pragma once
+
+#include "ReactCommon/TurboCxxModule.h"
+#include "ReactSkia/LegacyNativeModules/RSkBaseEventEmitter.h"
+#include "ReactSkia/core_modules/RSkNativeAnimatedNodesManager.h"
+
+namespace facebook {
+using namespace xplat::module;
+
+namespace react {
+
+class RSkNativeAnimatedModule : public CxxModule {
+ public:
+  RSkNativeAnimatedModule(ComponentViewRegistry *componentViewRegistry, RnsShell::AnimationDriver *animationDriver, Instance *bridgeInstance);
+  ~RSkNativeAnimatedModule() = default;
+  virtual auto getConstants() -> std::map<std::string, folly::dynamic>;
+  virtual auto getMethods() -> std::vector<Method>;
+  virtual std::string getName();
+
+ private:
+  // Emits onAnimatedValueUpdate to the NativeEventEmitter of NativeAnimatedHelper
+  class ValueUpdateEmitter : public RSkBaseEventEmitter {
+   public:
+    ValueUpdateEmitter(Instance *bridgeInstance) : RSkBaseEventEmitter(bridgeInstance) {}
+    void startObserving() override {}
+    void stopObserving() override {}
+  };
+
+  std::shared_ptr<RSkNativeAnimatedNodesManager> nodesManager_;
+  std::shared_ptr<ValueUpdateEmitter> valueUpdateEmitter_; // Shared with the compositor thread reporting the values
+};
+
+class RSkNativeAnimated : public TurboCxxModule {
+ public:
+  RSkNativeAnimated(
+    const std::string &name,
+    std::shared_ptr<CallInvoker> jsInvoker,
+    ComponentViewRegistry *componentViewRegistry,
+    RnsShell::AnimationDriver *animationDriver,
+    Instance *bridgeInstance);
+
+  ~RSkNativeAnimated() = default;
+};
+
+}//namespace react
+}//namespace facebook
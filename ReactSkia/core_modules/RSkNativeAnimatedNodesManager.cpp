@@ -0,0 +1,882 @@
+/*
+* Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+*
+* This source code is licensed under the MIT license found in the
+* LICENSE file in the root directory of this source tree.
+*/
+
+#include <ctype.h>
+#include <math.h>
+#include <algorithm>
+#include <functional>
+#include <map>
+
+#include "react/renderer/graphics/Transform.h"
+#include "react/renderer/components/view/ViewProps.h"
+
+#include "ReactSkia/ComponentViewRegistry.h"
+#include "ReactSkia/components/RSkComponent.h"
+#include "ReactSkia/core_modules/RSkNativeAnimatedNodesManager.h"
+#include "ReactSkia/utils/RnsLog.h"
+#include "ReactSkia/views/common/RSkConversion.h"
+
+#define ANIMATION_FRAME_DURATION_MS  (1000.0 / 60.0) // Frames animations are sampled at 60fps by JS
+#define DECAY_REST_DELTA  0.1
+
+namespace facebook {
+namespace react {
+
+enum AnimatedNodeType {
+  AnimatedNodeValue,
+  AnimatedNodeStyle,
+  AnimatedNodeTransform,
+  AnimatedNodeProps,
+};
+
+struct RSkNativeAnimatedNodesManager::AnimatedNode {
+  AnimatedNode(Tag nodeTag, AnimatedNodeType nodeType) : tag(nodeTag), type(nodeType) {}
+  virtual ~AnimatedNode() = default;
+
+  // Recomputes the node from its parents, called in topological order
+  virtual void update(RSkNativeAnimatedNodesManager &manager) {}
+
+  Tag tag;
+  AnimatedNodeType type;
+  std::vector<Tag> parents;
+  std::vector<Tag> children;
+};
+
+struct RSkNativeAnimatedNodesManager::ValueNode : public AnimatedNode {
+  ValueNode(Tag nodeTag, const folly::dynamic &config) : AnimatedNode(nodeTag, AnimatedNodeValue) {
+    value = config.getDefault("value", 0.0).asDouble();
+    offset = config.getDefault("offset", 0.0).asDouble();
+  }
+  double getValue() const { return value + offset; }
+
+  double value{0};
+  double offset{0};
+  bool hasListener{false}; // Value is reported to JS after each frame
+};
+
+namespace {
+
+using AnimatedNode = RSkNativeAnimatedNodesManager::AnimatedNode;
+using ValueNode = RSkNativeAnimatedNodesManager::ValueNode;
+
+double interpolate(double value, double inputMin, double inputMax, double outputMin, double outputMax,
+                   const std::string &extrapolateLeft, const std::string &extrapolateRight) {
+  if(value < inputMin) {
+    if(extrapolateLeft == "identity") return value;
+    if(extrapolateLeft == "clamp") value = inputMin;
+  }
+  if(value > inputMax) {
+    if(extrapolateRight == "identity") return value;
+    if(extrapolateRight == "clamp") value = inputMax;
+  }
+  if(outputMin == outputMax) return outputMin;
+  if(inputMin == inputMax) return (value <= inputMin) ? outputMin : outputMax;
+  return outputMin + (outputMax - outputMin) * (value - inputMin) / (inputMax - inputMin);
+}
+
+// Angles are animated in radians, "45deg" & "1rad" strings are converted
+double parseAngle(const folly::dynamic &angle) {
+  if(angle.isNumber()) return angle.asDouble();
+  if(!angle.isString()) return 0;
+  std::string angleString = angle.asString();
+  double value = atof(angleString.c_str());
+  return (angleString.find("deg") != std::string::npos) ? value * M_PI / 180 : value;
+}
+
+std::vector<double> doubleArray(const folly::dynamic &array) {
+  std::vector<double> values;
+  if(array.isArray()) {
+    for(auto &item : array) {
+      values.push_back(parseAngle(item));
+    }
+  }
+  return values;
+}
+
+std::vector<Tag> tagArray(const folly::dynamic &array) {
+  std::vector<Tag> tags;
+  if(array.isArray()) {
+    for(auto &item : array) {
+      tags.push_back(item.asInt());
+    }
+  }
+  return tags;
+}
+
+struct InterpolationNode : public ValueNode {
+  InterpolationNode(Tag nodeTag, const folly::dynamic &config) : ValueNode(nodeTag, config) {
+    inputRange = doubleArray(config["inputRange"]);
+    outputRange = doubleArray(config["outputRange"]);
+    extrapolateLeft = config.getDefault("extrapolateLeft", "extend").asString();
+    extrapolateRight = config.getDefault("extrapolateRight", "extend").asString();
+    if(config["outputRange"].isArray() && !config["outputRange"].empty() && config["outputRange"][0].isString()) {
+      std::string output = config["outputRange"][0].asString();
+      if((output.find("deg") == std::string::npos) && (output.find("rad") == std::string::npos)) {
+        RNS_LOG_NOT_IMPL_MSG("Interpolation to output range " << output);
+      }
+    }
+  }
+
+  void update(RSkNativeAnimatedNodesManager &manager) override {
+    if(parents.empty() || (inputRange.size() < 2) || (inputRange.size() != outputRange.size())) return;
+    ValueNode *parent = manager.getValueNode(parents.front());
+    if(!parent) return;
+    double input = parent->getValue();
+    size_t range = 1;
+    while((range < inputRange.size() - 1) && (inputRange[range] < input)) range++;
+    value = interpolate(input, inputRange[range - 1], inputRange[range], outputRange[range - 1], outputRange[range],
+                        extrapolateLeft, extrapolateRight);
+  }
+
+  std::vector<double> inputRange;
+  std::vector<double> outputRange;
+  std::string extrapolateLeft;
+  std::string extrapolateRight;
+};
+
+struct MathNode : public ValueNode {
+  using Operation = double (*)(double, double);
+
+  MathNode(Tag nodeTag, const folly::dynamic &config, Operation mathOperation)
+    : ValueNode(nodeTag, config), inputs(tagArray(config["input"])), operation(mathOperation) {}
+
+  void update(RSkNativeAnimatedNodesManager &manager) override {
+    bool first = true;
+    for(auto inputTag : inputs) {
+      ValueNode *input = manager.getValueNode(inputTag);
+      if(!input) {
+        RNS_LOG_ERROR("Illegal input node " << inputTag << " for math node " << tag);
+        return;
+      }
+      value = first ? input->getValue() : operation(value, input->getValue());
+      first = false;
+    }
+  }
+
+  std::vector<Tag> inputs;
+  Operation operation;
+};
+
+struct ModulusNode : public ValueNode {
+  ModulusNode(Tag nodeTag, const folly::dynamic &config)
+    : ValueNode(nodeTag, config), input(config["input"].asInt()), modulus(config["modulus"].asDouble()) {}
+
+  void update(RSkNativeAnimatedNodesManager &manager) override {
+    ValueNode *inputNode = manager.getValueNode(input);
+    if(inputNode && modulus != 0) {
+      value = fmod(fmod(inputNode->getValue(), modulus) + modulus, modulus);
+    }
+  }
+
+  Tag input;
+  double modulus;
+};
+
+struct DiffClampNode : public ValueNode {
+  DiffClampNode(Tag nodeTag, const folly::dynamic &config)
+    : ValueNode(nodeTag, config), input(config["input"].asInt()),
+      min(config["min"].asDouble()), max(config["max"].asDouble()) {}
+
+  void update(RSkNativeAnimatedNodesManager &manager) override {
+    ValueNode *inputNode = manager.getValueNode(input);
+    if(!inputNode) return;
+    double inputValue = inputNode->getValue();
+    double diff = inputValue - lastInputValue;
+    lastInputValue = inputValue;
+    value = std::min(std::max(value + diff, min), max);
+  }
+
+  Tag input;
+  double min;
+  double max;
+  double lastInputValue{0};
+};
+
+struct StyleNode : public AnimatedNode {
+  StyleNode(Tag nodeTag, const folly::dynamic &config) : AnimatedNode(nodeTag, AnimatedNodeStyle) {
+    for(auto &item : config["style"].items()) {
+      style[item.first.asString()] = item.second.asInt();
+    }
+  }
+  std::map<std::string, Tag> style;
+};
+
+struct TransformNode : public AnimatedNode {
+  struct Operation {
+    std::string property;
+    Tag nodeTag{0}; // Animated operation
+    double value{0}; // Static operation
+  };
+
+  TransformNode(Tag nodeTag, const folly::dynamic &config) : AnimatedNode(nodeTag, AnimatedNodeTransform) {
+    for(auto &item : config["transforms"]) {
+      Operation operation;
+      operation.property = item["property"].asString();
+      if(item["type"].asString() == "animated") {
+        operation.nodeTag = item["nodeTag"].asInt();
+      } else {
+        operation.value = parseAngle(item["value"]);
+      }
+      operations.push_back(operation);
+    }
+  }
+
+  Transform getTransform(RSkNativeAnimatedNodesManager &manager) {
+    Transform transform = Transform::Identity();
+    for(auto &operation : operations) {
+      double value = operation.value;
+      if(operation.nodeTag) {
+        ValueNode *node = manager.getValueNode(operation.nodeTag);
+        if(!node) continue;
+        value = node->getValue();
+      }
+      if(operation.property == "translateX") {
+        transform = transform * Transform::Translate(value, 0, 0);
+      } else if(operation.property == "translateY") {
+        transform = transform * Transform::Translate(0, value, 0);
+      } else if(operation.property == "scale") {
+        transform = transform * Transform::Scale(value, value, 1);
+      } else if(operation.property == "scaleX") {
+        transform = transform * Transform::Scale(value, 1, 1);
+      } else if(operation.property == "scaleY") {
+        transform = transform * Transform::Scale(1, value, 1);
+      } else if((operation.property == "rotate") || (operation.property == "rotateZ")) {
+        transform = transform * Transform::RotateZ(value);
+      } else if(operation.property == "rotateX") {
+        transform = transform * Transform::RotateX(value);
+      } else if(operation.property == "rotateY") {
+        transform = transform * Transform::RotateY(value);
+      } else if(operation.property == "perspective") {
+        transform = transform * Transform::Perspective(value);
+      } else if(operation.property == "skewX") {
+        transform = transform * Transform::Skew(value, 0);
+      } else if(operation.property == "skewY") {
+        transform = transform * Transform::Skew(0, value);
+      } else {
+        RNS_LOG_NOT_IMPL_MSG("Animated transform property " << operation.property);
+      }
+    }
+    return transform;
+  }
+
+  std::vector<Operation> operations;
+};
+
+} // namespace
+
+struct RSkNativeAnimatedNodesManager::PropsNode : public AnimatedNode {
+  PropsNode(Tag nodeTag, const folly::dynamic &config) : AnimatedNode(nodeTag, AnimatedNodeProps) {
+    for(auto &item : config["props"].items()) {
+      props[item.first.asString()] = item.second.asInt();
+    }
+  }
+
+  // Writes the animated props to the layer of the connected view, layer tree is locked by the caller
+  void update(RSkNativeAnimatedNodesManager &manager) override {
+    if(!viewTag) return;
+    std::shared_ptr<RSkComponent> component = manager.componentViewRegistry()->GetComponent(viewTag);
+    if(!component || !component->layer()) return;
+    for(auto &prop : props) {
+      AnimatedNode *node = manager.getNode(prop.second);
+      if(node && node->type == AnimatedNodeStyle) {
+        for(auto &style : static_cast<StyleNode*>(node)->style) {
+          applyProp(manager, *component->layer().get(), style.first, manager.getNode(style.second));
+        }
+      } else {
+        applyProp(manager, *component->layer().get(), prop.first, node);
+      }
+    }
+  }
+
+  void applyProp(RSkNativeAnimatedNodesManager &manager, RnsShell::Layer &layer, const std::string &name, AnimatedNode *node) {
+    if(!node) return;
+    if((name == "opacity") && (node->type == AnimatedNodeValue)) {
+      double opacity = static_cast<ValueNode*>(node)->getValue();
+      layer.opacity = std::min(std::max(opacity, 0.0), 1.0) * MAX_8BIT;
+      layer.invalidate(RnsShell::LayerCompositeInvalidate);
+    } else if((name == "transform") && (node->type == AnimatedNodeTransform)) {
+      layer.transformMatrix = RSkTransformTo2DMatrix(static_cast<TransformNode*>(node)->getTransform(manager));
+      layer.invalidate(RnsShell::LayerLayoutInvalidate);
+    } else {
+      RNS_LOG_NOT_IMPL_MSG("Native driven animation of prop " << name);
+    }
+  }
+
+  std::map<std::string, Tag> props;
+  Tag viewTag{0};
+};
+
+struct RSkNativeAnimatedNodesManager::Animation {
+  Animation(int animationId, Tag animatedNodeTag, const folly::dynamic &config, AnimatedEndCallback callback)
+    : id(animationId), nodeTag(animatedNodeTag), endCallback(callback) {
+    iterations = config.getDefault("iterations", 1).asInt();
+  }
+  virtual ~Animation() = default;
+
+  // Advances the node to the frame time, returns true once the animation is finished
+  bool step(ValueNode &node, double frameTimeMs) {
+    if(startTimeMs < 0) {
+      startTimeMs = frameTimeMs;
+      fromValue = node.value;
+    }
+    if(!run(node, frameTimeMs - startTimeMs)) return false;
+    if((iterations == -1) || (++currentIteration < iterations)) {
+      startTimeMs = frameTimeMs; // Next iteration starts over from the initial value
+      node.value = fromValue;
+      return false;
+    }
+    return true;
+  }
+
+  // Returns true when the current iteration is finished
+  virtual bool run(ValueNode &node, double elapsedMs) = 0;
+
+  int id;
+  Tag nodeTag;
+  AnimatedEndCallback endCallback;
+  int iterations{1}; // -1 for infinite
+  int currentIteration{0};
+  double startTimeMs{-1};
+  double fromValue{0};
+};
+
+namespace {
+
+using Animation = RSkNativeAnimatedNodesManager::Animation;
+
+struct FramesAnimation : public Animation {
+  FramesAnimation(int animationId, Tag nodeTag, const folly::dynamic &config, AnimatedEndCallback callback)
+    : Animation(animationId, nodeTag, config, callback),
+      frames(doubleArray(config["frames"])), toValue(config["toValue"].asDouble()) {}
+
+  bool run(ValueNode &node, double elapsedMs) override {
+    size_t frameIndex = round(elapsedMs / ANIMATION_FRAME_DURATION_MS);
+    if(frames.empty() || frameIndex >= frames.size() - 1) {
+      node.value = toValue;
+      return true;
+    }
+    node.value = fromValue + frames[frameIndex] * (toValue - fromValue);
+    return false;
+  }
+
+  std::vector<double> frames;
+  double toValue;
+};
+
+// Closed form of the damped harmonic oscillator, as used by JS SpringAnimation
+struct SpringAnimation : public Animation {
+  SpringAnimation(int animationId, Tag nodeTag, const folly::dynamic &config, AnimatedEndCallback callback)
+    : Animation(animationId, nodeTag, config, callback) {
+    toValue = config["toValue"].asDouble();
+    stiffness = config["stiffness"].asDouble();
+    damping = config["damping"].asDouble();
+    mass = config["mass"].asDouble();
+    initialVelocity = config.getDefault("initialVelocity", 0.0).asDouble();
+    overshootClamping = config.getDefault("overshootClamping", false).asBool();
+    restDisplacementThreshold = config.getDefault("restDisplacementThreshold", 0.001).asDouble();
+    restSpeedThreshold = config.getDefault("restSpeedThreshold", 0.001).asDouble();
+  }
+
+  bool run(ValueNode &node, double elapsedMs) override {
+    double t = elapsedMs / 1000;
+    double zeta = damping / (2 * sqrt(stiffness * mass));
+    double omega0 = sqrt(stiffness / mass);
+    double x0 = toValue - fromValue;
+    double v0 = -initialVelocity;
+    double position, velocity;
+
+    if(zeta < 1) {
+      double omega1 = omega0 * sqrt(1.0 - zeta * zeta);
+      double envelope = exp(-zeta * omega0 * t);
+      double a = (v0 + zeta * omega0 * x0) / omega1;
+      position = toValue - envelope * (a * sin(omega1 * t) + x0 * cos(omega1 * t));
+      velocity = zeta * omega0 * envelope * (a * sin(omega1 * t) + x0 * cos(omega1 * t)) -
+                 envelope * (cos(omega1 * t) * (v0 + zeta * omega0 * x0) - omega1 * x0 * sin(omega1 * t));
+    } else {
+      double envelope = exp(-omega0 * t);
+      position = toValue - envelope * (x0 + (v0 + omega0 * x0) * t);
+      velocity = envelope * (v0 * (t * omega0 - 1) + t * x0 * (omega0 * omega0));
+    }
+    node.value = position;
+
+    bool overshot = overshootClamping && (stiffness != 0) &&
+                    ((fromValue < toValue) ? (position > toValue) : (position < toValue));
+    bool atRest = (fabs(velocity) <= restSpeedThreshold) &&
+                  ((stiffness == 0) || (fabs(toValue - position) <= restDisplacementThreshold));
+    if(overshot || atRest) {
+      if(stiffness != 0) node.value = toValue;
+      return true;
+    }
+    return false;
+  }
+
+  double toValue;
+  double stiffness;
+  double damping;
+  double mass;
+  double initialVelocity;
+  bool overshootClamping;
+  double restDisplacementThreshold;
+  double restSpeedThreshold;
+};
+
+struct DecayAnimation : public Animation {
+  DecayAnimation(int animationId, Tag nodeTag, const folly::dynamic &config, AnimatedEndCallback callback)
+    : Animation(animationId, nodeTag, config, callback),
+      velocity(config["velocity"].asDouble()), deceleration(config["deceleration"].asDouble()) {}
+
+  bool run(ValueNode &node, double elapsedMs) override {
+    if(elapsedMs == 0) lastValue = fromValue;
+    double value = fromValue + velocity / (1 - deceleration) * (1 - exp(-(1 - deceleration) * elapsedMs));
+    bool finished = (elapsedMs > 0) && (fabs(lastValue - value) < DECAY_REST_DELTA);
+    lastValue = node.value = value;
+    return finished;
+  }
+
+  double velocity; // Per millisecond
+  double deceleration;
+  double lastValue{0};
+};
+
+// Views with a native driven Animated.event attached, events are dispatched to the manager which attached them
+std::mutex attachedEventsMutex;
+std::map<std::pair<Tag, std::string>, std::weak_ptr<RSkNativeAnimatedNodesManager>> attachedEvents;
+
+// "onScroll" & "topScroll" are both attached as "scroll"
+std::string normalizeEventName(const std::string &eventName) {
+  std::string name = eventName;
+  if(name.compare(0, 3, "top") == 0) {
+    name = name.substr(3);
+  } else if(name.compare(0, 2, "on") == 0) {
+    name = name.substr(2);
+  }
+  if(!name.empty()) name[0] = tolower(name[0]);
+  return name;
+}
+
+} // namespace
+
+RSkNativeAnimatedNodesManager::RSkNativeAnimatedNodesManager(ComponentViewRegistry *componentViewRegistry, RnsShell::AnimationDriver *animationDriver)
+  : componentViewRegistry_(componentViewRegistry)
+  , animationDriver_(animationDriver) {}
+
+RSkNativeAnimatedNodesManager::~RSkNativeAnimatedNodesManager() {}
+
+RSkNativeAnimatedNodesManager::AnimatedNode* RSkNativeAnimatedNodesManager::getNode(Tag tag) {
+  auto it = nodes_.find(tag);
+  return (it != nodes_.end()) ? it->second.get() : nullptr;
+}
+
+RSkNativeAnimatedNodesManager::ValueNode* RSkNativeAnimatedNodesManager::getValueNode(Tag tag) {
+  AnimatedNode *node = getNode(tag);
+  return (node && node->type == AnimatedNodeValue) ? static_cast<ValueNode*>(node) : nullptr;
+}
+
+void RSkNativeAnimatedNodesManager::createAnimatedNode(Tag tag, const folly::dynamic &config) {
+  std::string type = config["type"].asString();
+  std::unique_ptr<AnimatedNode> node;
+
+  if(type == "value") {
+    node = std::make_unique<ValueNode>(tag, config);
+  } else if(type == "interpolation") {
+    node = std::make_unique<InterpolationNode>(tag, config);
+  } else if(type == "addition") {
+    node = std::make_unique<MathNode>(tag, config, [](double a, double b) { return a + b; });
+  } else if(type == "subtraction") {
+    node = std::make_unique<MathNode>(tag, config, [](double a, double b) { return a - b; });
+  } else if(type == "multiplication") {
+    node = std::make_unique<MathNode>(tag, config, [](double a, double b) { return a * b; });
+  } else if(type == "division") {
+    node = std::make_unique<MathNode>(tag, config, [](double a, double b) { return (b != 0) ? a / b : a; });
+  } else if(type == "modulus") {
+    node = std::make_unique<ModulusNode>(tag, config);
+  } else if(type == "diffclamp") {
+    node = std::make_unique<DiffClampNode>(tag, config);
+  } else if(type == "style") {
+    node = std::make_unique<StyleNode>(tag, config);
+  } else if(type == "transform") {
+    node = std::make_unique<TransformNode>(tag, config);
+  } else if(type == "props") {
+    node = std::make_unique<PropsNode>(tag, config);
+  } else {
+    RNS_LOG_NOT_IMPL_MSG("Animated node type " << type);
+    return;
+  }
+  RNS_LOG_DEBUG("Create animated node(" << tag << ") type : " << type);
+  std::scoped_lock lock(mutex_);
+  nodes_[tag] = std::move(node);
+  updatedNodes_.insert(tag);
+}
+
+void RSkNativeAnimatedNodesManager::dropAnimatedNode(Tag tag) {
+  EndedAnimations endedAnimations;
+  {
+    std::scoped_lock lock(mutex_);
+    stopAnimationsForNode(tag, endedAnimations);
+    nodes_.erase(tag);
+    updatedNodes_.erase(tag);
+  }
+  notifyEnded(endedAnimations, false);
+}
+
+void RSkNativeAnimatedNodesManager::connectAnimatedNodes(Tag parentTag, Tag childTag) {
+  {
+    std::scoped_lock lock(mutex_);
+    AnimatedNode *parent = getNode(parentTag);
+    AnimatedNode *child = getNode(childTag);
+    if(!parent || !child) {
+      RNS_LOG_ERROR("Cannot connect animated nodes " << parentTag << " -> " << childTag);
+      return;
+    }
+    parent->children.push_back(childTag);
+    child->parents.push_back(parentTag);
+    updatedNodes_.insert(parentTag);
+  }
+  requestFrame();
+}
+
+void RSkNativeAnimatedNodesManager::disconnectAnimatedNodes(Tag parentTag, Tag childTag) {
+  std::scoped_lock lock(mutex_);
+  AnimatedNode *parent = getNode(parentTag);
+  AnimatedNode *child = getNode(childTag);
+  if(parent) {
+    parent->children.erase(std::remove(parent->children.begin(), parent->children.end(), childTag), parent->children.end());
+  }
+  if(child) {
+    child->parents.erase(std::remove(child->parents.begin(), child->parents.end(), parentTag), child->parents.end());
+  }
+}
+
+void RSkNativeAnimatedNodesManager::connectAnimatedNodeToView(Tag nodeTag, Tag viewTag) {
+  {
+    std::scoped_lock lock(mutex_);
+    AnimatedNode *node = getNode(nodeTag);
+    if(!node || node->type != AnimatedNodeProps) {
+      RNS_LOG_ERROR("Animated node " << nodeTag << " connected to view " << viewTag << " is not a props node");
+      return;
+    }
+    static_cast<PropsNode*>(node)->viewTag = viewTag;
+    updatedNodes_.insert(nodeTag);
+  }
+  requestFrame();
+}
+
+void RSkNativeAnimatedNodesManager::disconnectAnimatedNodeFromView(Tag nodeTag, Tag viewTag) {
+  std::scoped_lock lock(mutex_);
+  AnimatedNode *node = getNode(nodeTag);
+  if(node && node->type == AnimatedNodeProps && static_cast<PropsNode*>(node)->viewTag == viewTag) {
+    static_cast<PropsNode*>(node)->viewTag = 0;
+  }
+}
+
+void RSkNativeAnimatedNodesManager::restoreDefaultValues(Tag nodeTag) {
+  {
+    std::scoped_lock lock(mutex_);
+    AnimatedNode *node = getNode(nodeTag);
+    if(!node || node->type != AnimatedNodeProps || !static_cast<PropsNode*>(node)->viewTag) return;
+    viewsToRestore_.push_back(static_cast<PropsNode*>(node)->viewTag);
+  }
+  requestFrame();
+}
+
+double RSkNativeAnimatedNodesManager::getValue(Tag nodeTag) {
+  std::scoped_lock lock(mutex_);
+  ValueNode *node = getValueNode(nodeTag);
+  return node ? node->getValue() : 0;
+}
+
+void RSkNativeAnimatedNodesManager::setAnimatedNodeValue(Tag nodeTag, double value) {
+  EndedAnimations endedAnimations;
+  {
+    std::scoped_lock lock(mutex_);
+    ValueNode *node = getValueNode(nodeTag);
+    if(!node) return;
+    stopAnimationsForNode(nodeTag, endedAnimations);
+    node->value = value;
+    updatedNodes_.insert(nodeTag);
+  }
+  notifyEnded(endedAnimations, false);
+  requestFrame();
+}
+
+void RSkNativeAnimatedNodesManager::setAnimatedNodeOffset(Tag nodeTag, double offset) {
+  {
+    std::scoped_lock lock(mutex_);
+    ValueNode *node = getValueNode(nodeTag);
+    if(!node) return;
+    node->offset = offset;
+    updatedNodes_.insert(nodeTag);
+  }
+  requestFrame();
+}
+
+void RSkNativeAnimatedNodesManager::flattenAnimatedNodeOffset(Tag nodeTag) {
+  std::scoped_lock lock(mutex_);
+  ValueNode *node = getValueNode(nodeTag);
+  if(node) {
+    node->value += node->offset;
+    node->offset = 0;
+  }
+}
+
+void RSkNativeAnimatedNodesManager::extractAnimatedNodeOffset(Tag nodeTag) {
+  std::scoped_lock lock(mutex_);
+  ValueNode *node = getValueNode(nodeTag);
+  if(node) {
+    node->offset += node->value;
+    node->value = 0;
+  }
+}
+
+void RSkNativeAnimatedNodesManager::startListeningToAnimatedNodeValue(Tag nodeTag) {
+  {
+    std::scoped_lock lock(mutex_);
+    ValueNode *node = getValueNode(nodeTag);
+    if(!node) return;
+    node->hasListener = true;
+    updatedNodes_.insert(nodeTag); // Current value is reported on the next frame
+  }
+  requestFrame();
+}
+
+void RSkNativeAnimatedNodesManager::stopListeningToAnimatedNodeValue(Tag nodeTag) {
+  std::scoped_lock lock(mutex_);
+  ValueNode *node = getValueNode(nodeTag);
+  if(node) node->hasListener = false;
+}
+
+void RSkNativeAnimatedNodesManager::addAnimatedEventToView(Tag viewTag, const std::string &eventName, const folly::dynamic &eventMapping) {
+  EventMapping mapping{viewTag, normalizeEventName(eventName), {}, 0};
+  for(auto &pathItem : eventMapping["nativeEventPath"]) {
+    mapping.nativeEventPath.push_back(pathItem.asString());
+  }
+  mapping.animatedValueTag = eventMapping["animatedValueTag"].asInt();
+  RNS_LOG_DEBUG("Add animated event " << mapping.eventName << " to view(" << viewTag << ") for node(" << mapping.animatedValueTag << ")");
+  {
+    std::scoped_lock lock(mutex_);
+    eventMappings_.push_back(mapping);
+  }
+  std::scoped_lock lock(attachedEventsMutex);
+  attachedEvents[{viewTag, mapping.eventName}] = weak_from_this();
+}
+
+void RSkNativeAnimatedNodesManager::removeAnimatedEventFromView(Tag viewTag, const std::string &eventName, Tag animatedValueTag) {
+  std::string name = normalizeEventName(eventName);
+  bool stillAttached = false;
+  {
+    std::scoped_lock lock(mutex_);
+    eventMappings_.erase(std::remove_if(eventMappings_.begin(), eventMappings_.end(), [&](const EventMapping &mapping) {
+      return (mapping.viewTag == viewTag) && (mapping.eventName == name) && (mapping.animatedValueTag == animatedValueTag);
+    }), eventMappings_.end());
+    for(auto &mapping : eventMappings_) {
+      stillAttached |= (mapping.viewTag == viewTag) && (mapping.eventName == name);
+    }
+  }
+  if(!stillAttached) {
+    std::scoped_lock lock(attachedEventsMutex);
+    attachedEvents.erase({viewTag, name});
+  }
+}
+
+void RSkNativeAnimatedNodesManager::handleViewEvent(Tag viewTag, const std::string &eventName, const folly::dynamic &event) {
+  EndedAnimations endedAnimations;
+  bool updated = false;
+  {
+    std::scoped_lock lock(mutex_);
+    for(auto &mapping : eventMappings_) {
+      if((mapping.viewTag != viewTag) || (mapping.eventName != eventName)) continue;
+      const folly::dynamic *value = &event;
+      for(auto &key : mapping.nativeEventPath) {
+        value = (value->isObject()) ? value->get_ptr(key) : nullptr;
+        if(!value) break;
+      }
+      ValueNode *node = getValueNode(mapping.animatedValueTag);
+      if(!value || !value->isNumber() || !node) continue;
+      // Event drives the value, like setValue from JS
+      stopAnimationsForNode(node->tag, endedAnimations);
+      node->value = value->asDouble();
+      updatedNodes_.insert(node->tag);
+      updated = true;
+    }
+  }
+  notifyEnded(endedAnimations, false);
+  if(updated) requestFrame();
+}
+
+bool RSkNativeAnimatedNodesManager::isAnimatedEventAttached(Tag viewTag, const std::string &eventName) {
+  std::scoped_lock lock(attachedEventsMutex);
+  return attachedEvents.find({viewTag, eventName}) != attachedEvents.end();
+}
+
+void RSkNativeAnimatedNodesManager::dispatchAnimatedEvent(Tag viewTag, const std::string &eventName, const folly::dynamic &event) {
+  std::shared_ptr<RSkNativeAnimatedNodesManager> manager;
+  {
+    std::scoped_lock lock(attachedEventsMutex);
+    auto it = attachedEvents.find({viewTag, eventName});
+    if(it == attachedEvents.end()) return;
+    manager = it->second.lock();
+    if(!manager) {
+      attachedEvents.erase(it); // Instance is gone
+      return;
+    }
+  }
+  manager->handleViewEvent(viewTag, eventName, event);
+}
+
+void RSkNativeAnimatedNodesManager::startAnimatingNode(int animationId, Tag nodeTag, const folly::dynamic &config, AnimatedEndCallback endCallback) {
+  std::string type = config["type"].asString();
+  std::unique_ptr<Animation> animation;
+
+  if(type == "frames") {
+    animation = std::make_unique<FramesAnimation>(animationId, nodeTag, config, endCallback);
+  } else if(type == "spring") {
+    animation = std::make_unique<SpringAnimation>(animationId, nodeTag, config, endCallback);
+  } else if(type == "decay") {
+    animation = std::make_unique<DecayAnimation>(animationId, nodeTag, config, endCallback);
+  } else {
+    RNS_LOG_NOT_IMPL_MSG("Animation type " << type);
+    return;
+  }
+
+  EndedAnimations endedAnimations;
+  {
+    std::scoped_lock lock(mutex_);
+    if(!getValueNode(nodeTag)) {
+      RNS_LOG_ERROR("Animated node " << nodeTag << " does not exist or is not a value node");
+      return;
+    }
+    // New animation of a node replaces the running one
+    stopAnimationsForNode(nodeTag, endedAnimations);
+    animations_.push_back(std::move(animation));
+  }
+  notifyEnded(endedAnimations, false);
+  requestFrame();
+}
+
+void RSkNativeAnimatedNodesManager::stopAnimation(int animationId) {
+  EndedAnimations endedAnimations;
+  {
+    std::scoped_lock lock(mutex_);
+    for(auto it = animations_.begin(); it != animations_.end(); it++) {
+      if((*it)->id == animationId) {
+        endedAnimations.push_back((*it)->endCallback);
+        animations_.erase(it);
+        break;
+      }
+    }
+  }
+  notifyEnded(endedAnimations, false);
+}
+
+void RSkNativeAnimatedNodesManager::stopAnimationsForNode(Tag nodeTag, EndedAnimations &endedAnimations) {
+  auto it = animations_.begin();
+  while(it != animations_.end()) {
+    if((*it)->nodeTag == nodeTag) {
+      endedAnimations.push_back((*it)->endCallback);
+      it = animations_.erase(it);
+    } else {
+      it++;
+    }
+  }
+}
+
+void RSkNativeAnimatedNodesManager::notifyEnded(EndedAnimations &endedAnimations, bool finished) {
+  for(auto &endCallback : endedAnimations) {
+    if(endCallback) {
+      endCallback({folly::dynamic::object("finished", finished)});
+    }
+  }
+}
+
+void RSkNativeAnimatedNodesManager::requestFrame() {
+  {
+    std::scoped_lock lock(mutex_);
+    if(frameCallbackRegistered_ || !animationDriver_) return;
+    frameCallbackRegistered_ = true;
+  }
+  // Driver calls the frame callbacks without its lock, so it is never taken while holding mutex_
+  std::weak_ptr<RSkNativeAnimatedNodesManager> weakSelf = shared_from_this();
+  animationDriver_->addFrameCallback([weakSelf](double frameTimeMs) -> bool {
+    auto self = weakSelf.lock();
+    return self ? self->onFrame(frameTimeMs) : false;
+  });
+}
+
+bool RSkNativeAnimatedNodesManager::onFrame(double frameTimeMs) {
+  EndedAnimations finishedAnimations;
+  ValueUpdates valueUpdates;
+  bool running;
+  {
+    std::scoped_lock lock(mutex_);
+    auto it = animations_.begin();
+    while(it != animations_.end()) {
+      ValueNode *node = getValueNode((*it)->nodeTag);
+      bool finished = node ? (*it)->step(*node, frameTimeMs) : true;
+      if(node) updatedNodes_.insert(node->tag);
+      if(finished) {
+        finishedAnimations.push_back((*it)->endCallback);
+        it = animations_.erase(it);
+      } else {
+        it++;
+      }
+    }
+
+    updateNodes(valueUpdates);
+
+    for(auto viewTag : viewsToRestore_) {
+      std::shared_ptr<RSkComponent> component = componentViewRegistry_->GetComponent(viewTag);
+      if(!component || !component->layer()) continue;
+      auto const &viewProps = *std::static_pointer_cast<ViewProps const>(component->getComponentData().props);
+      component->layer()->opacity = std::min(std::max(viewProps.opacity, (Float)0.0), (Float)1.0) * MAX_8BIT;
+      component->layer()->transformMatrix = RSkTransformTo2DMatrix(viewProps.transform);
+      component->layer()->invalidate(RnsShell::LayerLayoutInvalidate);
+    }
+    viewsToRestore_.clear();
+
+    running = !animations_.empty();
+    if(!running) {
+      frameCallbackRegistered_ = false;
+    }
+  }
+  notifyEnded(finishedAnimations, true);
+  if(valueUpdateCallback_) {
+    for(auto &valueUpdate : valueUpdates) {
+      valueUpdateCallback_(valueUpdate.first, valueUpdate.second);
+    }
+  }
+  return running;
+}
+
+void RSkNativeAnimatedNodesManager::updateNodes(ValueUpdates &valueUpdates) {
+  /* Nodes reachable from the updated ones are visited in topological order (reverse post order of
+     a depth first traversal), so that each node is computed once, after all its updated parents. */
+  std::vector<AnimatedNode*> postOrder;
+  std::unordered_set<Tag> visited;
+  std::function<void(AnimatedNode*)> visit = [&](AnimatedNode *node) {
+    if(!visited.insert(node->tag).second) return;
+    for(auto childTag : node->children) {
+      AnimatedNode *child = getNode(childTag);
+      if(child) visit(child);
+    }
+    postOrder.push_back(node);
+  };
+  for(auto tag : updatedNodes_) {
+    AnimatedNode *node = getNode(tag);
+    if(node) visit(node);
+  }
+  updatedNodes_.clear();
+
+  for(auto it = postOrder.rbegin(); it != postOrder.rend(); it++) {
+    (*it)->update(*this);
+    if(((*it)->type == AnimatedNodeValue) && static_cast<ValueNode*>(*it)->hasListener) {
+      valueUpdates.emplace_back((*it)->tag, static_cast<ValueNode*>(*it)->getValue());
+    }
+  }
+}
+
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,117 @@
+/*
+* Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+*
+* This source code is licensed under the MIT license found in the
+* LICENSE file in the root directory of this source tree.
+*/
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <folly/dynamic.h>
+
+#include "cxxreact/CxxModule.h"
+#include "react/renderer/core/ReactPrimitives.h"
+
+#include "rns_shell/compositor/AnimationDriver.h"
+
+namespace facebook {
+namespace react {
+
+class ComponentViewRegistry;
+
+using AnimatedEndCallback = xplat::module::CxxModule::Callback;
+// Reports the new value of a node listened by JS, called on the compositor thread
+using AnimatedValueUpdateCallback = std::function<void(Tag nodeTag, double value)>;
+
+/*
+ * Graph of Animated nodes created by JS for the animations using native driver.
+ * Value nodes are advanced by timing (frames), spring & decay animations on the compositor frame tick,
+ * derived nodes (interpolation, math, diffclamp, transform, style) are updated in topological order and
+ * props nodes write the result directly to the layer of the connected view (opacity & transform).
+ * JS thread only edits the graph, all the layer writes happen on the compositor thread with the layer tree locked.
+ * Native events of the views (Animated.event with native driver) set the mapped value nodes directly,
+ * values listened by JS are reported back after each frame.
+ */
+class RSkNativeAnimatedNodesManager : public std::enable_shared_from_this<RSkNativeAnimatedNodesManager> {
+ public:
+  struct AnimatedNode;
+  struct ValueNode;
+  struct PropsNode;
+  struct Animation;
+
+  RSkNativeAnimatedNodesManager(ComponentViewRegistry *componentViewRegistry, RnsShell::AnimationDriver *animationDriver);
+  ~RSkNativeAnimatedNodesManager();
+
+  void createAnimatedNode(Tag tag, const folly::dynamic &config);
+  void dropAnimatedNode(Tag tag);
+  void connectAnimatedNodes(Tag parentTag, Tag childTag);
+  void disconnectAnimatedNodes(Tag parentTag, Tag childTag);
+  void connectAnimatedNodeToView(Tag nodeTag, Tag viewTag);
+  void disconnectAnimatedNodeFromView(Tag nodeTag, Tag viewTag);
+  void restoreDefaultValues(Tag nodeTag);
+
+  double getValue(Tag nodeTag);
+  void setAnimatedNodeValue(Tag nodeTag, double value);
+  void setAnimatedNodeOffset(Tag nodeTag, double offset);
+  void flattenAnimatedNodeOffset(Tag nodeTag);
+  void extractAnimatedNodeOffset(Tag nodeTag);
+
+  void startListeningToAnimatedNodeValue(Tag nodeTag);
+  void stopListeningToAnimatedNodeValue(Tag nodeTag);
+  void setValueUpdateCallback(AnimatedValueUpdateCallback callback) { valueUpdateCallback_ = callback; }
+
+  void addAnimatedEventToView(Tag viewTag, const std::string &eventName, const folly::dynamic &eventMapping);
+  void removeAnimatedEventFromView(Tag viewTag, const std::string &eventName, Tag animatedValueTag);
+  void handleViewEvent(Tag viewTag, const std::string &eventName, const folly::dynamic &event);
+
+  // Views dispatch their native events here, when a native driven Animated.event is attached to them.
+  // Event names are given without "on"/"top" prefix, e.g. "scroll".
+  static bool isAnimatedEventAttached(Tag viewTag, const std::string &eventName);
+  static void dispatchAnimatedEvent(Tag viewTag, const std::string &eventName, const folly::dynamic &event);
+
+  void startAnimatingNode(int animationId, Tag nodeTag, const folly::dynamic &config, AnimatedEndCallback endCallback);
+  void stopAnimation(int animationId);
+
+  AnimatedNode* getNode(Tag tag);
+  ValueNode* getValueNode(Tag tag);
+  ComponentViewRegistry* componentViewRegistry() { return componentViewRegistry_; }
+
+ private:
+  using EndedAnimations = std::vector<AnimatedEndCallback>;
+  using ValueUpdates = std::vector<std::pair<Tag, double>>;
+
+  struct EventMapping {
+    Tag viewTag;
+    std::string eventName;
+    std::vector<std::string> nativeEventPath; // Path of the value in the event, e.g. contentOffset.y
+    Tag animatedValueTag;
+  };
+
+  bool onFrame(double frameTimeMs);
+  void updateNodes(ValueUpdates &valueUpdates);
+  void stopAnimationsForNode(Tag nodeTag, EndedAnimations &endedAnimations);
+  void requestFrame();
+  static void notifyEnded(EndedAnimations &endedAnimations, bool finished);
+
+  std::mutex mutex_; // Graph is edited from JS thread & evaluated on compositor thread
+  std::unordered_map<Tag, std::unique_ptr<AnimatedNode>> nodes_;
+  std::vector<std::unique_ptr<Animation>> animations_;
+  std::unordered_set<Tag> updatedNodes_; // Nodes whose value changed since the last frame
+  std::vector<Tag> viewsToRestore_; // Views disconnected from animated props, to be reset to their props
+  std::vector<EventMapping> eventMappings_;
+  AnimatedValueUpdateCallback valueUpdateCallback_{nullptr};
+
+  ComponentViewRegistry *componentViewRegistry_;
+  RnsShell::AnimationDriver *animationDriver_;
+  bool frameCallbackRegistered_{false};
+};
+
+} // namespace react
+} // namespace facebook
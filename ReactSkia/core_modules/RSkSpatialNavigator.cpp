@@ -13,11 +13,65 @@
 #include "ReactSkia/core_modules/RSkInputEventManager.h"
 #include <ReactSkia/LegacyNativeModules/uimanager/UiManagerModule.h>
 #include "ReactSkia/ReactSkiaApp.h"
+#include "rns_shell/compositor/layers/ScrollLayer.h"
+#include "rns_shell/platform/linux/TaskLoop.h"
 
 namespace facebook{
 namespace react {
 namespace SpatialNavigator {
 
+#define FOCUS_PREDICTION_DELAY_MS 100 // Neighbours are computed after the focus & scroll updates of the last key have settled
+
+static inline int predictionIndex(rnsKey direction) {
+    switch(direction) {
+        case RNS_KEY_Up: return 0;
+        case RNS_KEY_Down: return 1;
+        case RNS_KEY_Left: return 2;
+        case RNS_KEY_Right: return 3;
+        default: return -1;
+    }
+}
+
+// Navigation scrolls & repaints components, which locks the layer tree, while mounting updates the candidate
+// lists with the layer tree locked. Layer tree is thus always locked first, so both orders can't deadlock.
+class RSkSpatialNavigator::NavigationLock {
+public:
+    enum Mode {
+        ReadOnly, // Tree is only read, never committed
+        CommitOnChange // Tree is committed when the navigation moved the focus or scrolled
+    };
+
+    NavigationLock(RSkSpatialNavigator &navigator, Mode mode = CommitOnChange) : navigator_(navigator), mode_(mode) {
+        RSkComponent *rootComponent = static_cast<RSkComponent*>(navigator_.rootContainer_);
+        if(rootComponent && rootComponent->layer()) {
+            treeClient_ = &rootComponent->layer()->client();
+            treeClient_->notifyFlushBegin();
+        }
+        navigator_.navigationMutex_.lock();
+        focusOnLock_ = navigator_.currentFocus_;
+        scrollGenerationOnLock_ = RnsShell::ScrollLayer::scrollPositionGeneration();
+    }
+    ~NavigationLock() {
+        bool changed = (mode_ == CommitOnChange) &&
+                       (navigator_.currentFocus_ != focusOnLock_ ||
+                        RnsShell::ScrollLayer::scrollPositionGeneration() != scrollGenerationOnLock_);
+        navigator_.navigationMutex_.unlock();
+        if(!treeClient_)
+            return;
+        if(changed)
+            treeClient_->notifyFlushRequired();
+        else
+            treeClient_->notifyFlushCancel();
+    }
+
+private:
+    RSkSpatialNavigator &navigator_;
+    Mode mode_;
+    RnsShell::Layer::Client *treeClient_{nullptr};
+    RSkComponent *focusOnLock_{nullptr};
+    uint64_t scrollGenerationOnLock_{0};
+};
+
 RSkSpatialNavigator* RSkSpatialNavigator::sharedSpatialNavigator_{nullptr};
 std::mutex RSkSpatialNavigator::mutex_;
 
@@ -72,6 +126,7 @@ void RSkSpatialNavigator::updateSpatialNavigatorState(NavigatorStateOperation op
     if(candidate == nullptr)
           return;
 
+    std::scoped_lock lock(navigationMutex_);
     Component candidateData = candidate->getComponentData();
     auto const &viewProps = *std::static_pointer_cast<ViewProps const>(candidateData.props);
 
@@ -96,180 +151,6 @@ void RSkSpatialNavigator::updateSpatialNavigatorState(NavigatorStateOperation op
     }
 }
 
-// Comparator function to insert elements into set in custom sort order
-// (Item1, Item2) returning true means add Item1 before Item2
-// Eg.
-// Item1 < Item2 -- Returning true means add Item1 before Item2. Results in ascending
-// Item1 > Item2 -- Returning true means add Item1 before Item2. Results in descending
-template <class T>
-struct sortDirectionComparator {
-    sortDirectionComparator(int dir) { this->direction_ = dir; }
-    bool operator()(const T& listItem, const T& newItem) const {
-        Component listData = listItem->getComponentData();
-        Component newData = newItem->getComponentData();
-        const SkIRect listCandidate = listItem->getScreenFrame();
-        const SkIRect newCandidate = newItem->getScreenFrame();
-
-        // Rule 4. If both candidates are having same dimension (x,y,w,h) then select the one with higher zIndex, else higher tag if zIndex is same
-        if(listCandidate == newCandidate) {
-            //Component with highest zIndex must be added before"
-            if(listData.commonProps.zIndex > newData.commonProps.zIndex) return true;
-            if(newData.commonProps.zIndex  > listData.commonProps.zIndex ) return false;
-            // Last Resort. If both have same zIndex then items with bigger Tag will have more priority (Last added items will always have bigger tags)
-            return listData.tag > newData.tag;
-        }
-        // Based on dircection following 4 rules apply.
-        // Rule 5. Select the Closest candidate in the requested direction.
-        // Rule 6. If both candidates have same distance, then select Lower one for Left/Right direction and Left Most for Up/Down direction
-        // Rule 7. If both candidates have same value in Rule 6, then select the one with lower width for Left/Right direction and lower height for Up/Down
-        // Rule 8. If both candidates have same value in Rule 7, then select the one with lower height for Left/Right direction and lower width for Up/Down
-        switch(direction_) {
-            case RNS_KEY_Right:
-            case RNS_KEY_Left: {
-                // Rule 5.
-                if(direction_ == RNS_KEY_Right) {
-                    if(listCandidate.left() < newCandidate.left()) return true;
-                    if(newCandidate.left()  < listCandidate.left()) return false;
-                }else {
-                    if(listCandidate.right() > newCandidate.right()) return true;
-                    if(newCandidate.right()  > listCandidate.right()) return false;
-                }
-                // Rule 6.
-                if(listCandidate.top() < newCandidate.top()) return true;
-                if(newCandidate.top()  < listCandidate.top()) return false;
-                // Rule 7.
-                if(listCandidate.width() < newCandidate.width()) return true;
-                if(newCandidate.width()  < listCandidate.width()) return false;
-                // Rule 8
-                if(listCandidate.height() < newCandidate.height()) return true;
-                if(newCandidate.height()  < listCandidate.height()) return false;
-
-                break;
-            }
-            case RNS_KEY_Up:
-            case RNS_KEY_Down: {
-                // Rule 5.
-                if(direction_ == RNS_KEY_Up) {
-                    if(listCandidate.bottom() > newCandidate.bottom()) return true;
-                    if(newCandidate.bottom()  > listCandidate.bottom()) return false;
-                } else {
-                    if(listCandidate.top() < newCandidate.top()) return true;
-                    if(newCandidate.top()  < listCandidate.top()) return false;
-                }
-                // Rule 6.
-                if(listCandidate.left() < newCandidate.left()) return true;
-                if(newCandidate.left() < listCandidate.left()) return false;
-                // Rule 7.
-                if(listCandidate.height() < newCandidate.height()) return true;
-                if(newCandidate.height()  < listCandidate.height()) return false;
-                // Rule 8
-                if(listCandidate.width() < newCandidate.width()) return true;
-                if(newCandidate.width()  < listCandidate.width()) return false;
-
-                break;
-            }
-            default:
-                break;
-        }
-        return false;
-    }
-    int direction_ = 0;
-};
-
-RSkComponent* RSkSpatialNavigator::pickCandidateInDirection(rnsKey keyEvent,
-                                            SortedCandidateList<RSkComponent>& overLapping,
-                                            SortedCandidateList<RSkComponent>& nonOverLapping) {
-
-#if defined(THIS_IS_NOT_DEFINED) && (!defined(GOOGLE_STRIP_LOG) || (GOOGLE_STRIP_LOG <= INFO))
-    for (auto candidate = overLapping.begin(); candidate != overLapping.end(); candidate++) {
-        RNS_LOG_INFO("OverLapping Tag[" << (*candidate)->getComponentData().tag << "] I[" <<
-                        (*candidate)->getScreenFrame().left() << " " <<
-                        (*candidate)->getScreenFrame().top() << " " <<
-                        (*candidate)->getScreenFrame().right() << " " <<
-                        (*candidate)->getScreenFrame().bottom() << "]");
-    }
-    for (auto candidate = nonOverLapping.begin(); candidate != nonOverLapping.end(); candidate++) {
-        RNS_LOG_INFO("NonOverLapping Tag[" << (*candidate)->getComponentData().tag << "] I[" <<
-                        (*candidate)->getScreenFrame().left() << " " <<
-                        (*candidate)->getScreenFrame().top() << " " <<
-                        (*candidate)->getScreenFrame().right() << " " <<
-                        (*candidate)->getScreenFrame().bottom() << "]");
-    }
-#endif
-
-    RSkComponent* nextFocus = nullptr;
-    // Rule 8. By default choose the first one from sorted overLapping set.
-    if(overLapping.size() != 0) {
-        auto front = overLapping.begin();
-        nextFocus = *front;
-    }
-
-    // Rule 9. If moving in Up or Down navigation, then check if nonOevrLapping is empty. If not,
-    // then choose the closest one between first candidate from both the list.
-    if((keyEvent == RNS_KEY_Up || keyEvent == RNS_KEY_Down) && nonOverLapping.size() != 0) {
-        auto front = nonOverLapping.begin();
-        if(nextFocus) {
-            if(keyEvent == RNS_KEY_Up) {
-                if(nextFocus->getScreenFrame().bottom() < (*front)->getScreenFrame().bottom())
-                    nextFocus = *front;
-            } else if(keyEvent == RNS_KEY_Down) {
-                if(nextFocus->getScreenFrame().top() > (*front)->getScreenFrame().top())
-                    nextFocus = *front;
-            }
-        } else { // OverLapping set was empty, nothing to compare.
-            nextFocus = *front;
-        }
-    }
-    // By now we have either have a  valid nextFocus candidate or there is no valid candidate to focus in the direction
-    if(nextFocus && nextFocus->getComponentData().tag == -1)
-        nextFocus = nullptr;
-
-    return nextFocus;
-}
-
-static inline bool isValidCandidate(rnsKey direction, RSkComponent *currentItem, RSkComponent *candidateItem) {
-
-    if(!currentItem || !candidateItem)
-        return false;
-
-    const SkIRect current = currentItem->getScreenFrame();
-    const SkIRect candidate = candidateItem->getScreenFrame();
-
-    // Rule 1. If the candidate has same dimention as the current focussed item then ignore.
-    if (candidate == current) {
-        RNS_LOG_DEBUG("Skip the candiate which has same dimension(x,y,w,h)");
-        return false;
-    }
-
-#if 0 // Android is not handling this scenario , so we can disable this code for now to avoid this extra check overhead.
-    // Rule 1.a If the candidte is completely inside the current focussed element and if it is below (not visible) then ignore it.
-    if(candidate.left() >= current.left() &&
-        candidate.right() <= current.right() &&
-        candidate.top() >= current.top() &&
-        candidate.bottom() <= current.bottom() &&
-        candidateItem->getComponentData().commonProps.zIndex <= currentItem->getComponentData().commonProps.zIndex &&
-        candidateItem->getComponentData().tag < currentItem->getComponentData().tag) {
-            return false;
-    }
-#endif
-
-    // Rule 2. Candidate must be in the direction of navigation.
-    switch(direction) {
-        case RNS_KEY_Right:
-            return (candidate.left() > current.left()); // Must be on right side
-        case RNS_KEY_Left:
-            return(candidate.right() < current.right()); // Must be on left side
-        case RNS_KEY_Up:
-            return (candidate.bottom() < current.bottom()); // Must be on up side
-        case RNS_KEY_Down:
-            return(candidate.top() > current.top()); // Must be on down side
-        default:
-            RNS_LOG_WARN("Inavlid diretion Navigation : " << RNSKeyMap[direction]);
-            break;
-    }
-    return false;
-}
-
 RSkComponent* RSkSpatialNavigator::findDefaultFocusInContainer(Container *container) {
     RSkComponent *nextFocus = nullptr;
     std::vector<RSkComponent*>::reverse_iterator i;
@@ -302,69 +183,25 @@ RSkComponent* RSkSpatialNavigator::findFocusCandidateInContainer(Container *cont
     RNS_LOG_DEBUG("Current Focus Tag[" << curData.tag << "] I[" <<
                     currentRect.left() << " " << currentRect.top() << " " << currentRect.right() << " " << currentRect.bottom() << "]");
 
-    // Sorted set which will use sortDirectionComparator to sort while inserting the elements
-    SortedCandidateList<RSkComponent> overLapping(keyEvent);
-    SortedCandidateList<RSkComponent> nonOverLapping(keyEvent);
-
-    CandidateList &navComponentList = container->navigationCandidates();
-
-    for (auto candidate = navComponentList.begin(); candidate != navComponentList.end(); candidate++) {
-        Component canData = (*candidate)->getComponentData();
-        const SkIRect candidateRect = (*candidate)->getScreenFrame();
-
-        RNS_LOG_DEBUG("Possible Candidate Tag[" << canData.tag << "] I[" <<
-                    candidateRect.left() << " " << candidateRect.top() << " " << candidateRect.right() << " " << candidateRect.bottom() << "]");
-
-        if (*candidate == currentFocus_) {
+    // Container keeps its candidates sorted in each direction by the scoring rules (see CandidateIndex),
+    // so only the candidates between the current focus and the nearest one are visited.
+    RSkComponent* nextFocus = container->findNearestCandidate(keyEvent, currentRect, [this, container, visibleOnly](RSkComponent* candidate) {
+        if (candidate == currentFocus_) {
             RNS_LOG_DEBUG("Skip the current focused item");
-            continue;
+            return false;
         }
-        if(visibleOnly && !container->isVisible((*candidate))) {
+        if(visibleOnly && !container->isVisible(candidate)) {
             RNS_LOG_DEBUG("Skip the offView candidates in this container");
-            continue;
+            return false;
         }
-        if (!isValidCandidate(keyEvent, currentFocus_, (*candidate)))
-            continue;
-
-        switch(keyEvent) {
-            case RNS_KEY_Right:
-            case RNS_KEY_Left: {
-                // Rule 3. Must have Projected overlap in Eastern/Western region
-                if(!( candidateRect.bottom() < currentRect.top()
-                    || candidateRect.top() > currentRect.bottom())) {
-                        RNS_LOG_DEBUG("Add Tag[ " << canData.tag << " ] to overlaping list for " << RNSKeyMap[keyEvent] << " direction");
-                        overLapping.insert(*candidate); // Sorted using sortDirectionComparator
-                } // For Right and left navigation we consider only candiates which has projected overalp
-                break;
-            }
-            case RNS_KEY_Up:
-            case RNS_KEY_Down: {
-                // Rule 3. Has either Projected overlap or nonOverlap in Northern/Southern region
-                if(!( candidateRect.right() < currentRect.left()
-                    || candidateRect.left() > currentRect.right())) {
-                        RNS_LOG_DEBUG("Add Tag[ " << canData.tag << " ] to overlaping list for " << RNSKeyMap[keyEvent] << " direction");
-                        overLapping.insert(*candidate); // Sorted using sortDirectionComparator
-                } else {
-                    // Rule 3.a For non-overlap, for up direction, only consider the candidates which is completely above current focussed item and
-                    // for down direction, only consider the candidates which is completely below current focussed item
-                    if(keyEvent == RNS_KEY_Up && candidateRect.bottom() <= currentRect.top()) {
-                        RNS_LOG_DEBUG("Add Tag[ " << canData.tag << " ] to nonOverlaping list for " << RNSKeyMap[keyEvent] << " direction");
-                        nonOverLapping.insert(*candidate); // Sorted using sortDirectionComparator
-                    } else if(keyEvent == RNS_KEY_Down && candidateRect.top() >= currentRect.bottom()) {
-                        RNS_LOG_DEBUG("Add Tag[ " << canData.tag << " ] to nonOverlaping list for " << RNSKeyMap[keyEvent] << " direction");
-                        nonOverLapping.insert(*candidate); // Sorted using sortDirectionComparator
-                    }
-                }
-                break;
-            }
-            default:
-                break;
-        } // switch
-    } // for loop
-
-    // By now we have two sorted set where the top most element in the set is the right candidate to navigate in respective set.
-    // Choose right candidate between top most element from overLapping and nonOverLapping set
-    return pickCandidateInDirection(keyEvent, overLapping, nonOverLapping);
+        return true;
+    });
+
+    // By now we have either have a  valid nextFocus candidate or there is no valid candidate to focus in the direction
+    if(nextFocus && nextFocus->getComponentData().tag == -1)
+        nextFocus = nullptr;
+
+    return nextFocus;
 }
 
 bool RSkSpatialNavigator::advanceFocusInDirection(Container *container, rnsKey keyEvent) {
@@ -381,8 +218,14 @@ bool RSkSpatialNavigator::advanceFocusInDirection(Container *container, rnsKey k
     visibleOnly = (containerIsCurrentFocusAncestor && container->canScrollInDirection(keyEvent)) ? false : true;
   }
 
-  // Find candidate to focus in given direction using spatial navigation algorithm
-  focusCandidate = findFocusCandidateInContainer(container, keyEvent, visibleOnly);
+  // Find candidate to focus in given direction using spatial navigation algorithm, unless predicted for the current focus
+  int direction = predictionIndex(keyEvent);
+  if(direction >= 0 && isPredictionValid(container)) {
+    focusCandidate = prediction_.neighbours[direction];
+    RNS_LOG_DEBUG("Predicted candidate used : " << (focusCandidate ? focusCandidate->getComponentData().tag : -1));
+  } else {
+    focusCandidate = findFocusCandidateInContainer(container, keyEvent, visibleOnly);
+  }
 
   if(focusCandidate == nullptr) {
     RNS_LOG_DEBUG("No " << (visibleOnly ? "visible " : "") << "focusable candidate found in this container" <<
@@ -414,49 +257,52 @@ bool RSkSpatialNavigator::advanceFocusInDirection(Container *container, rnsKey k
   }
 
   // Focus the candidate and update the spatial navigator states
-  updateFocusCandidate(focusCandidate);
+  setFocusCandidate(focusCandidate, false);
   return true;
 }
 
 #if defined(TARGET_OS_TV) && TARGET_OS_TV
+int RSkSpatialNavigator::nextFocusTag(rnsKey keyEvent){
+  if(currentFocus_ == nullptr)
+    return -1;
+  Component candidateData = currentFocus_->getComponentData();
+  if(!strcmp(candidateData.componentName, "Rootview"))
+    return -1;
+  auto const &componentProps = *std::static_pointer_cast<ViewProps const>(candidateData.props);
+
+  RNS_LOG_DEBUG(candidateData.componentName << "] componentProps[Up,Down,Left,Right] : " <<
+    componentProps.nextFocusUp << "," <<
+    componentProps.nextFocusDown << "," <<
+    componentProps.nextFocusLeft << "," <<
+    componentProps.nextFocusRight);
+
+  switch(keyEvent) {
+    case RNS_KEY_Up:
+      return (componentProps.nextFocusUp > 0) ? componentProps.nextFocusUp : -1;
+    case RNS_KEY_Down:
+      return (componentProps.nextFocusDown > 0) ? componentProps.nextFocusDown : -1;
+    case RNS_KEY_Left:
+      return (componentProps.nextFocusLeft > 0) ? componentProps.nextFocusLeft : -1;
+    case RNS_KEY_Right:
+      return (componentProps.nextFocusRight > 0) ? componentProps.nextFocusRight : -1;
+    default:
+      return -1;
+  }
+}
+
 bool RSkSpatialNavigator::hasNextFocusProperty(rnsKey keyEvent){
+  if(ReactSkiaApp::currentBridge() == nullptr)
+    return false;
   xplat::uimanager::UimanagerModule* uiManagerModule = static_cast<xplat::uimanager::UimanagerModule*>(ReactSkiaApp::currentBridge()->moduleForName("UIManager"));
-  if(currentFocus_ && uiManagerModule) {
-    Component candidateData = currentFocus_->getComponentData();
-    if(strcmp(candidateData.componentName, "Rootview")) {
-      auto const &componentProps = *std::static_pointer_cast<ViewProps const>(candidateData.props);
-      int nextFocusTag = -1;
-
-      RNS_LOG_DEBUG(candidateData.componentName << "] componentProps[Up,Down,Left,Right] : " <<
-        componentProps.nextFocusUp << "," <<
-        componentProps.nextFocusDown << "," <<
-        componentProps.nextFocusLeft << "," <<
-        componentProps.nextFocusRight);
-
-      switch(keyEvent) {
-        case RNS_KEY_Up:
-          if(componentProps.nextFocusUp > 0) nextFocusTag = componentProps.nextFocusUp;
-          break;
-        case RNS_KEY_Down:
-          if(componentProps.nextFocusDown > 0) nextFocusTag = componentProps.nextFocusDown;
-          break;
-        case RNS_KEY_Left:
-          if(componentProps.nextFocusLeft > 0) nextFocusTag = componentProps.nextFocusLeft;
-          break;
-        case RNS_KEY_Right:
-          if(componentProps.nextFocusRight > 0) nextFocusTag = componentProps.nextFocusRight;
-          break;
-        default:
-          return false;
-      }
-      if(nextFocusTag > 0) {
-        std::shared_ptr<RSkComponent> nextFocus = uiManagerModule->getComponentForReactTag(nextFocusTag);
-        RNS_LOG_DEBUG("nextFocus Tag[" << nextFocusTag << "] == [" << (nextFocus ? nextFocus->getComponentData().tag: -1) << "]");
-        if(nextFocus) {
-          updateFocusCandidate(nextFocus.get());
-          return true;
-        }
-      }
+  if(uiManagerModule == nullptr)
+    return false;
+  int tag = nextFocusTag(keyEvent);
+  if(tag > 0) {
+    std::shared_ptr<RSkComponent> nextFocus = uiManagerModule->getComponentForReactTag(tag);
+    RNS_LOG_DEBUG("nextFocus Tag[" << tag << "] == [" << (nextFocus ? nextFocus->getComponentData().tag: -1) << "]");
+    if(nextFocus) {
+      setFocusCandidate(nextFocus.get(), false);
+      return true;
     }
   }
   return false;
@@ -464,6 +310,11 @@ bool RSkSpatialNavigator::hasNextFocusProperty(rnsKey keyEvent){
 #endif //TARGET_OS_TV
 
 void RSkSpatialNavigator::updateFocusCandidate(RSkComponent* focusCandidate, bool needScroll){
+  NavigationLock lock(*this);
+  setFocusCandidate(focusCandidate, needScroll);
+}
+
+void RSkSpatialNavigator::setFocusCandidate(RSkComponent* focusCandidate, bool needScroll){
 #if defined(TARGET_OS_TV) && TARGET_OS_TV
   if( !focusCandidate || (currentFocus_ == focusCandidate))
     return ;
@@ -483,7 +334,58 @@ void RSkSpatialNavigator::updateFocusCandidate(RSkComponent* focusCandidate, boo
   }
 }
 
-void RSkSpatialNavigator::navigateInDirection(rnsKey keyEvent) {
+void RSkSpatialNavigator::navigateInDirection(rnsKey keyEvent, unsigned int moveCount) {
+  while(moveCount > 0) {
+    unsigned int moved = (moveCount > 1) ? moveFocusInContainer(keyEvent, moveCount) : 0;
+    if(moved == 0) { // Move needs the complete navigation : nextFocus property, change of container or scroll without focus
+      navigateOnceInDirection(keyEvent);
+      moved = 1;
+    }
+    moveCount -= moved;
+  }
+}
+
+unsigned int RSkSpatialNavigator::moveFocusInContainer(rnsKey keyEvent, unsigned int moveCount) {
+  // Steps through the candidates of the current container without notifying or scrolling to the intermediate ones,
+  // then scrolls to & focuses the last one. Stops where a step would leave the container or enter a nested one.
+  Container *container = currentContainer_;
+  if(currentFocus_ == nullptr || container == nullptr || currentFocus_->isContainer())
+    return 0;
+
+  RSkComponent *previousFocus = currentFocus_;
+  bool visibleOnly = !container->canScrollInDirection(keyEvent);
+  int direction = predictionIndex(keyEvent);
+  unsigned int moved = 0;
+
+  for(; moved < moveCount; moved++) {
+#if defined(TARGET_OS_TV) && TARGET_OS_TV
+    if(nextFocusTag(keyEvent) > 0)
+      break;
+#endif //TARGET_OS_TV
+    RSkComponent *candidate = (direction >= 0 && isPredictionValid(container)) ?
+                                prediction_.neighbours[direction] : findFocusCandidateInContainer(container, keyEvent, visibleOnly);
+    if(candidate == nullptr || candidate->isContainer())
+      break;
+    currentFocus_ = candidate;
+  }
+  RSkComponent *nextFocus = currentFocus_;
+  currentFocus_ = previousFocus;
+  if(moved == 0)
+    return 0;
+
+  RNS_LOG_DEBUG("Moved " << moved << " of " << moveCount << " step(s) in container " << container);
+  if(!container->isVisible(nextFocus))
+    container->scrollTo(nextFocus);
+  setFocusCandidate(nextFocus, false);
+  return moved;
+}
+
+void RSkSpatialNavigator::navigateOnceInDirection(rnsKey keyEvent) {
+
+#if defined(TARGET_OS_TV) && TARGET_OS_TV
+  if(hasNextFocusProperty(keyEvent))
+    return;
+#endif //TARGET_OS_TV
 
   if(currentContainer_ == nullptr)
       currentContainer_ = rootContainer_;
@@ -498,23 +400,22 @@ void RSkSpatialNavigator::navigateInDirection(rnsKey keyEvent) {
 
 }
 
-void RSkSpatialNavigator::handleKeyEvent(rnsKey  eventKeyType, rnsKeyAction eventKeyAction) {
+void RSkSpatialNavigator::handleKeyEvent(rnsKey  eventKeyType, rnsKeyAction eventKeyAction, unsigned int moveCount) {
 
     if(eventKeyAction != RNS_KEY_Press) // Need to act on keyPress only
         return;
 
-#if defined(TARGET_OS_TV) && TARGET_OS_TV
-    if(hasNextFocusProperty(eventKeyType))
-        return;
-#endif //TARGET_OS_TV
-
     // Then based on spatial navigation alogirthm, send blur/focus
     switch(eventKeyType) {
         case RNS_KEY_Up:
         case RNS_KEY_Down:
         case RNS_KEY_Left:
         case RNS_KEY_Right:{
-            RNS_PROFILE_API_OFF("NavigateInDirection : ", navigateInDirection(eventKeyType));
+            {
+              NavigationLock lock(*this);
+              RNS_PROFILE_API_OFF("NavigateInDirection : ", navigateInDirection(eventKeyType, moveCount));
+            }
+            scheduleFocusPrediction();
             break;
         }
         default:
@@ -522,7 +423,48 @@ void RSkSpatialNavigator::handleKeyEvent(rnsKey  eventKeyType, rnsKeyAction even
     }
 }
 
+bool RSkSpatialNavigator::isPredictionValid(Container *container) {
+    return (currentFocus_ && prediction_.focus == currentFocus_ && prediction_.container == container &&
+            prediction_.candidateListGeneration == CandidateIndex::candidateListGeneration() &&
+            prediction_.layoutGeneration == RnsShell::Layer::absoluteFrameGeneration() &&
+            prediction_.scrollGeneration == RnsShell::ScrollLayer::scrollPositionGeneration());
+}
+
+void RSkSpatialNavigator::scheduleFocusPrediction() {
+    {
+        std::scoped_lock lock(navigationMutex_);
+        if(predictionScheduled_)
+            return;
+        predictionScheduled_ = true;
+    }
+    RnsShell::TaskLoop::main().scheduleDispatch([this]() {
+        NavigationLock lock(*this, NavigationLock::ReadOnly); // Layout & scroll positions are read, nothing to render
+        predictionScheduled_ = false;
+        predictNeighbours();
+    }, FOCUS_PREDICTION_DELAY_MS);
+}
+
+void RSkSpatialNavigator::predictNeighbours() {
+    // Same search as the first step of navigateInDirection, so the next key press in any direction picks the result directly
+    Container *container = currentContainer_;
+    if(!currentFocus_ || !container || isPredictionValid(container))
+        return;
+
+    prediction_.focus = currentFocus_;
+    prediction_.container = container;
+    prediction_.candidateListGeneration = CandidateIndex::candidateListGeneration();
+    prediction_.layoutGeneration = RnsShell::Layer::absoluteFrameGeneration();
+    prediction_.scrollGeneration = RnsShell::ScrollLayer::scrollPositionGeneration();
+    for(rnsKey direction : {RNS_KEY_Up, RNS_KEY_Down, RNS_KEY_Left, RNS_KEY_Right}) {
+        // Current container is always an ancestor of the current focus, or the focus itself
+        bool visibleOnly = !container->canScrollInDirection(direction);
+        prediction_.neighbours[predictionIndex(direction)] = findFocusCandidateInContainer(container, direction, visibleOnly);
+    }
+    RNS_LOG_DEBUG("Predicted neighbours of Tag[" << currentFocus_->getComponentData().tag << "]");
+}
+
 RSkComponent* RSkSpatialNavigator::getCurrentFocusElement(){
+    std::scoped_lock lock(navigationMutex_);
     return currentFocus_;
 }
 
@@ -11,21 +11,16 @@
 #include <stdint.h>
 #include <array>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
 
-#include <folly/small_vector.h>
-#include <folly/sorted_vector_types.h>
-
 #include "ReactSkia/utils/RnsLog.h"
 #include "ReactSkia/utils/RnsUtils.h"
 #include "ReactSkia/sdk/NotificationCenter.h"
 #include "ReactSkia/sdk/RNSKeyCodeMapping.h"
 
-using folly::sorted_vector_map;
-using folly::sorted_vector_set;
-
 namespace facebook{
 namespace react {
 
@@ -35,11 +30,6 @@ namespace SpatialNavigator {
 
 typedef std::vector<RSkComponent *> CandidateList;
 
-template <class T>
-struct sortDirectionComparator;
-template <class T>
-using SortedCandidateList = sorted_vector_set<T*, sortDirectionComparator<T*>>;
-
 enum NavigatorStateOperation {
     ComponentAdded = 1,
     ComponentRemoved,
@@ -73,13 +63,43 @@ private:
     Container *rootContainer_{nullptr};
     Container *currentContainer_{nullptr};
 
-    void navigateInDirection(rnsKey keyEvent);
+    // Neighbours of the current focus in its container, computed once the focus has settled.
+    // Valid till the focus, candidates, layout or any scroll position changes.
+    // Only the candidate search is done ahead : focus appearance is drawn by the app from the focus & blur
+    // events, so there is no native focused / blurred picture of the neighbours to record in advance, and
+    // scrolling still starts once the new focus is chosen, not on the key press itself.
+    // Prediction only reads the tree, it never commits a frame.
+    struct FocusPrediction {
+        RSkComponent *focus{nullptr};
+        Container *container{nullptr};
+        uint64_t candidateListGeneration{0};
+        uint64_t layoutGeneration{0};
+        uint64_t scrollGeneration{0};
+        std::array<RSkComponent*, 4> neighbours; // Up, Down, Left & Right
+    };
+    FocusPrediction prediction_;
+    // Guards the focus, prediction & candidate lists of the containers. Key navigation, prediction & mounting
+    // run on different threads. Recursive, as focus & blur handlers of the components update the focus again.
+    std::recursive_mutex navigationMutex_;
+    bool predictionScheduled_{false};
+
+    class NavigationLock; // Locks the layer tree, then navigationMutex_
+
+    void setFocusCandidate(RSkComponent *focusCandidate, bool needScroll);
+
+    void scheduleFocusPrediction();
+    void predictNeighbours();
+    bool isPredictionValid(Container *container);
+
+    void navigateInDirection(rnsKey keyEvent, unsigned int moveCount);
+    void navigateOnceInDirection(rnsKey keyEvent);
+    unsigned int moveFocusInContainer(rnsKey keyEvent, unsigned int moveCount);
     bool advanceFocusInDirection(Container *container, rnsKey keyEvent);
 #if defined(TARGET_OS_TV) && TARGET_OS_TV
+    int nextFocusTag(rnsKey keyEvent);
     bool hasNextFocusProperty(rnsKey keyEvent);
 #endif
     RSkComponent* findFocusCandidateInContainer(Container *container, rnsKey keyEvent, bool visibleOnly);
-    RSkComponent* pickCandidateInDirection(rnsKey keyEvent, SortedCandidateList<RSkComponent>& overLapping, SortedCandidateList<RSkComponent>& nonOverLapping);
     RSkComponent* findDefaultFocusInContainer(Container *container);
     void sendNotificationWithEventType(std::string eventType, int tag, NotificationCompleteVoidCallback completeCB = nullptr);
 #if ENABLE(FEATURE_KEY_THROTTLING)
@@ -93,10 +113,13 @@ public:
     void updateFocusCandidate(RSkComponent *focusCandidate, bool needScroll=false);
     void updateSpatialNavigatorState(NavigatorStateOperation operation, RSkComponent *candidate);
 
-    void handleKeyEvent(rnsKey  eventType, rnsKeyAction eventKeyAction);
+    // moveCount > 1 for the coalesced auto repeats, applied in one pass with a single blur/focus
+    void handleKeyEvent(rnsKey  eventType, rnsKeyAction eventKeyAction, unsigned int moveCount = 1);
     RSkComponent* getCurrentFocusElement();
 
     void setRootContainer(Container *container) { rootContainer_ = container; }
+    // Held by the containers while their candidate lists are updated or searched
+    std::recursive_mutex& navigationMutex() { return navigationMutex_; }
 };
 
 }// namespace SpatialNavigator
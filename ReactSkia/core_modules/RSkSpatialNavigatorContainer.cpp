@@ -13,8 +13,15 @@ namespace facebook{
 namespace react {
 namespace SpatialNavigator {
 
+// Candidate lists are updated by the mounting & searched by the key navigation, on different threads
+static inline std::recursive_mutex& candidateListMutex() {
+  return RSkSpatialNavigator::sharedSpatialNavigator()->navigationMutex();
+}
+
 void Container::addComponent(RSkComponent *newCandidate) {
+  std::scoped_lock lock(candidateListMutex());
   navComponentList_.push_back(newCandidate);
+  candidateIndex_.invalidate();
   RSkSpatialNavigator::sharedSpatialNavigator()->updateSpatialNavigatorState(ComponentAdded, newCandidate);
 #if  (!defined(GOOGLE_STRIP_LOG) || (GOOGLE_STRIP_LOG <= INFO))
   auto containerCandidate = static_cast<RSkComponent*>(this);
@@ -24,7 +31,9 @@ void Container::addComponent(RSkComponent *newCandidate) {
 }
 
 void Container::mergeComponent(CandidateList candidates) {
+  std::scoped_lock lock(candidateListMutex());
   navComponentList_.insert(navComponentList_.end(), candidates.begin(), candidates.end());
+  candidateIndex_.invalidate();
 
 #if  (!defined(GOOGLE_STRIP_LOG) || (GOOGLE_STRIP_LOG <= INFO))
   auto containerCandidate = static_cast<RSkComponent*>(this);
@@ -46,16 +55,20 @@ void Container::mergeComponent(CandidateList candidates) {
 void Container::removeComponent(RSkComponent *candidate) {
   CandidateList::iterator it;
 
+  std::scoped_lock lock(candidateListMutex());
   it = std::find(navComponentList_.begin(), navComponentList_.end(), candidate);
   if (it != navComponentList_.end()) {
     RSkSpatialNavigator::sharedSpatialNavigator()->updateSpatialNavigatorState(ComponentRemoved, candidate);
     navComponentList_.erase(it);
+    candidateIndex_.invalidate();
   }
 }
 
 void Container::updateComponent(RSkComponent *candidate) {
     CandidateList::iterator it;
+    std::scoped_lock lock(candidateListMutex());
     it = std::find(navComponentList_.begin(), navComponentList_.end(), candidate);
+    candidateIndex_.invalidate(); // zIndex may have changed
 
     if (it != navComponentList_.end()) {
         // Candidate found in the navigatable list but candidate's focusable props have changed.
@@ -70,8 +83,25 @@ void Container::updateComponent(RSkComponent *candidate) {
     }
 }
 
+RSkComponent* Container::findNearestCandidate(rnsKey direction, const SkIRect& referenceScreenFrame, CandidateIndex::CandidateFilter filter) {
+  std::scoped_lock lock(candidateListMutex());
+  return candidateIndex_.findNearest(navComponentList_, direction, toLayerSpace(referenceScreenFrame), filter);
+}
+
+SkIRect Container::toLayerSpace(const SkIRect& screenFrame) {
+  if(!isScrollable())
+    return screenFrame;
+  SkIRect containerScreenFrame = static_cast<RSkComponent*>(this)->getScreenFrame();
+  SkPoint containerScrollOffset = getScrollOffset();
+  return screenFrame.makeOffset(-containerScreenFrame.x(),
+                                -containerScreenFrame.y()).makeOffset(
+                                 containerScrollOffset.x(),
+                                 containerScrollOffset.y());
+}
+
 RSkComponent* Container::firstInContainer(bool visible, bool skipChildren) {
 
+  std::scoped_lock lock(candidateListMutex());
   if(navComponentList_.size() == 0)
     return nullptr;
 
@@ -98,6 +128,7 @@ RSkComponent* Container::firstInContainer(bool visible, bool skipChildren) {
 RSkComponent* Container::preferredFocusInContainer() {
   RSkComponent *preferredFocus = nullptr;
   std::vector<RSkComponent*>::reverse_iterator i;
+  std::scoped_lock lock(candidateListMutex());
   CandidateList &navCompList = navComponentList_;
 
   for (i = navCompList.rbegin(); i != navCompList.rend(); ++i ) {
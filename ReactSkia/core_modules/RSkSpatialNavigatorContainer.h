@@ -10,6 +10,7 @@
 #include "include/core/SkPoint.h"
 
 #include "RSkSpatialNavigator.h"
+#include "RSkSpatialNavigatorIndex.h"
 
 using namespace facebook::react;
 
@@ -29,6 +30,7 @@ private:
 protected:
   // List of Navigatable Components in the container
   CandidateList navComponentList_;
+  CandidateIndex candidateIndex_;
 
 public:
   friend class RSkComponent;
@@ -48,6 +50,10 @@ public:
   void updateComponent(RSkComponent *candidate);
 
   CandidateList& navigationCandidates() { return navComponentList_; }
+  // Nearest candidate of this container from the reference screen frame in the direction
+  RSkComponent* findNearestCandidate(rnsKey direction, const SkIRect& referenceScreenFrame, CandidateIndex::CandidateFilter filter);
+  // Maps a screen frame to the layer space of this container's candidates, inverse of RSkComponent::getScreenFrame
+  SkIRect toLayerSpace(const SkIRect& screenFrame);
 
   RSkComponent* firstInContainer(bool visible = true, bool skipChildren = false);
 #if defined(TARGET_OS_TV) && TARGET_OS_TV
@@ -0,0 +1,202 @@
+/*
+* Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+*
+* Use of this source code is governed by a BSD-style license that can be
+* found in the LICENSE file.
+*/
+
+#include <algorithm>
+
+#include "RSkSpatialNavigatorIndex.h"
+#include "ReactSkia/components/RSkComponent.h"
+
+namespace facebook{
+namespace react {
+namespace SpatialNavigator {
+
+std::atomic<uint64_t> CandidateIndex::candidateListGeneration_(0);
+
+static inline int directionIndex(rnsKey direction) {
+    switch(direction) {
+        case RNS_KEY_Up: return 0;
+        case RNS_KEY_Down: return 1;
+        case RNS_KEY_Left: return 2;
+        case RNS_KEY_Right: return 3;
+        default: return -1;
+    }
+}
+
+// Distance key of Rule 5, candidates are sorted on it first
+static inline int32_t primaryKey(rnsKey direction, const SkIRect& frame) {
+    switch(direction) {
+        case RNS_KEY_Up: return frame.bottom();
+        case RNS_KEY_Down: return frame.top();
+        case RNS_KEY_Left: return frame.right();
+        default: return frame.left();
+    }
+}
+
+// (Item1, Item2) returning true means Item1 is a better candidate than Item2 in the direction
+bool CandidateIndex::isBefore(rnsKey direction, const Entry& listItem, const Entry& newItem) {
+    const SkIRect &listCandidate = listItem.frame;
+    const SkIRect &newCandidate = newItem.frame;
+
+    // Rule 4. If both candidates are having same dimension (x,y,w,h) then select the one with higher zIndex, else higher tag if zIndex is same
+    if(listCandidate == newCandidate) {
+        if(listItem.zIndex > newItem.zIndex) return true;
+        if(newItem.zIndex > listItem.zIndex) return false;
+        // Last Resort. If both have same zIndex then items with bigger Tag will have more priority (Last added items will always have bigger tags)
+        return listItem.tag > newItem.tag;
+    }
+    // Based on dircection following 4 rules apply.
+    // Rule 5. Select the Closest candidate in the requested direction.
+    // Rule 6. If both candidates have same distance, then select Lower one for Left/Right direction and Left Most for Up/Down direction
+    // Rule 7. If both candidates have same value in Rule 6, then select the one with lower width for Left/Right direction and lower height for Up/Down
+    // Rule 8. If both candidates have same value in Rule 7, then select the one with lower height for Left/Right direction and lower width for Up/Down
+    switch(direction) {
+        case RNS_KEY_Right:
+        case RNS_KEY_Left: {
+            // Rule 5.
+            if(direction == RNS_KEY_Right) {
+                if(listCandidate.left() < newCandidate.left()) return true;
+                if(newCandidate.left()  < listCandidate.left()) return false;
+            } else {
+                if(listCandidate.right() > newCandidate.right()) return true;
+                if(newCandidate.right()  > listCandidate.right()) return false;
+            }
+            // Rule 6.
+            if(listCandidate.top() < newCandidate.top()) return true;
+            if(newCandidate.top()  < listCandidate.top()) return false;
+            // Rule 7.
+            if(listCandidate.width() < newCandidate.width()) return true;
+            if(newCandidate.width()  < listCandidate.width()) return false;
+            // Rule 8
+            if(listCandidate.height() < newCandidate.height()) return true;
+            if(newCandidate.height()  < listCandidate.height()) return false;
+            break;
+        }
+        case RNS_KEY_Up:
+        case RNS_KEY_Down: {
+            // Rule 5.
+            if(direction == RNS_KEY_Up) {
+                if(listCandidate.bottom() > newCandidate.bottom()) return true;
+                if(newCandidate.bottom()  > listCandidate.bottom()) return false;
+            } else {
+                if(listCandidate.top() < newCandidate.top()) return true;
+                if(newCandidate.top()  < listCandidate.top()) return false;
+            }
+            // Rule 6.
+            if(listCandidate.left() < newCandidate.left()) return true;
+            if(newCandidate.left() < listCandidate.left()) return false;
+            // Rule 7.
+            if(listCandidate.height() < newCandidate.height()) return true;
+            if(newCandidate.height()  < listCandidate.height()) return false;
+            // Rule 8
+            if(listCandidate.width() < newCandidate.width()) return true;
+            if(newCandidate.width()  < listCandidate.width()) return false;
+            break;
+        }
+        default:
+            break;
+    }
+    return false;
+}
+
+void CandidateIndex::invalidate() {
+    isDirty_ = true;
+    candidateListGeneration_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void CandidateIndex::updateIfNeeded(CandidateList& candidates) {
+    uint64_t layoutGeneration = RnsShell::Layer::absoluteFrameGeneration();
+    if(!isDirty_ && layoutGeneration == layoutGeneration_)
+        return;
+
+    bool needsSort = isDirty_;
+    if(isDirty_) {
+        entries_.clear();
+        entries_.reserve(candidates.size());
+        for(auto candidate : candidates) {
+            Component candidateData = candidate->getComponentData();
+            entries_.push_back({candidate, candidate->getLayerAbsoluteFrame(), candidateData.commonProps.zIndex, candidateData.tag});
+        }
+    } else {
+        // Some layer has moved, order is rebuilt only if it was one of the candidates
+        for(auto &entry : entries_) {
+            const SkIRect &frame = entry.candidate->getLayerAbsoluteFrame();
+            if(frame != entry.frame) {
+                entry.frame = frame;
+                needsSort = true;
+            }
+        }
+    }
+    if(needsSort) {
+        for(rnsKey direction : {RNS_KEY_Up, RNS_KEY_Down, RNS_KEY_Left, RNS_KEY_Right}) {
+            auto &sortedEntries = sortedEntries_[directionIndex(direction)];
+            sortedEntries = entries_;
+            std::sort(sortedEntries.begin(), sortedEntries.end(), [direction](const Entry& item1, const Entry& item2) {
+                return isBefore(direction, item1, item2);
+            });
+        }
+        RNS_LOG_DEBUG("Rebuilt navigation index of " << entries_.size() << " candidate(s)");
+    }
+    isDirty_ = false;
+    layoutGeneration_ = layoutGeneration;
+}
+
+RSkComponent* CandidateIndex::findNearest(CandidateList& candidates, rnsKey direction, const SkIRect& referenceFrame, CandidateFilter filter) {
+    int index = directionIndex(direction);
+    if(index < 0) {
+        RNS_LOG_WARN("Inavlid diretion Navigation : " << RNSKeyMap[direction]);
+        return nullptr;
+    }
+    updateIfNeeded(candidates);
+    auto &sortedEntries = sortedEntries_[index];
+
+    // Rule 2. Candidate must be in the direction of navigation, sorted entries before this point are not.
+    int32_t referenceKey = primaryKey(direction, referenceFrame);
+    auto first = std::partition_point(sortedEntries.begin(), sortedEntries.end(), [direction, referenceKey](const Entry& entry) {
+        int32_t key = primaryKey(direction, entry.frame);
+        return (direction == RNS_KEY_Right || direction == RNS_KEY_Down) ? (key <= referenceKey) : (key >= referenceKey);
+    });
+
+    const Entry *overLapping = nullptr;
+    const Entry *nonOverLapping = nullptr;
+    for(auto entry = first; entry != sortedEntries.end(); entry++) {
+        const SkIRect &frame = entry->frame;
+        // Rule 9. Overlapping candidate is chosen over the non overlapping one only if it is as close, the farther ones can't be.
+        if(nonOverLapping && primaryKey(direction, frame) != primaryKey(direction, nonOverLapping->frame))
+            break;
+        // Rule 1. If the candidate has same dimention as the current focussed item then ignore.
+        if(frame == referenceFrame)
+            continue;
+
+        bool isOverLapping, isNonOverLapping = false;
+        if(direction == RNS_KEY_Right || direction == RNS_KEY_Left) {
+            // Rule 3. Must have Projected overlap in Eastern/Western region
+            isOverLapping = !(frame.bottom() < referenceFrame.top() || frame.top() > referenceFrame.bottom());
+        } else {
+            // Rule 3. Has either Projected overlap or nonOverlap in Northern/Southern region
+            isOverLapping = !(frame.right() < referenceFrame.left() || frame.left() > referenceFrame.right());
+            // Rule 3.a For non-overlap, only consider the candidates which are completely above (or below) current focussed item
+            if(!isOverLapping && !nonOverLapping) {
+                isNonOverLapping = (direction == RNS_KEY_Up) ? (frame.bottom() <= referenceFrame.top()) : (frame.top() >= referenceFrame.bottom());
+            }
+        }
+        if(!(isOverLapping || isNonOverLapping) || (filter && !filter(entry->candidate)))
+            continue;
+        if(isOverLapping) {
+            overLapping = &(*entry); // Sorted, so the first one is the closest
+            break;
+        }
+        nonOverLapping = &(*entry);
+    }
+
+    if(overLapping)
+        return overLapping->candidate;
+    return nonOverLapping ? nonOverLapping->candidate : nullptr;
+}
+
+}// namespace SpatialNavigator
+}//react
+}//facebook
@@ -0,0 +1,63 @@
+/*
+* Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+*
+* Use of this source code is governed by a BSD-style license that can be
+* found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+#include "include/core/SkRect.h"
+
+#include "RSkSpatialNavigator.h"
+
+namespace facebook{
+namespace react {
+namespace SpatialNavigator {
+
+/*
+ * Directional index of the navigation candidates of a container.
+ * Candidates are kept sorted for each of the 4 directions by the focus scoring rules, with their frames in the
+ * container's layer space, so scrolling the container does not reorder them. Index is rebuilt only when the
+ * candidate list or a candidate frame has changed, and a D-pad query binary searches to the first candidate
+ * in the direction and walks only till the nearest one is found.
+ */
+class CandidateIndex {
+public:
+    using CandidateFilter = std::function<bool(RSkComponent*)>;
+
+    void invalidate();
+    // Bumped when the candidates of any container change, results derived from the indexes are cached against it
+    static uint64_t candidateListGeneration() { return candidateListGeneration_.load(std::memory_order_relaxed); }
+
+    // Returns the nearest candidate from the reference frame in the direction, skipping the ones rejected by filter.
+    // Reference frame has to be in the container's layer space, see Container::toLayerSpace.
+    RSkComponent* findNearest(CandidateList& candidates, rnsKey direction, const SkIRect& referenceFrame, CandidateFilter filter);
+
+private:
+    struct Entry {
+        RSkComponent *candidate;
+        SkIRect frame;
+        int zIndex;
+        int tag;
+    };
+
+    void updateIfNeeded(CandidateList& candidates);
+    static bool isBefore(rnsKey direction, const Entry& listItem, const Entry& newItem);
+
+    static std::atomic<uint64_t> candidateListGeneration_;
+
+    std::vector<Entry> entries_;
+    std::array<std::vector<Entry>, 4> sortedEntries_; // Up, Down, Left & Right order
+    bool isDirty_{true};
+    uint64_t layoutGeneration_{0};
+};
+
+}// namespace SpatialNavigator
+}//react
+}//facebook
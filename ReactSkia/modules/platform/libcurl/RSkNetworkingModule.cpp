@@ -13,6 +13,7 @@
 #include <ReactCommon/TurboModuleUtils.h>
 #include "ReactCommon/TurboModule.h"
 
+#include "ReactSkia/utils/RnsBase64.h"
 #include "ReactSkia/utils/RnsLog.h"
 #include "ReactSkia/JSITurboModuleManager.h"
 #include "RSkNetworkingModule.h"
@@ -75,8 +76,10 @@ jsi::Value RSkNetworkingModule::sendRequest(
     struct NetworkRequest *networkRequest = ((struct NetworkRequest *)userdata);
     if(networkRequest) {
       networkRequest->downloadComplete_ = true;
-      if(!(networkRequest->useIncrementalUpdates_ && (networkRequest->responseType_ == "text") ))
-        sendData(responseData, networkRequest);
+      if(networkRequest->useIncrementalUpdates_ && (networkRequest->responseType_ == "text"))
+        sendIncrementalData(responseData, networkRequest, responseData->contentSize, responseData->contentSize, true);
+      else
+        sendData(networkRequest->curlRequest_->curlResponse, networkRequest);
       sendEventWithName("didCompleteNetworkResponse", folly::dynamic::array(networkRequest->requestId_, responseData->errorResult , responseData->responseTimeout ));
       connectionList_.erase(networkRequest->requestId_);
       delete networkRequest;
@@ -127,9 +130,8 @@ void RSkNetworkingModule::sendProgressEventwrapper(double dltotal,double dlnow,
   }
   if(networkRequest->downloadComplete_ == false && dlnow != 0.0) {
     if(networkRequest->useIncrementalUpdates_) {
-      if(networkRequest->responseType_ == "text" && responseData->responseBufferOffset !=0) {
-        sendEventWithName("didReceiveNetworkIncrementalData", folly::dynamic::array(networkRequest->requestId_ ,responseData->responseBuffer, dlnow,dltotal ));
-        responseData->responseBufferOffset = 0;
+      if(networkRequest->responseType_ == "text" && responseData->contentSize > networkRequest->deliveredOffset_) {
+        sendIncrementalData(responseData.get(), networkRequest, dlnow, dltotal, false);
       }else 
         sendEventWithName("didReceiveNetworkDataProgress", folly::dynamic::array(networkRequest->requestId_ , dlnow,dltotal ));
     }
@@ -142,19 +144,58 @@ void RSkNetworkingModule::headerCallbackWrapper(void* curlResponse, NetworkReque
   sendEventWithName("didReceiveNetworkResponse", folly::dynamic::array(networkRequest->requestId_  , responseData->statusCode, responseData->headerBuffer ,responseData->responseurl));
 }
 
-void RSkNetworkingModule::sendData(CurlResponse *responseData, NetworkRequest *networkRequest) {
-  char* responseBuffer= NULL;
-  if(!(responseData->responseBuffer) || responseData->contentSize == 0)
+// Length of the data without a trailing incomplete UTF-8 sequence, which is left for the next chunk
+static size_t completeUtf8Length(const char* data, size_t length) {
+  size_t trailStart = length > 3 ? length - 3 : 0;
+  for(size_t index = length; index > trailStart; index--) {
+    unsigned char byte = data[index - 1];
+    if((byte & 0xC0) == 0x80)
+      continue; // Continuation byte, look for the lead byte
+    size_t sequenceLength = (byte & 0x80) == 0 ? 1 : (byte & 0xE0) == 0xC0 ? 2 : (byte & 0xF0) == 0xE0 ? 3 : 4;
+    return (length - (index - 1) >= sequenceLength) ? length : index - 1;
+  }
+  return length;
+}
+
+void RSkNetworkingModule::sendIncrementalData(CurlResponse *responseData, NetworkRequest *networkRequest, double progress, double total, bool isLastChunk) {
+  // Called with the response buffer locked, or once the transfer is complete.
+  // Only the data received since the previous event is sent, the response keeps growing in place.
+  if(!(responseData->responseBuffer) || responseData->contentSize <= networkRequest->deliveredOffset_)
+    return;
+  const char* chunkStart = responseData->responseBuffer + networkRequest->deliveredOffset_;
+  size_t chunkLength = responseData->contentSize - networkRequest->deliveredOffset_;
+  if(!isLastChunk)
+    chunkLength = completeUtf8Length(chunkStart, chunkLength);
+  if(chunkLength == 0)
+    return;
+  // Buffer may be reallocated by the next write, so the chunk is copied once here
+  auto chunk = std::make_shared<std::string>(chunkStart, chunkLength);
+  networkRequest->deliveredOffset_ += chunkLength;
+  int requestId = networkRequest->requestId_;
+  sendEventWithJSIParams("didReceiveNetworkIncrementalData", [requestId, chunk, progress, total](jsi::Runtime &rt) -> jsi::Value {
+    return jsi::Array::createWithElements(rt, requestId,
+        jsi::String::createFromUtf8(rt, (const uint8_t*)chunk->data(), chunk->size()), progress, total);
+  });
+}
+
+void RSkNetworkingModule::sendData(std::shared_ptr<CurlResponse> responseData, NetworkRequest *networkRequest) {
+  if(!responseData || !(responseData->responseBuffer) || responseData->contentSize == 0)
     return;
-  if(networkRequest->responseType_ == "text")
-    responseBuffer = responseData->responseBuffer;
-  else if(networkRequest->responseType_ == "base64")
-    RNS_LOG_NOT_IMPL;
-  else {
+  bool isText = (networkRequest->responseType_ == "text");
+  if(!isText && networkRequest->responseType_ != "base64") {
     RNS_LOG_ERROR ( "Invalid responseType: \n");
     return;
   }
-  sendEventWithName("didReceiveNetworkData", folly::dynamic::array(networkRequest->requestId_ , responseBuffer));
+  // Response is complete & no longer written, so JS value is created straight from the curl buffer on JS thread.
+  // XMLHttpRequest asks for base64 to build arraybuffer responses.
+  int requestId = networkRequest->requestId_;
+  sendEventWithJSIParams("didReceiveNetworkData", [requestId, responseData, isText](jsi::Runtime &rt) -> jsi::Value {
+    const uint8_t* buffer = (const uint8_t*)responseData->responseBuffer;
+    jsi::String body = isText ?
+        jsi::String::createFromUtf8(rt, buffer, responseData->contentSize) :
+        jsi::String::createFromAscii(rt, base64Encode(buffer, responseData->contentSize));
+    return jsi::Array::createWithElements(rt, requestId, std::move(body));
+  });
 }
 
 }// namespace react
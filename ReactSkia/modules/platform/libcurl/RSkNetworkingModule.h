@@ -21,6 +21,7 @@ struct NetworkRequest {
     ,responseType_(responseType)
     ,uploadComplete_(false)
     ,downloadComplete_(false)
+    ,deliveredOffset_(0)
     {}
   RSkNetworkingModule *self_;
   int requestId_;
@@ -28,6 +29,7 @@ struct NetworkRequest {
   std::string responseType_;
   bool uploadComplete_;
   bool downloadComplete_;
+  int deliveredOffset_; // Response data already sent as incremental updates
   std::shared_ptr<CurlRequest> curlRequest_;
 };
 
@@ -48,7 +50,8 @@ class RSkNetworkingModule:  public RSkNetworkingModuleBase {
    jsi::Value abortRequest(
        folly::dynamic) override;
 
-  void sendData(CurlResponse*, NetworkRequest*);
+  void sendData(std::shared_ptr<CurlResponse>, NetworkRequest*);
+  void sendIncrementalData(CurlResponse*, NetworkRequest*, double progress, double total, bool isLastChunk);
   void sendProgressEventwrapper(double, double, double, double, NetworkRequest*);
   void headerCallbackWrapper(void*, NetworkRequest*);
   void writeMemoryCallbackWrapper(void*, char*, size_t);
@@ -8,6 +8,8 @@
 #include <ReactCommon/TurboModuleUtils.h>
 #include "ReactCommon/TurboModule.h"
 
+#include "ReactSkia/utils/RnsArrayBuffer.h"
+#include "ReactSkia/utils/RnsBase64.h"
 #include "ReactSkia/utils/RnsLog.h"
 #include "ReactSkia/JSITurboModuleManager.h"
 #include "RSkWebSocketModule.h"
@@ -40,12 +42,16 @@ jsi::Value RSkWebSocketModule::getConnect(
   websocketRequest->socketID = socketID;
   NopollRequest* nopollRequest =new NopollRequest(strdup(url.c_str()));
 
-  auto MessageHandlerCallback = [&](std::string type, const char* data, void* userData) -> void {
-    folly::dynamic parameters = folly::dynamic::object();
+  auto MessageHandlerCallback = [&](WebsocketMessageType type, std::shared_ptr<std::string> payload, void* userData) -> void {
     WebsocketRequest * websocketRequest = (WebsocketRequest *)userData;
+    if(type == WEBSOCKET_MESSAGE_BINARY) {
+      sendBinaryMessageEvent(websocketRequest->socketID, std::move(payload));
+      return;
+    }
+    folly::dynamic parameters = folly::dynamic::object();
     parameters["id"]= websocketRequest->socketID;
-    parameters["data"]= data;
-    parameters["type"]= type;
+    parameters["data"]= std::move(*payload);
+    parameters["type"]= "text";
     sendEventWithName(events_[2], folly::dynamic(parameters) );
   };
 
@@ -68,15 +74,48 @@ jsi::Value RSkWebSocketModule::getConnect(
     sendEventWithName(events_[3], folly::dynamic(parameters));
   };
 
+  // Closed by getClose or by the peer, code & reason are the ones of the close frame
+  auto disconnectCallback = [&](void* userData) -> void {
+      folly::dynamic parameters = folly::dynamic::object();
+      WebsocketRequest * websocketRequest = (WebsocketRequest *)userData;
+      parameters["id"] = websocketRequest->socketID;
+      parameters["code"] = websocketRequest->nopollRequest_->closeRequestCode;
+      parameters["reason"] = websocketRequest->nopollRequest_->closeReason;
+      connectionListLock_.lock();
+      connectionList_.erase(websocketRequest->socketID);
+      connectionListLock_.unlock();
+      sendEventWithName(events_[1], folly::dynamic(parameters));
+  };
+
   nopollRequest->nopolldelegator.NOPOLLMessageHandlerCallback = MessageHandlerCallback;
   nopollRequest->nopolldelegator.NOPOLLFailureCallback = failureCallback;
   nopollRequest->nopolldelegator.NOPOLLConnectCallback = connectCallback;
+  nopollRequest->nopolldelegator.NOPOLLDisconnectCallback = disconnectCallback;
   nopollRequest->nopolldelegator.delegatorData = websocketRequest;
   websocketRequest->nopollRequest_ = nopollRequest;
   sharedNopollWebsocket_->getConnect(websocketRequest->nopollRequest_);
   return jsi::Value();
 }
 
+void RSkWebSocketModule::sendBinaryMessageEvent(int socketID, std::shared_ptr<std::string> payload) {
+  // Binary message is handed to JS as an ArrayBuffer, created straight in the runtime from the reassembled payload.
+  // Type is not "binary", which WebSocket.js decodes from base64, so the ArrayBuffer reaches onmessage as is.
+  sendEventWithJSIParams(events_[2], [socketID, payload](jsi::Runtime &rt) -> jsi::Value {
+    jsi::Object parameters(rt);
+    parameters.setProperty(rt, "id", socketID);
+    jsi::Value arrayBuffer = createArrayBuffer(rt, (const uint8_t*)payload->data(), payload->size());
+    if(arrayBuffer.isUndefined()) {
+      // Only on runtimes without ArrayBuffer data access through JSI
+      parameters.setProperty(rt, "type", "binary");
+      parameters.setProperty(rt, "data", jsi::String::createFromAscii(rt, base64Encode((const unsigned char*)payload->data(), payload->size())));
+    } else {
+      parameters.setProperty(rt, "type", "arraybuffer");
+      parameters.setProperty(rt, "data", std::move(arrayBuffer));
+    }
+    return parameters;
+  });
+}
+
 jsi::Value RSkWebSocketModule::getClose(
   int code,
   std::string reason,
@@ -90,19 +129,6 @@ jsi::Value RSkWebSocketModule::getClose(
   }
   websocketRequest->nopollRequest_->closeRequestCode = code;
   websocketRequest->nopollRequest_->closeReason = reason;
-
-  auto disconnectCallback = [&](void* userData) -> void {
-      folly::dynamic parameters = folly::dynamic::object();
-      WebsocketRequest * websocketRequest = (WebsocketRequest *)userData;
-      parameters["id"] = websocketRequest->socketID;
-      parameters["code"] = websocketRequest->nopollRequest_->closeRequestCode;
-      parameters["reason"] = websocketRequest->nopollRequest_->closeReason;
-      connectionListLock_.lock();
-      connectionList_.erase(websocketRequest->socketID);
-      connectionListLock_.unlock();
-      sendEventWithName(events_[1], folly::dynamic(parameters));
-  };
-  websocketRequest->nopollRequest_->nopolldelegator.NOPOLLDisconnectCallback = disconnectCallback;
   sharedNopollWebsocket_->close(websocketRequest->nopollRequest_);
   return jsi::Value();
 }
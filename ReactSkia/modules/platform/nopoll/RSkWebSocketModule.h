@@ -56,6 +56,7 @@ class RSkWebSocketModule:  public RSkWebSocketModuleBase {
     std::vector<std::string> events_ = {"websocketOpen","websocketClosed",
                                     "websocketMessage","websocketFailed"};
   private:
+   void sendBinaryMessageEvent(int socketID, std::shared_ptr<std::string> payload);
    NopollWebsocket* sharedNopollWebsocket_;
    std::mutex connectionListLock_;
 };
@@ -40,9 +40,9 @@ void RNSApplicationManagerInterface::dispatchOnChange(std::string nextAppState)
   });
 }
 
-void RNSApplicationManagerInterface::dispatchOnMemoryWarning() {
-  appStateThread_.getEventBase()->runInEventBaseThread([&] {
-    client_.onMemoryWarning();
+void RNSApplicationManagerInterface::dispatchOnMemoryWarning(MemoryWarningLevel level) {
+  appStateThread_.getEventBase()->runInEventBaseThread([&, level] {
+    client_.onMemoryWarning(level);
   });
 }
 
@@ -22,6 +22,12 @@ using folly::format;
 using std::string;
 using std::vector;
 
+enum MemoryWarningLevel {
+  MemoryWarningLow = 1, // Reported to JS as memoryWarning event
+  MemoryWarningModerate, // Native caches are trimmed
+  MemoryWarningCritical
+};
+
 class RNSApplicationManagerInterface {
  public:
   class CallbackClient {
@@ -29,7 +35,7 @@ class RNSApplicationManagerInterface {
     virtual ~CallbackClient() {}
     // Events
     virtual void onChange(string nextAppState) = 0;
-    virtual void onMemoryWarning() = 0;
+    virtual void onMemoryWarning(MemoryWarningLevel level) = 0;
     virtual void onFocus() = 0;
     virtual void onBlur() = 0;
   };
@@ -48,7 +54,7 @@ class RNSApplicationManagerInterface {
 
  protected:
   void dispatchOnChange(string nextAppState);
-  void dispatchOnMemoryWarning();
+  void dispatchOnMemoryWarning(MemoryWarningLevel level);
   void dispatchOnFocus();
   void dispatchOnBlur();
 };
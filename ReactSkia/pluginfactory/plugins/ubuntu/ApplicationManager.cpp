@@ -22,7 +22,7 @@ RNSApplicationManagerInterfaceImpl::RNSApplicationManagerInterfaceImpl(AppCallba
 RNSApplicationManagerInterfaceImpl::~RNSApplicationManagerInterfaceImpl(){}
 
 void RNSApplicationManagerInterfaceImpl::handleMemoryNotification(int efd) {
-  dispatchOnMemoryWarning();
+  dispatchOnMemoryWarning(cgMemHandle_.memoryWarningLevel(efd));
 }
 
 RNSApplicationManagerInterfaceImpl::CgroupMemoryData&  RNSApplicationManagerInterfaceImpl::initializeCgroupMemory(CgroupMemoryNotificationCallback cb) {
@@ -24,14 +24,19 @@ class RNSApplicationManagerInterfaceImpl : public RNSApplicationManagerInterface
  private:
   struct CgroupMemoryData {
    public:
-    CgroupMemoryData(CgroupMemoryNotificationCallback fucn);
+    // cgroupMemoryPath : memory controller directory of the cgroup to monitor
+    CgroupMemoryData(CgroupMemoryNotificationCallback fucn, string cgroupMemoryPath = "/sys/fs/cgroup/memory");
     ~CgroupMemoryData();
+    MemoryWarningLevel memoryWarningLevel(int efd);
     static int addToEpollWait(int epfd, int efd);
     static int removeFromEpollWait(int epfd, int efd);
    private:
+    string cgroupMemoryPath_;
     int epfd_;
     int exitEfd_;
     int memEfd_{0};
+    int moderateMemEfd_{-1};
+    int criticalMemEfd_{-1};
     std::thread workerThread_;
     CgroupMemoryNotificationCallback notifyFunc {nullptr};
 
@@ -41,6 +46,8 @@ class RNSApplicationManagerInterfaceImpl : public RNSApplicationManagerInterface
     void monitorThread();
   };
 
+  friend class ApplicationManagerCgroupMemoryTest; // Drives the monitor over a fake cgroup directory
+
   CgroupMemoryData& cgMemHandle_;
   void handleMemoryNotification(int efd);
   CgroupMemoryData& initializeCgroupMemory(CgroupMemoryNotificationCallback cb);
@@ -15,9 +15,9 @@
 
 #define MAX_EPOLL_EVENTS            10
 #define MAX_EPOLL_TIMEOUT           -1 // infinite
-#define CGROUP_MEMORY_PRESSURE  "/sys/fs/cgroup/memory/memory.pressure_level"
-#define CGROUP_EVENT_CONTROL    "/sys/fs/cgroup/memory/cgroup.event_control"
-#define CGROUP_MEMORY_USAGE     "/sys/fs/cgroup/memory/memory.usage_in_bytes"
+#define CGROUP_MEMORY_PRESSURE  "/memory.pressure_level" // Files of the cgroup memory controller directory
+#define CGROUP_EVENT_CONTROL    "/cgroup.event_control"
+#define CGROUP_MEMORY_USAGE     "/memory.usage_in_bytes"
 
 namespace facebook {
 namespace react {
@@ -37,8 +37,9 @@ int RNSApplicationManagerInterfaceImpl::CgroupMemoryData::removeFromEpollWait(in
   return(epoll_ctl(epfd, EPOLL_CTL_DEL, efd, &ev));
 }
 
-RNSApplicationManagerInterfaceImpl::CgroupMemoryData::CgroupMemoryData(CgroupMemoryNotificationCallback cb)
-    : notifyFunc(cb) {
+RNSApplicationManagerInterfaceImpl::CgroupMemoryData::CgroupMemoryData(CgroupMemoryNotificationCallback cb, string cgroupMemoryPath)
+    : cgroupMemoryPath_(cgroupMemoryPath),
+      notifyFunc(cb) {
   if((epfd_ = epoll_create(1)) < 0) {
     RNS_LOG_ERROR("Couldnt Create Epoll FD" << strerror(errno));
     return;
@@ -55,6 +56,17 @@ RNSApplicationManagerInterfaceImpl::CgroupMemoryData::CgroupMemoryData(CgroupMem
     monitorThread();
   });
   memEfd_ = startMonitoringCgroupMemoryPressure("low", "hierarchy");
+  // Higher levels notify the lower level listeners as well, so each level is handled once per event
+  moderateMemEfd_ = startMonitoringCgroupMemoryPressure("medium", "hierarchy");
+  criticalMemEfd_ = startMonitoringCgroupMemoryPressure("critical", "hierarchy");
+}
+
+MemoryWarningLevel RNSApplicationManagerInterfaceImpl::CgroupMemoryData::memoryWarningLevel(int efd) {
+  if(efd == criticalMemEfd_)
+    return MemoryWarningCritical;
+  if(efd == moderateMemEfd_)
+    return MemoryWarningModerate;
+  return MemoryWarningLow;
 }
 
 void RNSApplicationManagerInterfaceImpl::CgroupMemoryData::monitorThread() {
@@ -110,29 +122,34 @@ RNSApplicationManagerInterfaceImpl::CgroupMemoryData::~CgroupMemoryData() {
   }
   if(exitEfd_)
     close(exitEfd_);
+  for(int memEfd : {memEfd_, moderateMemEfd_, criticalMemEfd_}) {
+    if(memEfd > 0)
+      close(memEfd);
+  }
 }
 
 int RNSApplicationManagerInterfaceImpl::CgroupMemoryData::configureEventControl(int eventFd, string commandBuffer) {
   int eventControlFd = -1;
   bool result = false;
+  string eventControlPath = cgroupMemoryPath_ + CGROUP_EVENT_CONTROL;
   do {
-    if ((eventControlFd = open(CGROUP_EVENT_CONTROL, O_WRONLY)) == -1) {
-      RNS_LOG_WARN("Failed to open : " << CGROUP_EVENT_CONTROL << " : " << strerror(errno));
+    if ((eventControlFd = open(eventControlPath.c_str(), O_WRONLY)) == -1) {
+      RNS_LOG_WARN("Failed to open : " << eventControlPath << " : " << strerror(errno));
       break;
     }
     if (write(eventControlFd, commandBuffer.c_str(), commandBuffer.length()) == -1) {
-      RNS_LOG_WARN("Failed to write cgroup.event_control file :" << CGROUP_EVENT_CONTROL << " : " << strerror(errno));
+      RNS_LOG_WARN("Failed to write cgroup.event_control file :" << eventControlPath << " : " << strerror(errno));
       break;
     }
     if( addToEpollWait(epfd_, eventFd) == -1) {
-      RNS_LOG_WARN("Failed to add epoll for :" << CGROUP_EVENT_CONTROL << " : " << strerror(errno));
+      RNS_LOG_WARN("Failed to add epoll for :" << eventControlPath << " : " << strerror(errno));
       break;
     }
     result = true;
   }while(0);
 
   if (eventControlFd >= 0 && close(eventControlFd) == -1) {
-    RNS_LOG_WARN("Failed close " << CGROUP_EVENT_CONTROL);
+    RNS_LOG_WARN("Failed close " << eventControlPath);
   }
   return result;
 }
@@ -147,8 +164,8 @@ int RNSApplicationManagerInterfaceImpl::CgroupMemoryData::startMonitoringCgroupM
       RNS_LOG_WARN("Couldnt create Event FD : " << strerror(errno));
       break;
     }
-    if ((memoryFileFd = open(CGROUP_MEMORY_PRESSURE, O_RDONLY)) == -1) {
-      RNS_LOG_WARN("Failed to open : " << CGROUP_MEMORY_PRESSURE << " : " << strerror(errno));
+    if ((memoryFileFd = open((cgroupMemoryPath_ + CGROUP_MEMORY_PRESSURE).c_str(), O_RDONLY)) == -1) {
+      RNS_LOG_WARN("Failed to open : " << cgroupMemoryPath_ << CGROUP_MEMORY_PRESSURE << " : " << strerror(errno));
       break;
     }
     sprintf(buffer, "%d %d %s,%s", eventFd, memoryFileFd, pressurelevel.c_str(), propagationMode.c_str());
@@ -178,8 +195,8 @@ int RNSApplicationManagerInterfaceImpl::CgroupMemoryData::startMonitoringCgroupM
       RNS_LOG_WARN("Couldnt create Event FD : " << strerror(errno));
       break;
     }
-    if ((memoryFileFd = open(CGROUP_MEMORY_USAGE, O_RDONLY)) == -1) {
-      RNS_LOG_WARN("Failed to open : " << CGROUP_MEMORY_USAGE << " : " << strerror(errno));
+    if ((memoryFileFd = open((cgroupMemoryPath_ + CGROUP_MEMORY_USAGE).c_str(), O_RDONLY)) == -1) {
+      RNS_LOG_WARN("Failed to open : " << cgroupMemoryPath_ << CGROUP_MEMORY_USAGE << " : " << strerror(errno));
       break;
     }
     sprintf(buffer, "%d %d %llu", eventFd, memoryFileFd, threshold);
@@ -34,7 +34,8 @@ CurlNetworking::CurlNetworking() {
       }
     }
   });
-
+  memoryPressureClientId_ = rns::sdk::RNSMemoryPressureBroker::instance()->addClient("NetworkCache",
+      std::bind(&CurlNetworking::trimMemory, this, std::placeholders::_1));
 }
 
 CurlNetworking* CurlNetworking::sharedCurlNetworking() {
@@ -61,6 +62,7 @@ CurlRequest::~CurlRequest() {
 }
 
 CurlNetworking::~CurlNetworking() {
+  rns::sdk::RNSMemoryPressureBroker::instance()->removeClient(memoryPressureClientId_);
   exitLoop_ = true;
   multiNetworkThread_.join();
   if(curlMultihandle_){
@@ -72,6 +74,21 @@ CurlNetworking::~CurlNetworking() {
     sharedCurlNetworking_ = nullptr;
 };
 
+size_t CurlNetworking::trimMemory(rns::sdk::MemoryPressureLevel level) {
+  // Responses still held by a pending request are not freed by removing them, so they are kept.
+  // Large responses are mostly images, which are also in the decoded image cache.
+  size_t minResponseBytes = (level == rns::sdk::MemoryPressureCritical) ? 0 : NETWORK_CACHE_TRIM_MIN_RESPONSE_SIZE;
+  size_t reclaimedBytes = 0;
+  size_t evictCount = networkCache_->evictIf([&](const shared_ptr<CurlResponse> &response) {
+    if(!response || response.use_count() > 1 || (size_t)response->responseBufferCapacity < minResponseBytes)
+      return false;
+    reclaimedBytes += response->responseBufferCapacity;
+    return true;
+  });
+  RNS_LOG_DEBUG("Evicted " << evictCount << " response(s) from network cache");
+  return reclaimedBytes;
+}
+
 bool CurlRequest::shouldCacheData() {
   curlResponse->cacheExpiryTime = DEFAULT_MAX_CACHE_EXPIRY_TIME;
   double responseMaxAgeTime = DEFAULT_MAX_CACHE_EXPIRY_TIME;
@@ -257,13 +274,24 @@ void CurlNetworking::setHeaders(shared_ptr<CurlRequest> curlRequest, folly::dyna
     curl_easy_setopt(curlRequest->handle, CURLOPT_HTTPHEADER, curlListRequestHeader);
 }
 
+void CurlNetworking::reserveResponseBuffer(CurlResponse* curlResponse, size_t contentSize) {
+  // One more byte for the null termination
+  if(contentSize + 1 <= (size_t)curlResponse->responseBufferCapacity)
+    return;
+  // Grown geometrically, so a big body is not reallocated & copied for every received chunk
+  size_t capacity = std::max(contentSize + 1, (size_t)curlResponse->responseBufferCapacity * 2);
+  curlResponse->responseBuffer  = (char *) realloc(curlResponse->responseBuffer , capacity);
+  RNS_LOG_ASSERT((curlResponse->responseBuffer), "responseBuffer cannot be null ");
+  curlResponse->responseBufferCapacity = capacity;
+}
+
 size_t CurlNetworking::writeCallbackCurlWrapper(void* buffer, size_t size, size_t nitems, void* userData) {
   CurlRequest *curlRequest = (CurlRequest *)userData;
+  size_t dataSize = size*nitems;
   std::scoped_lock lock(curlRequest->bufferLock);
-  curlRequest->curlResponse->responseBuffer  = (char *) realloc(curlRequest->curlResponse->responseBuffer , curlRequest->curlResponse->responseBufferOffset+nitems+1);
-  RNS_LOG_ASSERT((curlRequest->curlResponse->responseBuffer), "responseBuffer cannot be null ");
-  memcpy(&(curlRequest->curlResponse->responseBuffer [curlRequest->curlResponse->responseBufferOffset]), (char *)buffer, nitems);
-  curlRequest->curlResponse->responseBufferOffset += (size*nitems);
+  reserveResponseBuffer(curlRequest->curlResponse.get(), curlRequest->curlResponse->responseBufferOffset + dataSize);
+  memcpy(&(curlRequest->curlResponse->responseBuffer [curlRequest->curlResponse->responseBufferOffset]), (char *)buffer, dataSize);
+  curlRequest->curlResponse->responseBufferOffset += dataSize;
   curlRequest->curlResponse->responseBuffer[curlRequest->curlResponse->responseBufferOffset] = 0;
   curlRequest->curlResponse->contentSize = curlRequest->curlResponse->responseBufferOffset;
   if(!curlRequest->curlResponse->responseurl) {
@@ -271,6 +299,10 @@ size_t CurlNetworking::writeCallbackCurlWrapper(void* buffer, size_t size, size_
     curl_easy_getinfo(curlRequest->handle, CURLINFO_EFFECTIVE_URL, &url);
     curlRequest->curlResponse->responseurl= url;
   }
+  if(curlRequest->curldelegator.CURLNetworkingWriteCallback &&
+     !curlRequest->curldelegator.CURLNetworkingWriteCallback(curlRequest->curlResponse.get(), curlRequest->curldelegator.delegatorData)) {
+    return 0; // Delegator got what it needed, curl stops the transfer with a write error
+  }
   return size*nitems;
 }
 
@@ -301,6 +333,12 @@ size_t CurlNetworking::headerCallbackCurlWrapper(char* buffer, size_t size, size
     curl_easy_getinfo(curlRequest->handle, CURLINFO_RESPONSE_CODE, &response_code);
     curlRequest->curlResponse->responseurl= url;
     curlRequest->curlResponse->statusCode = response_code;
+    curl_off_t contentLength = -1;
+    curl_easy_getinfo(curlRequest->handle, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &contentLength);
+    if(contentLength > 0) {
+      std::scoped_lock lock(curlRequest->bufferLock);
+      reserveResponseBuffer(curlRequest->curlResponse.get(), contentLength);
+    }
 
 #if !defined(GOOGLE_STRIP_LOG) || (GOOGLE_STRIP_LOG <= INFO)
     RNS_LOG_DEBUG("Header buffer content size:" << curlRequest->curlResponse->headerBuffer.size());
@@ -408,6 +446,10 @@ bool CurlNetworking::sendRequest(shared_ptr<CurlRequest> curlRequest, folly::dyn
   return status;
 } 
 
+bool CurlNetworking::isAvailableInCache(std::string url) {
+  return networkCache_->isAvailableInCache(url);
+}
+
 bool CurlNetworking::abortRequest(shared_ptr<CurlRequest> curlRequest) {
   //Fix Me abort is called by main thread, Main thread will block untill abort completes. 
   //schedule in different thread. 
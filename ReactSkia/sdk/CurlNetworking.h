@@ -11,9 +11,11 @@
 #include <thread>  
 #include "jsi/JSIDynamic.h"
 #include "ThreadSafeCache.h"
+#include "RNSMemoryPressureBroker.h"
 #include "ReactSkia/sdk/FollyTimer.h"
 #define DEFAULT_MAX_CACHE_EXPIRY_TIME 1800000 // 30mins in seconds 1800000
 #define MAX_URL_REDIRECT 10L // maximum number of redirects allowed
+#define NETWORK_CACHE_TRIM_MIN_RESPONSE_SIZE 64*1024 // Smaller responses are kept on moderate memory pressure
 
 #ifndef CA_CERTIFICATE
 #define CA_CERTIFICATE       "/etc/ssl/certs/ca-certificates.crt"      /**< The certificate of the CA to establish https connection to the server*/
@@ -29,7 +31,7 @@ typedef struct Curldelegator {
   std::function<size_t(double, double, double, double, void*)> CURLNetworkingProgressCallback;
   std::function<size_t(void*,void*)> CURLNetworkingHeaderCallback;
   std::function<bool(void*,void*)> CURLNetworkingCompletionCallback;
-  std::function<bool(void*,void*)> CURLNetworkingWriteCallback;
+  std::function<bool(void*,void*)> CURLNetworkingWriteCallback; // Called on every received chunk, returns false to stop the transfer
   void *delegatorData;
 }Curldelegator;
 
@@ -37,6 +39,7 @@ typedef struct CurlResponse {
   CurlResponse()
    :responseBuffer(nullptr),
     responseBufferOffset(0),
+    responseBufferCapacity(0),
     contentSize(0),
     headerBufferSize(0),
     responseurl(nullptr){
@@ -51,6 +54,7 @@ typedef struct CurlResponse {
   folly::dynamic headerBuffer;
   char* responseBuffer;
   int responseBufferOffset;
+  int responseBufferCapacity; // Allocated size of responseBuffer, grown ahead of responseBufferOffset
   int contentSize;
   int headerBufferSize;
   const char* responseurl;
@@ -83,6 +87,7 @@ class CurlNetworking {
   ~CurlNetworking();
   bool sendRequest(shared_ptr<CurlRequest> curlRequest, folly::dynamic query);
   bool abortRequest(shared_ptr<CurlRequest> curlRequest);
+  bool isAvailableInCache(std::string url);
   static CurlNetworking* sharedCurlNetworking();
   static size_t writeCallbackCurlWrapper(void* buffer, size_t size, size_t nitems, void* userData) ;
   static size_t readCallback(void *ptr, size_t size, size_t nmemb, void *userdata);
@@ -97,10 +102,13 @@ class CurlNetworking {
   bool exitLoop_ = false;
   std::thread multiNetworkThread_;
   static std::mutex curlInstanceMutex_;
+  unsigned int memoryPressureClientId_{0};
+  size_t trimMemory(rns::sdk::MemoryPressureLevel level);
   void processNetworkRequest(CURLM *cm);
   bool prepareRequest(shared_ptr<CurlRequest> curlRequest, folly::dynamic data, string methodName);
   void sendResponseCacheData(shared_ptr<CurlRequest> curlRequest);
   void setHeaders(shared_ptr<CurlRequest> curlRequest, folly::dynamic headers);
+  static void reserveResponseBuffer(CurlResponse* curlResponse, size_t contentSize);
 };
 }//namespace react
 }//namespace facebook
@@ -5,6 +5,7 @@
 * LICENSE file in the root directory of this source tree.
 */
 #include <nopoll.h>
+#include <pthread.h>
 
 #include "ReactSkia/utils/RnsLog.h"
 #include "NopollWebsocket.h"
@@ -16,21 +17,33 @@ namespace react {
 NopollWebsocket* NopollWebsocket::sharedNopollWebsocket_{nullptr};
 std::mutex NopollWebsocket::requestLock_;
 
+namespace {
+
+// nopoll guards its context with these, connections are created on the connect threads & closed on the loop
+noPollPtr mutexCreate() {
+  pthread_mutex_t* mutex = new pthread_mutex_t;
+  pthread_mutex_init(mutex, NULL);
+  return mutex;
+}
+void mutexDestroy(noPollPtr mutex) {
+  pthread_mutex_destroy((pthread_mutex_t*)mutex);
+  delete (pthread_mutex_t*)mutex;
+}
+void mutexLock(noPollPtr mutex) {
+  pthread_mutex_lock((pthread_mutex_t*)mutex);
+}
+void mutexUnlock(noPollPtr mutex) {
+  pthread_mutex_unlock((pthread_mutex_t*)mutex);
+}
+
+} // namespace
+
 NopollWebsocket::NopollWebsocket() {
+  nopoll_thread_handlers(mutexCreate, mutexDestroy, mutexLock, mutexUnlock);
   ctx_ = nopoll_ctx_new ();
-  sem_init(&startDownloadingThread_, 0, 0);
-  wsMessageThread_ = std::thread([this]() {
-    std::thread t1(&NopollWebsocket::pollThread,this);
-    int error_code;
-    while (ctx_) {
-      // wait for ever
-      error_code = nopoll_loop_wait (ctx_, 0);
-      if (error_code == -4)
-        RNS_LOG_ERROR(" io waiting mechanism, errno=" << errno);
-      // recover by just calling io wait engine
-      // try to limit recoveries to avoid infinite loop
-    }
-  });
+  if(ctx_)
+    nopoll_conn_connect_timeout(ctx_, WEBSOCKET_HANDSHAKE_TIMEOUT_MS * 1000);
+  wsLoopThread_.getEventBase()->waitUntilRunning();
 }
 
 NopollWebsocket* NopollWebsocket::sharedNopollWebsocket() {
@@ -41,254 +54,395 @@ NopollWebsocket* NopollWebsocket::sharedNopollWebsocket() {
 }
 
 NopollWebsocket::~NopollWebsocket() {
+  // Connects in progress hand their socket to the loop first, then the loop closes everything
+  std::unordered_map<uint64_t, std::thread> connectThreads;
+  wsLoopThread_.getEventBase()->runInEventBaseThreadAndWait([this, &connectThreads]() {
+    connectThreads.swap(connectThreads_);
+  });
+  for(auto& connectThread : connectThreads)
+    connectThread.second.join();
+  wsLoopThread_.getEventBase()->runInEventBaseThreadAndWait([this]() {
+    while(!connections_.empty()) {
+      NopollRequest* nopollRequest = connections_.begin()->first;
+      nopollRequest->closeRequestCode = 1001; // Going away
+      closeOnLoop(nopollRequest);
+    }
+  });
   nopoll_ctx_unref(ctx_);
   std::lock_guard<std::mutex> lock(requestLock_);
   if(this == sharedNopollWebsocket_)
     sharedNopollWebsocket_ = nullptr;
 }
 
-void NopollWebsocket::multiConn(){
-  NopollRequest* nopollRequest = nullptr;
-  while(true) { // forever
-    requestQueueLock_.lock();
-    if(RequestQueue_.size() !=0) {
-      nopollRequest =RequestQueue_.front();
-      if(!nopollRequest) {
-        requestQueueLock_.unlock();
-        continue;
-      }
-      RequestQueue_.pop();
-    } else {
-      threadCountLock_.lock();
-      currentWorkerThreadCount_--;
-      threadCountLock_.unlock();
-      requestQueueLock_.unlock();
-      break;
-    }
-    requestQueueLock_.unlock();
-    switch(nopollRequest->messageType){
-      case REQUEST_MESSAGE_TYPE_OPEN:
-        getConnectNopoll(nopollRequest);
-        break;
-      case REQUEST_MESSAGE_TYPE_SEND:
-        sendNopoll(nopollRequest);
-        break;
-      case REQUEST_MESSAGE_TYPE_SENDBINARY:
-        sendBinaryNopoll(nopollRequest);
-        break;
-      case REQUEST_MESSAGE_TYPE_PING:
-        pingNopoll(nopollRequest);
-        break;
-      case REQUEST_MESSAGE_TYPE_CLOSE:
-        closeNopoll(nopollRequest);
-        break;
-      default :
-        RNS_LOG_DEBUG("messageType undefined");
-    }
-  }      
-}
-
-void  NopollWebsocket::pollThread() {
-  while(true) { //forever
-    requestQueueLock_.lock();
-    if(RequestQueue_.empty()){
-      requestQueueLock_.unlock();
-      sem_wait(&startDownloadingThread_);
-    } else {
-      threadCountLock_.lock();
-      if(currentWorkerThreadCount_ < MAX_WORKER_THEAD_COUNT) {
-        std::thread connectionThreads(&NopollWebsocket::multiConn,this);
-        connectionThreads.detach();
-        currentWorkerThreadCount_++;
-      }
-      threadCountLock_.unlock();
-      requestQueueLock_.unlock();
-      usleep(100); //to avoid cpu utilization
-    }
-  }
-}
-
-void onMessageHandler(noPollCtx * ctx, noPollConn * conn, 
-    noPollMsg * msg, noPollPtr user_data) {
-  const char * content = (const char *) nopoll_msg_get_payload (msg);
-  std::string type;
-  noPollOpCode  nopollType = nopoll_msg_opcode(msg);
-  switch(nopollType) {
-    case NOPOLL_TEXT_FRAME:
-      type = "blob";
-    case NOPOLL_BINARY_FRAME:
-      type = "binary";
-    default :
-      type = "unKnown";
-  }
-  NopollRequest* nopollRequest =  (NopollRequest*)user_data;
-  if(nopollRequest->nopolldelegator.NOPOLLMessageHandlerCallback)
-    nopollRequest->nopolldelegator.NOPOLLMessageHandlerCallback(type, content, nopollRequest->nopolldelegator.delegatorData);
-}
-
 std::string * NopollWebsocket::parseUrl(std::string& url) {
-// finding the "s://" substring in the url ex: wss://echo.websocket.org:80
+// finding the "s://" substring in the url ex: wss://echo.websocket.org:80/path
   if(url.find("s://") == -1) {
       RNS_LOG_ERROR("websocket url is invalid");
       return NULL;
   }
 
-  std::string* webSocketUrl = new std::string[2];
+  std::string* webSocketUrl = new std::string[3];
   std::string delimiter = ":";
   std::string webSocketEndPoint = url.substr(url.find(delimiter)+3,url.size());
+  size_t pathStart = webSocketEndPoint.find("/");
+  webSocketUrl[WEBSOCKET_PATH] = (pathStart != std::string::npos) ? webSocketEndPoint.substr(pathStart) : "/";
+  webSocketEndPoint = webSocketEndPoint.substr(0, pathStart);
   webSocketUrl[WEBSOCKET_URL]  = webSocketEndPoint.substr(0,webSocketEndPoint.find(delimiter));
 
-  webSocketUrl[WEBSOCKET_PORTNO] = webSocketEndPoint.substr(
-      webSocketEndPoint.find(delimiter)+1,
-      webSocketEndPoint.size());
+  if(webSocketEndPoint.find(delimiter) != std::string::npos) {
+    webSocketUrl[WEBSOCKET_PORTNO] = webSocketEndPoint.substr(webSocketEndPoint.find(delimiter)+1);
+  } else {
+    webSocketUrl[WEBSOCKET_PORTNO] = (url.find("wss://") == 0) ? "443" : "80";
+  }
 
   return webSocketUrl;
 }
 
+NopollWebsocket::Connection* NopollWebsocket::getConnection(NopollRequest* nopollRequest, const char* operation) {
+  auto it = connections_.find(nopollRequest);
+  if(it == connections_.end() || !it->second->isReady) {
+    RNS_LOG_ERROR("websocket is not connected for " << operation);
+    if(nopollRequest->nopolldelegator.NOPOLLFailureCallback)
+      nopollRequest->nopolldelegator.NOPOLLFailureCallback((char*)"websocket is not connected", nopollRequest->nopolldelegator.delegatorData);
+    return nullptr;
+  }
+  return it->second.get();
+}
+
 void NopollWebsocket::getConnect(NopollRequest* nopollRequest) {
+  if(!nopollRequest)
+    return;
   nopollRequest->messageType = REQUEST_MESSAGE_TYPE_OPEN;
-  requestQueueLock_.lock();
-  RequestQueue_.push(nopollRequest);
-  requestQueueLock_.unlock();
-  sem_post(&startDownloadingThread_);
+  wsLoopThread_.getEventBase()->runInEventBaseThread([this, nopollRequest]() {
+    pendingConnects_.insert(nopollRequest);
+    // Each connect blocks its own thread, so a slow peer or name resolution never delays the others
+    uint64_t connectId = nextConnectId_++;
+    connectThreads_[connectId] = std::thread([this, nopollRequest, connectId]() {
+      noPollConn* conn = openConnection(nopollRequest);
+      wsLoopThread_.getEventBase()->runInEventBaseThread([this, nopollRequest, connectId, conn]() {
+        auto it = connectThreads_.find(connectId);
+        if(it != connectThreads_.end()) { // Else joined by the destructor
+          it->second.join(); // Thread only returns after handing over
+          connectThreads_.erase(it);
+        }
+        connectOnLoop(nopollRequest, conn);
+      });
+    });
+  });
 }
 
-void NopollWebsocket::getConnectNopoll(NopollRequest* nopollRequest) {
-  if(!nopollRequest)
-    return;  
+noPollConn* NopollWebsocket::openConnection(NopollRequest* nopollRequest) {
   std::string url = nopollRequest->url;
   std::string* parsedUrl = NopollWebsocket::parseUrl(url);
   if(parsedUrl == NULL) {
     RNS_LOG_ERROR(" parsedUrl is NULL ");
-    return;
+    return NULL;
   }
 
   if(!ctx_) {
     RNS_LOG_ERROR("nopoll_ctx is NULL ");
-    return;
+    delete []parsedUrl;
+    return NULL;
   }
 
-  /* creating a connection 
+  /* Creating a connection resolves the host, connects & sends the handshake request,
+   * bounded by the connect timeout. Its reply is completed from the loop once the socket is readable.
    * TO DO: NULL/optional arguments has to be verified */
-  noPollConn* conn = nopoll_conn_new(ctx_,  parsedUrl[0].c_str() , parsedUrl[1].c_str() ,  NULL , "/", NULL , NULL);
-  delete []parsedUrl;
-  if(!conn) {
-      RNS_LOG_ERROR("websocket connection is NULL");
-      return;
+  noPollConn* conn;
+  if(url.find("wss://") == 0) {
+    conn = nopoll_conn_tls_new(ctx_, NULL, parsedUrl[WEBSOCKET_URL].c_str(), parsedUrl[WEBSOCKET_PORTNO].c_str(),
+                               NULL, parsedUrl[WEBSOCKET_PATH].c_str(), NULL, NULL);
+  } else {
+    conn = nopoll_conn_new(ctx_, parsedUrl[WEBSOCKET_URL].c_str(), parsedUrl[WEBSOCKET_PORTNO].c_str(),
+                           NULL, parsedUrl[WEBSOCKET_PATH].c_str(), NULL, NULL);
   }
-  RNS_LOG_DEBUG("waiting until connection is ok");
-  if(!nopoll_conn_wait_until_connection_ready (conn, 5)) {
-      RNS_LOG_ERROR("websocket connection is not ready");
-      nopoll_conn_unref(conn);
-      return;
+  delete []parsedUrl;
+  if(conn && !nopoll_conn_is_ok(conn)) {
+    nopoll_conn_close(conn);
+    conn = NULL;
   }
-  nopollRequest->conn = conn;
-  RNS_LOG_DEBUG("websocket connection sucessss");
-  nopoll_conn_set_on_msg(conn,onMessageHandler,nopollRequest);
-  if(nopollRequest->nopolldelegator.NOPOLLConnectCallback)
-    nopollRequest->nopolldelegator.NOPOLLConnectCallback(nopollRequest->nopolldelegator.delegatorData);
-  return;
+  if(!conn)
+    RNS_LOG_ERROR("websocket connection failed for " << url);
+  return conn;
 }
 
-void NopollWebsocket::send(NopollRequest* nopollRequest) {
-  nopollRequest->messageType = REQUEST_MESSAGE_TYPE_SEND;
-  requestQueueLock_.lock();
-  RequestQueue_.push(nopollRequest);
-  requestQueueLock_.unlock();
-  sem_post(&startDownloadingThread_);
+void NopollWebsocket::connectOnLoop(NopollRequest* nopollRequest, noPollConn* conn) {
+  if(pendingConnects_.erase(nopollRequest) == 0) {
+    // Closed while connecting, close event is already sent
+    if(conn)
+      nopoll_conn_close(conn);
+    return;
+  }
+  if(!conn) {
+    if(nopollRequest->nopolldelegator.NOPOLLFailureCallback)
+      nopollRequest->nopolldelegator.NOPOLLFailureCallback((char*)"websocket connection failed", nopollRequest->nopolldelegator.delegatorData);
+    return;
+  }
+  std::string url = nopollRequest->url;
+  nopoll_conn_set_sock_block(nopoll_conn_socket(conn), nopoll_false);
+
+  auto connection = std::make_unique<Connection>();
+  Connection* connectionPtr = connection.get();
+  connection->request = nopollRequest;
+  connection->conn = conn;
+  connection->lastActivity = std::chrono::steady_clock::now();
+  connection->socketHandler = std::make_unique<SocketHandler>(wsLoopThread_.getEventBase(), nopoll_conn_socket(conn),
+    [this, connectionPtr](uint16_t events) {
+      onSocketReady(*connectionPtr, events);
+    });
+  connection->socketHandler->registerHandler(folly::EventHandler::READ | folly::EventHandler::PERSIST);
+  connection->timer = folly::AsyncTimeout::make(*wsLoopThread_.getEventBase(), [this, connectionPtr]() noexcept {
+    onTimer(*connectionPtr);
+  });
+  connection->timer->scheduleTimeout(WEBSOCKET_HANDSHAKE_TIMEOUT_MS);
+  connections_[nopollRequest] = std::move(connection);
+  RNS_LOG_DEBUG("waiting for websocket handshake of " << url);
 }
 
-void NopollWebsocket::sendNopoll(NopollRequest* nopollRequest) {
-  if(!nopollRequest)
+void NopollWebsocket::onSocketReady(Connection& connection, uint16_t events) {
+  NopollRequest* nopollRequest = connection.request;
+  connection.lastActivity = std::chrono::steady_clock::now();
+
+  if(events & folly::EventHandler::WRITE) {
+    flushSendQueue(connection);
+    if(connections_.find(nopollRequest) == connections_.end())
+      return;
+  }
+  if(!(events & folly::EventHandler::READ))
     return;
-  int result = 0;
-  if(nopollRequest->conn != NULL ) {
-      result = nopoll_conn_send_text(nopollRequest->conn,  nopollRequest->sendMessageData.c_str(), nopollRequest->sendMessageData.length());
-      if (result== nopollRequest->sendMessageData.length()) {
-          RNS_LOG_DEBUG("sending data sucessfully");
-          return;
-      } 
+
+  // Socket is non blocking, so read until nopoll has no complete message
+  noPollMsg* msg;
+  while((msg = nopoll_conn_get_msg(connection.conn)) != NULL) {
+    bool isValid = onMessage(connection, msg);
+    nopoll_msg_unref(msg);
+    if(!isValid)
+      return; // Connection is failed & removed
+  }
+
+  if(!connection.isReady && nopoll_conn_is_ready(connection.conn)) {
+    RNS_LOG_DEBUG("websocket connection sucessss");
+    connection.isReady = true;
+    nopollRequest->conn = connection.conn;
+    connection.timer->scheduleTimeout(WEBSOCKET_PING_INTERVAL_MS);
+    if(nopollRequest->nopolldelegator.NOPOLLConnectCallback)
+      nopollRequest->nopolldelegator.NOPOLLConnectCallback(nopollRequest->nopolldelegator.delegatorData);
+  }
+  if(!nopoll_conn_is_ok(connection.conn)) {
+    if(connection.isReady && nopoll_conn_get_close_status(connection.conn))
+      closedByPeer(connection); // Close frame received, not a failure
+    else
+      failConnection(connection, connection.isReady ? "websocket connection lost" : "websocket handshake failed");
   }
-  if(nopollRequest->nopolldelegator.NOPOLLFailureCallback)
-    nopollRequest->nopolldelegator.NOPOLLFailureCallback((char*)"sending data is failed", nopollRequest->nopolldelegator.delegatorData);
-  return;
 }
 
-void NopollWebsocket::close(NopollRequest* nopollRequest) {
-  nopollRequest->messageType = REQUEST_MESSAGE_TYPE_CLOSE;
-  requestQueueLock_.lock();
-  RequestQueue_.push(nopollRequest);
-  requestQueueLock_.unlock();
-  sem_post(&startDownloadingThread_);
+bool NopollWebsocket::onMessage(Connection& connection, noPollMsg* msg) {
+  switch(nopoll_msg_opcode(msg)) {
+    case NOPOLL_TEXT_FRAME:
+    case NOPOLL_BINARY_FRAME:
+      if(connection.incomingMessage) {
+        if(connection.incomingSplitFrame)
+          break; // Rest of the frame split by nopoll keeps the frame opcode
+        failConnection(connection, "websocket data frame received before the end of fragmented message");
+        return false;
+      }
+      connection.incomingOpCode = nopoll_msg_opcode(msg);
+      connection.incomingMessage = std::make_shared<std::string>();
+      break;
+    case NOPOLL_CONTINUATION_FRAME:
+      if(!connection.incomingMessage) {
+        failConnection(connection, "websocket continuation frame received without a message");
+        return false;
+      }
+      break;
+    default:
+      return true; // Control frames are answered by nopoll, they only prove the peer is alive
+  }
+
+  int payloadSize = nopoll_msg_get_payload_size(msg);
+  if(connection.incomingMessage->size() + payloadSize > WEBSOCKET_MAX_MESSAGE_BYTES) {
+    failConnection(connection, "websocket message is too big");
+    return false;
+  }
+  if(payloadSize > 0)
+    connection.incomingMessage->append((const char*)nopoll_msg_get_payload(msg), payloadSize);
+
+  // Message is delivered only once its last frame is fully received. Frame split by nopoll
+  // for a partial socket read is flagged as fragment, like a frame without the FIN bit.
+  connection.incomingSplitFrame = nopoll_msg_is_fragment(msg);
+  if(!nopoll_msg_is_final(msg) || connection.incomingSplitFrame)
+    return true;
+
+  NopollRequest* nopollRequest = connection.request;
+  WebsocketMessageType type = (connection.incomingOpCode == NOPOLL_TEXT_FRAME) ? WEBSOCKET_MESSAGE_TEXT : WEBSOCKET_MESSAGE_BINARY;
+  std::shared_ptr<std::string> payload = std::move(connection.incomingMessage);
+  connection.incomingOpCode = NOPOLL_UNKNOWN_OP_CODE;
+  if(nopollRequest->nopolldelegator.NOPOLLMessageHandlerCallback)
+    nopollRequest->nopolldelegator.NOPOLLMessageHandlerCallback(type, std::move(payload), nopollRequest->nopolldelegator.delegatorData);
+  return true;
 }
 
-void NopollWebsocket::closeNopoll(NopollRequest* nopollRequest) {
-  if(!nopollRequest)
+void NopollWebsocket::onTimer(Connection& connection) {
+  if(!connection.isReady) {
+    failConnection(connection, "websocket handshake timed out");
     return;
-  if(nopollRequest->conn != NULL ) {
-    nopoll_conn_close_ext(nopollRequest->conn, nopollRequest->closeRequestCode, nopollRequest->closeReason.c_str(), nopollRequest->closeReason.size());
-    if(nopollRequest->nopolldelegator.NOPOLLDisconnectCallback)
-      nopollRequest->nopolldelegator.NOPOLLDisconnectCallback(nopollRequest->nopolldelegator.delegatorData);
-    return;  
   }
+  auto idleTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - connection.lastActivity).count();
+  if(idleTime >= 2 * WEBSOCKET_PING_INTERVAL_MS) {
+    failConnection(connection, "websocket ping timed out");
+    return;
+  }
+  if(idleTime >= WEBSOCKET_PING_INTERVAL_MS) {
+    nopoll_conn_send_ping(connection.conn); // Pong is seen as socket activity
+    connection.timer->scheduleTimeout(WEBSOCKET_PING_INTERVAL_MS);
+  } else {
+    connection.timer->scheduleTimeout(WEBSOCKET_PING_INTERVAL_MS - idleTime);
+  }
+}
+
+void NopollWebsocket::failConnection(Connection& connection, const char* message) {
+  NopollRequest* nopollRequest = connection.request;
+  RNS_LOG_ERROR(message << " : " << nopollRequest->url);
+  removeConnection(nopollRequest);
   if(nopollRequest->nopolldelegator.NOPOLLFailureCallback)
-    nopollRequest->nopolldelegator.NOPOLLFailureCallback((char*)"close connection is failed", nopollRequest->nopolldelegator.delegatorData);
-  return;
+    nopollRequest->nopolldelegator.NOPOLLFailureCallback((char*)message, nopollRequest->nopolldelegator.delegatorData);
 }
 
-void NopollWebsocket::ping(NopollRequest* nopollRequest) {
-  requestQueueLock_.lock();
-  nopollRequest->messageType = REQUEST_MESSAGE_TYPE_PING;
-  RequestQueue_.push(nopollRequest);
-  requestQueueLock_.unlock();
-  sem_post(&startDownloadingThread_);
+void NopollWebsocket::closedByPeer(Connection& connection) {
+  NopollRequest* nopollRequest = connection.request;
+  const char* closeReason = nopoll_conn_get_close_reason(connection.conn);
+  nopollRequest->closeRequestCode = nopoll_conn_get_close_status(connection.conn);
+  nopollRequest->closeReason = closeReason ? closeReason : "";
+  RNS_LOG_DEBUG("websocket closed by peer with code " << nopollRequest->closeRequestCode << " : " << nopollRequest->url);
+  removeConnection(nopollRequest);
+  if(nopollRequest->nopolldelegator.NOPOLLDisconnectCallback)
+    nopollRequest->nopolldelegator.NOPOLLDisconnectCallback(nopollRequest->nopolldelegator.delegatorData);
 }
 
-void NopollWebsocket::pingNopoll(NopollRequest* nopollRequest) {
-  if(!nopollRequest)
+void NopollWebsocket::removeConnection(NopollRequest* nopollRequest) {
+  auto it = connections_.find(nopollRequest);
+  if(it == connections_.end())
     return;
-  if(nopollRequest->conn != NULL ) {
-    nopoll_conn_send_ping(nopollRequest->conn);
-    return;  
-  }
-  if(nopollRequest->nopolldelegator.NOPOLLFailureCallback)
-    nopollRequest->nopolldelegator.NOPOLLFailureCallback((char*)"ping operation failed", nopollRequest->nopolldelegator.delegatorData);
-  return;
+  // Socket is unregistered from the loop before nopoll closes it
+  it->second->socketHandler->unregisterHandler();
+  it->second->timer->cancelTimeout();
+  if(nopoll_conn_is_ok(it->second->conn))
+    nopoll_conn_close(it->second->conn);
+  else
+    nopoll_conn_unref(it->second->conn);
+  nopollRequest->conn = NULL;
+  connections_.erase(it);
+}
+
+void NopollWebsocket::send(NopollRequest* nopollRequest) {
+  nopollRequest->messageType = REQUEST_MESSAGE_TYPE_SEND;
+  OutgoingMessage message{NOPOLL_TEXT_FRAME, nopollRequest->sendMessageData};
+  wsLoopThread_.getEventBase()->runInEventBaseThread([this, nopollRequest, message]() {
+    enqueueSend(nopollRequest, message);
+  });
 }
 
 void NopollWebsocket::sendBinary(NopollRequest* nopollRequest) {
   nopollRequest->messageType = REQUEST_MESSAGE_TYPE_SENDBINARY;
-  requestQueueLock_.lock();
-  RequestQueue_.push(nopollRequest);
-  requestQueueLock_.unlock();
-  sem_post(&startDownloadingThread_);
+  std::string base64Data = nopollRequest->sendMessageBase64Data;
+  wsLoopThread_.getEventBase()->runInEventBaseThread([this, nopollRequest, base64Data]() {
+    int wsBufferSize = B64DECODE_OUT_SAFESIZE(base64Data.length());
+    std::string webSocketBuffer(wsBufferSize, '\0');
+    if(!nopoll_base64_decode(base64Data.c_str(), base64Data.length(), &webSocketBuffer[0], &wsBufferSize)) {
+      if(nopollRequest->nopolldelegator.NOPOLLFailureCallback)
+        nopollRequest->nopolldelegator.NOPOLLFailureCallback((char*)"base64 string error", nopollRequest->nopolldelegator.delegatorData);
+      return;
+    }
+    webSocketBuffer.resize(wsBufferSize);
+    enqueueSend(nopollRequest, OutgoingMessage{NOPOLL_BINARY_FRAME, std::move(webSocketBuffer)});
+  });
 }
 
-void NopollWebsocket::sendBinaryNopoll(NopollRequest* nopollRequest) {
-  if(!nopollRequest)
+void NopollWebsocket::enqueueSend(NopollRequest* nopollRequest, OutgoingMessage message) {
+  Connection* connection = getConnection(nopollRequest, "send");
+  if(!connection)
     return;
-  int result = 0;
-  char webSocketBuffer[B64DECODE_OUT_SAFESIZE(nopollRequest->sendMessageBase64Data.length())];
-  int size = B64DECODE_OUT_SAFESIZE(nopollRequest->sendMessageBase64Data.length()); 
-  int wsBufferSize = B64DECODE_OUT_SAFESIZE(nopollRequest->sendMessageBase64Data.length());
-  if(!nopoll_base64_decode(nopollRequest->sendMessageBase64Data.c_str(), nopollRequest->sendMessageBase64Data.length(),
-      webSocketBuffer, &wsBufferSize)) {
-      if(nopollRequest->nopolldelegator.NOPOLLFailureCallback)
-        nopollRequest->nopolldelegator.NOPOLLFailureCallback((char*)"base64 string error", nopollRequest->nopolldelegator.delegatorData);
+  if(connection->queuedBytes + message.data.size() > WEBSOCKET_MAX_SEND_QUEUE_BYTES) {
+    RNS_LOG_ERROR("websocket send queue is full, " << connection->queuedBytes << " bytes pending");
+    if(nopollRequest->nopolldelegator.NOPOLLFailureCallback)
+      nopollRequest->nopolldelegator.NOPOLLFailureCallback((char*)"sending data is failed, send queue is full", nopollRequest->nopolldelegator.delegatorData);
     return;
   }
-  else if(nopollRequest->conn != NULL) {
-    result = nopoll_conn_send_binary(nopollRequest->conn, webSocketBuffer,strlen(webSocketBuffer) );
-    if (result == strlen(webSocketBuffer)) {
-      RNS_LOG_DEBUG("sending binary data sucessfully");
+  connection->queuedBytes += message.data.size();
+  connection->sendQueue.push_back(std::move(message));
+  flushSendQueue(*connection);
+}
+
+void NopollWebsocket::flushSendQueue(Connection& connection) {
+  // Frame partially written on a previous attempt has to be completed first, in order
+  if(nopoll_conn_pending_write_bytes(connection.conn) > 0) {
+    nopoll_conn_complete_pending_write(connection.conn);
+  }
+  while(!connection.sendQueue.empty() && (nopoll_conn_pending_write_bytes(connection.conn) == 0)) {
+    OutgoingMessage& message = connection.sendQueue.front();
+    int result = (message.opCode == NOPOLL_TEXT_FRAME) ?
+        nopoll_conn_send_text(connection.conn, message.data.c_str(), message.data.length()) :
+        nopoll_conn_send_binary(connection.conn, message.data.c_str(), message.data.length());
+    if(result < 0 && nopoll_conn_pending_write_bytes(connection.conn) == 0) {
+      failConnection(connection, (message.opCode == NOPOLL_TEXT_FRAME) ? "sending data is failed" : "sending binary data is failed");
       return;
-    } 
+    }
+    connection.queuedBytes -= message.data.size();
+    connection.sendQueue.pop_front();
   }
-  
-  if(nopollRequest->nopolldelegator.NOPOLLFailureCallback)
-    nopollRequest->nopolldelegator.NOPOLLFailureCallback((char*)"sending binary data is failed", nopollRequest->nopolldelegator.delegatorData);
-  return;
+  // Watch writability only while there is a backlog
+  uint16_t events = folly::EventHandler::READ | folly::EventHandler::PERSIST;
+  if(nopoll_conn_pending_write_bytes(connection.conn) > 0 || !connection.sendQueue.empty()) {
+    events |= folly::EventHandler::WRITE;
+  }
+  connection.socketHandler->registerHandler(events);
+}
+
+void NopollWebsocket::close(NopollRequest* nopollRequest) {
+  nopollRequest->messageType = REQUEST_MESSAGE_TYPE_CLOSE;
+  wsLoopThread_.getEventBase()->runInEventBaseThread([this, nopollRequest]() {
+    closeOnLoop(nopollRequest);
+  });
 }
 
+void NopollWebsocket::closeOnLoop(NopollRequest* nopollRequest) {
+  if(pendingConnects_.erase(nopollRequest)) {
+    // Socket is closed once its connect thread hands it over
+    if(nopollRequest->nopolldelegator.NOPOLLDisconnectCallback)
+      nopollRequest->nopolldelegator.NOPOLLDisconnectCallback(nopollRequest->nopolldelegator.delegatorData);
+    return;
+  }
+  auto it = connections_.find(nopollRequest);
+  if(it == connections_.end()) {
+    if(nopollRequest->nopolldelegator.NOPOLLFailureCallback)
+      nopollRequest->nopolldelegator.NOPOLLFailureCallback((char*)"close connection is failed", nopollRequest->nopolldelegator.delegatorData);
+    return;
+  }
+  noPollConn* conn = it->second->conn;
+  it->second->socketHandler->unregisterHandler();
+  it->second->timer->cancelTimeout();
+  connections_.erase(it);
+  nopollRequest->conn = NULL;
+  nopoll_conn_close_ext(conn, nopollRequest->closeRequestCode, nopollRequest->closeReason.c_str(), nopollRequest->closeReason.size());
+  if(nopollRequest->nopolldelegator.NOPOLLDisconnectCallback)
+    nopollRequest->nopolldelegator.NOPOLLDisconnectCallback(nopollRequest->nopolldelegator.delegatorData);
+}
+
+void NopollWebsocket::ping(NopollRequest* nopollRequest) {
+  nopollRequest->messageType = REQUEST_MESSAGE_TYPE_PING;
+  wsLoopThread_.getEventBase()->runInEventBaseThread([this, nopollRequest]() {
+    pingOnLoop(nopollRequest);
+  });
+}
+
+void NopollWebsocket::pingOnLoop(NopollRequest* nopollRequest) {
+  Connection* connection = getConnection(nopollRequest, "ping");
+  if(!connection)
+    return;
+  if(!nopoll_conn_send_ping(connection->conn)) {
+    failConnection(*connection, "ping operation failed");
+  }
+}
+
+}
 }
-}
\ No newline at end of file
@@ -1,23 +1,41 @@
-/*  * Copyright (C) 1994-2021 OpenTV, Inc. and Nagravision S.A.  
-*  * This source code is licensed under the MIT license found in the  
+/*  * Copyright (C) 1994-2021 OpenTV, Inc. and Nagravision S.A.
+*  * This source code is licensed under the MIT license found in the
 * LICENSE file in the root directory of this source tree.  */
 #include <nopoll.h>
-#include <thread> 
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
 #include <mutex>
-#include <semaphore.h>
-#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <folly/io/async/AsyncTimeout.h>
+#include <folly/io/async/EventHandler.h>
+#include <folly/io/async/ScopedEventBaseThread.h>
 
 #define WEBSOCKET_URL 0
 #define WEBSOCKET_PORTNO 1
+#define WEBSOCKET_PATH 2
 #define WEBSOCKET_RETURN_SUCESS 0
 #define WEBSOCKET_RETURN_FAILURE -1
 #define B64DECODE_OUT_SAFESIZE(x) (((x)*3)/4)
-#define MAX_WORKER_THEAD_COUNT 5
+#define WEBSOCKET_HANDSHAKE_TIMEOUT_MS 5000
+#define WEBSOCKET_PING_INTERVAL_MS 30000 // Ping is sent after this idle time, connection fails after twice of it
+#define WEBSOCKET_MAX_SEND_QUEUE_BYTES (16*1024*1024) // Sends are failed beyond this backlog
+#define WEBSOCKET_MAX_MESSAGE_BYTES (16*1024*1024) // Connection is failed on a bigger incoming message
 
 namespace facebook {
 namespace react {
+typedef enum WebsocketMessageType {
+  WEBSOCKET_MESSAGE_TEXT,
+  WEBSOCKET_MESSAGE_BINARY
+}WebsocketMessageType;
+
 typedef struct Nopolldelegator {
-  std::function<void(std::string& , const char* , void*)> NOPOLLMessageHandlerCallback;
+  // Payload holds the complete (reassembled) message with its length, binary data may contain '\0'
+  std::function<void(WebsocketMessageType, std::shared_ptr<std::string>, void*)> NOPOLLMessageHandlerCallback;
   std::function<void(char*, void*)> NOPOLLFailureCallback;
   std::function<void(void*)> NOPOLLConnectCallback;
   std::function<void(void*)> NOPOLLDisconnectCallback;
@@ -36,7 +54,7 @@ class NopollRequest {
  public :
   char* url;
   int closeRequestCode;
-  std::string sendMessageData; 
+  std::string sendMessageData;
   std::string closeReason;
   std::string sendMessageBase64Data;
   noPollConn* conn;
@@ -45,6 +63,15 @@ class NopollRequest {
   NopollRequest(char* lurl):url(lurl),conn(NULL){};
 };
 
+/*
+ * WebSocket transport running all the connections on a single event loop thread.
+ * Requests are posted to the loop, connection sockets are watched by the loop for
+ * the handshake completion, incoming messages & writability, so no thread is spawned
+ * or polling per request. Name resolution, TCP/TLS connect & handshake request block
+ * in nopoll, so each connection runs them on its own connect thread, which hands the
+ * socket over to the loop. Outgoing messages are queued per connection and written as
+ * the socket drains, idle connections are kept alive with ping on the same loop.
+ */
 class NopollWebsocket {
 
 public:
@@ -55,25 +82,59 @@ public:
  void sendBinary(NopollRequest*);
  void ping(NopollRequest*);
  void close(NopollRequest*);
- void getConnectNopoll(NopollRequest*);
- void sendNopoll(NopollRequest*);
- void sendBinaryNopoll(NopollRequest*);
- void pingNopoll(NopollRequest*);
- void closeNopoll(NopollRequest*);
- std::thread wsMessageThread_;
  std::string * parseUrl(std::string& url);
  static NopollWebsocket* sharedNopollWebsocket();
- void multiConn();
- void pollThread();
 private:
+ struct OutgoingMessage {
+   noPollOpCode opCode;
+   std::string data;
+ };
+ class SocketHandler : public folly::EventHandler {
+  public:
+   SocketHandler(folly::EventBase* eventBase, NOPOLL_SOCKET socket, std::function<void(uint16_t)> callback)
+     : folly::EventHandler(eventBase, folly::NetworkSocket::fromFd(socket)), callback_(callback) {}
+   void handlerReady(uint16_t events) noexcept override { callback_(events); }
+  private:
+   std::function<void(uint16_t)> callback_;
+ };
+ struct Connection {
+   NopollRequest* request;
+   noPollConn* conn;
+   bool isReady{false}; // Handshake completed
+   std::unique_ptr<SocketHandler> socketHandler;
+   std::unique_ptr<folly::AsyncTimeout> timer; // Handshake timeout, then keepalive
+   std::deque<OutgoingMessage> sendQueue;
+   size_t queuedBytes{0};
+   std::chrono::steady_clock::time_point lastActivity;
+   std::shared_ptr<std::string> incomingMessage; // Fragments received so far, handed over to the delegator once final
+   noPollOpCode incomingOpCode{NOPOLL_UNKNOWN_OP_CODE};
+   bool incomingSplitFrame{false}; // Last piece was a frame split by nopoll on a partial read
+ };
+
+ // Called on the connect threads only
+ noPollConn* openConnection(NopollRequest*);
+ // Called on the loop thread only
+ void connectOnLoop(NopollRequest*, noPollConn*);
+ void enqueueSend(NopollRequest*, OutgoingMessage message);
+ void flushSendQueue(Connection&);
+ void pingOnLoop(NopollRequest*);
+ void closeOnLoop(NopollRequest*);
+ void onSocketReady(Connection&, uint16_t events);
+ bool onMessage(Connection&, noPollMsg*);
+ void onTimer(Connection&);
+ void failConnection(Connection&, const char* message);
+ void closedByPeer(Connection&);
+ void removeConnection(NopollRequest*);
+ Connection* getConnection(NopollRequest*, const char* operation);
+
  noPollCtx* ctx_;
  static NopollWebsocket *sharedNopollWebsocket_;
  static std::mutex requestLock_;
- std::queue<NopollRequest*> RequestQueue_;
- int currentWorkerThreadCount_ = 0;
- std::mutex threadCountLock_;
- std::mutex requestQueueLock_;
- sem_t startDownloadingThread_;  /*semaphore to signal downloading thread to start, once there is something in the list*/
+ folly::ScopedEventBaseThread wsLoopThread_{"RNSWebSocket"};
+ std::unordered_map<NopollRequest*, std::unique_ptr<Connection>> connections_; // Accessed on loop thread only
+ std::unordered_set<NopollRequest*> pendingConnects_; // Connecting on a connect thread, accessed on loop thread only
+ std::unordered_map<uint64_t, std::thread> connectThreads_; // Joined once they hand over, accessed on loop thread only
+ uint64_t nextConnectId_{0};
 
 };
 }
@@ -7,6 +7,7 @@
 
 #include "include/core/SkFont.h"
 #include "include/core/SkFontMgr.h"
+#include "include/core/SkSurface.h"
 
 #include "ReactSkia/utils/RnsUtils.h"
 
@@ -36,6 +37,15 @@ namespace sdk {
 
 */
 
+OnScreenKeyboard::OnScreenKeyboard() {
+  memoryPressureClientId_ = RNSMemoryPressureBroker::instance()->addClient("OSKKeyTileAtlas",
+      std::bind(&OnScreenKeyboard::trimKeyTileAtlases, this, std::placeholders::_1));
+}
+
+OnScreenKeyboard::~OnScreenKeyboard() {
+  RNSMemoryPressureBroker::instance()->removeClient(memoryPressureClientId_);
+}
+
 OnScreenKeyboard& OnScreenKeyboard::getInstance() {
   static OnScreenKeyboard oskHandle;
   return oskHandle;
@@ -138,6 +148,13 @@ void OnScreenKeyboard::launchOSKWindow() {
       generateOSKLayout_=false;
   }
 
+  // Key tiles are rasterized with the layout positions & the theme, rebuild them on change
+  if(generateOSKLayout_ || (atlasTheme_ != oskConfig_.theme) || (atlasReturnKeyLabel_ != oskConfig_.returnKeyLabel)) {
+    keyTileAtlases_.clear();
+    atlasTheme_=oskConfig_.theme;
+    atlasReturnKeyLabel_=oskConfig_.returnKeyLabel;
+  }
+
   //Set up OSk configuration
   if(oskConfig_.type == OSK_ALPHA_NUMERIC_KB) {
     oskLayout_.kbLayoutType = ALPHA_LOWERCASE_LAYOUT;
@@ -309,6 +326,18 @@ void OnScreenKeyboard::drawKBLayout(std::vector<SkIRect> &dirtyRect) {
   unsigned int KeyCount=oskLayout_.keyInfo->at(rowCount).size()-1;
   oskLayout_.kBHeight=(oskLayout_.keyPos->at(rowCount).at(KeyCount).highlightTile.fBottom+3)-oskLayout_.kBVerticalStart;
 
+  /* Layout is a single blit of its pre-rendered keys*/
+  KeyTileAtlas *atlas=keyTileAtlas(true);
+  if(atlas) {
+    pictureCanvas_->drawImage(atlas->keys,atlas->bounds.x(),atlas->bounds.y());
+    if(isReturnKeyInactive()) {
+      drawKeyTile(oskLayout_.returnKeyIndex,false);
+    }
+    dirtyRect.push_back(atlas->bounds);
+    RNS_PROFILE_END("OSk Draw completion : ",OSKDraw)
+    return;
+  }
+
   clearScreen( oskLayout_.horizontalStartOffset,oskLayout_.kBVerticalStart,
                oskLayout_.placeHolderLength,oskLayout_.kBHeight,
                oskBGPaint_);
@@ -322,20 +351,7 @@ void OnScreenKeyboard::drawKBLayout(std::vector<SkIRect> &dirtyRect) {
       }
     }
     /*2. Draw KB partition*/
-    if(oskConfig_.type != OSK_NUMERIC_KB) {
-      SkPaint paint;
-      paint.setColor(placeHolderPaint_.getColor());
-      paint.setStrokeWidth(2);
-      unsigned int startY,xpos,endY;
-      startY=oskLayout_.keyPos->at(0).at(0).highlightTile.fTop - oskLayout_.kbGroupConfig[oskLayout_.keyInfo->at(0).at(0).kbPartitionId].groupKeySpacing.y();
-      endY=oskLayout_.keyPos->at(rowCount).at(KeyCount).highlightTile.fBottom+3;
-      for (unsigned int index=1;index<oskLayout_.keyInfo->at(0).size();index++) {
-        if(oskLayout_.keyInfo->at(0).at(index).kbPartitionId != oskLayout_.keyInfo->at(0).at(index-1).kbPartitionId) {
-          xpos=oskLayout_.keyPos->at(0).at(index).highlightTile.x()-(oskLayout_.keyPos->at(0).at(index).highlightTile.fLeft - oskLayout_.keyPos->at(0).at(index-1).highlightTile.fRight)/2;
-          pictureCanvas_->drawLine(xpos,startY,xpos,endY,paint);
-        }
-      }
-    }
+    drawKBPartitions();
   }
   dirtyRect.push_back(SkIRect::MakeXYWH(oskLayout_.horizontalStartOffset,oskLayout_.kBVerticalStart,
                              oskLayout_.placeHolderLength,oskLayout_.kBHeight));
@@ -343,6 +359,124 @@ void OnScreenKeyboard::drawKBLayout(std::vector<SkIRect> &dirtyRect) {
   RNS_PROFILE_END("OSk Draw completion : ",OSKDraw)
 }
 
+void OnScreenKeyboard::drawKBPartitions() {
+
+  if(oskConfig_.type == OSK_NUMERIC_KB) return;
+
+  unsigned int rowCount=oskLayout_.keyInfo->size()-1;
+  unsigned int KeyCount=oskLayout_.keyInfo->at(rowCount).size()-1;
+  SkPaint paint;
+  paint.setColor(placeHolderPaint_.getColor());
+  paint.setStrokeWidth(2);
+  unsigned int startY,xpos,endY;
+  startY=oskLayout_.keyPos->at(0).at(0).highlightTile.fTop - oskLayout_.kbGroupConfig[oskLayout_.keyInfo->at(0).at(0).kbPartitionId].groupKeySpacing.y();
+  endY=oskLayout_.keyPos->at(rowCount).at(KeyCount).highlightTile.fBottom+3;
+  for (unsigned int index=1;index<oskLayout_.keyInfo->at(0).size();index++) {
+    if(oskLayout_.keyInfo->at(0).at(index).kbPartitionId != oskLayout_.keyInfo->at(0).at(index-1).kbPartitionId) {
+      xpos=oskLayout_.keyPos->at(0).at(index).highlightTile.x()-(oskLayout_.keyPos->at(0).at(index).highlightTile.fLeft - oskLayout_.keyPos->at(0).at(index-1).highlightTile.fRight)/2;
+      pictureCanvas_->drawLine(xpos,startY,xpos,endY,paint);
+    }
+  }
+}
+
+SkIRect OnScreenKeyboard::keyBoardBounds() {
+  SkRect bounds=SkRect::MakeXYWH(oskLayout_.horizontalStartOffset,oskLayout_.kBVerticalStart,
+                                 oskLayout_.placeHolderLength,oskLayout_.kBHeight);
+  if(oskConfig_.type != OSK_NUMERIC_KB) {
+    /* Partitions start a key spacing above the first row*/
+    SkScalar partitionTop=oskLayout_.keyPos->at(0).at(0).highlightTile.fTop - oskLayout_.kbGroupConfig[oskLayout_.keyInfo->at(0).at(0).kbPartitionId].groupKeySpacing.y();
+    bounds.fTop=std::min(bounds.fTop,partitionTop-1);
+  }
+  return bounds.roundOut();
+}
+
+OnScreenKeyboard::KeyTileAtlas* OnScreenKeyboard::keyTileAtlas(bool createIfMissing) {
+
+  KBLayoutType layoutType=(oskConfig_.type == OSK_NUMERIC_KB) ? NUMERIC_LAYOUT : oskLayout_.kbLayoutType;
+  auto it=keyTileAtlases_.find(layoutType);
+  if(it != keyTileAtlases_.end()) {
+    return &it->second;
+  }
+  if(!createIfMissing) {
+    return nullptr;
+  }
+  KeyTileAtlas atlas;
+  if(!createKeyTileAtlas(atlas)) {
+    return nullptr;
+  }
+  return &(keyTileAtlases_[layoutType]=atlas);
+}
+
+bool OnScreenKeyboard::createKeyTileAtlas(KeyTileAtlas &atlas) {
+
+  RNS_PROFILE_START(OSKKeyTileAtlas)
+  atlas.bounds=keyBoardBounds();
+  SkImageInfo atlasInfo=SkImageInfo::MakeN32Premul(atlas.bounds.width(),atlas.bounds.height());
+  sk_sp<SkSurface> keysSurface=SkSurface::MakeRaster(atlasInfo);
+  sk_sp<SkSurface> highlightedKeysSurface=SkSurface::MakeRaster(atlasInfo);
+  if(!keysSurface || !highlightedKeysSurface) {
+    RNS_LOG_ERROR("Failed to create OSK key tile atlas of size : " << atlas.bounds.width() << "x" << atlas.bounds.height());
+    return false;
+  }
+
+  /* Keys are drawn with the live drawing code, redirected to the atlas surfaces*/
+  SkCanvas *pictureCanvas=pictureCanvas_;
+  renderingKeyTileAtlas_=true;
+  for(bool highlighted : {false,true}) {
+    pictureCanvas_=highlighted ? highlightedKeysSurface->getCanvas() : keysSurface->getCanvas();
+    pictureCanvas_->clear(oskBGPaint_.getColor());
+    pictureCanvas_->translate(-atlas.bounds.x(),-atlas.bounds.y());
+    for (unsigned int rowIndex = 0; rowIndex < oskLayout_.keyInfo->size(); rowIndex++) {
+      for (unsigned int keyIndex = 0; keyIndex < oskLayout_.keyInfo->at(rowIndex).size(); keyIndex++) {
+        if(highlighted) {
+          pictureCanvas_->drawRect(oskLayout_.keyPos->at(rowIndex).at(keyIndex).highlightTile,highLightTilePaint_);
+        }
+        drawKBKeyFont({keyIndex,rowIndex},highlighted);
+      }
+    }
+    if(!highlighted) {
+      drawKBPartitions();
+    }
+  }
+  renderingKeyTileAtlas_=false;
+  pictureCanvas_=pictureCanvas;
+
+  atlas.keys=keysSurface->makeImageSnapshot();
+  atlas.highlightedKeys=highlightedKeysSurface->makeImageSnapshot();
+  RNS_PROFILE_END("OSK Key Tile Atlas creation : ",OSKKeyTileAtlas)
+  return (atlas.keys && atlas.highlightedKeys);
+}
+
+size_t OnScreenKeyboard::trimKeyTileAtlases(MemoryPressureLevel level) {
+  std::scoped_lock lock(oskActiontCtrlMutex_);
+  // Atlas on screen is kept on moderate pressure, rest are rebuilt when their layout is shown next
+  KeyTileAtlas *atlasInUse=((oskState_ == OSK_STATE_ACTIVE) && (level == MemoryPressureModerate)) ? keyTileAtlas(false) : nullptr;
+  size_t bytesReclaimed{0};
+  for(auto it=keyTileAtlases_.begin();it != keyTileAtlases_.end();) {
+    if(&it->second == atlasInUse) {
+      it++;
+      continue;
+    }
+    bytesReclaimed += 2 * SkImageInfo::MakeN32Premul(it->second.bounds.width(),it->second.bounds.height()).computeMinByteSize();
+    it=keyTileAtlases_.erase(it);
+  }
+  return bytesReclaimed;
+}
+
+void OnScreenKeyboard::drawKeyTile(SkPoint index,bool highlighted) {
+
+  keyPosition_t &keyPos=oskLayout_.keyPos->at(index.y()).at(index.x());
+  KeyTileAtlas *atlas=keyTileAtlas(false);
+  /* Inactive look of the Return key is not in the atlas*/
+  if(atlas && !((index == oskLayout_.returnKeyIndex) && isReturnKeyInactive())) {
+    SkRect atlasTile=keyPos.highlightTile.makeOffset(-atlas->bounds.x(),-atlas->bounds.y());
+    pictureCanvas_->drawImageRect(highlighted ? atlas->highlightedKeys : atlas->keys,atlasTile,keyPos.highlightTile,nullptr);
+    return;
+  }
+  pictureCanvas_->drawRect(keyPos.highlightTile,highlighted ? highLightTilePaint_ : oskBGPaint_);
+  drawKBKeyFont(index,highlighted);
+}
+
 inline void OnScreenKeyboard::drawKBKeyFont(SkPoint index,bool onHLTile) {
 
   if(oskState_!= OSK_STATE_ACTIVE) return;
@@ -398,7 +532,7 @@ inline void OnScreenKeyboard::drawKBKeyFont(SkPoint index,bool onHLTile) {
       char* fontFamily=nullptr;
       if(!strcmp(keyName,"return")) {
      /* If autoActivateReturnKey_ is set. Return key to be presented in disabled/In-Active look until TI was empty.*/
-        if(autoActivateReturnKey_ && displayString_.empty()) {
+        if(!renderingKeyTileAtlas_ && isReturnKeyInactive()) {
           textPaint.setColor(inactiveTextPaint_.getColor());
         }
         if(oskConfig_.returnKeyLabel == OSK_RETURN_KEY_SEARCH) {
@@ -506,13 +640,11 @@ void OnScreenKeyboard ::drawHighLightOnKey(std::vector<SkIRect> &dirtyRect) {
   keyPosition_t & oldKeyPos=oskLayout_.keyPos->at(lastRowIndex).at(lastKeyIndex);
   keyPosition_t & keyPos=oskLayout_.keyPos->at(rowIndex).at(keyIndex);
 
-  pictureCanvas_->drawRect(oldKeyPos.highlightTile,oskBGPaint_);
-  drawKBKeyFont({lastKeyIndex,lastRowIndex});
+  drawKeyTile(lastFocussIndex_,false);
   dirtyRect.push_back(SkIRect::MakeXYWH(oldKeyPos.highlightTile.x(),oldKeyPos.highlightTile.y(),oldKeyPos.highlightTile.width(),oldKeyPos.highlightTile.height()));
 
   //Hight current focussed item
-  pictureCanvas_->drawRect(keyPos.highlightTile,highLightTilePaint_);
-  drawKBKeyFont({keyIndex,rowIndex},true);
+  drawKeyTile(currentFocussIndex_,true);
   dirtyRect.push_back(SkIRect::MakeXYWH(keyPos.highlightTile.x(),keyPos.highlightTile.y(),keyPos.highlightTile.width(),keyPos.highlightTile.height()));
 
   RNS_PROFILE_END(" Highlight Completion : ",HighlightOSKKey)
@@ -964,7 +1096,6 @@ void OnScreenKeyboard::repeatKeyProcessingThread(){
 
 void OnScreenKeyboard::triggerRenderRequest(OSKComponents components,bool batchRenderRequest) {
   std::scoped_lock lock(oskActiontCtrlMutex_);
-  SkPictureRecorder pictureRecorder_;
   std::string commandKey;
   std::vector<SkIRect>   dirtyRect;
   pictureCanvas_ = pictureRecorder_.beginRecording(SkRect::MakeXYWH(0, 0, screenSize_.width(), screenSize_.height()));
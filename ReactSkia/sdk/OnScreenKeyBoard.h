@@ -8,13 +8,16 @@
 #define OSK_H
 
 #include <semaphore.h>
+#include <map>
 #include <queue>
 
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
+#include "include/core/SkImage.h"
 
 #include "NotificationCenter.h"
 #include "RNSKeyCodeMapping.h"
+#include "RNSMemoryPressureBroker.h"
 #if ENABLE(FEATURE_KEY_THROTTLING)
 #include "ThreadSafeQueue.h"
 #endif /*ENABLE_FEATURE_KEY_THROTTLING*/
@@ -148,8 +151,15 @@ class OnScreenKeyboard : public WindowDelegator{
       SkScalar          kBVerticalStart;
     };
 
-    OnScreenKeyboard() = default;
-    ~OnScreenKeyboard() = default;
+    // Keys of a layout rasterized once, so that the layout & highlight updates are image blits
+    struct KeyTileAtlas {
+      SkIRect         bounds; // Key board area covered, in screen co-ordinates
+      sk_sp<SkImage>  keys; // Keys on the background, partitions included
+      sk_sp<SkImage>  highlightedKeys; // Keys on the highlight tile
+    };
+
+    OnScreenKeyboard();
+    ~OnScreenKeyboard();
 
     void launchOSKWindow();
     void onHWkeyHandler(rnsKey key, rnsKeyAction eventKeyAction,RnsShell::Window *window);
@@ -170,6 +180,13 @@ class OnScreenKeyboard : public WindowDelegator{
     void drawPlaceHolderDisplayString(std::vector<SkIRect> &dirtyRect);
     void drawKBLayout(std::vector<SkIRect> &dirtyRect);
     void drawKBKeyFont(SkPoint index,bool onHLTile=false);
+    void drawKBPartitions();
+    void drawKeyTile(SkPoint index,bool highlighted);
+    SkIRect keyBoardBounds();
+    KeyTileAtlas* keyTileAtlas(bool createIfMissing);
+    bool createKeyTileAtlas(KeyTileAtlas &atlas);
+    size_t trimKeyTileAtlases(MemoryPressureLevel level);
+    inline bool isReturnKeyInactive() { return (autoActivateReturnKey_ && displayString_.empty()); }
     static inline void onScreenKeyboardEventEmit(std::string eventType);
 
     std::mutex oskActiontCtrlMutex_;
@@ -209,7 +226,15 @@ class OnScreenKeyboard : public WindowDelegator{
     sem_t         sigKeyConsumed_;
     std::atomic<bool> waitingForKeyConsumedSignal_{false};
 #endif /*ENABLE_FEATURE_KEY_THROTTLING*/
+    SkPictureRecorder pictureRecorder_; // Reused across the render requests
     SkCanvas*     pictureCanvas_{nullptr};
+
+// Members for Key Tile Atlas
+    std::map<KBLayoutType,KeyTileAtlas> keyTileAtlases_;
+    OSKThemes     atlasTheme_{OSK_DARK_THEME};
+    OSKReturnKeyType atlasReturnKeyLabel_{OSK_RETURN_KEY_DEFAULT};
+    bool          renderingKeyTileAtlas_{false};
+    unsigned int  memoryPressureClientId_{0};
 };
 
 }// namespace sdk
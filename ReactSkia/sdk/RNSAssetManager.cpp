@@ -25,11 +25,24 @@ RNSAssetManager::RNSAssetManager(){
     if(length != 0){
       try{
         assetFile.seekg (0, assetFile.beg);
-        char * buffer = new char [length];
+        string Str(length, '\0');
         // read data as a block:
-        assetFile.read (buffer,length);
-        string Str(buffer);
-        assetDataFile_ = folly::parseJson(Str);
+        assetFile.read (&Str[0],length);
+        folly::dynamic assetDataFile = folly::parseJson(Str);
+        // Resolved once into a lookup table, instead of walking the json on every image load
+        auto assets = assetDataFile.find("assets");
+        if(assets != assetDataFile.items().end() && assets->second.isObject()) {
+          isAssetMapLoaded_ = true;
+          auto images = assets->second.find("images");
+          if(images != assets->second.items().end() && images->second.isObject()) {
+            assetPaths_.reserve(images->second.size());
+            for(auto &image : images->second.items()) {
+              auto path = image.second.find("path");
+              if(path != image.second.items().end() && path->second.isString())
+                assetPaths_[image.first.asString()] = path->second.getString();
+            }
+          }
+        }
       }
       catch(exception e){
         RNS_LOG_ERROR("json parsing failed");
@@ -51,14 +64,13 @@ RNSAssetManager* RNSAssetManager::instance(){
 
 string RNSAssetManager::getAssetPath(string uri){
   std::string result="";
-  if(assetDataFile_.find("assets") == assetDataFile_.items().end()){
+  if(!isAssetMapLoaded_){
     RNS_LOG_ERROR("Couldn't able to Load the asset file");
     return result;
   }
-  auto reqAsset = assetDataFile_["assets"]["images"];
-  auto pos = reqAsset.find(uri);
-  if( pos != reqAsset.items().end() ){
-    result = pos->second["path"].asString();
+  auto pos = assetPaths_.find(uri);
+  if( pos != assetPaths_.end() ){
+    result = pos->second;
     RNS_LOG_DEBUG("RNSAssetManager getDefaultAssetPATH"<<result);
   }else{
     RNS_LOG_ERROR("Image not found in assets");
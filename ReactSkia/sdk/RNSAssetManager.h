@@ -7,6 +7,7 @@
 #include <fstream>
 #include <iostream>
 #include <mutex>
+#include <unordered_map>
 #include <folly/json.h>
 using namespace std;
 namespace rns {
@@ -17,7 +18,8 @@ private:
   RNSAssetManager();
   static RNSAssetManager *RNSAssetManagerInstance_;
   static std::mutex mutex_;
-  folly::dynamic assetDataFile_ = folly::dynamic::object;
+  std::unordered_map<string, string> assetPaths_; // Image name to path, built once from the asset map file
+  bool isAssetMapLoaded_{false};
 public:  
   static RNSAssetManager* instance();
   string getAssetPath(string uri);
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <vector>
+
+#include "ReactSkia/utils/RnsLog.h"
+#include "RNSMemoryPressureBroker.h"
+
+namespace rns {
+namespace sdk {
+
+std::mutex RNSMemoryPressureBroker::mutex_;
+
+RNSMemoryPressureBroker* RNSMemoryPressureBroker::instance() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  static RNSMemoryPressureBroker *brokerInstance = new RNSMemoryPressureBroker(); // Never destroyed, clients are removed at any time
+  return brokerInstance;
+}
+
+unsigned int RNSMemoryPressureBroker::addClient(std::string name, TrimCallback trimCallback) {
+  std::lock_guard<std::mutex> lock(clientsMutex_);
+  unsigned int clientId = nextClientId_++;
+  clients_[clientId] = {name, trimCallback};
+  RNS_LOG_DEBUG("Memory pressure client added : " << name << " id : " << clientId);
+  return clientId;
+}
+
+void RNSMemoryPressureBroker::removeClient(unsigned int clientId) {
+  std::lock_guard<std::mutex> lock(clientsMutex_);
+  clients_.erase(clientId);
+}
+
+size_t RNSMemoryPressureBroker::notifyMemoryPressure(MemoryPressureLevel level) {
+  std::lock_guard<std::mutex> notifyLock(notifyMutex_);
+  std::vector<Client> clients;
+  {
+    // Callbacks take the locks of their caches, so they are not run with clientsMutex_ held
+    std::lock_guard<std::mutex> lock(clientsMutex_);
+    for(auto &client : clients_)
+      clients.push_back(client.second);
+  }
+
+  const char *levelName = (level == MemoryPressureCritical) ? "critical" : "moderate";
+  size_t totalReclaimedBytes = 0;
+  for(auto &client : clients) {
+    size_t reclaimedBytes = client.trimCallback ? client.trimCallback(level) : 0;
+    RNS_LOG_INFO("Memory pressure " << levelName << " : " << client.name << " reclaimed " << reclaimedBytes << " bytes");
+    totalReclaimedBytes += reclaimedBytes;
+  }
+  RNS_LOG_INFO("Memory pressure " << levelName << " : total reclaimed " << totalReclaimedBytes << " bytes from " << clients.size() << " cache(s)");
+  return totalReclaimedBytes;
+}
+
+} // namespace sdk
+} // namespace rns
@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#pragma once
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace rns {
+namespace sdk {
+
+enum MemoryPressureLevel {
+  MemoryPressureModerate = 1, // Drop what is not needed for the current screen
+  MemoryPressureCritical // Drop everything which can be rebuilt
+};
+
+/*
+ * Native side of the memory warnings. Caches register a trim callback, which frees memory as per the
+ * pressure level & returns the bytes reclaimed. Broker is notified on the memory pressure events of
+ * the platform (cgroup pressure level on linux) and runs all the callbacks on the notifying thread.
+ */
+class RNSMemoryPressureBroker {
+ public:
+  using TrimCallback = std::function<size_t(MemoryPressureLevel level)>;
+
+  static RNSMemoryPressureBroker* instance();
+
+  // Returns the id to remove the client with, callback must not add clients.
+  // Callbacks are run unlocked from a copy of the list, so one may still be called after its removeClient returns.
+  // Clients which are not singletons have to hold themselves weakly in the callback.
+  unsigned int addClient(std::string name, TrimCallback trimCallback);
+  void removeClient(unsigned int clientId);
+  // Returns the total bytes reclaimed, per client figures are logged
+  size_t notifyMemoryPressure(MemoryPressureLevel level);
+
+ private:
+  struct Client {
+    std::string name;
+    TrimCallback trimCallback;
+  };
+
+  RNSMemoryPressureBroker() = default;
+
+  static std::mutex mutex_;
+  std::mutex clientsMutex_;
+  std::mutex notifyMutex_; // Serializes the trims of the back to back pressure events
+  std::map<unsigned int, Client> clients_;
+  unsigned int nextClientId_{1};
+};
+
+} // namespace sdk
+} // namespace rns
@@ -4,6 +4,7 @@
 * This source code is licensed under the MIT license found in the
 * LICENSE file in the root directory of this source tree.
 */
+#include <functional>
 #include <mutex>
 #include <better/map.h>
 #include <better/optional.h>
@@ -32,7 +33,12 @@ class ThreadSafeCache {
   Timer * timer_{nullptr};
   double scheduleTimeExpiry_;
  public:
+  ~ThreadSafeCache() {
+    delete timer_; // Waits for an expiry callback in progress
+  }
+
   bool isAvailableInCache(const KeyT &key){
+    std::scoped_lock lock(cacheLock_);
     auto it = cacheMap_.find(key);
     if(it!= cacheMap_.end())
       return true;
@@ -48,7 +54,9 @@ class ThreadSafeCache {
     return it->second->value;
   }
 
+  // Runs on the timer thread, while entries are set & evicted from others
   void expiryTimerCallback() {
+    std::scoped_lock lock(cacheLock_);
     auto it =cacheMap_.begin();
     double currentTime = Timer::getCurrentTimeMSecs();
     std::chrono::duration<double, std::milli> milliseconds = Timer::getFutureTime().time_since_epoch();
@@ -94,6 +102,22 @@ class ThreadSafeCache {
     }
   }
 
+  // Removes the entries for which evict returns true & returns the count of removed entries
+  size_t evictIf(std::function<bool(const ValueT &value)> evict) {
+    std::scoped_lock lock(cacheLock_);
+    size_t evictCount = 0;
+    auto it = cacheMap_.begin();
+    while(it != cacheMap_.end()) {
+      if(evict(it->second->value)) {
+        it = cacheMap_.erase(it);
+        evictCount++;
+      } else {
+        it++;
+      }
+    }
+    return evictCount;
+  }
+
   bool needEvict(double requiredSize) {
     if(overallCurrentSize_+requiredSize < THREADSAFE_MAX_CACHE_HWM_LIMIT)
       return false;
@@ -40,6 +40,18 @@ class ThreadSafeQueue {
     return true;
   }
 
+  // Pops the front only if it satisfies the predicate
+  template<typename Predicate>
+  bool tryPopIf(Type& value, Predicate predicate) {
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    if(dataQueue_.empty() || !predicate(dataQueue_.front())) {
+      return false;
+    }
+    value = dataQueue_.front();
+    dataQueue_.pop();
+    return true;
+  }
+
   // Blocks when queue is empty
   void pop(Type& value) {
     std::unique_lock<std::mutex> lock(queueMutex_);
@@ -5,8 +5,11 @@
 * LICENSE file in the root directory of this source tree.
 */
 
+#include <algorithm>
 #include <vector>
 
+#include "include/core/SkPath.h"
+
 #include "NotificationCenter.h"
 #include "WindowDelegator.h"
 
@@ -23,7 +26,8 @@ namespace sdk {
  *> Works on expectation,client knows its screen's component and screen layout is fixed.
  *> Supports Partial Update, So Expects client would do component by component rendering all the time.
  *> As part of recorded commands, expects dirty regions associted with this draw and the updating component name
- *> Recent recorded command maintained for all the components.This will be used to redraw the screen, when current draw buffer misses old frames.
+ *> Recent recorded command maintained for all the components, keyed by the component name & kept in the order of
+    the first commit. This will be used to redraw the screen, when current draw buffer misses old frames.
 
    Rendering Logic followed by Window Delegator:
    =============================================
@@ -31,13 +35,26 @@ namespace sdk {
    "Dirty Rect of the current update received from client".
  (If buffer Age supported in Backend).
  *> If Buffer Age is "1", Write buffer is up to date and just needs to render received commands from the client.
- *>When Buffer Age is "0".Write buffer to be consider as empty and needs to redraw all the components in received order
-    to fill the missed frames
+ *> When Buffer Age is "0" or older than the damage history, Write buffer to be consider as empty and needs to redraw
+    all the components in received order.
  *> When "Buffer Age is anything other than "0" & "1", it means it is not empty but it misses few frames.
-    In this case, update the components which are set as inavlidate by client.
-    This is to reduce/ avoid rending of static component in the screen. So client is expected to set
-    "invalidate flag as false" for static/root components such as BACKGROUND and true for dynamic or components whose content will change.
+    Damage of the missed frames is taken from the damage history (same as the main compositor) & added to the current one.
+    Components overlapping this damage are redrawn in received order, clipped to the damage.
+
+   Overlay Mode (FEATURE_SUBWINDOW_OVERLAY):
+   =========================================
+ *> When an overlay host is set, no native window is created. Window is a layer composited by the main window's
+    compositor above its root layer, each component being a picture layer of it in the order of the first commit.
+ *> Component layer is framed to its dirty rects, so its damage is its last & current bounds. Buffer age & batching
+    are handled by the compositor, same as for the root layer tree.
+ *> Main window keys are sent to the top most overlay, through the sub window notification center.
 */
+#if ENABLE(FEATURE_SUBWINDOW_OVERLAY)
+RnsShell::RendererDelegate* WindowDelegator::overlayHost_{nullptr};
+std::vector<WindowDelegator*> WindowDelegator::overlayKeyFocusStack_;
+std::mutex WindowDelegator::overlayKeyFocusMutex_;
+#endif/*FEATURE_SUBWINDOW_OVERLAY*/
+
 void WindowDelegator::createWindow(SkSize windowSize,std::function<void ()> windowReadyCB,bool runOnTaskRunner) {
 
   windowSize_=windowSize;
@@ -56,6 +73,13 @@ void WindowDelegator::createWindow(SkSize windowSize,std::function<void ()> wind
 
 void  WindowDelegator::createNativeWindow() {
 
+#if ENABLE(FEATURE_SUBWINDOW_OVERLAY)
+  isOverlay_ = (overlayHost_ != nullptr);
+  if(isOverlay_) {
+    createOverlayLayer();
+    return;
+  }
+#endif/*FEATURE_SUBWINDOW_OVERLAY*/
   displayPlatForm_=RnsShell::PlatformDisplay::sharedDisplayForCompositing().type();
 
   if(displayPlatForm_ == RnsShell::PlatformDisplay::Type::X11) {
@@ -117,6 +141,11 @@ void WindowDelegator::closeWindow() {
 void WindowDelegator::closeNativeWindow() {
   std::scoped_lock lock(renderCtrlMutex_);
 
+#if ENABLE(FEATURE_SUBWINDOW_OVERLAY)
+  if(overlayLayer_) {
+    closeOverlayLayer();
+  }
+#endif/*FEATURE_SUBWINDOW_OVERLAY*/
   if(exposeEventID_ != -1) {
     NotificationCenter::defaultCenter().removeListener(exposeEventID_);
     exposeEventID_=-1;
@@ -131,6 +160,11 @@ void WindowDelegator::closeNativeWindow() {
   windowDelegatorCanvas_=nullptr;
   windowReadyTodrawCB_=nullptr;
   recentComponentCommands_.clear();
+  recentCommandIndex_.clear();
+  dirtyRects_.clear();
+#if USE(RNS_SHELL_PARTIAL_UPDATES)
+  damageHistory_.clear();
+#endif/*RNS_SHELL_PARTIAL_UPDATES*/
 }
 
 void WindowDelegator::commitDrawCall(std::string pictureCommandKey,PictureObject pictureObj,bool batchCommit) {
@@ -155,50 +189,33 @@ inline void WindowDelegator::renderToDisplay(std::string pictureCommandKey,Pictu
    RNS_LOG_INFO("Batching Request    : "<<batchCommit);
 #endif
 
+#if ENABLE(FEATURE_SUBWINDOW_OVERLAY)
+  if(isOverlay_) {
+    renderToOverlay(pictureCommandKey,pictureObj,batchCommit);
+    return;
+  }
+#endif/*FEATURE_SUBWINDOW_OVERLAY*/
+
   std::scoped_lock lock(renderCtrlMutex_);
 
 #if USE(RNS_SHELL_PARTIAL_UPDATES) && defined(RNS_SHELL_HAS_GPU_SUPPORT)
   int bufferAge=windowContext_->bufferAge();
 
-  if((bufferAge !=1) && batchCommit) {
-    //To avoid reduntant painting   & dirt Rect calculation. Just store the command.
-    //Rest will be handled , when Render Requested by client.
-    updateRecentCommand(pictureCommandKey,pictureObj);
-    return;
-  }
-
-  updateRecentCommand(pictureCommandKey,pictureObj,bufferAge,true);
+  updateRecentCommand(pictureCommandKey,pictureObj);
 
   if(bufferAge != 1) {
-// use Stored commands to fill missed frames in the write buffer in the order it received.
-
-    PictureCommandPairs::iterator it = recentComponentCommands_.begin();
-    bool fullScreenAddedAsDirtyRect{false};
-
-    for( ;it != recentComponentCommands_.end() ;it++ ) {
-      if(it->second.pictureCommand.get() ) {
-        RNS_LOG_DEBUG("playback PictureCommand for component : "<<it->first);
-        it->second.pictureCommand->playback(windowDelegatorCanvas_);
-
-          if(supportsPartialUpdate_ && !fullScreenAddedAsDirtyRect) {
-            if(bufferAge ==0 ) {
-                //Update complete Screen if Buffer Age is "0"
-                RNS_LOG_DEBUG("Buffer Age is 0, Doing Full Screen Update : ");
-                generateDirtyRect(fullScreenDirtyRects_);
-                fullScreenAddedAsDirtyRect=true;
-            } else if(it->second.invalidate) {
-              RNS_LOG_DEBUG("Updating dirty Rect for component : "<<it->first);
-              generateDirtyRect((it->second).dirtyRect);
-            }
-          }
-      }
+    //To avoid reduntant painting, batched commands are just stored with their damage.
+    //Rest will be handled , when Render Requested by client.
+    if(batchCommit) {
+      return;
     }
+    repaintFromRecentCommands(bufferAge);
   } else
 #endif/*RNS_SHELL_HAS_GPU_SUPPORT*/
   {
     if(pictureObj.pictureCommand.get()) {
       pictureObj.pictureCommand->playback(windowDelegatorCanvas_);
-#if USE(RNS_SHELL_PARTIAL_UPDATES)
+#if USE(RNS_SHELL_PARTIAL_UPDATES) && !defined(RNS_SHELL_HAS_GPU_SUPPORT)
       if(supportsPartialUpdate_) {
         generateDirtyRect(pictureObj.dirtyRect);
       }
@@ -223,63 +240,196 @@ inline void WindowDelegator::renderToDisplay(std::string pictureCommandKey,Pictu
     }
     if(windowContext_) {
       windowContext_->swapBuffers(dirtyRects_);
+#if USE(RNS_SHELL_PARTIAL_UPDATES)
+      if(supportsPartialUpdate_) {
+        damageHistory_.push(dirtyRects_);
+      }
+#endif/*RNS_SHELL_PARTIAL_UPDATES*/
       std::vector<SkIRect> emptyVect;
       dirtyRects_.swap(emptyVect);
     }
   }
 }
 
-void WindowDelegator::updateRecentCommand(std::string pictureCommandKey,PictureObject &pictureObj,
-                                                  int bufferAge,bool isUpdateDirtyRect) {
+void WindowDelegator::repaintFromRecentCommands(int bufferAge) {
+// use Stored commands to fill missed frames in the write buffer in the order it received.
+  bool fullRepaint{true};
+#if USE(RNS_SHELL_PARTIAL_UPDATES)
+  if(supportsPartialUpdate_) {
+    fullRepaint = !damageHistory_.addMissedDamages(bufferAge,dirtyRects_);
+    if(fullRepaint) {
+      //Update complete Screen if Buffer Age is "0" or older than the history
+      RNS_LOG_DEBUG("Buffer Age is " << bufferAge << ", Doing Full Screen Update : ");
+      dirtyRects_=fullScreenDirtyRects_;
+    }
+  }
+#endif/*RNS_SHELL_PARTIAL_UPDATES*/
+
+  SkAutoCanvasRestore autoRestore(windowDelegatorCanvas_,true);
+  if(!fullRepaint) {
+    SkPath clipPath;
+    for(SkIRect &dirtyRect:dirtyRects_) {
+      clipPath.addRect(SkRect::Make(dirtyRect));
+    }
+    windowDelegatorCanvas_->clipPath(clipPath);
+  }
 
-  PictureCommandPair commandPair=std::make_pair(pictureCommandKey,pictureObj);
+  for(auto &command:recentComponentCommands_) {
+    if(!command.second.pictureCommand.get()) {
+      continue;
+    }
+    if(!fullRepaint) {
+      // Components outside the damage are intact in this buffer
+      bool isDamaged{false};
+      for(SkIRect &componentRect:command.second.dirtyRect) {
+        for(SkIRect &dirtyRect:dirtyRects_) {
+          if(SkIRect::Intersects(componentRect,dirtyRect)) {
+            isDamaged=true;
+            break;
+          }
+        }
+        if(isDamaged) break;
+      }
+      if(!isDamaged) continue;
+    }
+    RNS_LOG_DEBUG("playback PictureCommand for component : "<<command.first);
+    command.second.pictureCommand->playback(windowDelegatorCanvas_);
+  }
+}
 
-  auto it = std::find_if(recentComponentCommands_.begin(), recentComponentCommands_.end(),
-                            [&] (PictureCommandPair cmdPair) {
-              if(cmdPair.first == pictureCommandKey) {
-                return true;
-              }
-              return false;
-            });
+void WindowDelegator::updateRecentCommand(std::string &pictureCommandKey,PictureObject &pictureObj) {
 
-  if(it != recentComponentCommands_.end()) {
+  auto it = recentCommandIndex_.find(pictureCommandKey);
+  if(it != recentCommandIndex_.end()) {
+    PictureObject &recentPictureObj=recentComponentCommands_[it->second].second;
 #if USE(RNS_SHELL_PARTIAL_UPDATES)
     //Update component's current dirtyRect on screen
-    if(isUpdateDirtyRect && supportsPartialUpdate_ && (bufferAge!=0)) {
-      generateDirtyRect(it->second.dirtyRect);
+    if(supportsPartialUpdate_) {
+      generateDirtyRect(recentPictureObj.dirtyRect);
     }
 #endif//RNS_SHELL_PARTIAL_UPDATES
-    *it=commandPair;
+    recentPictureObj=pictureObj;
   } else {
-    recentComponentCommands_.push_back(commandPair);
+    recentCommandIndex_[pictureCommandKey]=recentComponentCommands_.size();
+    recentComponentCommands_.push_back(std::make_pair(pictureCommandKey,pictureObj));
   }
+#if USE(RNS_SHELL_PARTIAL_UPDATES)
+  if(supportsPartialUpdate_) {
+    generateDirtyRect(pictureObj.dirtyRect);
+  }
+#endif//RNS_SHELL_PARTIAL_UPDATES
 }
 
 #if USE(RNS_SHELL_PARTIAL_UPDATES)
 inline void WindowDelegator:: generateDirtyRect(std::vector<SkIRect> &componentDirtRects){
   for(SkIRect& comDirtyRect:componentDirtRects) {
-    bool addToDirtyRect{true};
-    if(!dirtyRects_.empty()) {
-      std::vector<SkIRect>::iterator it = dirtyRects_.begin();
-      while( it != dirtyRects_.end()) {
-        SkIRect &dirtyRect = *it;
-        if((dirtyRect == comDirtyRect) || dirtyRect.contains(comDirtyRect) ) {
-          addToDirtyRect=false;// If same or part of existing ignore
-          break;
-        }
-        if(comDirtyRect.contains(dirtyRect)) {
-          it=dirtyRects_.erase(it);//Erase existing dirtRect , if it is part of new one
-        } else {
-          ++it;
-        }
-      }
+    RnsShell::Layer::addDamageRect(dirtyRects_,comDirtyRect);
+  }
+}
+#endif /*RNS_SHELL_PARTIAL_UPDATES*/
+#if ENABLE(FEATURE_SUBWINDOW_OVERLAY)
+void WindowDelegator::createOverlayLayer() {
+  overlayLayer_ = RnsShell::Layer::Create(*overlayHost_);
+  overlayLayer_->setFrame(SkIRect::MakeWH(windowSize_.width(),windowSize_.height()));
+
+  overlayHost_->begin();
+  overlayHost_->addOverlayLayer(overlayLayer_);
+  overlayHost_->commit(false);
+  {
+    std::scoped_lock lock(overlayKeyFocusMutex_);
+    overlayKeyFocusStack_.push_back(this);
+    RnsShell::Window::setOverlayKeyFocus(true);
+  }
+  windowActive = true;
+  // Overlay is drawn by the compositor of the main window, which is already exposed
+  if(windowReadyTodrawCB_) windowReadyTodrawCB_();
+}
+
+void WindowDelegator::closeOverlayLayer() {
+  {
+    std::scoped_lock lock(overlayKeyFocusMutex_);
+    overlayKeyFocusStack_.erase(std::remove(overlayKeyFocusStack_.begin(),overlayKeyFocusStack_.end(),this),overlayKeyFocusStack_.end());
+    RnsShell::Window::setOverlayKeyFocus(!overlayKeyFocusStack_.empty());
+  }
+  if(overlayHost_) {
+    overlayHost_->begin();
+    // Compositor damages the overlay bounds & removes it in the next pre-paint
+    overlayLayer_->invalidate(RnsShell::LayerRemoveInvalidate);
+    overlayHost_->commit(false);
+  }
+  overlayLayer_=nullptr;
+  overlayComponentLayers_.clear();
+  pendingOverlayCommands_.clear();
+}
+
+void WindowDelegator::closeOverlays() {
+  std::vector<WindowDelegator*> overlays;
+  {
+    // Overlay key focus lock is taken within the render lock of the overlays, so it is not held while closing them
+    std::scoped_lock lock(overlayKeyFocusMutex_);
+    overlays=overlayKeyFocusStack_;
+  }
+  for(auto overlay:overlays) {
+    std::scoped_lock lock(overlay->renderCtrlMutex_);
+    if(overlay->overlayLayer_) {
+      overlay->closeOverlayLayer();
     }
-    if(addToDirtyRect){
-      dirtyRects_.push_back(comDirtyRect);
+  }
+}
+
+void WindowDelegator::renderToOverlay(std::string &pictureCommandKey,PictureObject &pictureObj,bool batchCommit) {
+  std::scoped_lock lock(renderCtrlMutex_);
+  if(!overlayLayer_ || !overlayHost_) {
+    return; // Closed meanwhile
+  }
+
+  // Compositor gets the whole batch in the commit of its last command, as the native window gets it in a swap
+  pendingOverlayCommands_.push_back(std::make_pair(pictureCommandKey,pictureObj));
+  if(batchCommit) {
+    return;
+  }
+  overlayHost_->begin();
+  for(auto &command:pendingOverlayCommands_) {
+    updateOverlayComponent(command.first,command.second);
+  }
+  pendingOverlayCommands_.clear();
+  overlayHost_->commit(false);
+}
+
+void WindowDelegator::updateOverlayComponent(std::string &pictureCommandKey,PictureObject &pictureObj) {
+  SkIRect componentBounds=SkIRect::MakeEmpty();
+  for(SkIRect &dirtyRect:pictureObj.dirtyRect) {
+    componentBounds.join(dirtyRect);
+  }
+
+  RnsShell::SharedPictureLayer componentLayer;
+  auto it = overlayComponentLayers_.find(pictureCommandKey);
+  if(it != overlayComponentLayers_.end()) {
+    componentLayer=it->second;
+  } else {
+    componentLayer=RnsShell::PictureLayer::Create(*overlayHost_);
+    overlayLayer_->appendChild(componentLayer);
+    overlayComponentLayers_[pictureCommandKey]=componentLayer;
+  }
+  componentLayer->setPicture(pictureObj.pictureCommand);
+  componentLayer->setFrame(componentBounds);
+  componentLayer->invalidate();
+}
+#endif/*FEATURE_SUBWINDOW_OVERLAY*/
+
+RnsShell::Window* WindowDelegator::getWindow() {
+#if ENABLE(FEATURE_SUBWINDOW_OVERLAY)
+  {
+    std::scoped_lock lock(overlayKeyFocusMutex_);
+    if(std::find(overlayKeyFocusStack_.begin(),overlayKeyFocusStack_.end(),this) != overlayKeyFocusStack_.end()) {
+      // Overlay has no native window, it owns the main window keys while on top of the other overlays
+      return (overlayKeyFocusStack_.back() == this) ? RnsShell::Window::getMainWindow() : nullptr;
     }
   }
+#endif/*FEATURE_SUBWINDOW_OVERLAY*/
+  return window_;
 }
-#endif /*RNS_SHELL_PARTIAL_UPDATES*/
+
 void WindowDelegator::setWindowTittle(const char* titleString) {
   if(window_) window_->setTitle(titleString);
 }
@@ -7,6 +7,7 @@
 
 #include <semaphore.h>
 #include <thread>
+#include <unordered_map>
 
 #include "include/core/SkCanvas.h"
 #include "include/core/SkPictureRecorder.h"
@@ -16,6 +17,10 @@
 #include "rns_shell/platform/graphics/PlatformDisplay.h"
 #include "rns_shell/platform/graphics/WindowContextFactory.h"
 #include "rns_shell/platform/linux/TaskLoop.h"
+#if ENABLE(FEATURE_SUBWINDOW_OVERLAY)
+#include "rns_shell/compositor/RendererDelegate.h"
+#include "rns_shell/compositor/layers/PictureLayer.h"
+#endif/*FEATURE_SUBWINDOW_OVERLAY*/
 
 namespace rns {
 namespace sdk {
@@ -23,7 +28,7 @@ namespace sdk {
 struct pictureCommand {
   std::vector<SkIRect> dirtyRect;
   sk_sp<SkPicture> pictureCommand;
-  bool invalidate;
+  bool invalidate; // Not used, stale buffers are repainted only within their missed damage
 };
 typedef struct pictureCommand PictureObject;
 
@@ -41,19 +46,40 @@ class WindowDelegator {
     void closeNativeWindow();
     void setWindowTittle(const char* titleString);
     void commitDrawCall(std::string pictureCommandKey,PictureObject pictureObj,bool batchCommit=false);
-    RnsShell::Window* getWindow(){ return window_;}
-  
+    RnsShell::Window* getWindow();
+#if ENABLE(FEATURE_SUBWINDOW_OVERLAY)
+    // Renderer of the main window. When set, windows are composited as its overlay layers instead of native windows
+    static void setOverlayHost(RnsShell::RendererDelegate* overlayHost) { overlayHost_ = overlayHost; }
+    // Removes the layers of the open overlays from the overlay host, to be called before the host goes away
+    static void closeOverlays();
+#endif/*FEATURE_SUBWINDOW_OVERLAY*/
+
   private:
     void onExposeHandler(RnsShell::Window* window);
     void windowWorkerThread();
     void createNativeWindow();
     void renderToDisplay(std::string pictureCommandKey,PictureObject pictureObj,bool batchCommit);
-    void updateRecentCommand(std::string pictureCommandKey,PictureObject & pictureObj,int bufferAge=0,bool isUpdateDirtyRect=false);
+    void updateRecentCommand(std::string &pictureCommandKey,PictureObject & pictureObj);
+    void repaintFromRecentCommands(int bufferAge);
 #if USE(RNS_SHELL_PARTIAL_UPDATES)
     void generateDirtyRect(std::vector<SkIRect> &componentDirtRects);
     bool supportsPartialUpdate_{false};
     std::vector<SkIRect> fullScreenDirtyRects_;
+    RnsShell::DamageHistory damageHistory_; // Damages of the recent frames, for the buffers with age > 1
 #endif/*RNS_SHELL_PARTIAL_UPDATES*/
+#if ENABLE(FEATURE_SUBWINDOW_OVERLAY)
+    void createOverlayLayer();
+    void closeOverlayLayer();
+    void renderToOverlay(std::string &pictureCommandKey,PictureObject &pictureObj,bool batchCommit);
+    void updateOverlayComponent(std::string &pictureCommandKey,PictureObject &pictureObj);
+    static RnsShell::RendererDelegate* overlayHost_;
+    static std::vector<WindowDelegator*> overlayKeyFocusStack_; // Top most overlay gets the keys, like the top most native window
+    static std::mutex overlayKeyFocusMutex_;
+    RnsShell::SharedLayer overlayLayer_{nullptr};
+    std::unordered_map<std::string,RnsShell::SharedPictureLayer> overlayComponentLayers_; // Children of overlayLayer_, in the order of the first commit
+    PictureCommandPairs pendingOverlayCommands_; // Batched commands, applied to the layers in a single commit with the rest of the batch
+    bool isOverlay_{false}; // Window is composited as overlayLayer_, which is reset under renderCtrlMutex_ once closed
+#endif/*FEATURE_SUBWINDOW_OVERLAY*/
     std::unique_ptr<RnsShell::WindowContext> windowContext_{nullptr};
     RnsShell::Window* window_{nullptr};
     sk_sp<SkSurface>  backBuffer_;
@@ -75,7 +101,8 @@ class WindowDelegator {
     SkSize windowSize_;
     bool windowActive{false};
 
-    PictureCommandPairs recentComponentCommands_;
+    PictureCommandPairs recentComponentCommands_; // In the order of the first commit, which is the paint order
+    std::unordered_map<std::string,size_t> recentCommandIndex_; // Position of the component in recentComponentCommands_
 };
 
 } // namespace sdk
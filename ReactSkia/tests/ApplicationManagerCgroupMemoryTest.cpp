@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <condition_variable>
+#include <deque>
+#include <regex>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "ReactSkia/pluginfactory/plugins/ubuntu/ApplicationManager.h"
+
+#define TEST_STOP_COMMAND "stop"
+#define TEST_EVENT_TIMEOUT_MS 5000
+
+namespace facebook {
+namespace react {
+namespace rnsplugin {
+
+// Monitor over a fake cgroup memory controller directory. Its cgroup.event_control is a FIFO, so the
+// registrations written by the monitor are read back as the kernel gets them : "<eventfd> <file fd> <args>".
+// Pressure events are then raised by writing to the registered eventfds, as the kernel does.
+class ApplicationManagerCgroupMemoryTest : public ::testing::Test {
+ protected:
+  using CgroupMemoryData = RNSApplicationManagerInterfaceImpl::CgroupMemoryData;
+
+  void SetUp() override {
+    char pathTemplate[] = "/tmp/rnsCgroupMemoryXXXXXX";
+    ASSERT_NE(mkdtemp(pathTemplate), nullptr);
+    cgroupPath_ = pathTemplate;
+    close(open((cgroupPath_ + "/memory.pressure_level").c_str(), O_CREAT | O_RDONLY, 0644));
+    ASSERT_EQ(mkfifo(eventControlPath().c_str(), 0644), 0);
+    controlThread_ = std::thread([this]() { readEventControl(); });
+  }
+
+  void TearDown() override {
+    int controlFd = open(eventControlPath().c_str(), O_WRONLY);
+    write(controlFd, TEST_STOP_COMMAND, strlen(TEST_STOP_COMMAND));
+    close(controlFd);
+    controlThread_.join();
+    unlink(eventControlPath().c_str());
+    unlink((cgroupPath_ + "/memory.pressure_level").c_str());
+    rmdir(cgroupPath_.c_str());
+  }
+
+  std::string eventControlPath() const { return cgroupPath_ + "/cgroup.event_control"; }
+
+  // Returns the eventfd registered for the pressure level, -1 on timeout
+  int levelEventFd(const std::string &level) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::regex registration("(\\d+) (\\d+) " + level + ",hierarchy");
+    std::smatch match;
+    condition_.wait_for(lock, std::chrono::milliseconds(TEST_EVENT_TIMEOUT_MS),
+                        [&]() { return std::regex_search(eventControl_, match, registration); });
+    return match.empty() ? -1 : std::stoi(match[1]);
+  }
+
+  void raisePressure(int efd) {
+    uint64_t value = 1;
+    ASSERT_EQ(write(efd, &value, sizeof(value)), (ssize_t)sizeof(value));
+  }
+
+  // Returns the eventfd of the next notification, -1 on timeout
+  int nextNotification() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if(!condition_.wait_for(lock, std::chrono::milliseconds(TEST_EVENT_TIMEOUT_MS), [this]() { return !notifications_.empty(); }))
+      return -1;
+    int efd = notifications_.front();
+    notifications_.pop_front();
+    return efd;
+  }
+
+  CgroupMemoryNotificationCallback notificationCallback() {
+    return [this](int efd) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      notifications_.push_back(efd);
+      condition_.notify_all();
+    };
+  }
+
+  std::string cgroupPath_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::string eventControl_; // Everything written to cgroup.event_control
+  std::deque<int> notifications_;
+
+ private:
+  void readEventControl() {
+    while(true) {
+      int controlFd = open(eventControlPath().c_str(), O_RDONLY); // Blocks till the next writer opens it
+      char buffer[128];
+      ssize_t received;
+      while((received = read(controlFd, buffer, sizeof(buffer))) > 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        eventControl_.append(buffer, received);
+        condition_.notify_all();
+      }
+      close(controlFd);
+      std::lock_guard<std::mutex> lock(mutex_);
+      if(eventControl_.find(TEST_STOP_COMMAND) != std::string::npos)
+        return;
+    }
+  }
+
+  std::thread controlThread_;
+};
+
+TEST_F(ApplicationManagerCgroupMemoryTest, PressureLevelsAreReportedWithTheirLevel) {
+  CgroupMemoryData cgroupMemory(notificationCallback(), cgroupPath_);
+  std::vector<std::pair<std::string, MemoryWarningLevel>> levels = {
+    {"low", MemoryWarningLow}, {"medium", MemoryWarningModerate}, {"critical", MemoryWarningCritical}};
+
+  for(auto &level : levels) {
+    int efd = levelEventFd(level.first);
+    ASSERT_GE(efd, 0) << level.first << " pressure is not registered";
+    raisePressure(efd);
+    EXPECT_EQ(nextNotification(), efd);
+    EXPECT_EQ(cgroupMemory.memoryWarningLevel(efd), level.second);
+  }
+}
+
+TEST_F(ApplicationManagerCgroupMemoryTest, RepeatedPressureIsReportedEachTime) {
+  CgroupMemoryData cgroupMemory(notificationCallback(), cgroupPath_);
+  int efd = levelEventFd("critical");
+  ASSERT_GE(efd, 0);
+
+  for(int event = 0; event < 3; event++) {
+    raisePressure(efd); // Counter is read back by the monitor, so each write is a new edge
+    EXPECT_EQ(nextNotification(), efd);
+  }
+}
+
+TEST_F(ApplicationManagerCgroupMemoryTest, MissingCgroupIsNotMonitored) {
+  {
+    CgroupMemoryData cgroupMemory(notificationCallback(), cgroupPath_ + "/missing");
+  } // Monitor thread is stopped & joined all the same
+  std::lock_guard<std::mutex> lock(mutex_);
+  EXPECT_TRUE(eventControl_.empty());
+  EXPECT_TRUE(notifications_.empty());
+}
+
+} // namespace rnsplugin
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <condition_variable>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "ReactSkia/sdk/NopollWebsocket.h"
+
+#define TEST_CLOSE_COMMAND "close"
+#define TEST_CLOSE_CODE 4000
+#define TEST_CLOSE_REASON "bye"
+#define TEST_EVENT_TIMEOUT_MS 5000
+
+namespace facebook {
+namespace react {
+namespace {
+
+// Local echo server on its own nopoll loop. Messages are sent back as received, the close
+// command makes the server close the connection with a known code & reason.
+class EchoServer {
+ public:
+  EchoServer() {
+    ctx_ = nopoll_ctx_new();
+    listener_ = nopoll_listener_new(ctx_, "127.0.0.1", "0");
+    struct sockaddr_in address;
+    socklen_t length = sizeof(address);
+    getsockname(nopoll_conn_socket(listener_), (struct sockaddr*)&address, &length);
+    port_ = ntohs(address.sin_port);
+    nopoll_ctx_set_on_msg(ctx_, onMessage, nullptr);
+    loopThread_ = std::thread([this]() { nopoll_loop_wait(ctx_, 0); });
+  }
+
+  ~EchoServer() {
+    nopoll_loop_stop(ctx_);
+    loopThread_.join();
+    nopoll_conn_close(listener_);
+    nopoll_ctx_unref(ctx_);
+  }
+
+  std::string url() const { return "ws://127.0.0.1:" + std::to_string(port_) + "/"; }
+
+ private:
+  static void onMessage(noPollCtx* ctx, noPollConn* conn, noPollMsg* msg, noPollPtr userData) {
+    std::string payload((const char*)nopoll_msg_get_payload(msg), nopoll_msg_get_payload_size(msg));
+    if(payload == TEST_CLOSE_COMMAND) {
+      nopoll_conn_close_ext(conn, TEST_CLOSE_CODE, TEST_CLOSE_REASON, strlen(TEST_CLOSE_REASON));
+    } else if(nopoll_msg_opcode(msg) == NOPOLL_BINARY_FRAME) {
+      nopoll_conn_send_binary(conn, payload.data(), payload.size());
+    } else {
+      nopoll_conn_send_text(conn, payload.data(), payload.size());
+    }
+  }
+
+  noPollCtx* ctx_;
+  noPollConn* listener_;
+  int port_{0};
+  std::thread loopThread_;
+};
+
+// Records the delegator callbacks, which are called on the websocket loop thread
+class NopollWebsocketTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    urlString_ = server_.url();
+    request_ = std::make_unique<NopollRequest>(&urlString_[0]);
+    auto &delegator = request_->nopolldelegator;
+    delegator.delegatorData = this;
+    delegator.NOPOLLConnectCallback = [this](void*) { record("open"); };
+    delegator.NOPOLLDisconnectCallback = [this](void*) { record("close"); };
+    delegator.NOPOLLFailureCallback = [this](char* message, void*) { record(std::string("failure:") + message); };
+    delegator.NOPOLLMessageHandlerCallback = [this](WebsocketMessageType type, std::shared_ptr<std::string> payload, void*) {
+      record(std::string(type == WEBSOCKET_MESSAGE_TEXT ? "text:" : "binary:") + *payload);
+    };
+  }
+
+  void record(std::string event) {
+    std::lock_guard<std::mutex> lock(eventsMutex_);
+    events_.push_back(std::move(event));
+    eventsCondition_.notify_all();
+  }
+
+  // Returns the next event, empty on timeout
+  std::string nextEvent() {
+    std::unique_lock<std::mutex> lock(eventsMutex_);
+    if(!eventsCondition_.wait_for(lock, std::chrono::milliseconds(TEST_EVENT_TIMEOUT_MS), [this]() { return !events_.empty(); }))
+      return {};
+    std::string event = std::move(events_.front());
+    events_.pop_front();
+    return event;
+  }
+
+  EchoServer server_;
+  std::string urlString_;
+  std::unique_ptr<NopollRequest> request_;
+  std::mutex eventsMutex_;
+  std::condition_variable eventsCondition_;
+  std::deque<std::string> events_;
+  NopollWebsocket websocket_; // Destroyed first, it closes the connections still open
+};
+
+TEST_F(NopollWebsocketTest, EchoesTextAndBinary) {
+  websocket_.getConnect(request_.get());
+  ASSERT_EQ(nextEvent(), "open");
+
+  request_->sendMessageData = "hello";
+  websocket_.send(request_.get());
+  EXPECT_EQ(nextEvent(), "text:hello");
+
+  request_->sendMessageBase64Data = "AAECAw=="; // 00 01 02 03, binary keeps the '\0'
+  websocket_.sendBinary(request_.get());
+  EXPECT_EQ(nextEvent(), std::string("binary:") + std::string("\x00\x01\x02\x03", 4));
+
+  request_->closeRequestCode = 1000;
+  websocket_.close(request_.get());
+  EXPECT_EQ(nextEvent(), "close");
+}
+
+TEST_F(NopollWebsocketTest, PeerCloseIsCloseEvent) {
+  websocket_.getConnect(request_.get());
+  ASSERT_EQ(nextEvent(), "open");
+
+  request_->sendMessageData = TEST_CLOSE_COMMAND;
+  websocket_.send(request_.get());
+  EXPECT_EQ(nextEvent(), "close");
+  EXPECT_EQ(request_->closeRequestCode, TEST_CLOSE_CODE);
+  EXPECT_EQ(request_->closeReason, TEST_CLOSE_REASON);
+}
+
+TEST_F(NopollWebsocketTest, CloseWhileConnectingReportsClose) {
+  websocket_.getConnect(request_.get());
+  websocket_.close(request_.get());
+  EXPECT_EQ(nextEvent(), "close"); // Socket handed over after the close is dropped, no open follows
+  EXPECT_EQ(nextEvent(), "");
+}
+
+TEST_F(NopollWebsocketTest, RefusedConnectionFails) {
+  urlString_ = "ws://127.0.0.1:1/"; // Nothing listens on it
+  request_->url = &urlString_[0];
+  websocket_.getConnect(request_.get());
+  EXPECT_EQ(nextEvent(), "failure:websocket connection failed");
+}
+
+// Peer accepting TCP connections but never answering, so a connect to it stays in progress
+TEST_F(NopollWebsocketTest, SlowConnectDoesNotDelayOthers) {
+  int silentSocket = socket(AF_INET, SOCK_STREAM, 0);
+  struct sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t length = sizeof(address);
+  bind(silentSocket, (struct sockaddr*)&address, length);
+  listen(silentSocket, 1);
+  getsockname(silentSocket, (struct sockaddr*)&address, &length);
+  std::string silentUrl = "wss://127.0.0.1:" + std::to_string(ntohs(address.sin_port)) + "/"; // TLS handshake blocks
+  NopollRequest silentRequest(&silentUrl[0]);
+  silentRequest.nopolldelegator.delegatorData = this;
+  silentRequest.nopolldelegator.NOPOLLFailureCallback = [](char*, void*) {};
+
+  websocket_.getConnect(&silentRequest);
+  auto start = std::chrono::steady_clock::now();
+  websocket_.getConnect(request_.get());
+  ASSERT_EQ(nextEvent(), "open");
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(WEBSOCKET_HANDSHAKE_TIMEOUT_MS / 2));
+
+  silentRequest.closeRequestCode = 1000;
+  websocket_.close(&silentRequest); // Dropped once its connect gives up
+  websocket_.close(request_.get());
+  EXPECT_EQ(nextEvent(), "close");
+  ::close(silentSocket);
+}
+
+} // namespace
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include <array>
+#include <random>
+
+#include <better/map.h>
+
+#include "ReactSkia/components/RSkComponentTable.h"
+#include "ReactSkia/components/RSkComponentView.h"
+#include "rns_shell/tests/benchmark/RnsBenchmark.h"
+
+#include "RSkTestComponents.h"
+
+#define BENCHMARK_PROVIDER_COUNT 24 // Core & codegen component providers of the app
+#define BENCHMARK_UPDATES_PER_FRAME 64
+
+namespace facebook {
+namespace react {
+namespace {
+
+enum MutationType {
+  MutationCreate,
+  MutationUpdate,
+  MutationDelete,
+};
+
+struct Mutation {
+  MutationType type;
+  Tag tag;
+  int provider;
+};
+
+/*
+ * Mutation list of a screen : mounts count views, then updates, replaces & removes them in frames like a list
+ * scrolling through its items. Each mutation resolves its component by tag, as the mounting manager does.
+ */
+struct MutationReplay {
+  explicit MutationReplay(int count) {
+    std::mt19937 random(count);
+    std::vector<Tag> live;
+    Tag nextTag = 2;
+    auto create = [&]() {
+      mutations.push_back({MutationCreate, nextTag, static_cast<int>(random() % BENCHMARK_PROVIDER_COUNT)});
+      live.push_back(nextTag);
+      components.push_back(std::make_shared<RSkComponentView>(RSkTestComponentTree::makeShadowView(nextTag, SkIRect::MakeWH(10, 10))));
+      nextTag += 2;
+    };
+    for(int index = 0; index < count; index++)
+      create();
+    for(int frame = 0; frame < 20; frame++) {
+      for(int update = 0; update < BENCHMARK_UPDATES_PER_FRAME; update++)
+        mutations.push_back({MutationUpdate, live[random() % live.size()], 0});
+      for(int replace = 0; replace < count / 20; replace++) {
+        size_t index = random() % live.size();
+        mutations.push_back({MutationDelete, live[index], 0});
+        live.erase(live.begin() + index);
+        create();
+      }
+    }
+    for(auto tag : live)
+      mutations.push_back({MutationDelete, tag, 0});
+  }
+
+  std::shared_ptr<RSkComponent> component(Tag tag) { return components[tag / 2 - 1]; }
+
+  std::vector<Mutation> mutations;
+  std::vector<std::shared_ptr<RSkComponent>> components; // Index is tag / 2 - 1
+};
+
+// Per provider maps, resolved by asking every provider in turn. The lookup before the shared component table.
+struct ProviderScan {
+  std::shared_ptr<RSkComponent> find(Tag tag) {
+    for(auto &provider : providers) {
+      auto it = provider.find(tag);
+      if(it != provider.end())
+        return it->second;
+    }
+    return nullptr;
+  }
+
+  std::array<better::map<Tag, std::shared_ptr<RSkComponent>>, BENCHMARK_PROVIDER_COUNT> providers;
+};
+
+RNS_BENCHMARK_WITH_ARGS(BM_MutationReplayProviderScan, 100, 1000, 5000) {
+  MutationReplay replay(state.range());
+  ProviderScan scan;
+  size_t resolved = 0;
+  while(state.keepRunning()) {
+    for(auto &mutation : replay.mutations) {
+      switch(mutation.type) {
+        case MutationCreate:
+          scan.providers[mutation.provider][mutation.tag] = replay.component(mutation.tag);
+          break;
+        case MutationUpdate:
+          resolved += (scan.find(mutation.tag) != nullptr);
+          break;
+        case MutationDelete:
+          for(auto &provider : scan.providers) {
+            if(provider.erase(mutation.tag))
+              break;
+          }
+          break;
+      }
+    }
+  }
+  RnsShell::Benchmark::doNotOptimize(resolved);
+  state.setItemsProcessed(state.iterations() * replay.mutations.size());
+  state.setCounter("mutations", replay.mutations.size());
+}
+
+RNS_BENCHMARK_WITH_ARGS(BM_MutationReplayComponentTable, 100, 1000, 5000) {
+  MutationReplay replay(state.range());
+  RSkComponentTable table;
+  size_t resolved = 0;
+  while(state.keepRunning()) {
+    for(auto &mutation : replay.mutations) {
+      switch(mutation.type) {
+        case MutationCreate:
+          table.insert(mutation.tag, replay.component(mutation.tag), nullptr);
+          break;
+        case MutationUpdate:
+          resolved += (table.find(mutation.tag) != nullptr);
+          break;
+        case MutationDelete:
+          table.erase(mutation.tag);
+          break;
+      }
+    }
+  }
+  RnsShell::Benchmark::doNotOptimize(resolved);
+  state.setItemsProcessed(state.iterations() * replay.mutations.size());
+  state.setCounter("mutations", replay.mutations.size());
+}
+
+} // namespace
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include <map>
+#include <random>
+
+#include "gtest/gtest.h"
+
+#include "ReactSkia/components/RSkComponentTable.h"
+#include "ReactSkia/components/RSkComponentView.h"
+
+#include "RSkTestComponents.h"
+
+namespace facebook {
+namespace react {
+namespace {
+
+std::shared_ptr<RSkComponent> makeComponent(Tag tag) {
+  return std::make_shared<RSkComponentView>(RSkTestComponentTree::makeShadowView(tag, SkIRect::MakeWH(10, 10)));
+}
+
+TEST(RSkComponentTableTest, FindsInsertedComponent) {
+  RSkComponentTable table;
+  auto component = makeComponent(2);
+  auto *provider = reinterpret_cast<RSkComponentProvider*>(0x10);
+  table.insert(2, component, provider);
+
+  const RSkComponentTable::Entry *entry = table.find(2);
+  ASSERT_NE(entry, nullptr);
+  EXPECT_EQ(entry->component, component);
+  EXPECT_EQ(entry->provider, provider);
+  EXPECT_EQ(table.find(4), nullptr);
+  EXPECT_EQ(table.size(), 1u);
+}
+
+TEST(RSkComponentTableTest, InsertReplacesSameTag) {
+  RSkComponentTable table;
+  auto replacement = makeComponent(2);
+  table.insert(2, makeComponent(2), nullptr);
+  table.insert(2, replacement, nullptr);
+  ASSERT_NE(table.find(2), nullptr);
+  EXPECT_EQ(table.find(2)->component, replacement);
+  EXPECT_EQ(table.size(), 1u);
+}
+
+TEST(RSkComponentTableTest, EraseReleasesComponent) {
+  RSkComponentTable table;
+  auto component = makeComponent(2);
+  std::weak_ptr<RSkComponent> weakComponent = component;
+  table.insert(2, std::move(component), nullptr);
+  table.erase(2);
+  table.erase(2); // Erasing a missing tag is harmless
+  EXPECT_EQ(table.find(2), nullptr);
+  EXPECT_TRUE(weakComponent.expired());
+  EXPECT_EQ(table.size(), 0u);
+}
+
+TEST(RSkComponentTableTest, GrowsAndKeepsEntries) {
+  RSkComponentTable table;
+  std::vector<std::shared_ptr<RSkComponent>> components;
+  for(Tag tag = 2; tag <= 4000; tag += 2) {
+    components.push_back(makeComponent(tag));
+    table.insert(tag, components.back(), nullptr);
+  }
+  EXPECT_EQ(table.size(), components.size());
+  for(auto &component : components) {
+    Tag tag = component->getComponentData().tag;
+    ASSERT_NE(table.find(tag), nullptr) << "Tag " << tag;
+    EXPECT_EQ(table.find(tag)->component, component);
+  }
+}
+
+// Random inserts & erases against a reference map, exercises the backward shift deletion on long probe sequences
+TEST(RSkComponentTableTest, MatchesReferenceMap) {
+  RSkComponentTable table;
+  std::map<Tag, std::shared_ptr<RSkComponent>> reference;
+  std::mt19937 random(42);
+  std::uniform_int_distribution<Tag> tags(1, 600);
+
+  for(int operation = 0; operation < 20000; operation++) {
+    Tag tag = tags(random);
+    if(random() % 3) {
+      auto component = makeComponent(tag);
+      table.insert(tag, component, nullptr);
+      reference[tag] = component;
+    } else {
+      table.erase(tag);
+      reference.erase(tag);
+    }
+  }
+
+  ASSERT_EQ(table.size(), reference.size());
+  for(Tag tag = 1; tag <= 600; tag++) {
+    auto it = reference.find(tag);
+    const RSkComponentTable::Entry *entry = table.find(tag);
+    if(it == reference.end()) {
+      EXPECT_EQ(entry, nullptr) << "Tag " << tag;
+    } else {
+      ASSERT_NE(entry, nullptr) << "Tag " << tag;
+      EXPECT_EQ(entry->component, it->second);
+    }
+  }
+}
+
+} // namespace
+} // namespace react
+} // namespace facebook
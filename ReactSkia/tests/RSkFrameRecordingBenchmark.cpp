@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include "include/core/SkPictureRecorder.h"
+
+#include <react/renderer/graphics/Color.h>
+
+#include "ReactSkia/views/common/RSkDrawUtils.h"
+#include "rns_shell/tests/benchmark/RnsBenchmark.h"
+
+#define BENCHMARK_FRAME_WIDTH 300
+#define BENCHMARK_FRAME_HEIGHT 200
+
+namespace facebook {
+namespace react {
+namespace {
+
+enum BorderStyleCase {
+  UniformSolid = 0,
+  UniformSolidRounded,
+  UniformDashed,
+  NonUniformWidths,
+  NonUniformColors,
+  BorderStyleCaseCount
+};
+
+const char *borderStyleCaseName(int styleCase) {
+  static const char *names[] = {"uniform_solid", "uniform_solid_rounded", "uniform_dashed", "non_uniform_widths", "non_uniform_colors"};
+  return (styleCase >= 0 && styleCase < BorderStyleCaseCount) ? names[styleCase] : "unknown";
+}
+
+BorderMetrics makeBorderMetrics(int styleCase) {
+  SharedColor red = colorFromComponents({1, 0, 0, 1});
+  BorderMetrics metrics;
+  metrics.borderColors = {red, red, red, red};
+  metrics.borderWidths = {4, 4, 4, 4};
+  metrics.borderStyles = {BorderStyle::Solid, BorderStyle::Solid, BorderStyle::Solid, BorderStyle::Solid};
+  switch(styleCase) {
+    case UniformSolidRounded:
+      metrics.borderRadii = {16, 16, 16, 16};
+      break;
+    case UniformDashed:
+      metrics.borderRadii = {16, 16, 16, 16};
+      metrics.borderStyles = {BorderStyle::Dashed, BorderStyle::Dashed, BorderStyle::Dashed, BorderStyle::Dashed};
+      break;
+    case NonUniformWidths:
+      metrics.borderWidths = {2, 4, 6, 8};
+      metrics.borderRadii = {16, 16, 16, 16};
+      break;
+    case NonUniformColors:
+      metrics.borderColors.top = colorFromComponents({0, 1, 0, 1});
+      metrics.borderColors.bottom = colorFromComponents({0, 0, 1, 1});
+      metrics.borderRadii = {16, 16, 16, 16};
+      break;
+    default:
+      break;
+  }
+  return metrics;
+}
+
+// Background & border of one frame, recorded as a component re-records after a non geometric change
+sk_sp<SkPicture> recordFrame(const BorderMetrics &metrics, SharedColor backgroundColor,
+                             RSkDrawUtils::FrameGeometryCache *geometryCache) {
+  SkPictureRecorder recorder;
+  SkCanvas *canvas = recorder.beginRecording(SkRect::MakeWH(BENCHMARK_FRAME_WIDTH, BENCHMARK_FRAME_HEIGHT));
+  Rect frame{{0, 0}, {BENCHMARK_FRAME_WIDTH, BENCHMARK_FRAME_HEIGHT}};
+  RSkDrawUtils::drawBackground(canvas, frame, metrics, backgroundColor, geometryCache);
+  RSkDrawUtils::drawBorder(canvas, frame, metrics, backgroundColor, geometryCache);
+  return recorder.finishRecordingAsPicture();
+}
+
+RNS_BENCHMARK_WITH_ARGS(BM_FrameRecordingUncached, UniformSolid, UniformSolidRounded, UniformDashed, NonUniformWidths, NonUniformColors) {
+  BorderMetrics metrics = makeBorderMetrics(state.range());
+  SharedColor backgroundColor = colorFromComponents({1, 1, 1, 1});
+  while(state.keepRunning()) {
+    RnsShell::Benchmark::doNotOptimize(recordFrame(metrics, backgroundColor, nullptr));
+  }
+  state.setItemsProcessed(state.iterations());
+  state.setLabel(borderStyleCaseName(state.range()));
+}
+
+RNS_BENCHMARK_WITH_ARGS(BM_FrameRecordingCached, UniformSolid, UniformSolidRounded, UniformDashed, NonUniformWidths, NonUniformColors) {
+  BorderMetrics metrics = makeBorderMetrics(state.range());
+  SharedColor backgroundColor = colorFromComponents({1, 1, 1, 1});
+  RSkDrawUtils::FrameGeometryCache geometryCache;
+  recordFrame(metrics, backgroundColor, &geometryCache);
+  while(state.keepRunning()) {
+    RnsShell::Benchmark::doNotOptimize(recordFrame(metrics, backgroundColor, &geometryCache));
+  }
+  state.setItemsProcessed(state.iterations());
+  state.setLabel(borderStyleCaseName(state.range()));
+}
+
+} // namespace
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include "gtest/gtest.h"
+
+#include "include/core/SkSurface.h"
+#include "include/core/SkTime.h"
+
+#include "ReactSkia/sdk/RNSMemoryPressureBroker.h"
+#include "ReactSkia/views/common/RSkImageCacheManager.h"
+#include "rns_shell/common/MemoryAccounting.h"
+
+#define TEST_IMAGE_EXPIRY_MS 60000
+
+namespace facebook {
+namespace react {
+namespace {
+
+sk_sp<SkImage> makeRasterImage(int width, int height, SkColor color) {
+  sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(width, height);
+  surface->getCanvas()->clear(color);
+  return surface->makeImageSnapshot();
+}
+
+class RSkImageCacheManagerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    RSkImageCacheManager::init();
+    cacheManager_ = RSkImageCacheManager::getImageCacheManagerInstance();
+    cacheManager_->clearMemory(); // Images left by the earlier tests are not referenced anymore
+    accountedBytesBefore_ = RnsShell::MemoryAccounting::bytesUsed(RnsShell::MemoryCategoryDecodedImages);
+  }
+
+  size_t accountedBytes() {
+    return RnsShell::MemoryAccounting::bytesUsed(RnsShell::MemoryCategoryDecodedImages) - accountedBytesBefore_;
+  }
+
+  bool insert(const char *path, sk_sp<SkImage> image) {
+    return cacheManager_->imageDataInsertInCache(path, {image, SkTime::GetMSecs() + TEST_IMAGE_EXPIRY_MS});
+  }
+
+  RSkImageCacheManager *cacheManager_{nullptr};
+  size_t accountedBytesBefore_{0};
+};
+
+TEST_F(RSkImageCacheManagerTest, FindsInsertedImage) {
+  sk_sp<SkImage> image = makeRasterImage(64, 32, SK_ColorRED);
+  ASSERT_TRUE(insert("test://image/find", image));
+  EXPECT_EQ(cacheManager_->findImageDataInCache("test://image/find"), image);
+  EXPECT_EQ(cacheManager_->findImageDataInCache("test://image/missing"), nullptr);
+}
+
+TEST_F(RSkImageCacheManagerTest, RejectsEmptyImage) {
+  EXPECT_FALSE(insert("test://image/empty", nullptr));
+  EXPECT_EQ(cacheManager_->findImageDataInCache("test://image/empty"), nullptr);
+}
+
+TEST_F(RSkImageCacheManagerTest, AccountsDecodedBytes) {
+  sk_sp<SkImage> image = makeRasterImage(64, 32, SK_ColorRED);
+  ASSERT_TRUE(insert("test://image/accounting", image));
+  EXPECT_EQ(accountedBytes(), image->imageInfo().computeMinByteSize());
+}
+
+TEST_F(RSkImageCacheManagerTest, MemoryPressureEvictsOnlyUnusedImages) {
+  sk_sp<SkImage> shownImage = makeRasterImage(64, 64, SK_ColorRED);
+  ASSERT_TRUE(insert("test://image/shown", shownImage));
+  ASSERT_TRUE(insert("test://image/unused", makeRasterImage(128, 128, SK_ColorBLUE)));
+
+  size_t reclaimedBytes = rns::sdk::RNSMemoryPressureBroker::instance()->notifyMemoryPressure(rns::sdk::MemoryPressureModerate);
+  EXPECT_GE(reclaimedBytes, SkImageInfo::MakeN32Premul(128, 128).computeMinByteSize());
+  EXPECT_EQ(cacheManager_->findImageDataInCache("test://image/shown"), shownImage);
+  EXPECT_EQ(cacheManager_->findImageDataInCache("test://image/unused"), nullptr);
+  EXPECT_EQ(accountedBytes(), shownImage->imageInfo().computeMinByteSize());
+}
+
+TEST_F(RSkImageCacheManagerTest, ClearMemoryKeepsShownImages) {
+  sk_sp<SkImage> shownImage = makeRasterImage(16, 16, SK_ColorGREEN);
+  ASSERT_TRUE(insert("test://image/clear/shown", shownImage));
+  ASSERT_TRUE(insert("test://image/clear/unused", makeRasterImage(16, 16, SK_ColorGREEN)));
+  cacheManager_->clearMemory();
+  EXPECT_NE(cacheManager_->findImageDataInCache("test://image/clear/shown"), nullptr);
+  EXPECT_EQ(cacheManager_->findImageDataInCache("test://image/clear/unused"), nullptr);
+}
+
+} // namespace
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "include/core/SkSurface.h"
+
+#include "ReactSkia/sdk/RNSMemoryPressureBroker.h"
+#include "ReactSkia/views/common/RSkImageDecoder.h"
+#include "rns_shell/common/MemoryAccounting.h"
+
+#define TEST_FRAME_DURATION_MS 100
+#define TEST_FRAME_BYTES 4 // 1x1 N32 frame
+#define TEST_DECODE_TIMEOUT_MS 5000
+
+namespace facebook {
+namespace react {
+namespace {
+
+// 1x1 GIF looping forever over 2 frames of 100ms : color index 0, then color index 1
+const unsigned char kAnimatedGif[] = {
+  'G', 'I', 'F', '8', '9', 'a', 0x01, 0x00, 0x01, 0x00, 0x80, 0x00, 0x00,
+  0xFF, 0x00, 0x00, 0x00, 0x00, 0xFF, // Global color table : red, blue
+  0x21, 0xFF, 0x0B, 'N', 'E', 'T', 'S', 'C', 'A', 'P', 'E', '2', '.', '0', 0x03, 0x01, 0x00, 0x00, 0x00,
+  0x21, 0xF9, 0x04, 0x00, 0x0A, 0x00, 0x00, 0x00,
+  0x2C, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x02, 0x02, 0x44, 0x01, 0x00,
+  0x21, 0xF9, 0x04, 0x00, 0x0A, 0x00, 0x00, 0x00,
+  0x2C, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x02, 0x02, 0x4C, 0x01, 0x00,
+  0x3B,
+};
+
+size_t accountedBytes() {
+  return RnsShell::MemoryAccounting::bytesUsed(RnsShell::MemoryCategoryDecodedImages);
+}
+
+// Frames are decoded on the image decode thread, the previous one is returned meanwhile
+sk_sp<SkImage> waitForFrame(RSkAnimatedImage &animatedImage, double playbackTimeMs, double &nextFrameDelayMs) {
+  bool isFinished = false;
+  for(int waitedMs = 0; waitedMs < TEST_DECODE_TIMEOUT_MS; waitedMs += 5) {
+    sk_sp<SkImage> frame = animatedImage.frameForTime(playbackTimeMs, isFinished, nextFrameDelayMs);
+    if(frame && nextFrameDelayMs > ANIMATED_IMAGE_MIN_FRAME_DURATION_MS)
+      return frame;
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  return nullptr;
+}
+
+TEST(RSkImageDecoderTest, StillImageIsNotAnimated) {
+  sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(4, 4);
+  sk_sp<SkData> png = surface->makeImageSnapshot()->encodeToData(SkEncodedImageFormat::kPNG, 100);
+  EXPECT_EQ(RSkAnimatedImage::Make(png), nullptr);
+  EXPECT_EQ(RSkAnimatedImage::Make(nullptr), nullptr);
+}
+
+TEST(RSkImageDecoderTest, NextFrameIsDueAtItsStartTime) {
+  auto animatedImage = RSkAnimatedImage::Make(SkData::MakeWithoutCopy(kAnimatedGif, sizeof(kAnimatedGif)));
+  ASSERT_NE(animatedImage, nullptr);
+  double nextFrameDelayMs = 0;
+  ASSERT_NE(waitForFrame(*animatedImage, 30, nextFrameDelayMs), nullptr);
+  EXPECT_DOUBLE_EQ(nextFrameDelayMs, TEST_FRAME_DURATION_MS - 30);
+  ASSERT_NE(waitForFrame(*animatedImage, TEST_FRAME_DURATION_MS + 40, nextFrameDelayMs), nullptr);
+  EXPECT_DOUBLE_EQ(nextFrameDelayMs, TEST_FRAME_DURATION_MS - 40); // Loop restarts after the last frame
+}
+
+TEST(RSkImageDecoderTest, FrameCacheIsAccountedAndTrimmed) {
+  // Other caches are emptied first, so only the frames change the decoded image bytes
+  rns::sdk::RNSMemoryPressureBroker::instance()->notifyMemoryPressure(rns::sdk::MemoryPressureCritical);
+  size_t accountedBytesBefore = accountedBytes();
+  auto animatedImage = RSkAnimatedImage::Make(SkData::MakeWithoutCopy(kAnimatedGif, sizeof(kAnimatedGif)));
+  ASSERT_NE(animatedImage, nullptr);
+  double nextFrameDelayMs = 0;
+  ASSERT_NE(waitForFrame(*animatedImage, 0, nextFrameDelayMs), nullptr);
+  ASSERT_NE(waitForFrame(*animatedImage, TEST_FRAME_DURATION_MS, nextFrameDelayMs), nullptr);
+  EXPECT_EQ(accountedBytes() - accountedBytesBefore, (size_t)(2 * TEST_FRAME_BYTES));
+
+  // Shown frame is kept on moderate pressure
+  size_t reclaimedBytes = rns::sdk::RNSMemoryPressureBroker::instance()->notifyMemoryPressure(rns::sdk::MemoryPressureModerate);
+  EXPECT_GE(reclaimedBytes, (size_t)TEST_FRAME_BYTES);
+  EXPECT_EQ(accountedBytes() - accountedBytesBefore, (size_t)TEST_FRAME_BYTES);
+
+  rns::sdk::RNSMemoryPressureBroker::instance()->notifyMemoryPressure(rns::sdk::MemoryPressureCritical);
+  EXPECT_EQ(accountedBytes(), accountedBytesBefore);
+  ASSERT_NE(waitForFrame(*animatedImage, 0, nextFrameDelayMs), nullptr); // Decoded again when played
+  animatedImage = nullptr;
+  EXPECT_EQ(accountedBytes(), accountedBytesBefore);
+}
+
+} // namespace
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,217 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <future>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "include/core/SkSurface.h"
+
+#include "ReactSkia/core_modules/RSkImageLoader.h"
+#include "ReactSkia/views/common/RSkImageCacheManager.h"
+
+#define TEST_IMAGE_WIDTH 400
+#define TEST_IMAGE_HEIGHT 300
+#define TEST_PADDING_BYTES (1024 * 1024) // Trailing data, ignored by decoders, so the transfer takes a while
+#define TEST_CHUNK_BYTES (64 * 1024)
+#define TEST_CHUNK_DELAY_MS 20
+#define TEST_RESULT_TIMEOUT_S 10
+
+namespace facebook {
+namespace react {
+namespace {
+
+std::string makePng(int width, int height) {
+  sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(width, height);
+  surface->getCanvas()->clear(SK_ColorRED);
+  sk_sp<SkData> data = surface->makeImageSnapshot()->encodeToData(SkEncodedImageFormat::kPNG, 100);
+  return std::string((const char*)data->data(), data->size());
+}
+
+// HTTP/1.1 stub on loopback, serving fixed bodies per path. Bodies are written in chunks
+// with a delay, so a client stopping the transfer early is seen in the sent byte count.
+class HttpStubServer {
+ public:
+  struct Response {
+    int status{200};
+    std::string body;
+  };
+
+  HttpStubServer() {
+    listenSocket_ = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    bind(listenSocket_, (struct sockaddr*)&address, sizeof(address));
+    socklen_t length = sizeof(address);
+    getsockname(listenSocket_, (struct sockaddr*)&address, &length);
+    port_ = ntohs(address.sin_port);
+    listen(listenSocket_, 8);
+    acceptThread_ = std::thread([this]() { acceptLoop(); });
+  }
+
+  ~HttpStubServer() {
+    shutdown(listenSocket_, SHUT_RDWR);
+    ::close(listenSocket_);
+    acceptThread_.join();
+  }
+
+  void setResponse(const std::string &path, Response response) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    responses_[path] = std::move(response);
+  }
+
+  std::string url(const std::string &path) const { return "http://127.0.0.1:" + std::to_string(port_) + path; }
+
+  // Waits for the response of the path to be written or aborted, returns the body bytes sent
+  size_t waitForBodyBytesSent(const std::string &path) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_.wait_for(lock, std::chrono::seconds(TEST_RESULT_TIMEOUT_S), [&]() { return bodyBytesSent_.count(path) > 0; });
+    return bodyBytesSent_.count(path) ? bodyBytesSent_[path] : 0;
+  }
+
+  std::string lastRequest(const std::string &path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return requests_[path];
+  }
+
+ private:
+  void acceptLoop() {
+    int clientSocket;
+    while((clientSocket = accept(listenSocket_, nullptr, nullptr)) >= 0) {
+      serve(clientSocket); // One at a time is enough for the tests
+      ::close(clientSocket);
+    }
+  }
+
+  void serve(int clientSocket) {
+    std::string request;
+    char buffer[1024];
+    while(request.find("\r\n\r\n") == std::string::npos) {
+      ssize_t received = recv(clientSocket, buffer, sizeof(buffer), 0);
+      if(received <= 0)
+        return;
+      request.append(buffer, received);
+    }
+    size_t pathStart = request.find(' ') + 1;
+    std::string path = request.substr(pathStart, request.find(' ', pathStart) - pathStart);
+    Response response;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      requests_[path] = request;
+      if(responses_.count(path))
+        response = responses_[path];
+      else
+        response.status = 404;
+    }
+    std::string header = "HTTP/1.1 " + std::to_string(response.status) + (response.status == 200 ? " OK" : " Not Found") +
+        "\r\nContent-Type: image/png\r\nContent-Length: " + std::to_string(response.body.size()) +
+        "\r\nCache-Control: no-store\r\nConnection: close\r\n\r\n";
+    size_t bodyBytesSent = 0;
+    if(send(clientSocket, header.data(), header.size(), MSG_NOSIGNAL) == (ssize_t)header.size()) {
+      while(bodyBytesSent < response.body.size()) {
+        size_t chunkBytes = std::min<size_t>(TEST_CHUNK_BYTES, response.body.size() - bodyBytesSent);
+        ssize_t sent = send(clientSocket, response.body.data() + bodyBytesSent, chunkBytes, MSG_NOSIGNAL);
+        if(sent <= 0)
+          break; // Client closed the connection
+        bodyBytesSent += sent;
+        std::this_thread::sleep_for(std::chrono::milliseconds(TEST_CHUNK_DELAY_MS));
+      }
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    bodyBytesSent_[path] = bodyBytesSent;
+    condition_.notify_all();
+  }
+
+  int listenSocket_{-1};
+  int port_{0};
+  std::thread acceptThread_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::map<std::string, Response> responses_;
+  std::map<std::string, std::string> requests_;
+  std::map<std::string, size_t> bodyBytesSent_;
+};
+
+class RSkImageLoaderTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    RSkImageCacheManager::init();
+    methods_ = imageLoader_.getMethods();
+  }
+
+  // Calls a promise method of the module, returns the resolved or rejected arguments
+  std::pair<bool, folly::dynamic> call(const std::string &name, folly::dynamic args) {
+    auto result = std::make_shared<std::promise<std::pair<bool, folly::dynamic>>>();
+    auto settled = std::make_shared<std::once_flag>();
+    auto method = std::find_if(methods_.begin(), methods_.end(), [&](auto &method) { return method.name == name; });
+    method->func(args,
+      [result, settled](std::vector<folly::dynamic> values) {
+        std::call_once(*settled, [&]() { result->set_value({true, values.empty() ? nullptr : values[0]}); });
+      },
+      [result, settled](std::vector<folly::dynamic> values) {
+        std::call_once(*settled, [&]() { result->set_value({false, values.empty() ? nullptr : values[0]}); });
+      });
+    auto future = result->get_future();
+    if(future.wait_for(std::chrono::seconds(TEST_RESULT_TIMEOUT_S)) != std::future_status::ready)
+      return {false, "timeout"};
+    return future.get();
+  }
+
+  HttpStubServer server_;
+  RSkImageLoaderModule imageLoader_;
+  std::vector<xplat::module::CxxModule::Method> methods_;
+};
+
+TEST_F(RSkImageLoaderTest, GetSizeStopsTransferOnceHeaderIsRead) {
+  std::string body = makePng(TEST_IMAGE_WIDTH, TEST_IMAGE_HEIGHT) + std::string(TEST_PADDING_BYTES, '\0');
+  server_.setResponse("/size.png", {200, body});
+
+  auto result = call("getSize", folly::dynamic::array(server_.url("/size.png")));
+  ASSERT_TRUE(result.first);
+  EXPECT_EQ(result.second, folly::dynamic::array(TEST_IMAGE_WIDTH, TEST_IMAGE_HEIGHT));
+  EXPECT_LT(server_.waitForBodyBytesSent("/size.png"), body.size());
+}
+
+TEST_F(RSkImageLoaderTest, GetSizeWithHeadersForwardsHeaders) {
+  server_.setResponse("/headers.png", {200, makePng(20, 10)});
+
+  auto result = call("getSizeWithHeaders", folly::dynamic::array(server_.url("/headers.png"),
+                                                                 folly::dynamic::object("X-Test-Header", "rns")));
+  ASSERT_TRUE(result.first);
+  EXPECT_EQ(result.second, folly::dynamic::object("width", 20)("height", 10));
+  EXPECT_NE(server_.lastRequest("/headers.png").find("X-Test-Header: rns"), std::string::npos);
+}
+
+TEST_F(RSkImageLoaderTest, GetSizeRejectsMissingImage) {
+  auto result = call("getSize", folly::dynamic::array(server_.url("/missing.png")));
+  EXPECT_FALSE(result.first);
+}
+
+TEST_F(RSkImageLoaderTest, PrefetchedImageIsInMemoryCache) {
+  std::string url = server_.url("/prefetch.png");
+  server_.setResponse("/prefetch.png", {200, makePng(32, 32)});
+  EXPECT_EQ(call("queryCache", folly::dynamic::array(folly::dynamic::array(url))).second, folly::dynamic::object());
+
+  auto result = call("prefetchImage", folly::dynamic::array(url));
+  ASSERT_TRUE(result.first);
+  EXPECT_EQ(server_.waitForBodyBytesSent("/prefetch.png"), makePng(32, 32).size());
+  auto cacheStatus = call("queryCache", folly::dynamic::array(folly::dynamic::array(url))).second;
+  ASSERT_TRUE(cacheStatus.isObject());
+  EXPECT_NE(cacheStatus.getDefault(url, "").getString().find("memory"), std::string::npos);
+}
+
+} // namespace
+} // namespace react
+} // namespace facebook
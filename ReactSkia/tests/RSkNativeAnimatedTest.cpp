@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include <math.h>
+#include <algorithm>
+
+#include "gtest/gtest.h"
+
+#include "ReactSkia/ComponentViewRegistry.h"
+#include "ReactSkia/core_modules/RSkNativeAnimatedNodesManager.h"
+
+#define JS_FRAME_DURATION_MS (1000.0 / 60.0)
+#define TEST_VALUE_TAG 1
+#define TEST_VIEW_TAG 10
+
+namespace facebook {
+namespace react {
+namespace {
+
+using Easing = double (*)(double);
+
+double linear(double t) { return t; }
+double easeInQuad(double t) { return t * t; }
+
+// Frames config built by JS TimingAnimation.__getNativeAnimationConfig
+folly::dynamic timingConfig(double toValue, double durationMs, Easing easing) {
+  folly::dynamic frames = folly::dynamic::array();
+  int numFrames = round(durationMs / JS_FRAME_DURATION_MS);
+  for(int frame = 0; frame < numFrames; frame++) {
+    frames.push_back(easing((double)frame / numFrames));
+  }
+  frames.push_back(easing(1));
+  return folly::dynamic::object("type", "frames")("frames", frames)("toValue", toValue)("iterations", 1);
+}
+
+// Value JS TimingAnimation.onUpdate sets at a requestAnimationFrame time, when animation is JS driven
+double jsTimingValue(double fromValue, double toValue, double durationMs, Easing easing, double elapsedMs) {
+  if(elapsedMs >= durationMs) return fromValue + easing(1) * (toValue - fromValue);
+  return fromValue + easing(elapsedMs / durationMs) * (toValue - fromValue);
+}
+
+class RSkNativeAnimatedTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    nodesManager_ = std::make_shared<RSkNativeAnimatedNodesManager>(&componentViewRegistry_, &animationDriver_);
+    nodesManager_->createAnimatedNode(TEST_VALUE_TAG, folly::dynamic::object("type", "value")("value", 0)("offset", 0));
+  }
+
+  // Ticks the driver at the JS frame rate until the animation ends, returns the value of each frame
+  std::vector<double> runFrames(int maxFrames) {
+    std::vector<double> values;
+    for(int frame = 0; frame < maxFrames && !ended_; frame++) {
+      animationDriver_.tick(startTimeMs_ + frame * JS_FRAME_DURATION_MS);
+      values.push_back(nodesManager_->getValue(TEST_VALUE_TAG));
+    }
+    return values;
+  }
+
+  AnimatedEndCallback endCallback() {
+    return [this](std::vector<folly::dynamic> args) {
+      ended_ = true;
+      finished_ = args[0]["finished"].asBool();
+    };
+  }
+
+  RnsShell::AnimationDriver animationDriver_;
+  ComponentViewRegistry componentViewRegistry_;
+  std::shared_ptr<RSkNativeAnimatedNodesManager> nodesManager_;
+  double startTimeMs_{1000};
+  bool ended_{false};
+  bool finished_{false};
+};
+
+TEST_F(RSkNativeAnimatedTest, TimingMatchesJsDrivenFramesAndFinalValue) {
+  for(Easing easing : {linear, easeInQuad}) {
+    ended_ = false;
+    nodesManager_->setAnimatedNodeValue(TEST_VALUE_TAG, 0);
+    nodesManager_->startAnimatingNode(1, TEST_VALUE_TAG, timingConfig(100, 500, easing), endCallback());
+    std::vector<double> values = runFrames(60);
+
+    // Same value as JS would have set on each frame, & finished on the same frame
+    ASSERT_TRUE(ended_);
+    EXPECT_TRUE(finished_);
+    ASSERT_EQ(values.size(), 31u);
+    for(size_t frame = 0; frame < values.size(); frame++) {
+      EXPECT_NEAR(values[frame], jsTimingValue(0, 100, 500, easing, frame * JS_FRAME_DURATION_MS), 1e-6) << "frame " << frame;
+    }
+    EXPECT_DOUBLE_EQ(nodesManager_->getValue(TEST_VALUE_TAG), 100);
+    EXPECT_FALSE(animationDriver_.hasActiveAnimations());
+  }
+}
+
+TEST_F(RSkNativeAnimatedTest, SpringSettlesOnToValue) {
+  folly::dynamic config = folly::dynamic::object("type", "spring")("toValue", 1)("stiffness", 100)("damping", 10)
+                                                ("mass", 1)("initialVelocity", 0)("overshootClamping", false)
+                                                ("restDisplacementThreshold", 0.001)("restSpeedThreshold", 0.001);
+  nodesManager_->startAnimatingNode(1, TEST_VALUE_TAG, config, endCallback());
+  std::vector<double> values = runFrames(600);
+
+  ASSERT_TRUE(ended_);
+  EXPECT_TRUE(finished_);
+  EXPECT_GT(*std::max_element(values.begin(), values.end()), 1.0); // Under damped, overshoots
+  EXPECT_DOUBLE_EQ(nodesManager_->getValue(TEST_VALUE_TAG), 1);
+}
+
+TEST_F(RSkNativeAnimatedTest, SetValueStopsRunningAnimation) {
+  nodesManager_->startAnimatingNode(1, TEST_VALUE_TAG, timingConfig(100, 500, linear), endCallback());
+  runFrames(5);
+  nodesManager_->setAnimatedNodeValue(TEST_VALUE_TAG, 42);
+  EXPECT_TRUE(ended_);
+  EXPECT_FALSE(finished_);
+  EXPECT_DOUBLE_EQ(nodesManager_->getValue(TEST_VALUE_TAG), 42);
+}
+
+TEST_F(RSkNativeAnimatedTest, ListenedValuesAreReportedAfterFrame) {
+  std::vector<std::pair<Tag, double>> reported;
+  nodesManager_->setValueUpdateCallback([&reported](Tag nodeTag, double value) {
+    reported.emplace_back(nodeTag, value);
+  });
+  nodesManager_->createAnimatedNode(2, folly::dynamic::object("type", "multiplication")("input", folly::dynamic::array(TEST_VALUE_TAG, TEST_VALUE_TAG)));
+  nodesManager_->connectAnimatedNodes(TEST_VALUE_TAG, 2);
+  nodesManager_->startListeningToAnimatedNodeValue(2);
+
+  nodesManager_->setAnimatedNodeValue(TEST_VALUE_TAG, 3);
+  animationDriver_.tick(startTimeMs_);
+  ASSERT_EQ(reported.size(), 1u);
+  EXPECT_EQ(reported[0].first, 2);
+  EXPECT_DOUBLE_EQ(reported[0].second, 9);
+
+  nodesManager_->stopListeningToAnimatedNodeValue(2);
+  nodesManager_->setAnimatedNodeValue(TEST_VALUE_TAG, 4);
+  animationDriver_.tick(startTimeMs_ + JS_FRAME_DURATION_MS);
+  EXPECT_EQ(reported.size(), 1u);
+}
+
+TEST_F(RSkNativeAnimatedTest, ScrollEventDrivesMappedValue) {
+  folly::dynamic mapping = folly::dynamic::object("nativeEventPath", folly::dynamic::array("contentOffset", "y"))
+                                                 ("animatedValueTag", TEST_VALUE_TAG);
+  EXPECT_FALSE(RSkNativeAnimatedNodesManager::isAnimatedEventAttached(TEST_VIEW_TAG, "scroll"));
+  nodesManager_->addAnimatedEventToView(TEST_VIEW_TAG, "onScroll", mapping);
+  ASSERT_TRUE(RSkNativeAnimatedNodesManager::isAnimatedEventAttached(TEST_VIEW_TAG, "scroll"));
+
+  folly::dynamic event = folly::dynamic::object("contentOffset", folly::dynamic::object("x", 0)("y", 120));
+  RSkNativeAnimatedNodesManager::dispatchAnimatedEvent(TEST_VIEW_TAG, "scroll", event);
+  EXPECT_DOUBLE_EQ(nodesManager_->getValue(TEST_VALUE_TAG), 120);
+
+  // Events of other views & payloads without the mapped path leave the value
+  RSkNativeAnimatedNodesManager::dispatchAnimatedEvent(TEST_VIEW_TAG + 2, "scroll", event);
+  RSkNativeAnimatedNodesManager::dispatchAnimatedEvent(TEST_VIEW_TAG, "scroll", folly::dynamic::object("zoomScale", 1));
+  EXPECT_DOUBLE_EQ(nodesManager_->getValue(TEST_VALUE_TAG), 120);
+
+  nodesManager_->removeAnimatedEventFromView(TEST_VIEW_TAG, "onScroll", TEST_VALUE_TAG);
+  EXPECT_FALSE(RSkNativeAnimatedNodesManager::isAnimatedEventAttached(TEST_VIEW_TAG, "scroll"));
+}
+
+} // namespace
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include "include/core/SkMaskFilter.h"
+#include "include/core/SkSurface.h"
+
+#include <react/renderer/graphics/Color.h>
+
+#include "ReactSkia/views/common/RSkDrawUtils.h"
+#include "ReactSkia/views/common/RSkShadowCache.h"
+#include "rns_shell/tests/benchmark/RnsBenchmark.h"
+
+#define BENCHMARK_SURFACE_WIDTH 1920
+#define BENCHMARK_SURFACE_HEIGHT 1080
+#define BENCHMARK_TILE_WIDTH 300
+#define BENCHMARK_TILE_HEIGHT 200
+#define BENCHMARK_TILE_RADIUS 12
+#define BENCHMARK_TILE_COUNT 24 // A row of cards, as a TV home screen draws them
+
+namespace facebook {
+namespace react {
+namespace {
+
+struct ShadowScene {
+  explicit ShadowScene(int sigma)
+    : surface(SkSurface::MakeRasterN32Premul(BENCHMARK_SURFACE_WIDTH, BENCHMARK_SURFACE_HEIGHT)),
+      maskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, sigma)),
+      backgroundColor(colorFromComponents({1, 1, 1, 1})) {
+    borderMetrics.borderRadii.topLeft = BENCHMARK_TILE_RADIUS;
+    borderMetrics.borderRadii.topRight = BENCHMARK_TILE_RADIUS;
+    borderMetrics.borderRadii.bottomRight = BENCHMARK_TILE_RADIUS;
+    borderMetrics.borderRadii.bottomLeft = BENCHMARK_TILE_RADIUS;
+    for(int index = 0; index < BENCHMARK_TILE_COUNT; index++) {
+      int columns = BENCHMARK_SURFACE_WIDTH / (BENCHMARK_TILE_WIDTH + 20);
+      frames.push_back(Rect{{Float(20 + (index % columns) * (BENCHMARK_TILE_WIDTH + 20)),
+                             Float(20 + (index / columns) * (BENCHMARK_TILE_HEIGHT + 20))},
+                            {BENCHMARK_TILE_WIDTH, BENCHMARK_TILE_HEIGHT}});
+    }
+  }
+
+  // Translucent frame : no clip nor save layer, only the shadow itself is measured
+  void drawShadows() {
+    SkCanvas *canvas = surface->getCanvas();
+    for(auto &frame : frames) {
+      RSkDrawUtils::drawShadow(canvas, frame, borderMetrics, backgroundColor,
+                               SK_ColorBLACK, SkSize::Make(4, 4), 1.0, 0.5,
+                               nullptr, maskFilter);
+    }
+  }
+
+  // What drawShadow did before the cache : blur the rounded rect on every draw
+  void drawLiveShadows() {
+    SkCanvas *canvas = surface->getCanvas();
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setColor(SK_ColorBLACK);
+    paint.setMaskFilter(maskFilter);
+    for(auto &frame : frames) {
+      canvas->drawRRect(SkRRect::MakeRectXY(SkRect::MakeXYWH(frame.origin.x + 4, frame.origin.y + 4,
+                                                             frame.size.width, frame.size.height),
+                                            BENCHMARK_TILE_RADIUS, BENCHMARK_TILE_RADIUS), paint);
+    }
+  }
+
+  sk_sp<SkSurface> surface;
+  sk_sp<SkMaskFilter> maskFilter;
+  SharedColor backgroundColor;
+  BorderMetrics borderMetrics;
+  std::vector<Rect> frames;
+};
+
+RNS_BENCHMARK_WITH_ARGS(BM_ShadowLiveBlur, 4, 16, 32) {
+  ShadowScene scene(state.range());
+  while(state.keepRunning()) {
+    scene.drawLiveShadows();
+  }
+  state.setItemsProcessed(state.iterations() * BENCHMARK_TILE_COUNT);
+}
+
+// Steady state : all the tiles share one cached nine patch
+RNS_BENCHMARK_WITH_ARGS(BM_ShadowCacheHit, 4, 16, 32) {
+  ShadowScene scene(state.range());
+  RSkShadowCache::getInstance().clearMemory();
+  scene.drawShadows();
+  while(state.keepRunning()) {
+    scene.drawShadows();
+  }
+  state.setItemsProcessed(state.iterations() * BENCHMARK_TILE_COUNT);
+  state.setCounter("cachedBytes", RSkShadowCache::getInstance().getStats().bytesUsed);
+}
+
+// First frame after a trim : nine patch is rendered once, then hit by the other tiles
+RNS_BENCHMARK_WITH_ARGS(BM_ShadowCacheMiss, 4, 16, 32) {
+  ShadowScene scene(state.range());
+  while(state.keepRunning()) {
+    state.pauseTiming();
+    RSkShadowCache::getInstance().clearMemory();
+    state.resumeTiming();
+    scene.drawShadows();
+  }
+  state.setItemsProcessed(state.iterations() * BENCHMARK_TILE_COUNT);
+}
+
+} // namespace
+} // namespace react
+} // namespace facebook
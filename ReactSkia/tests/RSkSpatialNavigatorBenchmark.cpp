@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include <random>
+
+#include "ReactSkia/core_modules/RSkSpatialNavigatorContainer.h"
+#include "rns_shell/tests/benchmark/RnsBenchmark.h"
+
+#include "RSkTestComponents.h"
+
+#define BENCHMARK_GRID_COLUMNS 10
+#define BENCHMARK_CELL_SIZE 100
+#define BENCHMARK_CELL_GAP 20
+#define BENCHMARK_REPLAY_KEY_COUNT 2000
+#define BENCHMARK_REPLAY_MAX_RUN 8 // Presses in a row in the same direction, as when browsing a row of posters
+
+namespace facebook {
+namespace react {
+namespace {
+
+struct NavigationGrid {
+  explicit NavigationGrid(int count)
+    : tree(BENCHMARK_GRID_COLUMNS * (BENCHMARK_CELL_SIZE + BENCHMARK_CELL_GAP), 1080) {
+    for(int index = 0; index < count; index++) {
+      int row = index / BENCHMARK_GRID_COLUMNS;
+      int column = index % BENCHMARK_GRID_COLUMNS;
+      candidates.push_back(tree.addCandidate(container, SkIRect::MakeXYWH(column * (BENCHMARK_CELL_SIZE + BENCHMARK_CELL_GAP),
+                                                                          row * (BENCHMARK_CELL_SIZE + BENCHMARK_CELL_GAP),
+                                                                          BENCHMARK_CELL_SIZE, BENCHMARK_CELL_SIZE)));
+    }
+    tree.layout();
+  }
+
+  ~NavigationGrid() {
+    for(auto candidate : candidates)
+      container.removeComponent(candidate);
+  }
+
+  SpatialNavigator::Container container;
+  RSkTestComponentTree tree;
+  std::vector<RSkComponent*> candidates;
+};
+
+// D-pad walk over a settled grid, index is built once
+RNS_BENCHMARK_WITH_ARGS(BM_SpatialNavigationFindNearest, 100, 1000, 5000) {
+  NavigationGrid grid(state.range());
+  RSkComponent *focus = grid.candidates.front();
+  rnsKey direction = RNS_KEY_Right;
+  while(state.keepRunning()) {
+    RSkComponent *next = grid.container.findNearestCandidate(direction, focus->getLayerAbsoluteFrame(), nullptr);
+    if(next == nullptr) { // Edge of the grid, go down a row & turn around
+      direction = (direction == RNS_KEY_Right) ? RNS_KEY_Left : RNS_KEY_Right;
+      next = grid.container.findNearestCandidate(RNS_KEY_Down, focus->getLayerAbsoluteFrame(), nullptr);
+      if(next == nullptr)
+        next = grid.candidates.front();
+    }
+    focus = next;
+  }
+  state.setItemsProcessed(state.iterations());
+}
+
+// First navigation after the candidate list changed, index is rebuilt
+RNS_BENCHMARK_WITH_ARGS(BM_SpatialNavigationIndexRebuild, 100, 1000, 5000) {
+  NavigationGrid grid(state.range());
+  RSkComponent *focus = grid.candidates[grid.candidates.size() / 2];
+  while(state.keepRunning()) {
+    state.pauseTiming();
+    grid.container.removeComponent(grid.candidates.back());
+    grid.container.addComponent(grid.candidates.back());
+    state.resumeTiming();
+    RnsShell::Benchmark::doNotOptimize(grid.container.findNearestCandidate(RNS_KEY_Down, focus->getLayerAbsoluteFrame(), nullptr));
+  }
+  state.setItemsProcessed(state.iterations());
+}
+
+// Recorded-like D-pad session : runs of presses in one direction, mostly along the rows
+std::vector<rnsKey> makeKeySequence() {
+  std::mt19937 random(41);
+  const rnsKey directions[] = {RNS_KEY_Right, RNS_KEY_Right, RNS_KEY_Left, RNS_KEY_Down, RNS_KEY_Up};
+  std::vector<rnsKey> keys;
+  while(keys.size() < BENCHMARK_REPLAY_KEY_COUNT) {
+    rnsKey direction = directions[random() % 5];
+    keys.insert(keys.end(), 1 + random() % BENCHMARK_REPLAY_MAX_RUN, direction);
+  }
+  keys.resize(BENCHMARK_REPLAY_KEY_COUNT);
+  return keys;
+}
+
+// Replays the key sequence over a 10 column poster grid, the way the navigator searches on each press :
+// from the screen frame of the focus, skipping the focus itself. Edges keep the focus, as on a device.
+RNS_BENCHMARK_WITH_ARGS(BM_SpatialNavigationKeyReplay, 40, 200) {
+  NavigationGrid grid(BENCHMARK_GRID_COLUMNS * state.range());
+  std::vector<rnsKey> keys = makeKeySequence();
+  size_t focusMoves = 0;
+  while(state.keepRunning()) {
+    RSkComponent *focus = grid.candidates.front();
+    focusMoves = 0;
+    for(rnsKey key : keys) {
+      RSkComponent *next = grid.container.findNearestCandidate(key, focus->getScreenFrame(), [focus](RSkComponent *candidate) {
+        return candidate != focus;
+      });
+      if(next) {
+        focus = next;
+        focusMoves++;
+      }
+    }
+    RnsShell::Benchmark::doNotOptimize(focus);
+  }
+  state.setItemsProcessed(state.iterations() * keys.size());
+  state.setCounter("focusMoves", focusMoves);
+}
+
+} // namespace
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include "gtest/gtest.h"
+
+#include "ReactSkia/components/RSkComponentView.h"
+#include "ReactSkia/core_modules/RSkSpatialNavigatorContainer.h"
+
+#include "RSkTestComponents.h"
+
+namespace facebook {
+namespace react {
+namespace {
+
+// 3x3 grid of 100x100 candidates, 50 apart
+class RSkSpatialNavigatorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    for(int row = 0; row < 3; row++) {
+      for(int column = 0; column < 3; column++)
+        grid_[row][column] = tree_.addCandidate(container_, cellFrame(row, column));
+    }
+    tree_.layout();
+  }
+
+  void TearDown() override {
+    for(auto &component : tree_.components())
+      container_.removeComponent(component.get());
+  }
+
+  static SkIRect cellFrame(int row, int column) {
+    return SkIRect::MakeXYWH(100 + column * 150, 100 + row * 150, 100, 100);
+  }
+
+  RSkComponent* nearest(rnsKey direction, RSkComponent *from, SpatialNavigator::CandidateIndex::CandidateFilter filter = nullptr) {
+    return nearest(direction, from->getLayerAbsoluteFrame(), filter);
+  }
+
+  RSkComponent* nearest(rnsKey direction, const SkIRect &from, SpatialNavigator::CandidateIndex::CandidateFilter filter = nullptr) {
+    return container_.findNearestCandidate(direction, from, filter);
+  }
+
+  SpatialNavigator::Container container_;
+  RSkTestComponentTree tree_;
+  RSkComponent *grid_[3][3];
+};
+
+TEST_F(RSkSpatialNavigatorTest, MovesToAdjacentCandidate) {
+  EXPECT_EQ(nearest(RNS_KEY_Right, grid_[0][0]), grid_[0][1]);
+  EXPECT_EQ(nearest(RNS_KEY_Down, grid_[0][0]), grid_[1][0]);
+  EXPECT_EQ(nearest(RNS_KEY_Left, grid_[1][2]), grid_[1][1]);
+  EXPECT_EQ(nearest(RNS_KEY_Up, grid_[2][2]), grid_[1][2]);
+}
+
+TEST_F(RSkSpatialNavigatorTest, NoCandidateBeyondEdge) {
+  EXPECT_EQ(nearest(RNS_KEY_Left, grid_[0][0]), nullptr);
+  EXPECT_EQ(nearest(RNS_KEY_Up, grid_[0][1]), nullptr);
+  EXPECT_EQ(nearest(RNS_KEY_Right, grid_[2][2]), nullptr);
+  EXPECT_EQ(nearest(RNS_KEY_Down, grid_[2][2]), nullptr);
+}
+
+TEST_F(RSkSpatialNavigatorTest, FilteredCandidateIsSkipped) {
+  RSkComponent *skipped = grid_[0][1];
+  EXPECT_EQ(nearest(RNS_KEY_Right, grid_[0][0], [skipped](RSkComponent *candidate) { return candidate != skipped; }), grid_[0][2]);
+}
+
+TEST_F(RSkSpatialNavigatorTest, NonOverlappingCandidateBelow) {
+  // Nothing below overlaps the reference, nearest candidate completely below is picked, left most first
+  EXPECT_EQ(nearest(RNS_KEY_Down, SkIRect::MakeXYWH(600, 100, 100, 100)), grid_[1][0]);
+  // Nothing on the right overlaps vertically
+  EXPECT_EQ(nearest(RNS_KEY_Right, SkIRect::MakeXYWH(0, 600, 50, 50)), nullptr);
+}
+
+TEST_F(RSkSpatialNavigatorTest, SameFrameCandidatesPreferLatestTag) {
+  RSkComponent *first = tree_.addCandidate(container_, SkIRect::MakeXYWH(700, 100, 100, 100));
+  RSkComponent *latest = tree_.addCandidate(container_, SkIRect::MakeXYWH(700, 100, 100, 100));
+  tree_.layout();
+  ASSERT_GT(latest->getComponentData().tag, first->getComponentData().tag);
+  EXPECT_EQ(nearest(RNS_KEY_Right, grid_[0][2]), latest);
+}
+
+TEST_F(RSkSpatialNavigatorTest, IndexFollowsLayoutChanges) {
+  EXPECT_EQ(nearest(RNS_KEY_Right, grid_[0][0]), grid_[0][1]);
+  tree_.move(grid_[0][1], SkIRect::MakeXYWH(250, 900, 100, 100));
+  EXPECT_EQ(nearest(RNS_KEY_Right, grid_[0][0]), grid_[0][2]);
+  tree_.move(grid_[0][1], cellFrame(0, 1));
+  EXPECT_EQ(nearest(RNS_KEY_Right, grid_[0][0]), grid_[0][1]);
+}
+
+TEST_F(RSkSpatialNavigatorTest, IndexFollowsCandidateListChanges) {
+  uint64_t generation = SpatialNavigator::CandidateIndex::candidateListGeneration();
+  container_.removeComponent(grid_[0][1]);
+  EXPECT_NE(SpatialNavigator::CandidateIndex::candidateListGeneration(), generation);
+  EXPECT_EQ(nearest(RNS_KEY_Right, grid_[0][0]), grid_[0][2]);
+  container_.addComponent(grid_[0][1]);
+  EXPECT_EQ(nearest(RNS_KEY_Right, grid_[0][0]), grid_[0][1]);
+}
+
+} // namespace
+} // namespace react
+} // namespace facebook
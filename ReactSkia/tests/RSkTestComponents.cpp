@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include "ReactSkia/components/RSkComponentView.h"
+
+#include "RSkTestComponents.h"
+
+namespace facebook {
+namespace react {
+
+RSkTestComponentTree::RSkTestComponentTree(int width, int height) {
+  rootLayer_ = Layer::Create(Layer::EmptyClient::singleton(), LAYER_TYPE_VIRTUAL);
+  rootLayer_->setFrame(SkIRect::MakeWH(width, height));
+}
+
+ShadowView RSkTestComponentTree::makeShadowView(Tag tag, const SkIRect &frame, const char *componentName) {
+  ShadowView shadowView;
+  shadowView.tag = tag;
+  shadowView.componentName = componentName;
+  shadowView.props = std::make_shared<ViewProps const>();
+  shadowView.layoutMetrics.frame = Rect{{(Float)frame.x(), (Float)frame.y()}, {(Float)frame.width(), (Float)frame.height()}};
+  return shadowView;
+}
+
+RSkComponent* RSkTestComponentTree::addView(const SkIRect &frame) {
+  ShadowView shadowView = makeShadowView(nextTag_, frame);
+  nextTag_ += 2;
+  auto component = std::make_shared<RSkComponentView>(shadowView);
+  component->requiresLayer(shadowView, Layer::EmptyClient::singleton());
+  component->layer()->setFrame(frame);
+  rootLayer_->appendChild(component->layer());
+  components_.push_back(component);
+  return component.get();
+}
+
+RSkComponent* RSkTestComponentTree::addCandidate(SpatialNavigator::Container &container, const SkIRect &frame) {
+  RSkComponent *component = addView(frame);
+  container.addComponent(component);
+  return component;
+}
+
+void RSkTestComponentTree::move(RSkComponent *component, const SkIRect &frame) {
+  component->layer()->setFrame(frame);
+  component->layer()->invalidate(LayerLayoutInvalidate);
+  layout();
+}
+
+void RSkTestComponentTree::layout() {
+  FrameDamages damages;
+  SkRect clipBound = SkRect::MakeEmpty();
+  PaintContext context = {
+    nullptr, // Pre paint does not draw
+    damages,
+#if USE(RNS_SHELL_PARTIAL_UPDATES)
+    false,
+#endif
+    clipBound,
+    nullptr,
+    {0,0}
+  };
+  rootLayer_->prePaint(context);
+}
+
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,40 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "ReactSkia/components/RSkComponent.h"
+
+namespace facebook {
+namespace react {
+
+// Plain views with layers, standing in for a mounted component tree in the headless tests & benchmarks
+class RSkTestComponentTree {
+ public:
+  RSkTestComponentTree(int width = 1920, int height = 1080);
+
+  static ShadowView makeShadowView(Tag tag, const SkIRect &frame, const char *componentName = "View");
+
+  // Adds a view at the frame (root layer space) & registers it as a navigation candidate of the container
+  RSkComponent* addCandidate(SpatialNavigator::Container &container, const SkIRect &frame);
+  RSkComponent* addView(const SkIRect &frame);
+  void move(RSkComponent *component, const SkIRect &frame); // Moves & lays out the tree again
+
+  void layout(); // Updates the absolute frames, as the compositor's pre paint does
+  const std::vector<std::shared_ptr<RSkComponent>>& components() const { return components_; }
+  SharedLayer rootLayer() { return rootLayer_; }
+
+ private:
+  SharedLayer rootLayer_;
+  std::vector<std::shared_ptr<RSkComponent>> components_;
+  Tag nextTag_{2}; // Even tags, like the React tags of the views
+};
+
+} // namespace react
+} // namespace facebook
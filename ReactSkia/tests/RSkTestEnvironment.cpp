@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include <thread>
+
+#include "ReactSkia/ReactSkiaApp.h"
+#include "ReactSkia/sdk/NotificationCenter.h"
+#include "ReactSkia/utils/RnsLog.h"
+#include "rns_shell/common/MemoryAccounting.h"
+#include "rns_shell/platform/linux/TaskLoop.h"
+
+#include "RSkTestEnvironment.h"
+
+namespace facebook {
+namespace react {
+
+// Defined by the app, tests run without a bridge
+facebook::react::RNInstance* ReactSkiaApp::currentBridgeInstance{nullptr};
+
+static std::thread mainLoopThread;
+
+void RSkTestEnvironment::setUp(int argc, char **argv) {
+  FLAGS_logtostderr = 1;
+  FLAGS_minloglevel = 1; // Warnings & errors, info logs of the hot paths would skew the benchmarks
+  google::InitGoogleLogging(argv[0]);
+
+  RnsShell::TaskLoop::initializeMain();
+  RnsShell::MemoryAccounting::initialize();
+  NotificationCenter::initializeDefault();
+  NotificationCenter::initializeSubWindowCenter();
+
+  mainLoopThread = std::thread([]() {
+    RnsShell::TaskLoop::main().run();
+  });
+  RnsShell::TaskLoop::main().waitUntilRunning();
+}
+
+void RSkTestEnvironment::tearDown() {
+  RnsShell::TaskLoop::main().stop();
+  if(mainLoopThread.joinable())
+    mainLoopThread.join();
+  google::ShutdownGoogleLogging();
+}
+
+} // namespace react
+} // namespace facebook
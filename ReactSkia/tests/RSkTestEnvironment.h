@@ -0,0 +1,24 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#pragma once
+
+namespace facebook {
+namespace react {
+
+/*
+ * Headless environment of the test & benchmark executables. Brings up what the app shell does before the
+ * application is created (logging, main task loop, notification centers, memory accounting), without the
+ * platform display & the RN instance. Main task loop runs on its own thread, so the code dispatching to it works.
+ */
+class RSkTestEnvironment {
+ public:
+  static void setUp(int argc, char **argv);
+  static void tearDown();
+};
+
+} // namespace react
+} // namespace facebook
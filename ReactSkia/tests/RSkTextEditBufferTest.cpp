@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include <random>
+
+#include "gtest/gtest.h"
+
+#include "ReactSkia/components/RSkTextEditBuffer.h"
+
+#define TEST_RANDOM_EDIT_COUNT 20000
+
+namespace facebook {
+namespace react {
+namespace {
+
+// Line starts of the reference string, as the edit buffer keeps them
+std::vector<size_t> lineStartsOf(const std::string &text) {
+  std::vector<size_t> lineStarts{0};
+  for(size_t index = 0; index < text.length(); index++) {
+    if(text[index] == '\n') lineStarts.push_back(index + 1);
+  }
+  return lineStarts;
+}
+
+void expectSameText(const RSkTextEditBuffer &buffer, const std::string &reference) {
+  ASSERT_EQ(buffer.length(), reference.length());
+  ASSERT_EQ(buffer.text(), reference);
+  std::vector<size_t> lineStarts = lineStartsOf(reference);
+  ASSERT_EQ(buffer.lineCount(), lineStarts.size());
+  for(size_t line = 0; line < lineStarts.size(); line++) {
+    size_t lineEnd = (line + 1 < lineStarts.size()) ? lineStarts[line + 1] - 1 : reference.length();
+    EXPECT_EQ(buffer.lineStart(line), lineStarts[line]);
+    EXPECT_EQ(buffer.lineText(line), reference.substr(lineStarts[line], lineEnd - lineStarts[line]));
+  }
+}
+
+TEST(RSkTextEditBufferTest, TypingAtCursorGrowsText) {
+  RSkTextEditBuffer buffer("ac");
+  buffer.insert(1, "b");
+  buffer.insert(2, "X");
+  buffer.insert(3, "Y");
+  expectSameText(buffer, "abXYc");
+  buffer.erase(2, 2);
+  expectSameText(buffer, "abc");
+  buffer.erase(10, 1); // Out of range is a no op
+  expectSameText(buffer, "abc");
+}
+
+TEST(RSkTextEditBufferTest, LinesFollowEdits) {
+  RSkTextEditBuffer buffer("first\nsecond");
+  EXPECT_EQ(buffer.lineCount(), 2u);
+  EXPECT_EQ(buffer.lineOf(5), 0u);
+  EXPECT_EQ(buffer.lineOf(6), 1u);
+  buffer.insert(3, "\n\n");
+  expectSameText(buffer, "fir\n\nst\nsecond");
+  EXPECT_EQ(buffer.lineLength(1), 0u);
+  buffer.erase(2, 6); // Line breaks inside the erased range merge the lines
+  expectSameText(buffer, "fisecond");
+  buffer.reset({});
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_EQ(buffer.lineCount(), 1u);
+}
+
+TEST(RSkTextEditBufferTest, RandomEditsMatchString) {
+  std::mt19937 random(7);
+  std::string reference = "initial\ntext";
+  RSkTextEditBuffer buffer(reference);
+  const std::string alphabet = "abc \n";
+  size_t cursor = reference.length();
+  for(int edit = 0; edit < TEST_RANDOM_EDIT_COUNT; edit++) {
+    int action = random() % 10;
+    if(action < 2) {
+      cursor = random() % (reference.length() + 1); // Cursor moved somewhere else
+    } else if(action < 8) {
+      std::string text(1 + random() % 3, alphabet[random() % alphabet.length()]);
+      buffer.insert(cursor, text);
+      reference.insert(cursor, text);
+      cursor += text.length();
+    } else if(cursor > 0) {
+      size_t length = 1 + random() % std::min<size_t>(cursor, 4);
+      cursor -= length;
+      buffer.erase(cursor, length);
+      reference.erase(cursor, length);
+    }
+    if(edit % 97 == 0) {
+      expectSameText(buffer, reference);
+    }
+  }
+  expectSameText(buffer, reference);
+}
+
+TEST(RSkTextEditBufferTest, UnchangedLinesAreNotLaidOutAgain) {
+  size_t factoryCalls = 0;
+  RSkTextLineParagraphs::ParagraphFactory factory = [&factoryCalls](const std::string &lineText) {
+    factoryCalls++;
+    return std::shared_ptr<skia::textlayout::Paragraph>();
+  };
+  RSkTextEditBuffer buffer("one\ntwo\nthree");
+  RSkTextLineParagraphs lineParagraphs;
+  EXPECT_EQ(lineParagraphs.layout(buffer, factory), 3u);
+
+  buffer.insert(7, "o"); // Edits the second line only
+  EXPECT_EQ(lineParagraphs.layout(buffer, factory), 1u);
+  buffer.insert(0, "zero\n"); // Lines below a new line are reused
+  EXPECT_EQ(lineParagraphs.layout(buffer, factory), 1u);
+  ASSERT_EQ(lineParagraphs.lines().size(), 4u);
+  EXPECT_EQ(lineParagraphs.lines()[2].text, "twoo");
+
+  lineParagraphs.clear();
+  EXPECT_EQ(lineParagraphs.layout(buffer, factory), 4u);
+  EXPECT_EQ(factoryCalls, 9u);
+}
+
+TEST(RSkTextEditBufferTest, LaidOutLinesFollowRandomEdits) {
+  RSkTextLineParagraphs::ParagraphFactory factory = [](const std::string &lineText) {
+    return std::shared_ptr<skia::textlayout::Paragraph>();
+  };
+  std::mt19937 random(11);
+  RSkTextEditBuffer buffer("first\nsecond\nthird");
+  RSkTextLineParagraphs lineParagraphs;
+  lineParagraphs.layout(buffer, factory);
+  buffer.insert(5, "\n"); // Line break at the end of a line lays out only the new line
+  EXPECT_EQ(lineParagraphs.layout(buffer, factory), 1u);
+  buffer.erase(5, 1); // Joining it back lays out the joined line
+  EXPECT_EQ(lineParagraphs.layout(buffer, factory), 1u);
+
+  const std::string alphabet = "ab\n";
+  for(int edit = 0; edit < TEST_RANDOM_EDIT_COUNT; edit++) {
+    size_t position = random() % (buffer.length() + 1);
+    if(random() % 3) {
+      buffer.insert(position, std::string(1 + random() % 2, alphabet[random() % alphabet.length()]));
+    } else {
+      buffer.erase(position, 1 + random() % 3);
+    }
+    if(random() % 4) {
+      continue; // Edits add up till the next layout
+    }
+    lineParagraphs.layout(buffer, factory);
+    ASSERT_EQ(lineParagraphs.lines().size(), buffer.lineCount());
+    for(size_t line = 0; line < buffer.lineCount(); line++) {
+      ASSERT_EQ(lineParagraphs.lines()[line].text, buffer.lineText(line));
+    }
+  }
+}
+
+} // namespace
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include "modules/skparagraph/src/ParagraphBuilderImpl.h"
+
+#include "ReactSkia/components/RSkTextEditBuffer.h"
+#include "ReactSkia/textlayoutmanager/RSkTextLayoutManager.h"
+#include "rns_shell/tests/benchmark/RnsBenchmark.h"
+
+#define BENCHMARK_TYPED_CHARACTERS 10000
+#define BENCHMARK_LINE_LENGTH 80 // Line break typed after it, as in a multiline input
+#define BENCHMARK_INPUT_WIDTH 1200
+
+namespace facebook {
+namespace react {
+namespace {
+
+using namespace skia::textlayout;
+
+struct TypingSession {
+  TypingSession() {
+    textAttributes = TextAttributes::defaultTextAttributes();
+    textAttributes.fontSize = 24;
+  }
+
+  // Paragraph built the way TextInput builds the one of a line
+  std::shared_ptr<Paragraph> buildParagraph(const std::string &text) {
+    RSkSkTextLayout textLayout;
+    textLayout.builder = std::static_pointer_cast<ParagraphBuilder>(
+                            std::make_shared<ParagraphBuilderImpl>(textLayout.paraStyle, layoutManager.collection_));
+    layoutManager.buildText(textLayout, nullptr, ParagraphAttributes{}, textAttributes, text.empty() ? "\u200B" : text, true);
+    textLayout.builder->setParagraphStyle(textLayout.paraStyle);
+    std::shared_ptr<Paragraph> paragraph = textLayout.builder->Build();
+    paragraph->layout(BENCHMARK_INPUT_WIDTH);
+    return paragraph;
+  }
+
+  static char typedCharacter(int index) {
+    return ((index + 1) % BENCHMARK_LINE_LENGTH == 0) ? '\n' : static_cast<char>('a' + index % 26);
+  }
+
+  RSkTextLayoutManager layoutManager;
+  TextAttributes textAttributes;
+};
+
+// Each key edits the piece table & lays out only the edited line
+RNS_BENCHMARK(BM_TextInputTypingLineLayout) {
+  TypingSession session;
+  RSkTextLineParagraphs::ParagraphFactory factory = [&session](const std::string &lineText) {
+    return session.buildParagraph(lineText);
+  };
+  size_t laidOutLines = 0;
+  while(state.keepRunning()) {
+    RSkTextEditBuffer buffer;
+    RSkTextLineParagraphs lineParagraphs;
+    laidOutLines = 0;
+    for(int index = 0; index < BENCHMARK_TYPED_CHARACTERS; index++) {
+      buffer.insert(buffer.length(), std::string(1, TypingSession::typedCharacter(index)));
+      laidOutLines += lineParagraphs.layout(buffer, factory);
+    }
+    RnsShell::Benchmark::doNotOptimize(lineParagraphs.height());
+  }
+  state.setItemsProcessed(state.iterations() * BENCHMARK_TYPED_CHARACTERS);
+  state.setCounter("laidOutLines", laidOutLines);
+}
+
+// What TextInput did before : each key copies the string & lays out the whole text as one paragraph
+RNS_BENCHMARK(BM_TextInputTypingFullLayout) {
+  TypingSession session;
+  while(state.keepRunning()) {
+    std::string text;
+    std::shared_ptr<Paragraph> paragraph;
+    for(int index = 0; index < BENCHMARK_TYPED_CHARACTERS; index++) {
+      std::string textString = text;
+      textString.insert(textString.length(), 1, TypingSession::typedCharacter(index));
+      text = textString;
+      paragraph = session.buildParagraph(text);
+    }
+    RnsShell::Benchmark::doNotOptimize(paragraph->getHeight());
+  }
+  state.setItemsProcessed(state.iterations() * BENCHMARK_TYPED_CHARACTERS);
+}
+
+} // namespace
+} // namespace react
+} // namespace facebook
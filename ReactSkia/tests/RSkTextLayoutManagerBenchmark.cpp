@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include <limits>
+
+#include "ReactSkia/textlayoutmanager/RSkTextLayoutManager.h"
+#include "rns_shell/tests/benchmark/RnsBenchmark.h"
+
+#define BENCHMARK_TEXT_WORD "lorem "
+
+namespace facebook {
+namespace react {
+namespace {
+
+AttributedString makeString(int words) {
+  AttributedString attributedString;
+  AttributedString::Fragment fragment;
+  for(int word = 0; word < words; word++)
+    fragment.string += BENCHMARK_TEXT_WORD;
+  fragment.textAttributes = TextAttributes::defaultTextAttributes();
+  fragment.textAttributes.fontSize = 24;
+  attributedString.appendFragment(fragment);
+  return attributedString;
+}
+
+// Text measure of the layout pass, the argument is the word count
+RNS_BENCHMARK_WITH_ARGS(BM_TextDoMeasure, 1, 10, 100) {
+  RSkTextLayoutManager layoutManager;
+  AttributedString attributedString = makeString(state.range());
+  LayoutConstraints layoutConstraints{{0, 0}, {600, std::numeric_limits<Float>::infinity()}};
+  TextMeasurement measurement;
+  while(state.keepRunning()) {
+    measurement = layoutManager.doMeasure(nullptr, attributedString, ParagraphAttributes{}, layoutConstraints);
+    RnsShell::Benchmark::doNotOptimize(measurement.size);
+  }
+  state.setItemsProcessed(state.iterations());
+  state.setCounter("height", measurement.size.height);
+}
+
+} // namespace
+} // namespace react
+} // namespace facebook
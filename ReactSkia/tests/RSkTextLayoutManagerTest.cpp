@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include <limits>
+
+#include "gtest/gtest.h"
+
+#include "ReactSkia/textlayoutmanager/RSkTextLayoutManager.h"
+
+#define TEST_TEXT_SHORT "Hello"
+#define TEST_TEXT_LONG "The quick brown fox jumps over the lazy dog, again and again, till the line has to wrap"
+
+namespace facebook {
+namespace react {
+namespace {
+
+class RSkTextLayoutManagerTest : public ::testing::Test {
+ protected:
+  static AttributedString makeString(std::string text, Float fontSize = 20) {
+    AttributedString attributedString;
+    AttributedString::Fragment fragment;
+    fragment.string = text;
+    fragment.textAttributes = TextAttributes::defaultTextAttributes();
+    fragment.textAttributes.fontSize = fontSize;
+    attributedString.appendFragment(fragment);
+    return attributedString;
+  }
+
+  static void appendAttachment(AttributedString &attributedString, Size size) {
+    AttributedString::Fragment fragment;
+    fragment.string = AttributedString::Fragment::AttachmentCharacter();
+    fragment.parentShadowView.layoutMetrics.frame.size = size;
+    attributedString.appendFragment(fragment);
+  }
+
+  TextMeasurement measure(const AttributedString &attributedString, Float maxWidth) {
+    LayoutConstraints layoutConstraints{{0, 0}, {maxWidth, std::numeric_limits<Float>::infinity()}};
+    return layoutManager_.doMeasure(nullptr, attributedString, ParagraphAttributes{}, layoutConstraints);
+  }
+
+  RSkTextLayoutManager layoutManager_;
+};
+
+TEST_F(RSkTextLayoutManagerTest, MeasuresSingleLine) {
+  TextMeasurement measurement = measure(makeString(TEST_TEXT_SHORT), 1000);
+  EXPECT_GT(measurement.size.width, 0);
+  EXPECT_LT(measurement.size.width, 1000);
+  EXPECT_GT(measurement.size.height, 0);
+  EXPECT_TRUE(measurement.attachments.empty());
+}
+
+TEST_F(RSkTextLayoutManagerTest, WidthIsClampedToConstraint) {
+  TextMeasurement measurement = measure(makeString(TEST_TEXT_LONG), 200);
+  EXPECT_LE(measurement.size.width, 200);
+}
+
+TEST_F(RSkTextLayoutManagerTest, NarrowConstraintWrapsToMoreLines) {
+  TextMeasurement wide = measure(makeString(TEST_TEXT_LONG), 5000);
+  TextMeasurement narrow = measure(makeString(TEST_TEXT_LONG), 200);
+  EXPECT_GT(narrow.size.height, wide.size.height);
+}
+
+TEST_F(RSkTextLayoutManagerTest, LargerFontIsLarger) {
+  TextMeasurement small = measure(makeString(TEST_TEXT_SHORT, 12), 1000);
+  TextMeasurement large = measure(makeString(TEST_TEXT_SHORT, 48), 1000);
+  EXPECT_GT(large.size.width, small.size.width);
+  EXPECT_GT(large.size.height, small.size.height);
+}
+
+TEST_F(RSkTextLayoutManagerTest, MeasureIsRepeatable) {
+  AttributedString attributedString = makeString(TEST_TEXT_LONG);
+  TextMeasurement first = measure(attributedString, 300);
+  TextMeasurement second = measure(attributedString, 300);
+  EXPECT_EQ(first.size, second.size);
+}
+
+TEST_F(RSkTextLayoutManagerTest, AttachmentsAreReported) {
+  AttributedString attributedString = makeString(TEST_TEXT_SHORT);
+  appendAttachment(attributedString, {50, 40});
+  appendAttachment(attributedString, {30, 60});
+  TextMeasurement measurement = measure(attributedString, 1000);
+  ASSERT_EQ(measurement.attachments.size(), 2u);
+  EXPECT_EQ(measurement.attachments[0].frame.size, (Size{50, 40}));
+  EXPECT_EQ(measurement.attachments[1].frame.size, (Size{30, 60}));
+  EXPECT_GE(measurement.size.height, 60);
+}
+
+} // namespace
+} // namespace react
+} // namespace facebook
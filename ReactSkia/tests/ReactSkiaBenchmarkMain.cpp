@@ -0,0 +1,16 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include "rns_shell/tests/benchmark/RnsBenchmark.h"
+
+#include "RSkTestEnvironment.h"
+
+int main(int argc, char **argv) {
+  facebook::react::RSkTestEnvironment::setUp(argc, argv);
+  int status = RnsShell::Benchmark::runBenchmarks(argc, argv);
+  facebook::react::RSkTestEnvironment::tearDown();
+  return status;
+}
@@ -0,0 +1,17 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include "gtest/gtest.h"
+
+#include "RSkTestEnvironment.h"
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  facebook::react::RSkTestEnvironment::setUp(argc, argv);
+  int status = RUN_ALL_TESTS();
+  facebook::react::RSkTestEnvironment::tearDown();
+  return status;
+}
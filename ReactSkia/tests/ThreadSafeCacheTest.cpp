@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ReactSkia/sdk/ThreadSafeCache.h"
+
+#define TEST_CACHE_LONG_EXPIRY_MS 60000
+#define TEST_CACHE_SHORT_EXPIRY_MS 50
+#define TEST_CACHE_EXPIRY_WAIT_MS 500
+
+namespace rns {
+namespace sdk {
+namespace {
+
+double expiryAfter(double durationMs) {
+  return Timer::getCurrentTimeMSecs() + durationMs;
+}
+
+TEST(ThreadSafeCacheTest, ReturnsCachedValue) {
+  ThreadSafeCache<std::string, int> cache;
+  cache.setCache("first", 1, expiryAfter(TEST_CACHE_LONG_EXPIRY_MS));
+  cache.setCache("second", 2, expiryAfter(TEST_CACHE_LONG_EXPIRY_MS));
+
+  EXPECT_TRUE(cache.isAvailableInCache("first"));
+  ASSERT_TRUE(cache.getCacheData("second").has_value());
+  EXPECT_EQ(cache.getCacheData("second").value(), 2);
+  EXPECT_FALSE(cache.getCacheData("third").has_value());
+  EXPECT_FALSE(cache.isAvailableInCache("third"));
+}
+
+TEST(ThreadSafeCacheTest, SetCacheReplacesValue) {
+  ThreadSafeCache<std::string, int> cache;
+  cache.setCache("key", 1, expiryAfter(TEST_CACHE_LONG_EXPIRY_MS));
+  cache.setCache("key", 5, expiryAfter(TEST_CACHE_LONG_EXPIRY_MS));
+  ASSERT_TRUE(cache.getCacheData("key").has_value());
+  EXPECT_EQ(cache.getCacheData("key").value(), 5);
+}
+
+TEST(ThreadSafeCacheTest, ExpiredEntriesAreRemoved) {
+  ThreadSafeCache<std::string, int> cache;
+  cache.setCache("long", 1, expiryAfter(TEST_CACHE_LONG_EXPIRY_MS));
+  cache.setCache("short", 2, expiryAfter(TEST_CACHE_SHORT_EXPIRY_MS)); // Reschedules the expiry timer earlier
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(TEST_CACHE_EXPIRY_WAIT_MS));
+  EXPECT_FALSE(cache.getCacheData("short").has_value());
+  EXPECT_TRUE(cache.getCacheData("long").has_value());
+}
+
+TEST(ThreadSafeCacheTest, EvictIfRemovesMatchingEntries) {
+  ThreadSafeCache<int, int> cache;
+  for(int key = 0; key < 10; key++)
+    cache.setCache(key, key * 10, expiryAfter(TEST_CACHE_LONG_EXPIRY_MS));
+
+  size_t evictCount = cache.evictIf([](const int &value) { return value >= 50; });
+  EXPECT_EQ(evictCount, 5u);
+  EXPECT_TRUE(cache.getCacheData(4).has_value());
+  EXPECT_FALSE(cache.getCacheData(5).has_value());
+}
+
+TEST(ThreadSafeCacheTest, ConcurrentReadersAndWriters) {
+  ThreadSafeCache<int, std::shared_ptr<int>> cache;
+  std::vector<std::thread> threads;
+  for(int thread = 0; thread < 4; thread++) {
+    threads.emplace_back([&cache, thread]() {
+      for(int index = 0; index < 1000; index++) {
+        int key = thread * 1000 + index;
+        cache.setCache(key, std::make_shared<int>(key), expiryAfter(TEST_CACHE_LONG_EXPIRY_MS));
+        auto value = cache.getCacheData(key);
+        ASSERT_TRUE(value.has_value());
+        EXPECT_EQ(*value.value(), key);
+      }
+    });
+  }
+  for(auto &thread : threads)
+    thread.join();
+  EXPECT_EQ(cache.evictIf([](const std::shared_ptr<int> &value) { return true; }), 4000u);
+}
+
+} // namespace
+} // namespace sdk
+} // namespace rns
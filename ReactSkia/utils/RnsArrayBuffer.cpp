@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include <atomic>
+#include <string.h>
+
+#include "ReactSkia/utils/RnsArrayBuffer.h"
+#include "ReactSkia/utils/RnsLog.h"
+
+namespace facebook {
+namespace react {
+
+// Set once the runtime has refused ArrayBuffer data access, so the exception is not paid on each call
+static std::atomic<bool> arrayBufferDataUnsupported{false};
+
+jsi::Value createArrayBuffer(jsi::Runtime &rt, const uint8_t* data, size_t length) {
+  if(arrayBufferDataUnsupported) {
+    return jsi::Value::undefined();
+  }
+  try {
+    jsi::ArrayBuffer arrayBuffer = rt.global().getPropertyAsFunction(rt, "ArrayBuffer")
+        .callAsConstructor(rt, static_cast<double>(length)).getObject(rt).getArrayBuffer(rt);
+    if(length) {
+      memcpy(arrayBuffer.data(rt), data, length);
+    }
+    return std::move(arrayBuffer);
+  } catch(const jsi::JSError &) {
+    throw; // Thrown by JS itself, like an allocation failure. Not a missing runtime feature.
+  } catch(const std::exception &error) {
+    RNS_LOG_WARN("ArrayBuffer data is not accessible on " << rt.description() << " : " << error.what());
+    arrayBufferDataUnsupported = true;
+  }
+  return jsi::Value::undefined();
+}
+
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,23 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "jsi/jsi.h"
+
+namespace facebook {
+namespace react {
+
+// ArrayBuffer created by the runtime & filled once from the bytes, to be called on the JS thread.
+// Returns undefined on runtimes which do not expose ArrayBuffer data through JSI (JSC), the caller then
+// falls back to the encoding its JS counterpart decodes.
+jsi::Value createArrayBuffer(jsi::Runtime &rt, const uint8_t* data, size_t length);
+
+} // namespace react
+} // namespace facebook
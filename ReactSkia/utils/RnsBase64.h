@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+namespace facebook {
+namespace react {
+
+// Padded base64 without line breaks, as JS base64-js decodes it for ArrayBuffer data
+inline std::string base64Encode(const unsigned char* data, size_t length) {
+  static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string encoded;
+  encoded.reserve(((length + 2) / 3) * 4);
+  size_t index = 0;
+  for(; index + 2 < length; index += 3) {
+    uint32_t triple = (data[index] << 16) | (data[index + 1] << 8) | data[index + 2];
+    encoded.push_back(alphabet[(triple >> 18) & 0x3F]);
+    encoded.push_back(alphabet[(triple >> 12) & 0x3F]);
+    encoded.push_back(alphabet[(triple >> 6) & 0x3F]);
+    encoded.push_back(alphabet[triple & 0x3F]);
+  }
+  if(index < length) {
+    uint32_t triple = data[index] << 16;
+    if(index + 1 < length)
+      triple |= data[index + 1] << 8;
+    encoded.push_back(alphabet[(triple >> 18) & 0x3F]);
+    encoded.push_back(alphabet[(triple >> 12) & 0x3F]);
+    encoded.push_back((index + 1 < length) ? alphabet[(triple >> 6) & 0x3F] : '=');
+    encoded.push_back('=');
+  }
+  return encoded;
+}
+
+} // namespace react
+} // namespace facebook
@@ -5,7 +5,9 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <algorithm>
 #include <math.h>
+#include <vector>
 
 #include "include/core/SkPaint.h"
 #include "include/core/SkClipOp.h"
@@ -15,6 +17,7 @@
 
 #include "RSkDrawUtils.h"
 #include "RSkConversion.h"
+#include "RSkShadowCache.h"
 #include "ReactSkia/utils/RnsLog.h"
 
 #define DEFAULT_BACKGROUND_COLOR  SK_ColorTRANSPARENT /*Transaprent*/
@@ -25,6 +28,10 @@
 
 namespace facebook {
 namespace react {
+
+using RSkDrawUtils::FrameDrawOp;
+using RSkDrawUtils::FrameGeometry;
+
 namespace {
 
 enum FrameType {
@@ -142,7 +149,21 @@ inline bool hasUniformBorderEdges(BorderMetrics borderProps)
 {
     return  ( borderProps.borderColors.isUniform() &&  borderProps.borderWidths.isUniform());
 }
-void drawRect(FrameType frameType,SkCanvas *canvas,
+inline void drawFrameOp(SkCanvas *canvas,const FrameDrawOp &drawOp)
+{
+    switch(drawOp.type) {
+        case FrameDrawOp::RRect:
+            canvas->drawRRect(drawOp.outer, drawOp.paint);
+            break;
+        case FrameDrawOp::DRRect:
+            canvas->drawDRRect(drawOp.outer, drawOp.inner, drawOp.paint);
+            break;
+        case FrameDrawOp::Path:
+            canvas->drawPath(drawOp.path, drawOp.paint);
+            break;
+    }
+}
+FrameDrawOp createRectDrawOp(FrameType frameType,
                                         Rect frame,
                                         BorderMetrics borderProps,
                                         SkColor Color,
@@ -150,13 +171,13 @@ void drawRect(FrameType frameType,SkCanvas *canvas,
                                         sk_sp<SkMaskFilter> shadowMaskFilter=nullptr
                  )
 {
-    if(canvas == NULL) return;
 /*Case DrawRect assumes same width for all the sides.So referring left */
     auto rectStrokeWidth = borderProps.borderWidths.left;
 
-    SkRRect rRect;
+    FrameDrawOp drawOp;
+    SkRRect &rRect=drawOp.outer;
     SkRect rect;
-    SkPaint paintObj;
+    SkPaint &paintObj=drawOp.paint;
     if(paint != NULL){ paintObj = *paint; }
 
     paintObj.setAntiAlias(true);
@@ -190,18 +211,110 @@ void drawRect(FrameType frameType,SkCanvas *canvas,
     } else if((frameType == MonoChromeStrokedRect) ||(frameType == PolyChromeStrokedRect) ){
         setStyle(rectStrokeWidth,SkPaint::kStroke_Style,borderProps.borderStyles.left,&paintObj);
     }
-    canvas->drawRRect(rRect, paintObj);
+    return drawOp;
 }
-inline void drawPath(SkCanvas *canvas,SkPath &path,SharedColor Color,sk_sp<SkImageFilter> shadowImageFilter=nullptr)
+void drawRect(FrameType frameType,SkCanvas *canvas,
+                                        Rect frame,
+                                        BorderMetrics borderProps,
+                                        SkColor Color,
+                                        SkPaint *paint=NULL,
+                                        sk_sp<SkMaskFilter> shadowMaskFilter=nullptr
+                 )
 {
+    if(canvas == NULL) return;
+    drawFrameOp(canvas,createRectDrawOp(frameType,frame,borderProps,Color,paint,shadowMaskFilter));
+}
+FrameDrawOp createSolidBorderDrawOp(Rect frame,BorderMetrics borderProps,SkColor Color)
+{
+/* Uniform solid border is the area between two rounded rects, filled in a single draw.
+   Matches the stroke of the rrect inset by half the width : arcs grow by half the width outside
+   and shrink by half the width inside, square corners stay square.*/
+    auto strokeWidth = borderProps.borderWidths.left;
+    Float cornerRadii[4]={borderProps.borderRadii.topLeft,borderProps.borderRadii.topRight,
+                          borderProps.borderRadii.bottomRight,borderProps.borderRadii.bottomLeft};
+    SkVector outerRadii[4],innerRadii[4];
+    for(int corner=0;corner<4;corner++) {
+        Float outerRadius=(cornerRadii[corner] > 0) ? cornerRadii[corner]+strokeWidth/2 : 0;
+        Float innerRadius=std::max<Float>(cornerRadii[corner]-strokeWidth/2,0);
+        outerRadii[corner]={outerRadius,outerRadius};
+        innerRadii[corner]={innerRadius,innerRadius};
+    }
+    SkRect outerRect=SkRect::MakeXYWH(frame.origin.x,frame.origin.y,frame.size.width,frame.size.height);
+    SkRect innerRect=outerRect.makeInset(strokeWidth,strokeWidth);
+
+    FrameDrawOp drawOp;
+    drawOp.paint.setAntiAlias(true);
+    drawOp.paint.setColor(Color);
+    drawOp.outer.setRectRadii(outerRect,outerRadii);
+    if(innerRect.isEmpty()) {
+        drawOp.type=FrameDrawOp::RRect; // Border covers the whole frame
+    } else {
+        drawOp.type=FrameDrawOp::DRRect;
+        drawOp.inner.setRectRadii(innerRect,innerRadii);
+    }
+    return drawOp;
+}
+bool drawCachedRectShadow(FrameType frameType,SkCanvas *canvas,
+                                        Rect frame,
+                                        BorderMetrics borderProps,
+                                        SkColor shadowColor,
+                                        sk_sp<SkMaskFilter> shadowMaskFilter)
+{
+/* Cached nine patch reproduces only solid rect frames, drawn without scaling.
+   Other frames are blurred live*/
+    SkMaskFilterBase::BlurRec blurRec;
+    if(!shadowMaskFilter || !as_MFB(shadowMaskFilter)->asABlur(&blurRec) ||
+       (blurRec.fStyle != kNormal_SkBlurStyle) ||
+       !canvas->getTotalMatrix().isTranslate()) {
+        return false;
+    }
+    if((frameType != FilledRect) && (borderProps.borderStyles.left != BorderStyle::Solid)) {
+        return false;
+    }
+
+    RSkShadowCache::Key key;
+    key.radii[0]=borderProps.borderRadii.topLeft;
+    key.radii[1]=borderProps.borderRadii.topRight;
+    key.radii[2]=borderProps.borderRadii.bottomRight;
+    key.radii[3]=borderProps.borderRadii.bottomLeft;
+    /* Same stroke as drawRect*/
+    key.strokeWidth=((frameType == FilledRect) && !hasUniformBorderEdges(borderProps)) ? 0 : borderProps.borderWidths.left;
+    key.sigma=blurRec.fSigma;
+    key.color=shadowColor;
+    key.filled=(frameType == FilledRect);
+
+    auto ninePatch=RSkShadowCache::getInstance().findOrCreate(key,
+                       SkSize::Make(frame.size.width,frame.size.height),
+                       [&](SkCanvas *shadowCanvas,SkRect shadowFrame) {
+                           drawRect(frameType,shadowCanvas,
+                                    Rect{{shadowFrame.x(),shadowFrame.y()},{shadowFrame.width(),shadowFrame.height()}},
+                                    borderProps,shadowColor,NULL,shadowMaskFilter);
+                       });
+    if(!ninePatch.image) {
+        return false;
+    }
     SkPaint paint;
-    paint.setAntiAlias(true);
-    paint.setColor(RSkColorFromSharedColor(Color, DEFAULT_COLOR));
+    paint.setFilterQuality(kLow_SkFilterQuality);
+    SkRect dstRect=SkRect::MakeXYWH(frame.origin.x,frame.origin.y,frame.size.width,frame.size.height);
+    canvas->drawImageNine(ninePatch.image.get(),ninePatch.center,dstRect.makeOutset(ninePatch.outset,ninePatch.outset),&paint);
+    return true;
+}
+FrameDrawOp createPathDrawOp(SkPath &path,SharedColor Color,sk_sp<SkImageFilter> shadowImageFilter=nullptr)
+{
+    FrameDrawOp drawOp;
+    drawOp.type=FrameDrawOp::Path;
+    drawOp.paint.setAntiAlias(true);
+    drawOp.paint.setColor(RSkColorFromSharedColor(Color, DEFAULT_COLOR));
     path.setFillType(SkPathFillType::kEvenOdd);
     if(shadowImageFilter != nullptr) {
-        paint.setImageFilter(shadowImageFilter);
+        drawOp.paint.setImageFilter(shadowImageFilter);
     }
-    canvas->drawPath(path, paint);
+    drawOp.path=path;
+    return drawOp;
+}
+inline void drawPath(SkCanvas *canvas,SkPath &path,SharedColor Color,sk_sp<SkImageFilter> shadowImageFilter=nullptr)
+{
+    drawFrameOp(canvas,createPathDrawOp(path,Color,shadowImageFilter));
 }
 inline void createPath(PathMetrics pathMetrics,BorderEdges borderEdge,SkPath& path)
 {
@@ -364,22 +477,19 @@ inline void drawDiscretePath( SkCanvas *canvas,Rect frame,
     return;
 }
 
-} //namespace
-namespace RSkDrawUtils{
-
-void  drawBackground(SkCanvas *canvas, 
-                               Rect frame,
+void createBackgroundDrawOps(Rect frame,
                                BorderMetrics borderProps,
-                               SharedColor backgroundColor)
+                               SharedColor backgroundColor,
+                               std::vector<FrameDrawOp> &drawOps)
 {
     if(hasVisibleBackGround(backgroundColor)){
-      drawRect(FilledRect,canvas,frame,borderProps,RSkColorFromSharedColor(backgroundColor, DEFAULT_BACKGROUND_COLOR));
+      drawOps.push_back(createRectDrawOp(FilledRect,frame,borderProps,RSkColorFromSharedColor(backgroundColor, DEFAULT_BACKGROUND_COLOR)));
     }
 }
-void drawBorder(SkCanvas *canvas,
-                               Rect frame,
+void createBorderDrawOps(Rect frame,
                                BorderMetrics borderProps,
-                               SharedColor backgroundColor)
+                               SharedColor backgroundColor,
+                               std::vector<FrameDrawOp> &drawOps)
 {
 
     FrameType frameType = detectFrameBorderType(borderProps.borderColors,borderProps.borderWidths);
@@ -390,22 +500,88 @@ void drawBorder(SkCanvas *canvas,
         (((!color && (*backgroundColor != *blackColor())) ||  \
              (color && (*color != *backgroundColor))) ? true : false)
 
-    #define CHECK_SIDE_VISIBILITY_AND_DRAW_SIDE_FOR_BORDER(side,sideWidth,color)   \
+    #define CHECK_SIDE_VISIBILITY_AND_CREATE_SIDE_FOR_BORDER(side,sideWidth,color)   \
         /* Draw Side, if it has visble color & thickness & color different from background colour*/ \
         if(BACKGROUND_COLOR_DIFFERENT_FROM_BORDER_COLOR(color) && \
             isBorderEdgeVisible(color,(sideWidth)) /*Side has Visible color & thickness*/ \
          ){ \
-            createAndDrawDiscretePath(side,canvas,frame,borderProps); \
+            SkPath sidePath=createAndDrawDiscretePath(side,NULL,frame,borderProps,nullptr,false); \
+            drawOps.push_back(createPathDrawOp(sidePath,color)); \
         }
 
     if((frameType == MonoChromeStrokedRect) && BACKGROUND_COLOR_DIFFERENT_FROM_BORDER_COLOR(borderProps.borderColors.left)) {
-        drawRect(MonoChromeStrokedRect,canvas,frame,borderProps,RSkColorFromSharedColor(borderProps.borderColors.left, DEFAULT_COLOR));
+        SkColor borderColor=RSkColorFromSharedColor(borderProps.borderColors.left, DEFAULT_COLOR);
+        if(borderProps.borderStyles.left == BorderStyle::Solid) {
+            drawOps.push_back(createSolidBorderDrawOp(frame,borderProps,borderColor));
+        } else {
+            drawOps.push_back(createRectDrawOp(MonoChromeStrokedRect,frame,borderProps,borderColor));
+        }
     } else if((frameType == PolyChromeStrokedRect)|| (frameType == DiscretePath)) {
-        CHECK_SIDE_VISIBILITY_AND_DRAW_SIDE_FOR_BORDER(RightEdge,borderProps.borderWidths.right,borderProps.borderColors.right)
-        CHECK_SIDE_VISIBILITY_AND_DRAW_SIDE_FOR_BORDER(LeftEdge,borderProps.borderWidths.left,borderProps.borderColors.left)
-        CHECK_SIDE_VISIBILITY_AND_DRAW_SIDE_FOR_BORDER(TopEdge,borderProps.borderWidths.top,borderProps.borderColors.top)
-        CHECK_SIDE_VISIBILITY_AND_DRAW_SIDE_FOR_BORDER(BottomEdge,borderProps.borderWidths.bottom,borderProps.borderColors.bottom)
+        CHECK_SIDE_VISIBILITY_AND_CREATE_SIDE_FOR_BORDER(RightEdge,borderProps.borderWidths.right,borderProps.borderColors.right)
+        CHECK_SIDE_VISIBILITY_AND_CREATE_SIDE_FOR_BORDER(LeftEdge,borderProps.borderWidths.left,borderProps.borderColors.left)
+        CHECK_SIDE_VISIBILITY_AND_CREATE_SIDE_FOR_BORDER(TopEdge,borderProps.borderWidths.top,borderProps.borderColors.top)
+        CHECK_SIDE_VISIBILITY_AND_CREATE_SIDE_FOR_BORDER(BottomEdge,borderProps.borderWidths.bottom,borderProps.borderColors.bottom)
+    }
+}
+using CreateDrawOpsFunc = void (*)(Rect,BorderMetrics,SharedColor,std::vector<FrameDrawOp>&);
+void drawFrameGeometry(SkCanvas *canvas,
+                               Rect frame,
+                               BorderMetrics borderProps,
+                               SharedColor backgroundColor,
+                               FrameGeometry *geometry,
+                               CreateDrawOpsFunc createDrawOps)
+{
+    if(!geometry) {
+        std::vector<FrameDrawOp> drawOps;
+        createDrawOps(frame,borderProps,backgroundColor,drawOps);
+        for(auto &drawOp : drawOps) {
+            drawFrameOp(canvas,drawOp);
+        }
+        return;
     }
+    /* Cached geometry is in frame coordinates, so that it stays valid when the frame only moves*/
+    if(!geometry->valid || (geometry->frameSize != frame.size) ||
+       (geometry->borderMetrics != borderProps) || (geometry->backgroundColor != backgroundColor)) {
+        geometry->drawOps.clear();
+        createDrawOps(Rect{{0,0},frame.size},borderProps,backgroundColor,geometry->drawOps);
+        geometry->frameSize=frame.size;
+        geometry->borderMetrics=borderProps;
+        geometry->backgroundColor=backgroundColor;
+        geometry->valid=true;
+    }
+    if(geometry->drawOps.empty()) {
+        return;
+    }
+    canvas->save();
+    canvas->translate(frame.origin.x,frame.origin.y);
+    for(auto &drawOp : geometry->drawOps) {
+        drawFrameOp(canvas,drawOp);
+    }
+    canvas->restore();
+}
+
+} //namespace
+namespace RSkDrawUtils{
+
+void  drawBackground(SkCanvas *canvas,
+                               Rect frame,
+                               BorderMetrics borderProps,
+                               SharedColor backgroundColor,
+                               FrameGeometryCache *geometryCache)
+{
+    drawFrameGeometry(canvas,frame,borderProps,backgroundColor,
+                      geometryCache ? &geometryCache->background : nullptr,
+                      createBackgroundDrawOps);
+}
+void drawBorder(SkCanvas *canvas,
+                               Rect frame,
+                               BorderMetrics borderProps,
+                               SharedColor backgroundColor,
+                               FrameGeometryCache *geometryCache)
+{
+    drawFrameGeometry(canvas,frame,borderProps,backgroundColor,
+                      geometryCache ? &geometryCache->border : nullptr,
+                      createBorderDrawOps);
 }
 bool  drawShadow(SkCanvas* canvas,Rect frame,
                         BorderMetrics borderProps,
@@ -463,8 +639,10 @@ bool  drawShadow(SkCanvas* canvas,Rect frame,
     }
 /*Proceed to draw Shadow*/
     if(frameType != DiscretePath ) {
-       /*Frame is a Rect*/
-       drawRect(frameType,canvas,shadowFrame,borderProps,shadowColor,NULL,shadowMaskFilter);
+       /*Frame is a Rect, reuse the pre-rendered shadow when possible*/
+       if(!drawCachedRectShadow(frameType,canvas,shadowFrame,borderProps,shadowColor,shadowMaskFilter)) {
+           drawRect(frameType,canvas,shadowFrame,borderProps,shadowColor,NULL,shadowMaskFilter);
+       }
     } else {
         /*Frame is Non contiguos or Discrete, so draw it as a path*/
         drawDiscretePath(canvas,frame,borderProps,shadowImageFilter);
@@ -6,7 +6,11 @@
  */
 #pragma once
 
+#include <vector>
+
 #include "include/core/SkCanvas.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkRRect.h"
 #include <react/renderer/components/view/ViewProps.h>
 
 namespace facebook {
@@ -14,15 +18,44 @@ namespace react {
 
 namespace RSkDrawUtils{
 
+  struct FrameDrawOp {
+    enum Type {
+      RRect,
+      DRRect, // Area between outer & inner rrects
+      Path
+    } type{RRect};
+    SkRRect outer;
+    SkRRect inner;
+    SkPath path;
+    SkPaint paint;
+  };
+
+  struct FrameGeometry {
+    bool valid{false};
+    Size frameSize{};
+    BorderMetrics borderMetrics{};
+    SharedColor backgroundColor{};
+    std::vector<FrameDrawOp> drawOps; // In frame coordinates
+  };
+
+/* Background & Border geometry of a component, reused across its recordings
+   as long as border metrics, frame size & background color are unchanged */
+  struct FrameGeometryCache {
+    FrameGeometry background;
+    FrameGeometry border;
+  };
+
 /*Function: Draw Background & Border */
   void drawBackground(SkCanvas *canvas,
                                Rect frame,
                                BorderMetrics borderMetrics,
-                               SharedColor bgColor);
+                               SharedColor bgColor,
+                               FrameGeometryCache *geometryCache=nullptr);
   void drawBorder(SkCanvas *canvas,
                                Rect frame,
                                BorderMetrics borderMetrics,
-                               SharedColor bgColor);
+                               SharedColor bgColor,
+                               FrameGeometryCache *geometryCache=nullptr);
   bool drawShadow(SkCanvas *canvas,
                                Rect frame,
                                BorderMetrics borderMetrics,
@@ -4,6 +4,7 @@
  * This source code is licensed under the MIT license found in the
  * LICENSE file in the root directory of this source tree.
  */
+#include <algorithm>
 #include <better/map.h>
 
 #include "include/core/SkData.h"
@@ -11,6 +12,7 @@
 #include "ReactSkia/RSkSurfaceWindow.h"
 #include "ReactSkia/views/common/RSkImageCacheManager.h"
 #include "ReactSkia/utils/RnsLog.h"
+#include "rns_shell/common/MemoryAccounting.h"
 #include "rns_shell/common/WindowContext.h"
 using namespace std;
 
@@ -31,8 +33,17 @@ std::mutex RSkImageCacheManager::mutex_;
 
 RSkImageCacheManager* RSkImageCacheManager::imageCacheManagerInstance_{nullptr};
 
-RSkImageCacheManager::RSkImageCacheManager() { };
+RSkImageCacheManager::RSkImageCacheManager() {
+  memoryPressureClientId_ = RNSMemoryPressureBroker::instance()->addClient("ImageCache",
+      std::bind(&RSkImageCacheManager::trimMemory, this, std::placeholders::_1));
+  // Images are the first to go when the render resources are over budget
+  memoryBudgetEvictorId_ = RnsShell::MemoryAccounting::addEvictor(RnsShell::MemoryCategoryDecodedImages, [this](size_t bytesToFree) {
+    return trimMemory(MemoryPressureModerate);
+  });
+};
 RSkImageCacheManager::~RSkImageCacheManager() {
+  RNSMemoryPressureBroker::instance()->removeClient(memoryPressureClientId_);
+  RnsShell::MemoryAccounting::removeEvictor(memoryBudgetEvictorId_);
   std::lock_guard<std::mutex> lock(mutex_);
   if(this == imageCacheManagerInstance_)
     imageCacheManagerInstance_ = nullptr;
@@ -129,6 +140,7 @@ void RSkImageCacheManager::expiryTimeCallback() {
       it++;
     }
   }
+  updateMemoryAccounting();
   if(imageCache_.size()){
     scheduleTimeExpiry_ = scheduleTimeExpiry;
     timer_->reschedule((scheduleTimeExpiry_ - SkTime::GetMSecs()),0);
@@ -151,6 +163,7 @@ bool RSkImageCacheManager::imageDataInsertInCache(const char* path,decodedimageC
   if(imageCacheData.imageData && evictAsNeeded()) {
     imageCache_.insert(std::pair<std::string, decodedimageCacheData>(path,imageCacheData));
     RNS_LOG_INFO("New Entry in Map..."<<" file :"<<path<< "  expiryTime :"<<imageCacheData.expiryTime);
+    updateMemoryAccounting();
     if(imageCache_.size() == 1) {
       scheduleTimeExpiry_ = imageCacheData.expiryTime;
       if(timer_ == nullptr) {
@@ -166,22 +179,72 @@ bool RSkImageCacheManager::imageDataInsertInCache(const char* path,decodedimageC
     }
     return true;
   } else {
+    updateMemoryAccounting(); // Some entries may have been evicted
     RNS_LOG_ERROR("Insert image data to cache failed... :"<<" file :" << path);
     return false;
   }
 }
 
-bool RSkImageCacheManager::clearMemory() {
-  std::scoped_lock lock(imageCacheLock);
-  size_t usageArr[2]={0,0};
+size_t RSkImageCacheManager::evictUnusedImages() {
+  // Called with imageCacheLock held. Images still shown by a component are kept.
+  size_t evictedBytes = 0;
   ImageCacheMap::iterator it=imageCache_.begin();
   while( it != imageCache_.end()) {
     if((it->second.imageData)->unique()) {
+      evictedBytes += it->second.imageData->imageInfo().computeMinByteSize();
       it=imageCache_.erase(it);
     } else {
       ++it;
     }
   }
+  return evictedBytes;
+}
+
+size_t RSkImageCacheManager::trimMemory(MemoryPressureLevel level) {
+  size_t usageBefore[2]={0,0};
+  size_t usageAfter[2]={0,0};
+  size_t evictedBytes = 0;
+  getCacheUsage(usageBefore);
+  {
+    std::scoped_lock lock(imageCacheLock);
+    evictedBytes = evictUnusedImages();
+    updateMemoryAccounting();
+  }
+  if(level == MemoryPressureCritical) {
+    clearMemory();
+  } else {
+#ifdef RNS_SHELL_HAS_GPU_SUPPORT
+    RnsShell::WindowContext::grTransactionBegin();
+    GrDirectContext* gpuContext = RSkSurfaceWindow::getDirectContext();
+    if(gpuContext) {
+      gpuContext->performDeferredCleanup(std::chrono::milliseconds(SKIA_GPU_RESOURCE_UNUSED_TIME_MS));
+    }
+    RnsShell::WindowContext::grTransactionEnd();
+#endif
+  }
+  getCacheUsage(usageAfter);
+  size_t cacheBytes = 0;
+  for(int index : {CPU_MEM_ARR_INDEX, GPU_MEM_ARR_INDEX}) {
+    if(usageBefore[index] > usageAfter[index])
+      cacheBytes += usageBefore[index] - usageAfter[index];
+  }
+  // Lazily decoded images live in the resource cache, so their bytes are already part of its usage drop
+  return std::max(evictedBytes, cacheBytes);
+}
+
+void RSkImageCacheManager::updateMemoryAccounting() {
+  // Called with imageCacheLock held
+  size_t cachedBytes = 0;
+  for(auto &entry : imageCache_)
+    cachedBytes += entry.second.imageData->imageInfo().computeMinByteSize();
+  RnsShell::MemoryAccounting::update(RnsShell::MemoryCategoryDecodedImages, accountedBytes_, cachedBytes);
+  accountedBytes_ = cachedBytes;
+}
+
+bool RSkImageCacheManager::clearMemory() {
+  std::scoped_lock lock(imageCacheLock);
+  evictUnusedImages();
+  updateMemoryAccounting();
 #ifdef RNS_SHELL_HAS_GPU_SUPPORT
   RnsShell::WindowContext::grTransactionBegin();
   GrDirectContext* gpuContext = RSkSurfaceWindow::getDirectContext();
@@ -194,7 +257,7 @@ bool RSkImageCacheManager::clearMemory() {
     printCacheUsage(); // for print memory size for CPU and GPU cache
 #endif //RNS_IMAGECACHING_DEBUG
   SkGraphics::PurgeResourceCache(); // purge for CPU memory cache
-  if(imageCache_.empty()) {
+  if(imageCache_.empty() && timer_) {
     timer_->abort();
   }
   return true;
@@ -12,9 +12,11 @@
 #include "include/gpu/GrDirectContext.h"
 
 #include "ReactSkia/sdk/FollyTimer.h"
+#include "ReactSkia/sdk/RNSMemoryPressureBroker.h"
 
 #define SKIA_CPU_IMAGE_CACHE_LIMIT  50*1024*1024 // 52,428,800 bytes
 #define SKIA_GPU_IMAGE_CACHE_LIMIT  50*1024*1024 // 52,428,800 bytes
+#define SKIA_GPU_RESOURCE_UNUSED_TIME_MS 5000 // GPU resources not used since, are purged on moderate memory pressure
 
 using namespace std;
 using namespace rns::sdk;
@@ -44,6 +46,12 @@ class RSkImageCacheManager {
   double scheduleTimeExpiry_;
   RSkImageCacheManager();
   Timer * timer_{nullptr};
+  unsigned int memoryPressureClientId_{0};
+  unsigned int memoryBudgetEvictorId_{0};
+  size_t accountedBytes_{0}; // Decoded bytes reported to RnsShell::MemoryAccounting
+  size_t trimMemory(MemoryPressureLevel level);
+  void updateMemoryAccounting();
+  size_t evictUnusedImages();
   void getCacheUsage(size_t usageArr[]);
   bool evictAsNeeded();
   void expiryTimeCallback();
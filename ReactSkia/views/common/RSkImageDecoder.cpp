@@ -0,0 +1,317 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include <algorithm>
+#include <string.h>
+#include <math.h>
+
+#include "include/core/SkStream.h"
+
+#include "ReactSkia/sdk/CurlNetworking.h"
+#include "ReactSkia/utils/RnsLog.h"
+#include "ReactSkia/views/common/RSkImageDecoder.h"
+#include "ReactSkia/views/common/RSkImageUtils.h"
+#include "rns_shell/common/MemoryAccounting.h"
+
+namespace facebook {
+namespace react {
+
+std::shared_ptr<RSkAnimatedImage> RSkAnimatedImage::Make(sk_sp<SkData> encodedData) {
+  if(!encodedData)
+    return nullptr;
+  std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(encodedData);
+  if(!codec || codec->getFrameCount() <= 1)
+    return nullptr;
+  std::shared_ptr<RSkAnimatedImage> animatedImage(new RSkAnimatedImage(std::move(codec)));
+  animatedImage->addMemoryClients();
+  return animatedImage;
+}
+
+RSkAnimatedImage::RSkAnimatedImage(std::unique_ptr<SkCodec> codec)
+    : codec_(std::move(codec)) {
+  frameInfos_ = codec_->getFrameInfo();
+  dimensions_ = codec_->dimensions();
+  repetitionCount_ = codec_->getRepetitionCount();
+  for(auto &frameInfo : frameInfos_) {
+    frameStartTimes_.push_back(loopDuration_);
+    loopDuration_ += (frameInfo.fDuration < ANIMATED_IMAGE_MIN_FRAME_DURATION_MS) ? ANIMATED_IMAGE_DEFAULT_FRAME_DURATION_MS : frameInfo.fDuration;
+  }
+  composedFrame_.allocPixels(SkImageInfo::MakeN32Premul(dimensions_));
+}
+
+void RSkAnimatedImage::addMemoryClients() {
+  // Broker & budget run a copy of their callbacks unlocked, so they may call in while the image is being
+  // destroyed on another thread. Callbacks hold the image weakly & keep it alive for the time of the call.
+  std::weak_ptr<RSkAnimatedImage> weakThis = shared_from_this();
+  memoryPressureClientId_ = rns::sdk::RNSMemoryPressureBroker::instance()->addClient("AnimatedImageFrames",
+      [weakThis](rns::sdk::MemoryPressureLevel level) -> size_t {
+    auto self = weakThis.lock();
+    return self ? self->trimMemory(level) : 0;
+  });
+  memoryBudgetEvictorId_ = RnsShell::MemoryAccounting::addEvictor(RnsShell::MemoryCategoryDecodedImages,
+      [weakThis](size_t bytesToFree) -> size_t {
+    auto self = weakThis.lock();
+    return self ? self->trimMemory(rns::sdk::MemoryPressureModerate) : 0;
+  });
+}
+
+RSkAnimatedImage::~RSkAnimatedImage() {
+  rns::sdk::RNSMemoryPressureBroker::instance()->removeClient(memoryPressureClientId_);
+  RnsShell::MemoryAccounting::removeEvictor(memoryBudgetEvictorId_);
+  RnsShell::MemoryAccounting::update(RnsShell::MemoryCategoryDecodedImages, accountedBytes_, 0);
+}
+
+sk_sp<SkImage> RSkAnimatedImage::frameForTime(double playbackTimeMs, bool &isFinished, double &nextFrameDelayMs) {
+  int frameIndex;
+  isFinished = false;
+  nextFrameDelayMs = 0;
+  if(repetitionCount_ != SkCodec::kRepetitionCountInfinite && playbackTimeMs >= loopDuration_ * (repetitionCount_ + 1)) {
+    frameIndex = frameInfos_.size() - 1;
+    isFinished = true;
+  } else {
+    double loopTime = fmod(playbackTimeMs, loopDuration_);
+    frameIndex = std::upper_bound(frameStartTimes_.begin(), frameStartTimes_.end(), loopTime) - frameStartTimes_.begin() - 1;
+    double nextFrameStartTime = (frameIndex + 1 < (int)frameStartTimes_.size()) ? frameStartTimes_[frameIndex + 1] : loopDuration_;
+    nextFrameDelayMs = nextFrameStartTime - loopTime;
+  }
+
+  std::scoped_lock lock(mutex_);
+  auto frame = frameCache_.find(frameIndex);
+  if(frame != frameCache_.end()) {
+    lastFrame_ = frame->second;
+    lastFrameIndex_ = frameIndex;
+    if(!isFinished)
+      requestFrame((frameIndex + 1) % frameInfos_.size()); // Decoded ahead, while this one is shown
+  } else {
+    // Previous frame stays on screen till this one is decoded, checked again shortly
+    requestFrame(frameIndex);
+    isFinished = false;
+    nextFrameDelayMs = std::min(nextFrameDelayMs, (double)ANIMATED_IMAGE_MIN_FRAME_DURATION_MS);
+  }
+  return lastFrame_;
+}
+
+void RSkAnimatedImage::requestFrame(int frameIndex) {
+  // Called with mutex_ held. One frame is decoded at a time, in the playback order.
+  if(pendingFrameIndex_ != -1 || frameCache_.find(frameIndex) != frameCache_.end())
+    return;
+  pendingFrameIndex_ = frameIndex;
+  std::weak_ptr<RSkAnimatedImage> weakThis = shared_from_this();
+  RSkImageUtils::runOnDecodeThread([weakThis, frameIndex]() {
+    auto self = weakThis.lock();
+    if(self)
+      self->decodeFrame(frameIndex);
+  });
+}
+
+void RSkAnimatedImage::decodeFrame(int frameIndex) {
+  const SkCodec::FrameInfo &frameInfo = frameInfos_[frameIndex];
+  SkCodec::Options options;
+  options.fFrameIndex = frameIndex;
+  int requiredFrame = frameInfo.fRequiredFrame;
+  if(requiredFrame == SkCodec::kNoFrame) {
+    composedFrame_.eraseColor(SK_ColorTRANSPARENT);
+    options.fPriorFrame = SkCodec::kNoFrame;
+  } else if(composedFrameIndex_ >= requiredFrame && composedFrameIndex_ < frameIndex &&
+            frameInfos_[composedFrameIndex_].fDisposalMethod != SkCodecAnimation::DisposalMethod::kRestorePrevious) {
+    options.fPriorFrame = composedFrameIndex_; // Usual case, frame is drawn over the previous one
+  } else {
+    decodeFrame(requiredFrame);
+    options.fPriorFrame = requiredFrame;
+  }
+  SkCodec::Result result = codec_->getPixels(composedFrame_.info(), composedFrame_.getPixels(), composedFrame_.rowBytes(), &options);
+  if(result != SkCodec::kSuccess && result != SkCodec::kIncompleteInput) {
+    RNS_LOG_ERROR("Failed to decode animated image frame " << frameIndex << " : " << SkCodec::ResultToString(result));
+  }
+  composedFrameIndex_ = frameIndex;
+
+  // Cached even if broken, showing the previous content instead of decoding again on every frame
+  sk_sp<SkImage> frame = SkImage::MakeRasterCopy(composedFrame_.pixmap());
+  std::scoped_lock lock(mutex_);
+  if(pendingFrameIndex_ == frameIndex) {
+    pendingFrameIndex_ = -1;
+    cacheFrame(frameIndex, frame);
+  }
+}
+
+void RSkAnimatedImage::cacheFrame(int frameIndex, sk_sp<SkImage> frame) {
+  // Called with mutex_ held
+  if(!frame)
+    return;
+  size_t frameBytes = frame->imageInfo().computeMinByteSize();
+  while(frameCacheBytes_ + frameBytes > ANIMATED_IMAGE_FRAME_CACHE_LIMIT && !frameCacheOrder_.empty())
+    evictFrame(frameCacheOrder_.front());
+  frameCache_[frameIndex] = frame;
+  frameCacheOrder_.push_back(frameIndex);
+  frameCacheBytes_ += frameBytes;
+  updateMemoryAccounting();
+}
+
+void RSkAnimatedImage::evictFrame(int frameIndex) {
+  // Called with mutex_ held
+  auto evictedFrame = frameCache_.find(frameIndex);
+  if(evictedFrame == frameCache_.end())
+    return;
+  frameCacheBytes_ -= evictedFrame->second->imageInfo().computeMinByteSize();
+  frameCache_.erase(evictedFrame);
+  frameCacheOrder_.remove(frameIndex);
+}
+
+size_t RSkAnimatedImage::trimMemory(rns::sdk::MemoryPressureLevel level) {
+  // Frames are decoded again when played. Shown frame is kept on moderate pressure, to avoid a flicker
+  // on the next frame, it is still referenced by lastFrame_ on critical pressure.
+  std::scoped_lock lock(mutex_);
+  size_t cachedBytes = frameCacheBytes_;
+  std::list<int> evictedFrames = frameCacheOrder_;
+  for(int frameIndex : evictedFrames) {
+    if(level == rns::sdk::MemoryPressureCritical || frameIndex != lastFrameIndex_)
+      evictFrame(frameIndex);
+  }
+  updateMemoryAccounting();
+  return cachedBytes - frameCacheBytes_;
+}
+
+void RSkAnimatedImage::updateMemoryAccounting() {
+  // Called with mutex_ held
+  RnsShell::MemoryAccounting::update(RnsShell::MemoryCategoryDecodedImages, accountedBytes_, frameCacheBytes_);
+  accountedBytes_ = frameCacheBytes_;
+}
+
+// Reads the data received so far. Short reads make the codec report incomplete input,
+// and incremental decode resumes from the same position once more data is appended.
+class RSkProgressiveImageDecoder::ReceivedDataStream : public SkStream {
+ public:
+  ReceivedDataStream(RSkProgressiveImageDecoder *decoder) : decoder_(decoder) {}
+
+  size_t read(void* buffer, size_t size) override {
+    size_t readSize = decoder_->readReceivedData(position_, buffer, size);
+    position_ += readSize;
+    return readSize;
+  }
+  bool isAtEnd() const override { return false; }
+  bool rewind() override {
+    position_ = 0;
+    return true;
+  }
+
+ private:
+  RSkProgressiveImageDecoder *decoder_; // Owns the codec, which owns this stream
+  size_t position_{0};
+};
+
+RSkProgressiveImageDecoder::RSkProgressiveImageDecoder(std::weak_ptr<CurlRequest> curlRequest, PreviewCallback previewCallback)
+    : curlRequest_(curlRequest),
+      previewCallback_(previewCallback) {}
+
+void RSkProgressiveImageDecoder::appendData(size_t receivedSize) {
+  // Called with the buffer lock of the request held, data is read from its buffer on the decode thread
+  std::scoped_lock lock(mutex_);
+  receivedSize_ = receivedSize;
+  if(isCancelled_ || isUnsupported_ || decodePending_ || (receivedSize_ - lastDecodedSize_ < PROGRESSIVE_DECODE_MIN_BYTES))
+    return;
+  decodePending_ = true;
+  std::weak_ptr<RSkProgressiveImageDecoder> weakThis = shared_from_this();
+  RSkImageUtils::runOnDecodeThread([weakThis]() {
+    auto self = weakThis.lock();
+    if(self)
+      self->decodeReceivedData();
+  });
+}
+
+void RSkProgressiveImageDecoder::cancel() {
+  {
+    std::scoped_lock lock(mutex_);
+    if(isCancelled_)
+      return;
+    isCancelled_ = true;
+  }
+  // Codec & preview bitmap belong to the decode thread, they are released there
+  std::weak_ptr<RSkProgressiveImageDecoder> weakThis = shared_from_this();
+  RSkImageUtils::runOnDecodeThread([weakThis]() {
+    auto self = weakThis.lock();
+    if(self) {
+      self->codec_ = nullptr;
+      self->bitmap_.reset();
+    }
+  });
+}
+
+size_t RSkProgressiveImageDecoder::readReceivedData(size_t offset, void* buffer, size_t size) {
+  std::shared_ptr<CurlRequest> curlRequest = curlRequest_.lock();
+  if(!curlRequest)
+    return 0;
+  std::scoped_lock lock(curlRequest->bufferLock);
+  CurlResponse *response = curlRequest->curlResponse.get();
+  if(!response || !response->responseBuffer || offset >= (size_t)response->contentSize)
+    return 0;
+  size_t readSize = std::min(size, (size_t)response->contentSize - offset);
+  if(buffer)
+    memcpy(buffer, response->responseBuffer + offset, readSize);
+  return readSize;
+}
+
+void RSkProgressiveImageDecoder::decodeReceivedData() {
+  size_t receivedSize;
+  {
+    std::scoped_lock lock(mutex_);
+    decodePending_ = false;
+    if(isCancelled_ || isUnsupported_)
+      return;
+    receivedSize = receivedSize_;
+  }
+
+  SkCodec::Result result;
+  if(!codec_) {
+    codec_ = SkCodec::MakeFromStream(std::make_unique<ReceivedDataStream>(this), &result);
+    if(!codec_) {
+      if(result != SkCodec::kIncompleteInput) {
+        std::scoped_lock lock(mutex_);
+        isUnsupported_ = true;
+      }
+      return;
+    }
+    if(!bitmap_.tryAllocPixels(SkImageInfo::MakeN32Premul(codec_->dimensions()))) {
+      RNS_LOG_ERROR("No memory for progressive image preview");
+      result = SkCodec::kInternalError;
+    } else {
+      bitmap_.eraseColor(SK_ColorTRANSPARENT);
+      result = codec_->startIncrementalDecode(bitmap_.info(), bitmap_.getPixels(), bitmap_.rowBytes());
+    }
+    if(result != SkCodec::kSuccess) {
+      // No resumable decode for this format (JPEG, WebP) : no preview, complete data is decoded once downloaded
+      RNS_LOG_DEBUG("No progressive decode : " << SkCodec::ResultToString(result));
+      codec_ = nullptr;
+      bitmap_.reset();
+      std::scoped_lock lock(mutex_);
+      isUnsupported_ = true;
+      return;
+    }
+  }
+
+  int decodedRows = 0;
+  result = codec_->incrementalDecode(&decodedRows);
+  if(result != SkCodec::kSuccess && result != SkCodec::kIncompleteInput) {
+    RNS_LOG_DEBUG("Progressive decode stopped : " << SkCodec::ResultToString(result));
+    codec_ = nullptr;
+    bitmap_.reset();
+    std::scoped_lock lock(mutex_);
+    isUnsupported_ = true;
+    return;
+  }
+
+  sk_sp<SkImage> preview = SkImage::MakeRasterCopy(bitmap_.pixmap());
+  {
+    std::scoped_lock lock(mutex_);
+    lastDecodedSize_ = receivedSize;
+    if(isCancelled_)
+      return;
+  }
+  if(preview && previewCallback_)
+    previewCallback_(preview);
+}
+
+} // namespace react
+} // namespace facebook
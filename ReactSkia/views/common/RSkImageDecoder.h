@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#pragma once
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "include/codec/SkCodec.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkData.h"
+#include "include/core/SkImage.h"
+
+#include "ReactSkia/sdk/RNSMemoryPressureBroker.h"
+
+#define ANIMATED_IMAGE_FRAME_CACHE_LIMIT 16*1024*1024 // Decoded frames kept per animated image
+#define ANIMATED_IMAGE_MIN_FRAME_DURATION_MS 20 // Shorter durations are played at 100ms, as browsers do
+#define ANIMATED_IMAGE_DEFAULT_FRAME_DURATION_MS 100
+#define PROGRESSIVE_DECODE_MIN_BYTES 64*1024 // New data needed before the preview is decoded & shown again
+
+namespace facebook {
+namespace react {
+
+class CurlRequest;
+
+/*
+ * Multi frame image (GIF, WebP, APNG) played from its encoded data.
+ * Frames are decoded one at a time on the image decode thread and kept in a cache bounded by
+ * ANIMATED_IMAGE_FRAME_CACHE_LIMIT, so the caller only picks the frame for the current time
+ * and keeps showing the previous one while the next is being decoded.
+ * Cached frames are reported to RnsShell::MemoryAccounting as decoded images & trimmed on memory pressure.
+ */
+class RSkAnimatedImage : public std::enable_shared_from_this<RSkAnimatedImage> {
+ public:
+  // Returns nullptr for the images with a single frame
+  static std::shared_ptr<RSkAnimatedImage> Make(sk_sp<SkData> encodedData);
+  ~RSkAnimatedImage();
+
+  SkISize dimensions() const { return dimensions_; }
+  // Frame to show at the time since the playback start, nullptr till the first frame is decoded.
+  // isFinished is set once the last repetition is over, else nextFrameDelayMs is the time till the
+  // next frame starts, or a short retry delay while the frame for the time is still being decoded.
+  sk_sp<SkImage> frameForTime(double playbackTimeMs, bool &isFinished, double &nextFrameDelayMs);
+
+ private:
+  RSkAnimatedImage(std::unique_ptr<SkCodec> codec);
+  void addMemoryClients();
+  void requestFrame(int frameIndex);
+  void decodeFrame(int frameIndex); // Decode thread only
+  void cacheFrame(int frameIndex, sk_sp<SkImage> frame);
+  void evictFrame(int frameIndex);
+  size_t trimMemory(rns::sdk::MemoryPressureLevel level);
+  void updateMemoryAccounting();
+
+  // Decode thread only
+  std::unique_ptr<SkCodec> codec_;
+  SkBitmap composedFrame_; // Frames may be drawn over their previous frame
+  int composedFrameIndex_{-1};
+
+  std::vector<SkCodec::FrameInfo> frameInfos_;
+  std::vector<double> frameStartTimes_;
+  double loopDuration_{0};
+  int repetitionCount_{0};
+  SkISize dimensions_;
+
+  std::mutex mutex_;
+  std::unordered_map<int, sk_sp<SkImage>> frameCache_;
+  std::list<int> frameCacheOrder_; // Least recently decoded first
+  size_t frameCacheBytes_{0};
+  size_t accountedBytes_{0}; // Frame cache bytes reported to RnsShell::MemoryAccounting
+  int pendingFrameIndex_{-1};
+  int lastFrameIndex_{-1};
+  sk_sp<SkImage> lastFrame_;
+
+  unsigned int memoryPressureClientId_{0};
+  unsigned int memoryBudgetEvictorId_{0};
+};
+
+/*
+ * Decodes an image while it is downloaded, so large images show up row by row.
+ * Data is read from the response buffer of the request, under its buffer lock, and is never copied.
+ * Codecs supporting incremental decode (PNG, GIF) resume from where they stopped, once
+ * PROGRESSIVE_DECODE_MIN_BYTES more arrived. Others have no preview, the complete data is decoded once.
+ * Previews are built on the image decode thread & reported through the callback.
+ */
+class RSkProgressiveImageDecoder : public std::enable_shared_from_this<RSkProgressiveImageDecoder> {
+ public:
+  using PreviewCallback = std::function<void(sk_sp<SkImage> preview)>;
+
+  RSkProgressiveImageDecoder(std::weak_ptr<CurlRequest> curlRequest, PreviewCallback previewCallback);
+
+  // Called with the size received so far, from the write callback of the request
+  void appendData(size_t receivedSize);
+  void cancel();
+
+ private:
+  class ReceivedDataStream;
+
+  void decodeReceivedData(); // Decode thread only
+  size_t readReceivedData(size_t offset, void* buffer, size_t size);
+
+  std::weak_ptr<CurlRequest> curlRequest_;
+  PreviewCallback previewCallback_;
+  std::mutex mutex_;
+  size_t receivedSize_{0};
+  size_t lastDecodedSize_{0};
+  bool decodePending_{false};
+  bool isCancelled_{false};
+  bool isUnsupported_{false};
+
+  // Decode thread only
+  std::unique_ptr<SkCodec> codec_;
+  SkBitmap bitmap_;
+};
+
+} // namespace react
+} // namespace facebook
@@ -4,10 +4,17 @@
  * This source code is licensed under the MIT license found in the
  * LICENSE file in the root directory of this source tree.
  */
+#include <algorithm>
 #include <math.h>
+#include <string_view>
+
+#include <folly/io/async/ScopedEventBaseThread.h>
+#include <openssl/sha.h>
 
 #include "include/core/SkRect.h"
 
+#include "ReactSkia/utils/RnsLog.h"
+
 #include "ReactSkia/views/common/RSkImageUtils.h"
 
 namespace facebook {
@@ -82,6 +89,110 @@ namespace RSkImageUtils {
           return targetRect;
       }
   }
+
+  std::string imageCacheKey(const std::string &uri) {
+    if(!isDataUri(uri))
+      return uri;
+    // SHA-256 of the whole URI (media type & encoding included), distinct URIs never share a key in practice
+    unsigned char digest[SHA256_DIGEST_LENGTH];
+    SHA256(reinterpret_cast<const uint8_t*>(uri.data()), uri.size(), digest);
+    static const char hexDigits[] = "0123456789abcdef";
+    std::string key = "data:#sha256-";
+    key.reserve(key.size() + 2 * SHA256_DIGEST_LENGTH);
+    for(unsigned char byte : digest) {
+      key += hexDigits[byte >> 4];
+      key += hexDigits[byte & 0x0f];
+    }
+    return key;
+  }
+
+  static inline int base64Value(unsigned char c) {
+    if(c >= 'A' && c <= 'Z') return c - 'A';
+    if(c >= 'a' && c <= 'z') return c - 'a' + 26;
+    if(c >= '0' && c <= '9') return c - '0' + 52;
+    if(c == '+' || c == '-') return 62; // Also accepts the url safe alphabet
+    if(c == '/' || c == '_') return 63;
+    return -1;
+  }
+
+  static inline int hexValue(unsigned char c) {
+    if(c >= '0' && c <= '9') return c - '0';
+    if(c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if(c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+  }
+
+  sk_sp<SkData> decodeDataUri(const std::string &uri) {
+    // data:[<mediatype>][;base64],<data>
+    size_t commaPos = uri.find(',');
+    if(!isDataUri(uri) || commaPos == std::string::npos) {
+      RNS_LOG_ERROR("Invalid data uri");
+      return nullptr;
+    }
+    std::string_view header(uri.data() + 5, commaPos - 5);
+    std::string_view payload(uri.data() + commaPos + 1, uri.size() - commaPos - 1);
+    bool isBase64 = header.size() >= 7 && header.substr(header.size() - 7) == ";base64";
+
+    // Decoded straight into the SkData, which is handed over to the codec without another copy
+    sk_sp<SkData> data = SkData::MakeUninitialized(isBase64 ? (payload.size() / 4) * 3 + 3 : payload.size());
+    uint8_t* output = static_cast<uint8_t*>(data->writable_data());
+    size_t outputSize = 0;
+    if(isBase64) {
+      uint32_t bits = 0;
+      int bitCount = 0;
+      for(unsigned char c : payload) {
+        if(c == '=')
+          break;
+        int value = base64Value(c);
+        if(value < 0) {
+          if(isspace(c))
+            continue; // Line breaks
+          RNS_LOG_ERROR("Invalid base64 data in data uri");
+          return nullptr;
+        }
+        bits = (bits << 6) | value;
+        bitCount += 6;
+        if(bitCount >= 8) {
+          bitCount -= 8;
+          output[outputSize++] = (bits >> bitCount) & 0xFF;
+        }
+      }
+    } else {
+      for(size_t index = 0; index < payload.size(); index++) {
+        if(payload[index] == '%' && index + 2 < payload.size() &&
+           hexValue(payload[index + 1]) >= 0 && hexValue(payload[index + 2]) >= 0) {
+          output[outputSize++] = (hexValue(payload[index + 1]) << 4) | hexValue(payload[index + 2]);
+          index += 2;
+        } else {
+          output[outputSize++] = payload[index];
+        }
+      }
+    }
+    if(outputSize == 0)
+      return nullptr;
+    return SkData::MakeSubset(data.get(), 0, outputSize);
+  }
+
+  void runOnDecodeThread(folly::Func task) {
+    static folly::ScopedEventBaseThread decodeThread("RNSImageDecode");
+    decodeThread.getEventBase()->runInEventBaseThread(std::move(task));
+  }
+
+  void runOnImageTimerThread(folly::Func task, double delayMs) {
+    static folly::ScopedEventBaseThread timerThread("RNSImageTimer");
+    folly::EventBase *eventBase = timerThread.getEventBase();
+    // Timeouts of the event base are only scheduled from its own thread
+    eventBase->runInEventBaseThread([eventBase, task = std::move(task), delayMs]() mutable {
+      eventBase->runAfterDelay(std::move(task), static_cast<uint32_t>(std::max(delayMs, 0.0)));
+    });
+  }
+
+  void decodeDataUriAsync(std::string uri, DataUriDecodeCallback callback) {
+    runOnDecodeThread([uri = std::move(uri), callback = std::move(callback)]() {
+      callback(decodeDataUri(uri));
+    });
+  }
+
 } //RSkImageUtils
 
 } // namespace react
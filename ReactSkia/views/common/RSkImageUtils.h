@@ -6,6 +6,11 @@
  */
 #pragma once
 
+#include <functional>
+
+#include <folly/Function.h>
+
+#include "include/core/SkData.h"
 #include "react/renderer/components/image/ImageShadowNode.h"
 
 namespace facebook {
@@ -15,6 +20,22 @@ namespace RSkImageUtils{
   
   SkRect computeTargetRect (Size srcSize,SkRect targetRect,ImageResizeMode resizeMode); 
 
+  using DataUriDecodeCallback = std::function<void(sk_sp<SkData> data)>;
+
+  inline bool isDataUri(const std::string &uri) { return uri.compare(0, 5, "data:") == 0; }
+  // Key of the image in RSkImageCacheManager. Data URIs are keyed by the SHA-256 digest of their content,
+  // so the (often big) payload is neither kept twice nor compared on every lookup.
+  std::string imageCacheKey(const std::string &uri);
+  // Encoded image from a base64 or percent encoded data URI, nullptr if it is malformed
+  sk_sp<SkData> decodeDataUri(const std::string &uri);
+  // Decodes on the image decode thread, callback is called on that thread
+  void decodeDataUriAsync(std::string uri, DataUriDecodeCallback callback);
+  // Single thread shared by the image decoding work kept away from the paint path
+  void runOnDecodeThread(folly::Func task);
+  // Runs the task after the delay on the image timer thread, kept apart from the decode thread
+  // so the pacing of animated images does not wait for the decodes queued meanwhile
+  void runOnImageTimerThread(folly::Func task, double delayMs);
+
 } //namespace RSkImageUtils
 
 } // namespace react
@@ -0,0 +1,159 @@
+/*
+* Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+*
+* This source code is licensed under the MIT license found in the
+* LICENSE file in the root directory of this source tree.
+*/
+
+#include <math.h>
+
+#include "include/core/SkSurface.h"
+
+#include "ReactSkia/views/common/RSkShadowCache.h"
+#include "ReactSkia/utils/RnsLog.h"
+
+#define RSK_SHADOW_CACHE_MAX_ENTRY_SIZE  RSK_SHADOW_CACHE_LIMIT/4 // Larger shadows are drawn live
+#define BLUR_SIGMA_EXTENT  3 // Blur spreads upto 3 sigma around the frame
+
+namespace facebook {
+namespace react {
+
+bool RSkShadowCache::Key::operator==(const Key &other) const {
+  return (radii[0] == other.radii[0]) && (radii[1] == other.radii[1]) &&
+         (radii[2] == other.radii[2]) && (radii[3] == other.radii[3]) &&
+         (strokeWidth == other.strokeWidth) && (sigma == other.sigma) &&
+         (color == other.color) && (filled == other.filled);
+}
+
+size_t RSkShadowCache::KeyHash::operator()(const Key &key) const {
+  std::hash<SkScalar> scalarHash;
+  size_t hash = std::hash<uint32_t>()(key.color) ^ (key.filled ? 0x9e3779b9 : 0);
+  for (auto value : {key.radii[0], key.radii[1], key.radii[2], key.radii[3], key.strokeWidth, key.sigma}) {
+    hash ^= scalarHash(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  }
+  return hash;
+}
+
+RSkShadowCache::RSkShadowCache() {
+  memoryPressureClientId_ = rns::sdk::RNSMemoryPressureBroker::instance()->addClient("ShadowCache",
+      std::bind(&RSkShadowCache::trimMemory, this, std::placeholders::_1));
+}
+
+RSkShadowCache::~RSkShadowCache() {
+  rns::sdk::RNSMemoryPressureBroker::instance()->removeClient(memoryPressureClientId_);
+}
+
+RSkShadowCache& RSkShadowCache::getInstance() {
+  static RSkShadowCache shadowCache;
+  return shadowCache;
+}
+
+RSkShadowCache::NinePatch RSkShadowCache::findOrCreate(const Key &key, SkSize frameSize, Rasterizer rasterizer) {
+  /* Smallest frame holding the corners : each corner is kept away from the stretchable
+     row & column by its radius, the stroke and the blur extent, so that stretched pixels are
+     the same as the ones a live blur would have produced along the straight edges.
+  */
+  int outset = ceil(BLUR_SIGMA_EXTENT * key.sigma);
+  int left = ceil(std::max(key.radii[0], key.radii[3]) + key.strokeWidth) + outset;
+  int top = ceil(std::max(key.radii[0], key.radii[1]) + key.strokeWidth) + outset;
+  int right = ceil(std::max(key.radii[1], key.radii[2]) + key.strokeWidth) + outset;
+  int bottom = ceil(std::max(key.radii[3], key.radii[2]) + key.strokeWidth) + outset;
+  int minFrameWidth = left + 1 + right;
+  int minFrameHeight = top + 1 + bottom;
+
+  if((frameSize.width() < minFrameWidth) || (frameSize.height() < minFrameHeight)) {
+    return NinePatch(); // Corners would overlap, nothing to stretch
+  }
+  int imageWidth = minFrameWidth + 2 * outset;
+  int imageHeight = minFrameHeight + 2 * outset;
+  size_t imageBytes = imageWidth * imageHeight * sizeof(SkPMColor);
+  if(imageBytes > RSK_SHADOW_CACHE_MAX_ENTRY_SIZE) {
+    return NinePatch();
+  }
+
+  {
+    std::scoped_lock lock(mutex_);
+    auto it = cache_.find(key);
+    if(it != cache_.end()) {
+      lruList_.splice(lruList_.begin(), lruList_, it->second);
+      stats_.hits++;
+      return it->second->second;
+    }
+    stats_.misses++;
+  }
+
+  // Render outside the lock, so that the other recording threads are not held
+  sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(imageWidth, imageHeight);
+  if(!surface) {
+    RNS_LOG_ERROR("Failed to create surface for shadow of size " << imageWidth << "x" << imageHeight);
+    return NinePatch();
+  }
+  surface->getCanvas()->clear(SK_ColorTRANSPARENT);
+  rasterizer(surface->getCanvas(), SkRect::MakeXYWH(outset, outset, minFrameWidth, minFrameHeight));
+
+  NinePatch ninePatch;
+  ninePatch.image = surface->makeImageSnapshot();
+  ninePatch.center = SkIRect::MakeXYWH(outset + left, outset + top, 1, 1);
+  ninePatch.outset = outset;
+
+  std::scoped_lock lock(mutex_);
+  auto it = cache_.find(key);
+  if(it != cache_.end()) {
+    // Another thread rendered the same shadow meanwhile
+    lruList_.splice(lruList_.begin(), lruList_, it->second);
+    return it->second->second;
+  }
+  evictAsNeeded(imageBytes);
+  lruList_.emplace_front(key, ninePatch);
+  cache_[key] = lruList_.begin();
+  stats_.bytesUsed += imageBytes;
+  stats_.entries = cache_.size();
+  RNS_LOG_DEBUG("New shadow in cache, size : " << imageWidth << "x" << imageHeight << " sigma : " << key.sigma);
+#ifdef RNS_SHADOW_CACHE_USAGE_DEBUG
+  printCacheUsage();
+#endif
+  return ninePatch;
+}
+
+void RSkShadowCache::evictAsNeeded(size_t incomingBytes, size_t limit) {
+  while(!lruList_.empty() && (stats_.bytesUsed + incomingBytes > limit)) {
+    auto &lruEntry = lruList_.back();
+    stats_.bytesUsed -= lruEntry.second.image->imageInfo().computeMinByteSize();
+    cache_.erase(lruEntry.first);
+    lruList_.pop_back();
+    stats_.evictions++;
+  }
+  stats_.entries = cache_.size();
+}
+
+void RSkShadowCache::clearMemory() {
+  std::scoped_lock lock(mutex_);
+  stats_.evictions += cache_.size();
+  cache_.clear();
+  lruList_.clear();
+  stats_.bytesUsed = 0;
+  stats_.entries = 0;
+}
+
+size_t RSkShadowCache::trimMemory(rns::sdk::MemoryPressureLevel level) {
+  std::scoped_lock lock(mutex_);
+  size_t bytesUsed = stats_.bytesUsed;
+  evictAsNeeded(0, (level == rns::sdk::MemoryPressureCritical) ? 0 : RSK_SHADOW_CACHE_LIMIT/2);
+  return bytesUsed - stats_.bytesUsed;
+}
+
+RSkShadowCache::Stats RSkShadowCache::getStats() {
+  std::scoped_lock lock(mutex_);
+  return stats_;
+}
+
+#ifdef RNS_SHADOW_CACHE_USAGE_DEBUG
+void RSkShadowCache::printCacheUsage() {
+  RNS_LOG_INFO("Shadow cache hits : " << stats_.hits << " misses : " << stats_.misses <<
+               " evictions : " << stats_.evictions << " entries : " << stats_.entries <<
+               " bytes : " << stats_.bytesUsed);
+}
+#endif //RNS_SHADOW_CACHE_USAGE_DEBUG
+
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,90 @@
+/*
+* Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+*
+* This source code is licensed under the MIT license found in the
+* LICENSE file in the root directory of this source tree.
+*/
+#pragma once
+
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkImage.h"
+
+#include "ReactSkia/sdk/RNSMemoryPressureBroker.h"
+
+#define RSK_SHADOW_CACHE_LIMIT  4*1024*1024 // 4,194,304 bytes
+
+namespace facebook {
+namespace react {
+
+/*
+ * Cache of pre-rendered blurred shadows of rounded rect frames.
+ * A shadow of a rect frame is invariant along its straight edges, so it is rendered once
+ * on the smallest frame holding its four blurred corners and drawn as a nine patch stretched
+ * to the actual frame. Cache is shared by all the components & bounded by RSK_SHADOW_CACHE_LIMIT,
+ * least recently used shadows are evicted first.
+ */
+class RSkShadowCache {
+ public:
+  struct Key {
+    SkScalar radii[4]{0,0,0,0}; // Clockwise from top left
+    SkScalar strokeWidth{0};
+    SkScalar sigma{0};
+    SkColor color{SK_ColorBLACK};
+    bool filled{true};
+
+    bool operator==(const Key &other) const;
+  };
+
+  struct NinePatch {
+    sk_sp<SkImage> image{nullptr};
+    SkIRect center{SkIRect::MakeEmpty()}; // Stretchable area of image
+    SkScalar outset{0}; // Blur extent around the frame
+  };
+
+  struct Stats {
+    size_t hits{0};
+    size_t misses{0};
+    size_t evictions{0};
+    size_t entries{0};
+    size_t bytesUsed{0};
+  };
+
+  // Renders the shadow of the frame described by the key, on the given canvas & frame
+  using Rasterizer = std::function<void(SkCanvas *canvas, SkRect frame)>;
+
+  static RSkShadowCache& getInstance();
+
+  /* Returns the nine patch of the shadow, rendering it on a miss.
+     Empty nine patch is returned, when frame is too small to be stretched from the cached shadow */
+  NinePatch findOrCreate(const Key &key, SkSize frameSize, Rasterizer rasterizer);
+  void clearMemory();
+  Stats getStats();
+
+ private:
+  struct KeyHash {
+    size_t operator()(const Key &key) const;
+  };
+  using LruList = std::list<std::pair<Key, NinePatch>>;
+
+  RSkShadowCache();
+  ~RSkShadowCache();
+  void evictAsNeeded(size_t incomingBytes, size_t limit = RSK_SHADOW_CACHE_LIMIT);
+  size_t trimMemory(rns::sdk::MemoryPressureLevel level); // Half the limit on moderate pressure, all on critical
+#ifdef RNS_SHADOW_CACHE_USAGE_DEBUG
+  void printCacheUsage();
+#endif
+
+  std::mutex mutex_; // Pictures are recorded from multiple threads
+  LruList lruList_; // Most recently used at front
+  std::unordered_map<Key, LruList::iterator, KeyHash> cache_;
+  Stats stats_;
+  unsigned int memoryPressureClientId_{0};
+};
+
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include <algorithm>
+#include <signal.h>
+#include <vector>
+
+#include <folly/io/async/AsyncSignalHandler.h>
+
+#include "include/core/SkGraphics.h"
+#include "include/core/SkTime.h"
+
+#include "ReactSkia/utils/RnsLog.h"
+
+#include "platform/linux/TaskLoop.h"
+#include "MemoryAccounting.h"
+
+namespace RnsShell {
+
+std::atomic<size_t> MemoryAccounting::bytesUsed_[MemoryCategoryCount];
+std::atomic<size_t> MemoryAccounting::budgetBytes_(RNS_MEMORY_BUDGET_MB * 1024 * 1024);
+std::mutex MemoryAccounting::evictorsMutex_;
+std::map<unsigned int, MemoryAccounting::EvictorEntry> MemoryAccounting::evictors_;
+unsigned int MemoryAccounting::nextEvictorId_{1};
+double MemoryAccounting::lastEnforceTimeMs_{0};
+
+static const char* categoryName(int category) {
+    switch(category) {
+        case MemoryCategoryDecodedImages: return "DecodedImages";
+        case MemoryCategoryScrollBitmaps: return "ScrollBitmaps";
+        case MemoryCategoryPictures: return "Pictures";
+        case MemoryCategoryFontCache: return "FontCache";
+        default: return "Unknown";
+    }
+}
+
+// Signal is delivered on the main task loop, so the dump does not run in the signal context
+class MemoryDumpSignalHandler : public folly::AsyncSignalHandler {
+public:
+    MemoryDumpSignalHandler(folly::EventBase* eventBase) : folly::AsyncSignalHandler(eventBase) {}
+    void signalReceived(int signum) noexcept override { MemoryAccounting::dump(); }
+};
+
+void MemoryAccounting::initialize() {
+    static std::unique_ptr<MemoryDumpSignalHandler> dumpSignalHandler;
+    if(dumpSignalHandler)
+        return;
+    dumpSignalHandler = std::make_unique<MemoryDumpSignalHandler>(&TaskLoop::main().eventBase());
+    dumpSignalHandler->registerSignalHandler(RNS_MEMORY_DUMP_SIGNAL);
+    RNS_LOG_INFO("Memory budget : " << budgetBytes_.load() << " bytes, send signal " << RNS_MEMORY_DUMP_SIGNAL << " to dump the usage");
+}
+
+void MemoryAccounting::update(MemoryCategory category, size_t oldBytes, size_t newBytes) {
+    if(oldBytes == newBytes)
+        return;
+    if(newBytes > oldBytes)
+        bytesUsed_[category].fetch_add(newBytes - oldBytes, std::memory_order_relaxed);
+    else
+        bytesUsed_[category].fetch_sub(oldBytes - newBytes, std::memory_order_relaxed);
+}
+
+size_t MemoryAccounting::bytesUsed(MemoryCategory category) {
+    if(category == MemoryCategoryFontCache)
+        return SkGraphics::GetFontCacheUsed();
+    return bytesUsed_[category].load(std::memory_order_relaxed);
+}
+
+size_t MemoryAccounting::totalBytesUsed() {
+    size_t totalBytes = 0;
+    for(int category = 0; category < MemoryCategoryCount; category++)
+        totalBytes += bytesUsed(static_cast<MemoryCategory>(category));
+    return totalBytes;
+}
+
+size_t MemoryAccounting::budgetedBytesUsed() {
+    return totalBytesUsed() - bytesUsed(MemoryCategoryPictures);
+}
+
+bool MemoryAccounting::isOverBudget() {
+    size_t budgetBytes = budgetBytes_.load(std::memory_order_relaxed);
+    return budgetBytes && (budgetedBytesUsed() > budgetBytes);
+}
+
+unsigned int MemoryAccounting::addEvictor(MemoryCategory category, Evictor evictor) {
+    std::lock_guard<std::mutex> lock(evictorsMutex_);
+    unsigned int evictorId = nextEvictorId_++;
+    evictors_[evictorId] = {category, evictor};
+    return evictorId;
+}
+
+void MemoryAccounting::removeEvictor(unsigned int evictorId) {
+    std::lock_guard<std::mutex> lock(evictorsMutex_);
+    evictors_.erase(evictorId);
+}
+
+size_t MemoryAccounting::enforceBudget() {
+    size_t budgetBytes = budgetBytes_.load(std::memory_order_relaxed);
+    size_t totalBytes = budgetedBytesUsed();
+    if(!budgetBytes || totalBytes <= budgetBytes)
+        return 0;
+    double currentTimeMs = SkTime::GetMSecs();
+    if(currentTimeMs - lastEnforceTimeMs_ < RNS_MEMORY_BUDGET_ENFORCE_INTERVAL_MS)
+        return 0;
+    lastEnforceTimeMs_ = currentTimeMs;
+
+    std::vector<EvictorEntry> evictors;
+    {
+        // Evictors take the locks of their owners, so they are not run with evictorsMutex_ held
+        std::lock_guard<std::mutex> lock(evictorsMutex_);
+        for(auto &entry : evictors_)
+            evictors.push_back(entry.second);
+    }
+    std::stable_sort(evictors.begin(), evictors.end(), [](const EvictorEntry& entry1, const EvictorEntry& entry2) {
+        return entry1.category < entry2.category;
+    });
+
+    size_t freedBytes = 0;
+    for(auto &entry : evictors) {
+        if(totalBytes <= budgetBytes + freedBytes)
+            break;
+        size_t evictorFreedBytes = entry.evictor(totalBytes - budgetBytes - freedBytes);
+        RNS_LOG_DEBUG("Memory budget : " << categoryName(entry.category) << " freed " << evictorFreedBytes << " bytes");
+        freedBytes += evictorFreedBytes;
+    }
+    RNS_LOG_INFO("Memory budget of " << budgetBytes << " bytes exceeded by " << totalBytes - budgetBytes << " bytes, freed " << freedBytes << " bytes");
+    return freedBytes;
+}
+
+void MemoryAccounting::dump() {
+    RNS_LOG_INFO("========== Render resource memory ==========");
+    for(int category = 0; category < MemoryCategoryCount; category++)
+        RNS_LOG_INFO(categoryName(category) << " : " << bytesUsed(static_cast<MemoryCategory>(category)) << " bytes");
+    RNS_LOG_INFO("Total : " << totalBytesUsed() << " bytes, Budgeted : " << budgetedBytesUsed() << " bytes, Budget : " << budgetBytes_.load() << " bytes");
+    // Lazily decoded images are in here as well, so it is not added to the total
+    RNS_LOG_INFO("Skia resource cache : " << SkGraphics::GetResourceCacheTotalBytesUsed() << " bytes");
+    RNS_LOG_INFO("============================================");
+}
+
+} // namespace RnsShell
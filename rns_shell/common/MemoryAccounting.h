@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
+
+#ifndef RNS_MEMORY_BUDGET_MB
+#define RNS_MEMORY_BUDGET_MB 0 // Budget for the accounted render resources, 0 disables enforcement
+#endif
+#define RNS_MEMORY_DUMP_SIGNAL SIGUSR2 // Logs the per category breakdown
+#define RNS_MEMORY_BUDGET_ENFORCE_INTERVAL_MS 1000 // Eviction is not retried on every frame, when owners have nothing left to free
+
+namespace RnsShell {
+
+enum MemoryCategory {
+    MemoryCategoryDecodedImages = 0, // Decoded images held by the image cache & the frame caches of animated images
+    MemoryCategoryScrollBitmaps, // Backing bitmaps of the scroll layers
+    MemoryCategoryPictures, // Recorded pictures of the picture layers, reported but not budgeted
+    MemoryCategoryFontCache, // Skia glyph cache, sampled from Skia
+    MemoryCategoryCount
+};
+
+/*
+ * Bytes held by the render resources, per category. Owners report their allocations as they change,
+ * caches owned by Skia are sampled. When the budgeted total crosses the budget, owners are asked to evict
+ * in the order of their category : images first, then offscreen scroll bitmaps. Pictures are the only copy
+ * of the content till the component records again & nothing can evict them, so they are in the breakdown
+ * but not counted against the budget.
+ */
+class MemoryAccounting {
+public:
+    // Frees at least bytesToFree if it can & returns the bytes actually freed
+    using Evictor = std::function<size_t(size_t bytesToFree)>;
+
+    static void initialize(); // Installs the dump signal handler, main task loop has to be initialized
+    static void update(MemoryCategory category, size_t oldBytes, size_t newBytes);
+    static size_t bytesUsed(MemoryCategory category);
+    static size_t totalBytesUsed();
+    static size_t budgetedBytesUsed(); // Total of the categories which can be evicted
+
+    static void setBudget(size_t budgetBytes) { budgetBytes_ = budgetBytes; }
+    static size_t budget() { return budgetBytes_; }
+    static bool isOverBudget();
+
+    // Evictors are run unlocked from a copy of the list, so one may still be called after its removeEvictor returns.
+    // Owners which are not singletons have to hold themselves weakly in the evictor.
+    static unsigned int addEvictor(MemoryCategory category, Evictor evictor);
+    static void removeEvictor(unsigned int evictorId);
+    // Has to be called with the layer tree locked, scroll bitmaps are evicted from the tree
+    static size_t enforceBudget();
+
+    static void dump();
+
+private:
+    struct EvictorEntry {
+        MemoryCategory category;
+        Evictor evictor;
+    };
+
+    static std::atomic<size_t> bytesUsed_[MemoryCategoryCount];
+    static std::atomic<size_t> budgetBytes_;
+    static std::mutex evictorsMutex_;
+    static std::map<unsigned int, EvictorEntry> evictors_;
+    static unsigned int nextEvictorId_;
+    static double lastEnforceTimeMs_;
+};
+
+} // namespace RnsShell
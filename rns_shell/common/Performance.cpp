@@ -5,7 +5,22 @@
  * found in the LICENSE file.
  */
 
+#include <algorithm>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "platform/linux/TaskLoop.h"
+
 #include "Performance.h"
+#include "Window.h"
+
+#define INPUT_LATENCY_MAX_PENDING_STAMPS 64 // Stamps of the keys emitted before the input manager listens
+#define INPUT_LATENCY_EVENT_TIMEOUT_MS 2000 // Keys without a commit or swap by then are dropped
+#define INPUT_LATENCY_MAX_SAMPLES 1024 // Percentiles are computed on the latest samples
+#define INPUT_LATENCY_AVERAGE_WEIGHT 0.25 // Weight of the latest key in the running averages
 
 static unsigned long long localFrameCount = 0;
 double fpsTimeStampA = 0;
@@ -53,4 +68,252 @@ void Performance::takeSamples(uint64_t swapBufferTime) {
     }
 }
 
+namespace {
+
+enum InputEventState {
+    InputEventQueued,
+    InputEventDispatched,
+    InputEventCommitted
+};
+
+struct PlatformStamp {
+    rnsKey key;
+    rnsKeyAction action;
+    double timeMs;
+};
+
+struct TrackedInputEvent {
+    InputEventState state{InputEventQueued};
+    double platformTimeMs{0};
+    double dequeueTimeMs{0};
+    double dispatchTimeMs{0};
+    double commitTimeMs{0};
+};
+
+std::mutex inputLatencyMutex;
+std::list<PlatformStamp> pendingStamps;
+std::map<uint64_t, TrackedInputEvent> trackedEvents;
+std::deque<double> stageSamples[InputLatencyStageCount];
+// Scopes of the calling thread, see InputLatency::DispatchScope & InputLatency::JSUpdateScope
+thread_local std::vector<uint64_t> dispatchScopeEventIds;
+thread_local double jsUpdateStartTimeMs{0};
+uint64_t nextInputEventId{1};
+uint64_t presentedEventCount{0};
+uint64_t droppedEventCount{0};
+double renderTurnaroundAverageMs{0};
+
+void addSample(int stage, double latencyMs) {
+    stageSamples[stage].push_back(latencyMs);
+    if(stageSamples[stage].size() > INPUT_LATENCY_MAX_SAMPLES)
+        stageSamples[stage].pop_front();
+}
+
+// Called with inputLatencyMutex held
+void dropTimedOutEvents(double currentTimeMs) {
+    for(auto it = trackedEvents.begin(); it != trackedEvents.end();) {
+        if(currentTimeMs - it->second.platformTimeMs > INPUT_LATENCY_EVENT_TIMEOUT_MS) {
+            it = trackedEvents.erase(it);
+            droppedEventCount++;
+        } else {
+            it++;
+        }
+    }
+}
+
+// Called with inputLatencyMutex held
+InputLatencySnapshot takeSnapshot() {
+    InputLatencySnapshot snapshot;
+    snapshot.presentedCount = presentedEventCount;
+    snapshot.droppedCount = droppedEventCount;
+    for(int stage = 0; stage < InputLatencyStageCount; stage++) {
+        if(stageSamples[stage].empty())
+            continue;
+        std::vector<double> samples(stageSamples[stage].begin(), stageSamples[stage].end());
+        std::sort(samples.begin(), samples.end());
+        auto percentile = [&samples](double fraction) {
+            return samples[std::min(samples.size() - 1, (size_t)(fraction * samples.size()))];
+        };
+        snapshot.stages[stage] = {samples.size(), percentile(0.50), percentile(0.95), percentile(0.99), samples.back()};
+    }
+    return snapshot;
+}
+
+// Called with inputLatencyMutex held
+void logPercentiles() {
+    InputLatencySnapshot snapshot = takeSnapshot();
+    RNS_LOG_INFO("Input latency of " << snapshot.presentedCount << " key(s), " << snapshot.droppedCount << " key(s) without update");
+    for(int stage = 0; stage < InputLatencyStageCount; stage++) {
+        InputLatencyHistogram &histogram = snapshot.stages[stage];
+        if(histogram.sampleCount == 0)
+            continue;
+        RNS_LOG_INFO("  " << InputLatency::stageName(stage) << " (ms) p50 : " << histogram.p50Ms << " p95 : " << histogram.p95Ms <<
+                     " p99 : " << histogram.p99Ms << " max : " << histogram.maxMs);
+    }
+}
+
+// Runs on the main task loop, the keys are posted one interval apart
+void injectKey(std::shared_ptr<std::vector<rnsKey>> keys, size_t index, int intervalMs) {
+    Window *window = Window::getMainWindow();
+    if(index == keys->size() || window == nullptr) {
+        // Last keys get their frame meanwhile
+        TaskLoop::main().scheduleDispatch([]() { InputLatency::report(); }, INPUT_LATENCY_EVENT_TIMEOUT_MS);
+        return;
+    }
+    window->postKey(keys->at(index), RNS_KEY_Press);
+    window->postKey(keys->at(index), RNS_KEY_Release);
+    TaskLoop::main().scheduleDispatch([keys, index, intervalMs]() { injectKey(keys, index + 1, intervalMs); }, intervalMs);
+}
+
+} // namespace
+
+const char* InputLatency::stageName(int stage) {
+    switch(stage) {
+        case InputLatencyStageQueue: return "queue";
+        case InputLatencyStageDispatch: return "dispatch";
+        case InputLatencyStageCommit: return "commit";
+        case InputLatencyStagePresent: return "present";
+        default: return "total";
+    }
+}
+
+void InputLatency::stampPlatformEvent(rnsKey key, rnsKeyAction action) {
+    if(action != RNS_KEY_Press) // Releases do not lead to any update
+        return;
+    std::scoped_lock lock(inputLatencyMutex);
+    pendingStamps.push_back({key, action, SkTime::GetMSecs()});
+    if(pendingStamps.size() > INPUT_LATENCY_MAX_PENDING_STAMPS)
+        pendingStamps.pop_front();
+}
+
+uint64_t InputLatency::beginEvent(rnsKey key, rnsKeyAction action) {
+    if(action != RNS_KEY_Press)
+        return 0;
+    std::scoped_lock lock(inputLatencyMutex);
+    // Keys are delivered in the emitted order, unmatched older stamps are of the keys nobody listened to
+    while(!pendingStamps.empty()) {
+        PlatformStamp stamp = pendingStamps.front();
+        pendingStamps.pop_front();
+        if(stamp.key == key && stamp.action == action) {
+            uint64_t eventId = nextInputEventId++;
+            trackedEvents[eventId].platformTimeMs = stamp.timeMs;
+            return eventId;
+        }
+    }
+    return 0;
+}
+
+void InputLatency::markDequeued(uint64_t eventId) {
+    std::scoped_lock lock(inputLatencyMutex);
+    auto it = trackedEvents.find(eventId);
+    if(it != trackedEvents.end())
+        it->second.dequeueTimeMs = SkTime::GetMSecs();
+}
+
+InputLatency::DispatchScope::DispatchScope(const std::vector<uint64_t>& eventIds) {
+    {
+        std::scoped_lock lock(inputLatencyMutex);
+        double currentTimeMs = SkTime::GetMSecs();
+        for(auto eventId : eventIds) {
+            auto it = trackedEvents.find(eventId);
+            if(it != trackedEvents.end() && it->second.state == InputEventQueued) {
+                it->second.dispatchTimeMs = currentTimeMs;
+                it->second.state = InputEventDispatched;
+            }
+        }
+    }
+    outerEventIds_.swap(dispatchScopeEventIds);
+    dispatchScopeEventIds = eventIds;
+}
+
+InputLatency::DispatchScope::~DispatchScope() {
+    // Keys not committed by now wait for a JS update
+    dispatchScopeEventIds.swap(outerEventIds_);
+}
+
+InputLatency::JSUpdateScope::JSUpdateScope() : outerStartTimeMs_(jsUpdateStartTimeMs) {
+    jsUpdateStartTimeMs = SkTime::GetMSecs();
+}
+
+InputLatency::JSUpdateScope::~JSUpdateScope() {
+    jsUpdateStartTimeMs = outerStartTimeMs_;
+}
+
+void InputLatency::onCommit() {
+    if(dispatchScopeEventIds.empty() && jsUpdateStartTimeMs == 0)
+        return; // Not caused by a key
+    std::scoped_lock lock(inputLatencyMutex);
+    if(trackedEvents.empty())
+        return;
+    double currentTimeMs = SkTime::GetMSecs();
+    auto commitEvent = [currentTimeMs](TrackedInputEvent &event) {
+        event.commitTimeMs = currentTimeMs;
+        event.state = InputEventCommitted;
+    };
+    for(auto eventId : dispatchScopeEventIds) {
+        auto it = trackedEvents.find(eventId);
+        if(it != trackedEvents.end() && it->second.state == InputEventDispatched)
+            commitEvent(it->second);
+    }
+    if(jsUpdateStartTimeMs != 0) {
+        for(auto &event : trackedEvents) {
+            if(event.second.state == InputEventDispatched && event.second.dispatchTimeMs <= jsUpdateStartTimeMs)
+                commitEvent(event.second);
+        }
+    }
+}
+
+void InputLatency::onPresent() {
+    std::scoped_lock lock(inputLatencyMutex);
+    if(trackedEvents.empty())
+        return;
+    double currentTimeMs = SkTime::GetMSecs();
+    bool needsReport = false;
+    for(auto it = trackedEvents.begin(); it != trackedEvents.end();) {
+        TrackedInputEvent &event = it->second;
+        if(event.state != InputEventCommitted) {
+            it++;
+            continue;
+        }
+        addSample(InputLatencyStageQueue, event.dequeueTimeMs - event.platformTimeMs);
+        addSample(InputLatencyStageDispatch, event.dispatchTimeMs - event.dequeueTimeMs);
+        addSample(InputLatencyStageCommit, event.commitTimeMs - event.dispatchTimeMs);
+        addSample(InputLatencyStagePresent, currentTimeMs - event.commitTimeMs);
+        addSample(InputLatencyStageTotal, currentTimeMs - event.platformTimeMs);
+        double renderTurnaroundMs = currentTimeMs - event.dispatchTimeMs;
+        renderTurnaroundAverageMs = (renderTurnaroundAverageMs == 0) ? renderTurnaroundMs :
+            (renderTurnaroundAverageMs + INPUT_LATENCY_AVERAGE_WEIGHT * (renderTurnaroundMs - renderTurnaroundAverageMs));
+        needsReport |= ((++presentedEventCount % INPUT_LATENCY_REPORT_INTERVAL) == 0);
+        it = trackedEvents.erase(it);
+    }
+    dropTimedOutEvents(currentTimeMs);
+    if(needsReport)
+        logPercentiles();
+}
+
+double InputLatency::averageRenderTurnaroundMs() {
+    std::scoped_lock lock(inputLatencyMutex);
+    return renderTurnaroundAverageMs;
+}
+
+void InputLatency::report() {
+    std::scoped_lock lock(inputLatencyMutex);
+    logPercentiles();
+}
+
+InputLatencySnapshot InputLatency::snapshot() {
+    std::scoped_lock lock(inputLatencyMutex);
+    return takeSnapshot();
+}
+
+void InputLatency::injectKeys(std::vector<rnsKey> keys, int intervalMs, int startDelayMs) {
+    auto injectedKeys = std::make_shared<std::vector<rnsKey>>(std::move(keys));
+    // Timers have to be armed from the task loop thread
+    TaskLoop::main().dispatch([injectedKeys, intervalMs, startDelayMs]() {
+        TaskLoop::main().scheduleDispatch([injectedKeys, intervalMs]() {
+            RNS_LOG_INFO("Injecting " << injectedKeys->size() << " key(s) every " << intervalMs << " ms");
+            injectKey(injectedKeys, 0, intervalMs);
+        }, startDelayMs);
+    });
+}
+
 } // namespace RnsShell
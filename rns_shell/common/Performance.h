@@ -7,9 +7,14 @@
 
 #pragma once
 
+#include <vector>
+
+#include "ReactSkia/sdk/RNSKeyCodeMapping.h"
 #include "ReactSkia/utils/RnsUtils.h"
 #include "ReactSkia/utils/RnsLog.h"
 
+#define INPUT_LATENCY_REPORT_INTERVAL 100 // Percentiles are logged after every these many presented key events
+
 namespace RnsShell {
 
 class Performance {
@@ -17,4 +22,72 @@ public:
     static void takeSamples(uint64_t swapBufferTime);
     static void displayFps();
 };
+
+enum InputLatencyStage {
+    InputLatencyStageQueue = 0, // Platform event till the input manager picks it up
+    InputLatencyStageDispatch, // Till the key is handed to the focused component, the navigator & JS
+    InputLatencyStageCommit, // Till the commit of its native handling, else of the first JS update after it
+    InputLatencyStagePresent, // Till the swap showing that commit
+    InputLatencyStageTotal, // Platform event till the swap
+    InputLatencyStageCount
+};
+
+struct InputLatencyHistogram {
+    size_t sampleCount{0};
+    double p50Ms{0};
+    double p95Ms{0};
+    double p99Ms{0};
+    double maxMs{0};
+};
+
+struct InputLatencySnapshot {
+    uint64_t presentedCount{0};
+    uint64_t droppedCount{0}; // Keys without a presented frame within the timeout
+    InputLatencyHistogram stages[InputLatencyStageCount];
+};
+
+/*
+ * Input to photon latency of the key presses of the main window.
+ * Platform stamps the key, input manager takes over the stamp in an id carried with the key till the dispatch.
+ * Commits are attributed by their origin, not by their order : the commits made within the DispatchScope of
+ * the keys, on the input thread, are theirs. Else the keys get the commit of the first JS update (mounting
+ * transaction) started after their dispatch. Other commits, like animations, are not attributed. Keys then
+ * get the swap of the frame rendering their commit, keys which do not lead to a commit are dropped after a timeout. Per stage p50/p95/p99 are logged periodically & by report(),
+ * and read by snapshot(), which the JS runtime gets as nativeInputLatency() next to performance.now().
+ */
+class InputLatency {
+public:
+    static void stampPlatformEvent(rnsKey key, rnsKeyAction action); // Before the key is emitted to the listeners
+    static uint64_t beginEvent(rnsKey key, rnsKeyAction action); // Returns 0, when the key was not stamped
+    static void markDequeued(uint64_t eventId);
+
+    // Native handling of the keys, which are marked dispatched on entry. Commits made on this thread meanwhile are theirs.
+    class DispatchScope {
+    public:
+        DispatchScope(const std::vector<uint64_t>& eventIds);
+        ~DispatchScope();
+    private:
+        std::vector<uint64_t> outerEventIds_;
+    };
+    // Update made by JS, its commit on this thread is the one of the keys dispatched before the scope
+    class JSUpdateScope {
+    public:
+        JSUpdateScope();
+        ~JSUpdateScope();
+    private:
+        double outerStartTimeMs_;
+    };
+    static void onCommit(); // Attributes the commit as per the scopes of the calling thread
+    static void onPresent();
+    static void report();
+    static InputLatencySnapshot snapshot(); // Percentiles of the latest samples of each stage
+    static const char* stageName(int stage);
+
+    // Running average of dispatch till the swap of the recent keys, 0 till a key gets presented
+    static double averageRenderTurnaroundMs();
+
+    // Posts the keys to the event loop of the main window every intervalMs, for automated runs. Reports when done.
+    static void injectKeys(std::vector<rnsKey> keys, int intervalMs, int startDelayMs);
+};
+
 } //namespace RnsShell
@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "include/core/SkRect.h"
 #include "include/core/SkSize.h"
 #include "include/core/SkTypes.h"
@@ -14,6 +16,7 @@
 
 #include "Application.h"
 #include "DisplayParams.h"
+#include "ReactSkia/sdk/RNSKeyCodeMapping.h"
 
 class GrDirectContext;
 class SkCanvas;
@@ -41,6 +44,8 @@ public:
             return mainWindow_->getWindowSize();
         return SkSize::MakeEmpty();
     }
+    // Sub window UIs composited as overlays of the main window get its keys, in place of the app
+    static void setOverlayKeyFocus(bool hasFocus) { overlayKeyFocus_ = hasFocus; }
 
     virtual ~Window();
 
@@ -49,6 +54,8 @@ public:
     virtual void closeWindow() = 0;
     virtual uint64_t nativeWindowHandle() = 0;
     virtual SkSize getWindowSize() = 0;
+    // Queues the key on the platform event loop, it is then handled as a key received from the platform
+    virtual void postKey(rnsKey key, rnsKeyAction action) = 0;
 
     enum BackendType {
         kNativeGL_BackendType,
@@ -82,6 +89,7 @@ private:
 protected:
     Window();
     static Window *mainWindow_;
+    static std::atomic<bool> overlayKeyFocus_;
     WindowType     winType{DefaultWindow};
     DisplayParams          requestedDisplayParams_;
 };
@@ -0,0 +1,120 @@
+/*
+* Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+*
+* Use of this source code is governed by a BSD-style license that can be
+* found in the LICENSE file.
+*/
+
+#include "ReactSkia/utils/RnsLog.h"
+
+#include "AnimationDriver.h"
+
+namespace RnsShell {
+
+AnimationId AnimationDriver::addAnimation(SharedLayer layer, LayerAnimatedProperty property, LayerAnimationStep step) {
+    if(!layer || !step) {
+        RNS_LOG_ERROR("Invalid layer or animation step");
+        return 0;
+    }
+    AnimationId animationId;
+    bool wasIdle;
+    {
+        std::scoped_lock lock(mutex_);
+        animationId = nextAnimationId_++;
+        wasIdle = isIdle();
+        animations_.push_back({animationId, layer, property, step});
+    }
+    RNS_LOG_DEBUG("Add animation(" << animationId << ") for layer(" << layer->layerId() << ") property : " << property);
+    if(wasIdle && frameRequestCallback_) {
+        frameRequestCallback_(); // Start the frame loop
+    }
+    return animationId;
+}
+
+AnimationId AnimationDriver::addFrameCallback(FrameCallback callback) {
+    if(!callback) {
+        RNS_LOG_ERROR("Invalid frame callback");
+        return 0;
+    }
+    AnimationId animationId;
+    bool wasIdle;
+    {
+        std::scoped_lock lock(mutex_);
+        animationId = nextAnimationId_++;
+        wasIdle = isIdle();
+        frameCallbacks_.emplace_back(animationId, std::make_shared<FrameCallback>(callback));
+    }
+    RNS_LOG_DEBUG("Add frame callback(" << animationId << ")");
+    if(wasIdle && frameRequestCallback_) {
+        frameRequestCallback_();
+    }
+    return animationId;
+}
+
+void AnimationDriver::removeAnimation(AnimationId animationId) {
+    std::scoped_lock lock(mutex_);
+    for(auto it = animations_.begin(); it != animations_.end(); it++) {
+        if(it->id == animationId) {
+            RNS_LOG_DEBUG("Remove animation(" << animationId << ")");
+            animations_.erase(it);
+            return;
+        }
+    }
+    for(auto it = frameCallbacks_.begin(); it != frameCallbacks_.end(); it++) {
+        if(it->first == animationId) {
+            RNS_LOG_DEBUG("Remove frame callback(" << animationId << ")");
+            frameCallbacks_.erase(it);
+            return;
+        }
+    }
+}
+
+bool AnimationDriver::hasActiveAnimations() {
+    std::scoped_lock lock(mutex_);
+    return !isIdle();
+}
+
+bool AnimationDriver::tick(double frameTimeMs) {
+    // Frame callbacks may take their own locks, which are also held while adding animations, so call them unlocked
+    decltype(frameCallbacks_) frameCallbacks;
+    {
+        std::scoped_lock lock(mutex_);
+        frameCallbacks = frameCallbacks_;
+    }
+    std::vector<AnimationId> finishedCallbacks;
+    for(auto &frameCallback : frameCallbacks) {
+        if(!(*frameCallback.second)(frameTimeMs)) {
+            finishedCallbacks.push_back(frameCallback.first);
+        }
+    }
+
+    std::scoped_lock lock(mutex_);
+    for(auto animationId : finishedCallbacks) {
+        for(auto it = frameCallbacks_.begin(); it != frameCallbacks_.end(); it++) {
+            if(it->first == animationId) {
+                frameCallbacks_.erase(it);
+                break;
+            }
+        }
+    }
+    auto it = animations_.begin();
+    while(it != animations_.end()) {
+        SharedLayer layer = it->layer.lock();
+        if(!layer) {
+            it = animations_.erase(it); // Layer is gone with its component
+            continue;
+        }
+        bool running = it->step(*layer.get(), frameTimeMs);
+        // Animated properties are applied while compositing, picture of the layer is still valid
+        layer->invalidate((it->property == LayerAnimatedTransform) ? LayerLayoutInvalidate : LayerCompositeInvalidate);
+        if(!running) {
+            RNS_LOG_DEBUG("Animation(" << it->id << ") finished");
+            it = animations_.erase(it);
+        } else {
+            it++;
+        }
+    }
+    return !isIdle();
+}
+
+}   // namespace RnsShell
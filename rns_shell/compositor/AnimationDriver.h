@@ -0,0 +1,70 @@
+/*
+* Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+*
+* Use of this source code is governed by a BSD-style license that can be
+* found in the LICENSE file.
+*/
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "layers/Layer.h"
+
+namespace RnsShell {
+
+using AnimationId = uint64_t;
+// Advances the animated property of the layer to the frame time (in milliseconds). Returns false once the animation is finished.
+using LayerAnimationStep = std::function<bool(Layer& layer, double frameTimeMs)>;
+// Called on every frame while registered, for animations writing several layers. Returns false to unregister.
+using FrameCallback = std::function<bool(double frameTimeMs)>;
+
+enum LayerAnimatedProperty {
+    LayerAnimatedTransform, // Writes Layer::transformMatrix
+    LayerAnimatedOpacity, // Writes Layer::opacity
+};
+
+/*
+ * Native animation driver owned by the compositor.
+ * Registered animations are advanced on the compositor thread, right before rendering each frame,
+ * with the layer tree locked. Only the animated layers are invalidated, and only for the composite time
+ * properties, so recorded pictures are reused and no JS round trip is needed to produce a frame.
+ * Animation steps must not add or remove animations, they finish by returning false.
+ * Frame callbacks run before the layer animations, without the driver lock, and invalidate the layers they write.
+ */
+class AnimationDriver {
+    RNS_MAKE_NONCOPYABLE(AnimationDriver);
+public:
+    using FrameRequestCallback = std::function<void()>;
+
+    AnimationDriver() = default;
+
+    void setFrameRequestCallback(FrameRequestCallback callback) { frameRequestCallback_ = callback; }
+
+    AnimationId addAnimation(SharedLayer layer, LayerAnimatedProperty property, LayerAnimationStep step);
+    AnimationId addFrameCallback(FrameCallback callback);
+    void removeAnimation(AnimationId animationId); // Removes layer animation or frame callback
+    bool hasActiveAnimations();
+
+    // Called by compositor before rendering a frame. Returns true if animations are still running, so next frame is needed.
+    bool tick(double frameTimeMs);
+
+private:
+    struct LayerAnimation {
+        AnimationId id;
+        std::weak_ptr<Layer> layer;
+        LayerAnimatedProperty property;
+        LayerAnimationStep step;
+    };
+
+    std::mutex mutex_; // Animations are added & removed from the mounting thread, advanced from the compositor thread
+    std::vector<LayerAnimation> animations_;
+    std::vector<std::pair<AnimationId, std::shared_ptr<FrameCallback>>> frameCallbacks_;
+    AnimationId nextAnimationId_{1};
+
+    bool isIdle() { return animations_.empty() && frameCallbacks_.empty(); }
+    FrameRequestCallback frameRequestCallback_{nullptr};
+};
+
+}   // namespace RnsShell
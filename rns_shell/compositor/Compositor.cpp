@@ -10,10 +10,13 @@
 #include "include/core/SkSurface.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkRegion.h"
+#include "include/core/SkTime.h"
 
 #include "ReactSkia/utils/RnsLog.h"
 
 #include "platform/linux/TaskLoop.h"
+#include "MemoryAccounting.h"
+#include "Performance.h"
 #include "WindowContextFactory.h"
 #ifdef RNS_SHELL_HAS_GPU_SUPPORT
 #include "GLWindowContext.h"
@@ -30,7 +33,8 @@ std::unique_ptr<Compositor> Compositor::create(Client& compositorClient, Platfor
 
 Compositor::Compositor(Client& client, PlatformDisplayID displayID, SkSize& viewportSize, float scaleFactor)
     :client_(client)
-    ,rootLayer_(nullptr) {
+    ,rootLayer_(nullptr)
+    ,overlayRootLayer_(Layer::Create(Layer::EmptyClient::singleton())) {
 
     nativeWindowHandle_ = reinterpret_cast<GLNativeWindowType>(client_.nativeSurfaceHandle());
     if(nativeWindowHandle_) {
@@ -53,9 +57,11 @@ Compositor::Compositor(Client& client, PlatformDisplayID displayID, SkSize& view
         attributes_.scaleFactor = scaleFactor;
         attributes_.needsResize = !viewportSize.isEmpty();
     }
+    overlayRootLayer_->setFrame(SkIRect::MakeSize(attributes_.viewportSize.toRound()));
 #if USE(RNS_SHELL_PARTIAL_UPDATES)
     supportPartialUpdate_ = windowContext_->supportsPartialUpdate();
 #endif
+    animationDriver_.setFrameRequestCallback([this]() { scheduleAnimationFrame(); });
     RNS_LOG_DEBUG("Native Window Handle : " << nativeWindowHandle_ << " Window Context : " << windowContext_.get() << "Back Buffer : " << backBuffer_.get());
 }
 
@@ -131,8 +137,8 @@ SkRect Compositor::beginClip() {
     // 2. Based on buffer age, add damages from previous frames if required or set entire surface as damage.
     if(bufferAge == 1) // Buffer is up to date. No need to add damages from previous frames.
         goto safeClipReturn;
-    else if(bufferAge == 0 || // Buffer is being used for the first time or has been reset
-            (bufferAge > frameDamageHistory_.size())) { // dont have enough history, so set entire surface as damage.
+    else if(!frameDamageHistory_.addMissedDamages(bufferAge, surfaceDamage_)) {
+        // Buffer is new/reset or dont have enough history.
         // Need full redraw, so ignore all dirty rects & clippath then mark entire surface as damage.
         int width = attributes_.viewportSize.width();
         int height = attributes_.viewportSize.height();
@@ -140,18 +146,10 @@ SkRect Compositor::beginClip() {
         clipPath.reset();
         Layer::addDamageRect(surfaceDamage_, {0, 0, width, height});
         clipPath.addRect(0, 0, width, height);
-    } else if(bufferAge > 1) { // Need to add damages from previous frames upto buffer age.
-        auto frameDamages = frameDamageHistory_.rbegin();
-        FrameDamages &dirtyRects = (*frameDamages);
-        for (auto age = bufferAge - 1; frameDamages != frameDamageHistory_.rend() && age > 0; ++frameDamages, --age) {
-            dirtyRects = *frameDamages;
-            for (auto& rect : dirtyRects) {
-                RNS_LOG_DEBUG("Buffer Age[" << bufferAge << "], History Index[" << age << "] : Aditional Damage [" <<
-                    rect.x() << "," << rect.y() << "," << rect.width() << "," << rect.height() << "]");
-              Layer::addDamageRect(surfaceDamage_, rect);
-              clipPath.addRect(rect.left(), rect.top(), rect.right(), rect.bottom());
-            }
-        }
+    } else { // Damages from previous frames upto buffer age are added
+        clipPath.reset();
+        for (auto& rect : surfaceDamage_)
+            clipPath.addRect(rect.left(), rect.top(), rect.right(), rect.bottom());
     }
 
 safeClipReturn:
@@ -192,6 +190,11 @@ void Compositor::renderLayerTree() {
         if (needsResize)
             glViewport(0, 0, viewportSize.width(), viewportSize.height());
 #endif
+        // Advance native animations for this frame, animated layers get invalidated before pre-paint
+        lastFrameTimeMs_ = SkTime::GetMSecs();
+        if(animationDriver_.tick(lastFrameTimeMs_)) {
+            scheduleAnimationFrame();
+        }
         auto canvas = backBuffer_->getCanvas();
         SkAutoCanvasRestore save(canvas, true);
         SkRect clipBound = SkRect::MakeEmpty();
@@ -207,6 +210,12 @@ void Compositor::renderLayerTree() {
             {0,0} //scrollOffset is zero for rootLayer
         };
         RNS_PROFILE_API_OFF("Render Tree Pre-Paint", rootLayer_.get()->prePaint(paintContext));
+        // Overlays track their own damage, which adds up to the damage of the root layer tree
+        RNS_PROFILE_API_OFF("Overlay Layers Pre-Paint", overlayRootLayer_->prePaint(paintContext));
+        if(MemoryAccounting::isOverBudget()) {
+            // Layer tree is locked & not painting yet, so layers can drop their offscreen resources
+            RNS_PROFILE_API_OFF("Enforce Memory Budget", MemoryAccounting::enforceBudget());
+        }
 #if USE(RNS_SHELL_PARTIAL_UPDATES) && ENABLE(RNS_SHELL_BUFFER_AGE)
         FrameDamages currentFrameDamages(surfaceDamage_); // Copy dirty rects from current frame before adding any damage from previous frame
         clipBound = beginClip();
@@ -214,11 +223,15 @@ void Compositor::renderLayerTree() {
         clipBound = beginClip(paintContext);
 #endif
         /* Check if paint required*/
-        if(!rootLayer_.get()->needsPainting(paintContext)) return;
+        bool paintOverlays = !overlayRootLayer_->children().empty() && overlayRootLayer_->needsPainting(paintContext);
+        if(!rootLayer_.get()->needsPainting(paintContext) && !paintOverlays) return;
 #ifdef RNS_SHELL_HAS_GPU_SUPPORT
         WindowContext::grTransactionBegin();
 #endif
         RNS_PROFILE_API_OFF("Render Tree Paint", rootLayer_.get()->paint(paintContext));
+        if(paintOverlays) {
+            RNS_PROFILE_API_OFF("Overlay Layers Paint", overlayRootLayer_->paint(paintContext));
+        }
         RNS_PROFILE_API_OFF("SkSurface Flush & Submit", backBuffer_->flushAndSubmit());
 #ifdef RNS_SHELL_HAS_GPU_SUPPORT
         WindowContext::grTransactionEnd();
@@ -238,15 +251,11 @@ void Compositor::renderLayerTree() {
 #endif
         RNS_PROFILE_API_OFF("SwapBuffers", windowContext_->swapBuffers(surfaceDamage_));
         client_.didRenderFrame();
+        InputLatency::onPresent();
 
 #if USE(RNS_SHELL_PARTIAL_UPDATES) && ENABLE(RNS_SHELL_BUFFER_AGE)
         // Add current frame damage to history.
-        if (frameDamageHistory_.size() >= RNS_SHELL_MAX_FRAME_DAMAGE_HISTORY) {
-          FrameDamages damages = frameDamageHistory_.front();
-          damages.clear();
-          frameDamageHistory_.pop_front();
-        }
-        frameDamageHistory_.push_back(currentFrameDamages);
+        frameDamageHistory_.push(currentFrameDamages);
 #endif
     }
 }
@@ -257,11 +266,17 @@ void Compositor::begin() {
     surfaceDamage_.clear(); // Clear the previous damage rects.
 }
 
+void Compositor::cancel() {
+    // Nothing to render, neither a frame nor an input latency commit
+    isMutating.unlock();
+}
+
 void Compositor::commit(bool immediate=false) {
     if(!windowContext_) {
         isMutating.unlock();
         return;
     }
+    InputLatency::onCommit(); // Keys handled natively on this thread, or updated by JS, get this commit
 
     if(immediate) {
         RNS_PROFILE_API_OFF("RenderTree Immediate:", renderLayerTree());
@@ -302,6 +317,23 @@ void Compositor::commit(bool immediate=false) {
     });
 }
 
+void Compositor::scheduleAnimationFrame() {
+    if(animationFrameScheduled_.exchange(true))
+        return; // Next frame is already scheduled
+
+    // Timers have to be armed from the task loop thread
+    TaskLoop::main().dispatch([this]() {
+        double elapsedMs = SkTime::GetMSecs() - lastFrameTimeMs_;
+        long long delayMs = std::max<long long>(0, (RNS_TARGET_FPS_US * 1e-3) - elapsedMs);
+        TaskLoop::main().scheduleDispatch([this]() {
+            animationFrameScheduled_ = false;
+            std::scoped_lock lock(isMutating); // Lock to make sure render tree is not mutated during the rendering
+            surfaceDamage_.clear();
+            RNS_PROFILE_API_OFF("RenderTree Animation Frame:", renderLayerTree());
+        }, delayMs);
+    });
+}
+
 void Compositor::setRootLayer(SharedLayer rootLayer) {
   if (rootLayer_.get() == rootLayer.get())
     return;
@@ -309,6 +341,11 @@ void Compositor::setRootLayer(SharedLayer rootLayer) {
   rootLayer_ = rootLayer;
 }
 
+void Compositor::addOverlayLayer(SharedLayer overlayLayer) {
+    RNS_LOG_INFO("Add Overlay Layer : " << overlayLayer.get());
+    overlayRootLayer_->appendChild(overlayLayer); // Most recent overlay is painted on top
+}
+
 void Compositor::setViewportSize(const SkSize& viewportSize) {
     //locker(attributes_.lock);
     if(viewportSize.width() == attributes_.viewportSize.width() &&
@@ -317,6 +354,8 @@ void Compositor::setViewportSize(const SkSize& viewportSize) {
     }
     attributes_.viewportSize = viewportSize;
     attributes_.needsResize = true;
+    overlayRootLayer_->setFrame(SkIRect::MakeSize(viewportSize.toRound()));
+    overlayRootLayer_->invalidate(LayerLayoutInvalidate);
     commit();
 }
 
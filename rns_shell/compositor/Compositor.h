@@ -7,6 +7,7 @@
 */
 #pragma once
 
+#include <atomic>
 #include <list>
 
 #include "third_party/skia/include/core/SkRect.h"
@@ -14,9 +15,10 @@
 #include "WindowContext.h"
 #include "PlatformDisplay.h"
 #include "layers/Layer.h"
+#include "AnimationDriver.h"
+#include "DamageHistory.h"
 
 #define RNS_TARGET_FPS_US 16666.7 // In Microseconds
-#define RNS_SHELL_MAX_FRAME_DAMAGE_HISTORY 5
 
 namespace RnsShell {
 
@@ -42,7 +44,12 @@ public:
     SkSize& viewport() { return attributes_.viewportSize; }
     void invalidate();
     void begin(); // Call this before modifying render layer tree
+    void cancel(); // Call this instead of commit when the render layer tree was only read
     void commit(bool immediate); // Commit the changes in render layer tree - immediately/schedule
+    AnimationDriver* animationDriver() { return &animationDriver_; }
+    // Overlays are composited above the root layer tree (System UIs like keyboard & alerts drawn within the main window).
+    // Call this between begin & commit, overlay is removed by invalidating it with LayerRemoveInvalidate.
+    void addOverlayLayer(SharedLayer overlayLayer);
 #if USE(RNS_SHELL_PARTIAL_UPDATES)
     bool supportsPartialUpdates() { return supportPartialUpdate_; } // Wheather compositor can support partial paint and update
     void addDamageRect(SkIRect damage) { if(supportPartialUpdate_ && !damage.isEmpty()) surfaceDamage_.push_back(damage); }
@@ -57,12 +64,16 @@ private:
 
     void createWindowContext();
     void renderLayerTree();
+    void scheduleAnimationFrame(); // Render next frame at the target frame rate, for running native animations
 #if USE(RNS_SHELL_PARTIAL_UPDATES) && ENABLE(RNS_SHELL_BUFFER_AGE)
     SkRect beginClip();
 #endif
-    std::mutex isMutating; // Lock the renderLayer tree while updating and rendering
+    // Lock the renderLayer tree while updating and rendering. Recursive, spatial navigation keeps the tree
+    // locked across a key, while the scrolls & repaints it triggers begin & commit the tree again.
+    std::recursive_mutex isMutating;
     Client& client_;
     SharedLayer rootLayer_;
+    SharedLayer overlayRootLayer_; // Parent of the overlay layers, sized to the viewport
     std::unique_ptr<WindowContext> windowContext_;
     sk_sp<SkSurface> backBuffer_;
     GLNativeWindowType nativeWindowHandle_;
@@ -71,8 +82,11 @@ private:
     bool supportPartialUpdate_;
 #endif
     std::vector<SkIRect> surfaceDamage_;
+    AnimationDriver animationDriver_;
+    std::atomic<bool> animationFrameScheduled_{false};
+    std::atomic<double> lastFrameTimeMs_{0};
 #if USE(RNS_SHELL_PARTIAL_UPDATES) && ENABLE(RNS_SHELL_BUFFER_AGE)
-    std::list<FrameDamages> frameDamageHistory_;
+    DamageHistory frameDamageHistory_;
 #endif
     struct {
         //Lock lock;
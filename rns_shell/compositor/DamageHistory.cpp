@@ -0,0 +1,38 @@
+/*
+* Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+*
+* Use of this source code is governed by a BSD-style license that can be
+* found in the LICENSE file.
+*/
+
+#include "ReactSkia/utils/RnsLog.h"
+
+#include "DamageHistory.h"
+
+namespace RnsShell {
+
+#if USE(RNS_SHELL_PARTIAL_UPDATES)
+bool DamageHistory::addMissedDamages(int bufferAge, FrameDamages& frameDamages) {
+    if(bufferAge <= 0 || bufferAge > history_.size())
+        return false;
+
+    // Buffer of age N has the content of N frames back, so it misses the damages of the latest N-1 frames
+    auto frameDamagesIt = history_.rbegin();
+    for (auto age = bufferAge - 1; frameDamagesIt != history_.rend() && age > 0; ++frameDamagesIt, --age) {
+        for (auto& rect : *frameDamagesIt) {
+            RNS_LOG_DEBUG("Buffer Age[" << bufferAge << "], History Index[" << age << "] : Aditional Damage [" <<
+                rect.x() << "," << rect.y() << "," << rect.width() << "," << rect.height() << "]");
+            Layer::addDamageRect(frameDamages, rect);
+        }
+    }
+    return true;
+}
+
+void DamageHistory::push(const FrameDamages& frameDamages) {
+    if (history_.size() >= RNS_SHELL_MAX_FRAME_DAMAGE_HISTORY)
+        history_.pop_front();
+    history_.push_back(frameDamages);
+}
+#endif // USE(RNS_SHELL_PARTIAL_UPDATES)
+
+}   // namespace RnsShell
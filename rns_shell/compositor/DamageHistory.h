@@ -0,0 +1,35 @@
+/*
+* Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+*
+* Use of this source code is governed by a BSD-style license that can be
+* found in the LICENSE file.
+*/
+#pragma once
+
+#include <list>
+
+#include "layers/Layer.h"
+
+#define RNS_SHELL_MAX_FRAME_DAMAGE_HISTORY 5
+
+namespace RnsShell {
+
+#if USE(RNS_SHELL_PARTIAL_UPDATES)
+/*
+ * Damages of the recent frames of a window surface, to repaint the back buffers which missed them (buffer age > 1).
+ * Shared by the compositor & the sub windows of the window delegator.
+ */
+class DamageHistory {
+public:
+    // Adds the damages missed by a back buffer of the given age to the frame damages. Returns false when the
+    // buffer is new/reset or older than the history, that is when the whole surface has to be repainted.
+    bool addMissedDamages(int bufferAge, FrameDamages& frameDamages);
+    void push(const FrameDamages& frameDamages); // Damages of the frame just swapped
+    void clear() { history_.clear(); }
+
+private:
+    std::list<FrameDamages> history_;
+};
+#endif // USE(RNS_SHELL_PARTIAL_UPDATES)
+
+}   // namespace RnsShell
@@ -44,6 +44,10 @@ void LayerTreeHost::begin() {
   compositor_->begin();
 }
 
+void LayerTreeHost::cancel() {
+  compositor_->cancel();
+}
+
 void LayerTreeHost::commitScene(bool immediate) {
   // TODO Check compositor state idle, progress, scheduled
   compositor_->commit(immediate);
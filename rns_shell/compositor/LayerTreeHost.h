@@ -21,6 +21,7 @@ class LayerTreeHost {
 
   void setRootCompositingLayer(SharedLayer rootLayer);
   void begin();
+  void cancel();
   void commitScene(bool immediate);
   void sizeDidChange(SkSize& size);
 
@@ -23,10 +23,18 @@ GrDirectContext* RendererDelegate::graphicsDirectContext() {
 }
 #endif
 
+AnimationDriver* RendererDelegate::animationDriver() {
+  return(layerTreeHost_->compositor()->animationDriver());
+}
+
 void RendererDelegate::begin() {
   layerTreeHost_->begin();
 }
 
+void RendererDelegate::cancel() {
+  layerTreeHost_->cancel();
+}
+
 void RendererDelegate::commit(bool immediate) {
   layerTreeHost_->commitScene(immediate);
 }
@@ -35,6 +43,10 @@ void RendererDelegate::setRootLayer(SharedLayer rootLayer) {
   layerTreeHost_->setRootCompositingLayer(rootLayer);
 }
 
+void RendererDelegate::addOverlayLayer(SharedLayer overlayLayer) {
+  layerTreeHost_->compositor()->addOverlayLayer(overlayLayer);
+}
+
 void RendererDelegate::scheduleRenderingUpdate() {
   commit(false);
 }
@@ -43,5 +55,9 @@ void RendererDelegate::beginRenderingUpdate() {
   begin();
 }
 
+void RendererDelegate::cancelRenderingUpdate() {
+  cancel();
+}
+
 
 }   // namespace RnsShell
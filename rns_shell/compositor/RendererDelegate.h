@@ -22,13 +22,18 @@ public:
     SkSize viewPort();
     void scheduleRenderingUpdate();
     void beginRenderingUpdate();
+    void cancelRenderingUpdate();
     void setRootLayer(SharedLayer rootLayer);
+    void addOverlayLayer(SharedLayer overlayLayer); // Call this between begin & commit
     void commit(bool immediate);
     void begin();
+    void cancel();
 
     // Layer Client Implementation
     void notifyFlushRequired() override { scheduleRenderingUpdate(); }
     void notifyFlushBegin() override { beginRenderingUpdate(); }
+    void notifyFlushCancel() override { cancelRenderingUpdate(); }
+    AnimationDriver* animationDriver() override;
 
 protected:
     std::unique_ptr<LayerTreeHost> layerTreeHost_;
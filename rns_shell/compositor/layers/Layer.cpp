@@ -82,6 +82,8 @@ SharedLayer Layer::Create(Client& layerClient, LayerType type) {
     }
 }
 
+std::atomic<uint64_t> Layer::absoluteFrameGeneration_(0);
+
 uint64_t Layer::nextUniqueId() {
     static std::atomic<uint64_t> nextId(1);
     uint64_t id;
@@ -168,7 +170,11 @@ void Layer::preRoll(PaintContext& context, bool forceLayout) {
         calculateTransformMatrix();
         SkRect mapRect=SkRect::Make(frame_);
         absoluteTransformMatrix_.mapRect(&mapRect);
-        absFrame_ = mapRect.roundOut();
+        SkIRect newAbsFrame = mapRect.roundOut();
+        if(newAbsFrame != absFrame_) {
+            absFrame_ = newAbsFrame;
+            absoluteFrameGeneration_.fetch_add(1, std::memory_order_relaxed);
+        }
         SkIRect newBounds = absFrame_;
         frameBounds_ = frame_;
         if(isShadowVisible) {
@@ -11,6 +11,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <array>
+#include <atomic>
 #include <map>
 #include <memory>
 #include <set>
@@ -28,6 +29,7 @@
 namespace RnsShell {
 
 class Layer;
+class AnimationDriver;
 
 enum LayerType {
     LAYER_TYPE_DEFAULT = 0, // Default layer type will need to register a paint functions using registerOnPaint.
@@ -39,10 +41,11 @@ enum LayerType {
 
 enum LayerInvalidateMask {
     LayerInvalidateNone = 0,
-    LayerPaintInvalidate = 1 << 0,
-    LayerLayoutInvalidate = 1 << 1,
+    LayerPaintInvalidate = 1 << 0, // Layer content has to be re-recorded
+    LayerLayoutInvalidate = 1 << 1, // Layer geometry (frame, transform) has to be recalculated
     LayerRemoveInvalidate = 1 << 2,
-    LayerInvalidateAll = LayerPaintInvalidate | LayerLayoutInvalidate
+    LayerCompositeInvalidate = 1 << 3, // Layer content is intact, only composite time properties (opacity, clip, ordering) changed
+    LayerInvalidateAll = LayerPaintInvalidate | LayerLayoutInvalidate | LayerCompositeInvalidate
 };
 
 typedef std::vector<std::shared_ptr<Layer> > LayerList;
@@ -68,6 +71,8 @@ public:
         virtual ~Client() = default;
         virtual void notifyFlushRequired() { }
         virtual void notifyFlushBegin() { }
+        virtual void notifyFlushCancel() { } // Ends notifyFlushBegin without a commit, when nothing was changed
+        virtual AnimationDriver* animationDriver() { return nullptr; } // Native animation driver of the compositor rendering the layer
     };
 
     // Singleton defualt client used for default layers.
@@ -129,6 +134,9 @@ public:
 
     const SkIRect& getBounds() const { return bounds_; }
 
+    // Bumped when the absolute frame of any layer changes, values derived from the layer geometry are cached against it
+    static uint64_t absoluteFrameGeneration() { return absoluteFrameGeneration_.load(std::memory_order_relaxed); }
+
     const SkPoint& anchorPosition() const { return anchorPosition_; }
     void setAnchorPosition(const SkPoint& anchorPosition) { anchorPosition_ = anchorPosition; }
 
@@ -147,6 +155,7 @@ protected:
 #endif
 private:
     static uint64_t nextUniqueId();
+    static std::atomic<uint64_t> absoluteFrameGeneration_;
 
     void setParent(Layer* layer);
     void setSkipParentMatrix(bool skipParentMatrix) {skipParentMatrix_ = skipParentMatrix;}
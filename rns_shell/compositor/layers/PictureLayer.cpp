@@ -5,6 +5,7 @@
 * found in the LICENSE file.
 */
 
+#include "common/MemoryAccounting.h"
 #include "compositor/layers/PictureLayer.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 
@@ -19,6 +20,17 @@ PictureLayer::PictureLayer(Client& layerClient)
     RNS_LOG_DEBUG("Picture Layer Constructed(" << this << ") with ID : " << layerId() << " and LayerClient : " << &layerClient);
 }
 
+PictureLayer::~PictureLayer() {
+    MemoryAccounting::update(MemoryCategoryPictures, pictureBytes_, 0);
+}
+
+void PictureLayer::setPicture(sk_sp<SkPicture> picture) {
+    size_t pictureBytes = picture ? picture->approximateBytesUsed() : 0;
+    MemoryAccounting::update(MemoryCategoryPictures, pictureBytes_, pictureBytes);
+    pictureBytes_ = pictureBytes;
+    picture_ = picture;
+}
+
 void PictureLayer::paintSelf(PaintContext& context) {
 #if !defined(GOOGLE_STRIP_LOG) || (GOOGLE_STRIP_LOG <= INFO)
     RNS_GET_TIME_STAMP_US(start);
@@ -21,17 +21,18 @@ public:
 
     static SharedPictureLayer Create(Client& layerClient);
     PictureLayer(Client& layerClient);
-    virtual ~PictureLayer() {};
+    virtual ~PictureLayer();
 
     SkPicture* picture() const { return picture_.get(); }
     virtual void paintSelf(PaintContext& context) override;
 
-    void setPicture(sk_sp<SkPicture> picture) { picture_ = picture; }
+    void setPicture(sk_sp<SkPicture> picture);
 
 private:
     // Picture may reference images that have a reference to a GPU resource.
     // TODO what will happen for NON-GPU ?
     sk_sp<SkPicture> picture_;
+    size_t pictureBytes_{0}; // Reported to MemoryAccounting
 
     typedef Layer INHERITED;
 };
@@ -8,11 +8,18 @@
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
 
+#include "common/MemoryAccounting.h"
 #include "compositor/Compositor.h"
 #include "compositor/layers/ScrollLayer.h"
 
 namespace RnsShell {
 
+std::atomic<uint64_t> ScrollLayer::scrollPositionGeneration_(0);
+#if USE(SCROLL_LAYER_BITMAP)
+std::mutex ScrollLayer::bitmapLayersMutex_;
+std::set<ScrollLayer*> ScrollLayer::bitmapLayers_;
+#endif
+
 #if ENABLE(FEATURE_SCROLL_INDICATOR)
 
 #define SCROLLBAR_THICKNESS  (5)
@@ -231,10 +238,24 @@ ScrollLayer::ScrollLayer(Client& layerClient)
 #if USE(SCROLL_LAYER_BITMAP)
     drawDestRect_.setEmpty();
     drawSrcRect_.setEmpty();
+    static std::once_flag evictorOnceFlag;
+    std::call_once(evictorOnceFlag, []() {
+        MemoryAccounting::addEvictor(MemoryCategoryScrollBitmaps, ScrollLayer::evictOffscreenBitmaps);
+    });
+    std::lock_guard<std::mutex> lock(bitmapLayersMutex_);
+    bitmapLayers_.insert(this);
 #endif
     RNS_LOG_DEBUG("Scroll Layer Constructed(" << this << ") with ID : " << layerId());
 }
 
+ScrollLayer::~ScrollLayer() {
+#if USE(SCROLL_LAYER_BITMAP)
+    std::lock_guard<std::mutex> lock(bitmapLayersMutex_);
+    bitmapLayers_.erase(this);
+    MemoryAccounting::update(MemoryCategoryScrollBitmaps, bitmapBytes_, 0);
+#endif
+}
+
 bool ScrollLayer::setContentSize(SkISize contentSize) {
     /* If contentSize has changed, reset bitmap to reconfigure*/
     if(contentSize_ != contentSize) {
@@ -251,6 +272,8 @@ bool ScrollLayer::setContentSize(SkISize contentSize) {
 }
 
 void ScrollLayer::setScrollPosition(SkPoint scrollPos) {
+    if(scrollOffsetX_ != (int)scrollPos.x() || scrollOffsetY_ != (int)scrollPos.y())
+        scrollPositionGeneration_.fetch_add(1, std::memory_order_relaxed);
     scrollOffsetX_ = scrollPos.x();
     scrollOffsetY_ = scrollPos.y();
     RNS_LOG_DEBUG("Scroll Layer (" << layerId_ << ") Set ScrollOffset :" << scrollOffsetX_ << "," << scrollOffsetY_);
@@ -274,7 +297,46 @@ void ScrollLayer::bitmapConfigure() {
        /* Apply the background color in bitmap */
        scrollBitmap_.eraseColor(backgroundColor);
        scrollCanvas_ = std::make_unique<SkCanvas>(scrollBitmap_);
+
+       size_t bitmapBytes = scrollBitmap_.computeByteSize();
+       MemoryAccounting::update(MemoryCategoryScrollBitmaps, bitmapBytes_, bitmapBytes);
+       bitmapBytes_ = bitmapBytes;
+       isBitmapEvicted_ = false;
+    }
+}
+
+bool ScrollLayer::isBitmapEvictable() {
+    // Nested scroll layers are painted on the bitmap of their ancestor, so their frames are not in screen space
+    for(Layer* ancestor = parent(); ancestor; ancestor = ancestor->parent()) {
+        if(ancestor->type() == LAYER_TYPE_SCROLL)
+            return false;
     }
+    Layer* root = rootLayer();
+    return (root != this) && !absFrame_.intersects(root->absoluteFrame());
+}
+
+void ScrollLayer::evictBitmap() {
+    scrollCanvas_.reset();
+    scrollBitmap_.reset();
+    MemoryAccounting::update(MemoryCategoryScrollBitmaps, bitmapBytes_, 0);
+    bitmapBytes_ = 0;
+    isBitmapEvicted_ = true;
+    forceBitmapReset_ = true; // All the children are painted again on the new bitmap
+}
+
+size_t ScrollLayer::evictOffscreenBitmaps(size_t bytesToFree) {
+    std::lock_guard<std::mutex> lock(bitmapLayersMutex_);
+    size_t freedBytes = 0;
+    for(auto layer : bitmapLayers_) {
+        if(freedBytes >= bytesToFree)
+            break;
+        if(layer->isBitmapEvicted_ || layer->scrollBitmap_.drawsNothing() || !layer->isBitmapEvictable())
+            continue;
+        RNS_LOG_DEBUG("Scroll Layer (" << layer->layerId_ << ") offscreen, evicting bitmap of " << layer->bitmapBytes_ << " bytes");
+        freedBytes += layer->bitmapBytes_;
+        layer->evictBitmap();
+    }
+    return freedBytes;
 }
 #endif
 
@@ -303,14 +365,18 @@ void ScrollLayer::prePaint(PaintContext& context, bool forceLayout) {
     };
 
 #if USE(SCROLL_LAYER_BITMAP)
-    bitmapConfigure();
-    scrollCanvas_->save();
+    // Evicted bitmap is rebuilt only once the layer is back on screen
+    bool skipBitmap = isBitmapEvicted_ && isBitmapEvictable();
+    if(!skipBitmap) {
+        bitmapConfigure();
+        scrollCanvas_->save();
 #if USE(RNS_SHELL_PARTIAL_UPDATES)
-    //If bitmapReset,we have to draw all childrens.So add bitmap Rect as damageRect
-    if(forceBitmapReset_) {
-        addDamageRect(bitmapPaintContext,{0,0,contentSize_.width(),contentSize_.height()});
-    }
+        //If bitmapReset,we have to draw all childrens.So add bitmap Rect as damageRect
+        if(forceBitmapReset_) {
+            addDamageRect(bitmapPaintContext,{0,0,contentSize_.width(),contentSize_.height()});
+        }
 #endif
+    }
 #endif
     /* Prepaint child recursively and then paint self */
     /* Child for prepaint is selected based on below condition */
@@ -391,7 +457,13 @@ void ScrollLayer::prePaint(PaintContext& context, bool forceLayout) {
     invalidateMask_ = static_cast<LayerInvalidateMask>(invalidateMask_ & LayerRemoveInvalidate);
     recycleChildList.clear();
 #if USE(SCROLL_LAYER_BITMAP)
-    forceBitmapReset_ = false;
+    if(skipBitmap) {
+        bitmapSurfaceDamage_.clear(); // Whole bitmap is painted when rebuilt
+        drawSrcRect_.setEmpty();
+        drawDestRect_.setEmpty();
+    } else {
+        forceBitmapReset_ = false;
+    }
 #endif
 }
 
@@ -539,6 +611,10 @@ void ScrollLayer::paintChildrenAndSelf(PaintContext& context) {
 
 void ScrollLayer::paint(PaintContext& context) {
     RNS_LOG_TRACE("Scroll Layer (" << layerId() << ") has " << children().size() << " childrens");
+#if USE(SCROLL_LAYER_BITMAP)
+    if(scrollBitmap_.drawsNothing()) // Evicted while offscreen
+        return;
+#endif
     SkAutoCanvasRestore save(context.canvas, true); // Save current clip and matrix state
 
     applyLayerTransformMatrix(context);
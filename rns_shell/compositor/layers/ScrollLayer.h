@@ -7,6 +7,9 @@
 
 #pragma once
 
+#include <mutex>
+#include <set>
+
 #include "compositor/layers/Layer.h"
 #include "include/core/SkPicture.h"
 
@@ -60,7 +63,7 @@ public:
 
     static SharedScrollLayer Create(Client& layerClient);
     ScrollLayer(Client& layerClient);
-    virtual ~ScrollLayer() {};
+    virtual ~ScrollLayer();
 
     SkPicture* shadowPicture() const { return shadowPicture_.get(); }
     SkPicture* borderPicture() const { return borderPicture_.get(); }
@@ -77,6 +80,8 @@ public:
 
     void setScrollPosition(SkPoint scrollPos) ;
     SkPoint getScrollPosition() { return SkPoint::Make(scrollOffsetX_,scrollOffsetY_);};
+    // Bumped when the scroll position of any scroll layer changes, see Layer::absoluteFrameGeneration
+    static uint64_t scrollPositionGeneration() { return scrollPositionGeneration_.load(std::memory_order_relaxed); }
 
 #if ENABLE(FEATURE_SCROLL_INDICATOR)
     ScrollBar& getScrollBar() { return scrollbar_;}
@@ -94,9 +99,18 @@ private:
 
     SkIRect drawDestRect_;
     SkIRect drawSrcRect_;
+
+    bool isBitmapEvictable();
+    void evictBitmap();
+    static size_t evictOffscreenBitmaps(size_t bytesToFree); // MemoryAccounting evictor
+    bool isBitmapEvicted_{false}; // Dropped while offscreen, rebuilt once back on screen
+    size_t bitmapBytes_{0}; // Reported to MemoryAccounting
+    static std::mutex bitmapLayersMutex_;
+    static std::set<ScrollLayer*> bitmapLayers_;
 #endif
     std::vector<SkIRect> bitmapSurfaceDamage_;
 
+    static std::atomic<uint64_t> scrollPositionGeneration_;
     int scrollOffsetX_{0};   // Offset to scroll in x direction
     int scrollOffsetY_{0};   // Offset to scroll in y direction
     SkISize contentSize_{0};  // total size of all contents
@@ -7,6 +7,7 @@
 */
 
 #include "src/utils/SkUTF.h"
+#include "Performance.h"
 #include "WindowContextFactory.h"
 #include "WindowLibWPE.h"
 #include "platform/linux/TaskLoop.h"
@@ -16,6 +17,7 @@ namespace RnsShell {
 
 SkTDynamicHash<WindowLibWPE, WPEWindowID> WindowLibWPE::gWindowMap;
 Window* Window::mainWindow_;
+std::atomic<bool> Window::overlayKeyFocus_{false};
 
 GMainLoop       *WindowLibWPE::mainLoop_;
 Application     *WindowLibWPE::mainApp_;
@@ -264,13 +266,32 @@ void WindowLibWPE::setRequestedDisplayParams(const DisplayParams& params, bool a
     INHERITED::setRequestedDisplayParams(params, allowReattach);
 }
 
+void WindowLibWPE::postKey(rnsKey key, rnsKeyAction action) {
+    struct PostedKey {
+        WindowLibWPE* window;
+        rnsKey key;
+        rnsKeyAction action;
+    };
+    if(!mainLoop_)
+        return;
+    g_main_context_invoke_full(g_main_loop_get_context(mainLoop_), G_PRIORITY_DEFAULT,
+        [](gpointer data) -> gboolean {
+            auto postedKey = reinterpret_cast<PostedKey*>(data);
+            postedKey->window->onKey(postedKey->key, postedKey->action);
+            return G_SOURCE_REMOVE;
+        },
+        new PostedKey{this, key, action},
+        [](gpointer data) { delete reinterpret_cast<PostedKey*>(data); });
+}
+
 void WindowLibWPE::onKey(rnsKey eventKeyType, rnsKeyAction eventKeyAction){
 #if ENABLE(FEATURE_ONSCREEN_KEYBOARD) || ENABLE(FEATURE_ALERT)
-    if(winType == SubWindow) {
+    if(winType == SubWindow || overlayKeyFocus_) {
         NotificationCenter::subWindowCenter().emit("onHWKeyEvent", eventKeyType, eventKeyAction,(Window*)this);
     } else
 #endif/*FEATURE_ONSCREEN_KEYBOARD*/
     {
+        InputLatency::stampPlatformEvent(eventKeyType, eventKeyAction);
         NotificationCenter::defaultCenter().emit("onHWKeyEvent", eventKeyType, eventKeyAction);
     }
     return;
@@ -65,6 +65,7 @@ public:
     }
 
     void setRequestedDisplayParams(const DisplayParams&, bool allowReattach) override;
+    void postKey(rnsKey key, rnsKeyAction action) override;
 
     static SkTDynamicHash<WindowLibWPE, WPEWindowID> gWindowMap;
     static GMainLoop       *mainLoop_;
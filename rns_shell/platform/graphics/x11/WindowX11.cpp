@@ -17,6 +17,7 @@
 #ifdef RNS_SHELL_HAS_GPU_SUPPORT
 #include "GLWindowContext.h"
 #endif
+#include "Performance.h"
 #include "WindowX11.h"
 #include "WindowContextFactory.h"
 
@@ -26,6 +27,7 @@ namespace RnsShell {
 
 SkTDynamicHash<WindowX11, XWindow> WindowX11::gWindowMap;
 Window* Window::mainWindow_;
+std::atomic<bool> Window::overlayKeyFocus_{false};
 
 const long kEventMask = ExposureMask | StructureNotifyMask |
                         KeyPressMask | KeyReleaseMask |
@@ -241,6 +243,7 @@ bool WindowX11::initWindow(PlatformDisplay *platformDisplay,SkSize dimension,Win
     // set up to catch window delete message
     wmDeleteMessage_ = XInternAtom(display, "WM_DELETE_WINDOW", False);
     XSetWMProtocols(display, window_, &wmDeleteMessage_, 1);
+    postedKeyMessage_ = XInternAtom(display, "RNS_POSTED_KEY", False);
 
     // add to hashtable of windows
     gWindowMap.add(this);
@@ -301,6 +304,10 @@ bool WindowX11::handleEvent(const XEvent& event) {
             break;
 
         case ClientMessage:
+            if (event.xclient.message_type == postedKeyMessage_) {
+                onKey((rnsKey)event.xclient.data.l[0], (rnsKeyAction)event.xclient.data.l[1]);
+                break;
+            }
             if ((Atom)event.xclient.data.l[0] == wmDeleteMessage_ &&
                 gWindowMap.count() == 1) {
                 return true;
@@ -336,6 +343,21 @@ void WindowX11::show() {
     XMapWindow(display_, window_);
 }
 
+void WindowX11::postKey(rnsKey key, rnsKeyAction action) {
+    if (!display_)
+        return;
+    // Display is opened after XInitThreads, so the event can be sent from any thread
+    XEvent event = {0};
+    event.xclient.type = ClientMessage;
+    event.xclient.window = window_;
+    event.xclient.message_type = postedKeyMessage_;
+    event.xclient.format = 32;
+    event.xclient.data.l[0] = key;
+    event.xclient.data.l[1] = action;
+    XSendEvent(display_, window_, False, NoEventMask, &event);
+    XFlush(display_);
+}
+
 void WindowX11::setRequestedDisplayParams(const DisplayParams& params, bool allowReattach) {
     RNS_LOG_NOT_IMPL;
     //INHERITED::setRequestedDisplayParams(params, allowReattach);
@@ -347,11 +369,12 @@ void WindowX11::onExpose() {
 
 void WindowX11::onKey(rnsKey eventKeyType, rnsKeyAction eventKeyAction){
 #if ENABLE(FEATURE_ONSCREEN_KEYBOARD) || ENABLE(FEATURE_ALERT)
-    if(winType == SubWindow) {
+    if(winType == SubWindow || overlayKeyFocus_) {
         NotificationCenter::subWindowCenter().emit("onHWKeyEvent", eventKeyType, eventKeyAction,(Window*)this);
     } else
 #endif/*FEATURE_ONSCREEN_KEYBOARD*/
     {
+        InputLatency::stampPlatformEvent(eventKeyType, eventKeyAction);
         NotificationCenter::defaultCenter().emit("onHWKeyEvent", eventKeyType, eventKeyAction);
     }
     return;
@@ -61,6 +61,7 @@ public:
     bool handleEvent(const XEvent& event);
     void setTitle(const char*) override;
     void show() override;
+    void postKey(rnsKey key, rnsKeyAction action) override;
 
     static const XWindow& GetKey(const WindowX11& w) {
         return w.window_;
@@ -86,6 +87,7 @@ private:
 #endif
     int          MSAASampleCount_;
     Atom         wmDeleteMessage_;
+    Atom         postedKeyMessage_; // Client message carrying a key posted by postKey
     typedef Window INHERITED;
 };
 
@@ -28,6 +28,7 @@ public:
 
     void dispatch(Func fun);
     void scheduleDispatch(Func fun, long long timeoutMs); // schedule a task with timeout(in milliseconds)
+    EventBase& eventBase() { return eventBase_; } // For the handlers living on the loop, like signal handlers
 
 private:
     EventBase eventBase_;
@@ -29,6 +29,7 @@
 #include "ReactSkia/utils/RnsLog.h"
 
 #include "Application.h"
+#include "MemoryAccounting.h"
 #include "Window.h"
 #include "PlatformDisplay.h"
 
@@ -39,6 +40,7 @@ static bool platformInitialize(char **argv) {
     bool status = false;
 
     TaskLoop::initializeMain();
+    MemoryAccounting::initialize();
     NotificationCenter::initializeDefault();
 #if ENABLE(FEATURE_ONSCREEN_KEYBOARD) || ENABLE(FEATURE_ALERT)
     NotificationCenter::initializeSubWindowCenter();//Intializing Notification center for Events from subWindows
@@ -0,0 +1,79 @@
+/*
+* Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+*
+* Use of this source code is governed by a BSD-style license that can be
+* found in the LICENSE file.
+*/
+
+#include "gtest/gtest.h"
+
+#include "rns_shell/compositor/DamageHistory.h"
+
+namespace RnsShell {
+namespace {
+
+#if USE(RNS_SHELL_PARTIAL_UPDATES)
+TEST(DamageHistoryTest, NewOrResetBufferNeedsFullRepaint) {
+    DamageHistory history;
+    FrameDamages damages;
+    history.push({SkIRect::MakeXYWH(0, 0, 10, 10)});
+    EXPECT_FALSE(history.addMissedDamages(0, damages));
+    EXPECT_TRUE(damages.empty());
+}
+
+TEST(DamageHistoryTest, BufferOlderThanHistoryNeedsFullRepaint) {
+    DamageHistory history;
+    FrameDamages damages;
+    history.push({SkIRect::MakeXYWH(0, 0, 10, 10)});
+    history.push({SkIRect::MakeXYWH(20, 0, 10, 10)});
+    EXPECT_FALSE(history.addMissedDamages(3, damages));
+}
+
+TEST(DamageHistoryTest, LatestBufferMissesNothing) {
+    DamageHistory history;
+    FrameDamages damages = {SkIRect::MakeXYWH(100, 100, 10, 10)};
+    history.push({SkIRect::MakeXYWH(0, 0, 10, 10)});
+    EXPECT_TRUE(history.addMissedDamages(1, damages));
+    ASSERT_EQ(damages.size(), 1u);
+    EXPECT_EQ(damages[0], SkIRect::MakeXYWH(100, 100, 10, 10));
+}
+
+TEST(DamageHistoryTest, OlderBufferGetsDamagesOfFramesItMissed) {
+    DamageHistory history;
+    history.push({SkIRect::MakeXYWH(0, 0, 10, 10)});
+    history.push({SkIRect::MakeXYWH(20, 0, 10, 10)});
+    history.push({SkIRect::MakeXYWH(40, 0, 10, 10)});
+
+    FrameDamages damages = {SkIRect::MakeXYWH(100, 100, 10, 10)};
+    EXPECT_TRUE(history.addMissedDamages(3, damages));
+    ASSERT_EQ(damages.size(), 3u);
+    EXPECT_EQ(damages[1], SkIRect::MakeXYWH(40, 0, 10, 10));
+    EXPECT_EQ(damages[2], SkIRect::MakeXYWH(20, 0, 10, 10));
+}
+
+TEST(DamageHistoryTest, MissedDamagesAreMerged) {
+    DamageHistory history;
+    history.push({SkIRect::MakeXYWH(10, 10, 10, 10)});
+    history.push({SkIRect::MakeXYWH(0, 0, 10, 10)});
+
+    FrameDamages damages = {SkIRect::MakeXYWH(0, 0, 100, 100)};
+    EXPECT_TRUE(history.addMissedDamages(2, damages));
+    EXPECT_EQ(damages.size(), 1u);
+}
+
+TEST(DamageHistoryTest, KeepsOnlyRecentFrames) {
+    DamageHistory history;
+    for(int frame = 0; frame < RNS_SHELL_MAX_FRAME_DAMAGE_HISTORY + 2; frame++)
+        history.push({SkIRect::MakeXYWH(frame * 20, 0, 10, 10)});
+
+    FrameDamages damages;
+    EXPECT_TRUE(history.addMissedDamages(RNS_SHELL_MAX_FRAME_DAMAGE_HISTORY, damages));
+    EXPECT_FALSE(history.addMissedDamages(RNS_SHELL_MAX_FRAME_DAMAGE_HISTORY + 1, damages));
+
+    history.clear();
+    EXPECT_FALSE(history.addMissedDamages(1, damages));
+}
+#endif // USE(RNS_SHELL_PARTIAL_UPDATES)
+
+} // namespace
+} // namespace RnsShell
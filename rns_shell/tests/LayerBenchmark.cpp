@@ -0,0 +1,149 @@
+/*
+* Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+*
+* Use of this source code is governed by a BSD-style license that can be
+* found in the LICENSE file.
+*/
+
+#include "include/core/SkSurface.h"
+
+#include "rns_shell/compositor/layers/Layer.h"
+#include "rns_shell/tests/benchmark/RnsBenchmark.h"
+
+#define BENCHMARK_SURFACE_WIDTH 1280
+#define BENCHMARK_SURFACE_HEIGHT 720
+#define BENCHMARK_TILE_SIZE 40
+
+namespace RnsShell {
+namespace {
+
+// Rows of tiles like a grid screen, with count leaf layers spread over the surface
+struct LayerTree {
+    explicit LayerTree(int count) {
+        surface = SkSurface::MakeRasterN32Premul(BENCHMARK_SURFACE_WIDTH, BENCHMARK_SURFACE_HEIGHT);
+        root = Layer::Create(Layer::EmptyClient::singleton(), LAYER_TYPE_VIRTUAL);
+        root->setFrame(SkIRect::MakeWH(BENCHMARK_SURFACE_WIDTH, BENCHMARK_SURFACE_HEIGHT));
+
+        int columns = BENCHMARK_SURFACE_WIDTH / BENCHMARK_TILE_SIZE;
+        SharedLayer row;
+        for(int index = 0; index < count; index++) {
+            int column = index % columns;
+            if(column == 0) {
+                row = Layer::Create(Layer::EmptyClient::singleton(), LAYER_TYPE_VIRTUAL);
+                int rowIndex = (index / columns) % (BENCHMARK_SURFACE_HEIGHT / BENCHMARK_TILE_SIZE);
+                row->setFrame(SkIRect::MakeXYWH(0, rowIndex * BENCHMARK_TILE_SIZE, BENCHMARK_SURFACE_WIDTH, BENCHMARK_TILE_SIZE));
+                root->appendChild(row);
+            }
+            SharedLayer tile = Layer::Create(Layer::EmptyClient::singleton(), LAYER_TYPE_DEFAULT);
+            Layer* rawTile = tile.get();
+            SkColor color = SkColorSetRGB(index * 7, index * 13, index * 29);
+            tile->setFrame(SkIRect::MakeXYWH(column * BENCHMARK_TILE_SIZE + 2, 2, BENCHMARK_TILE_SIZE - 4, BENCHMARK_TILE_SIZE - 4));
+            tile->registerOnPaint([rawTile, color](SkCanvas* canvas) {
+                SkPaint paint;
+                paint.setColor(color);
+                canvas->drawIRect(rawTile->getFrame(), paint);
+            });
+            row->appendChild(tile);
+            tiles.push_back(tile);
+        }
+        renderFrame(); // Settles the initial damage of the new layers
+    }
+
+    void renderFrame() {
+        FrameDamages damages;
+        SkRect clipBound = SkRect::MakeEmpty();
+        PaintContext context = {
+            surface->getCanvas(),
+            damages,
+#if USE(RNS_SHELL_PARTIAL_UPDATES)
+            true,
+#endif
+            clipBound,
+            nullptr,
+            {0,0}
+        };
+        root->prePaint(context);
+        root->paint(context);
+        lastDamageCount = damages.size();
+    }
+
+    sk_sp<SkSurface> surface;
+    SharedLayer root;
+    LayerList tiles;
+    size_t lastDamageCount{0};
+};
+
+// Focus move on a grid, two tiles repainted per frame
+RNS_BENCHMARK_WITH_ARGS(BM_LayerTreeFocusMoveFrame, 64, 256, 1024) {
+    LayerTree tree(state.range());
+    size_t focused = 0;
+    while(state.keepRunning()) {
+        tree.tiles[focused]->invalidate(LayerPaintInvalidate);
+        focused = (focused + 1) % tree.tiles.size();
+        tree.tiles[focused]->invalidate(LayerPaintInvalidate);
+        tree.renderFrame();
+    }
+    state.setItemsProcessed(state.iterations());
+    state.setCounter("damage_rects", tree.lastDamageCount);
+}
+
+// Whole tree scrolled, every layer recomputes its absolute frame
+RNS_BENCHMARK_WITH_ARGS(BM_LayerTreeLayoutFrame, 64, 256, 1024) {
+    LayerTree tree(state.range());
+    int offset = 0;
+    while(state.keepRunning()) {
+        offset = (offset + 1) % BENCHMARK_TILE_SIZE;
+        for(auto& row : tree.root->children()) {
+            SkIRect frame = row->getFrame();
+            row->setFrame(frame.makeOffset(0, (offset ? 1 : -(BENCHMARK_TILE_SIZE - 1))));
+            row->invalidate(LayerLayoutInvalidate);
+        }
+        tree.renderFrame();
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+// Pre paint only, with nothing invalidated. Cost of walking a settled tree each frame.
+RNS_BENCHMARK_WITH_ARGS(BM_LayerTreeIdlePrePaint, 64, 256, 1024) {
+    LayerTree tree(state.range());
+    while(state.keepRunning()) {
+        FrameDamages damages;
+        SkRect clipBound = SkRect::MakeEmpty();
+        PaintContext context = {
+            tree.surface->getCanvas(),
+            damages,
+#if USE(RNS_SHELL_PARTIAL_UPDATES)
+            true,
+#endif
+            clipBound,
+            nullptr,
+            {0,0}
+        };
+        tree.root->prePaint(context);
+        Benchmark::doNotOptimize(damages.size());
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+}
+
+#if USE(RNS_SHELL_PARTIAL_UPDATES)
+// Damage accumulation of scattered rects, some covering the earlier ones
+RNS_BENCHMARK_WITH_ARGS(BM_AddDamageRect, 8, 64, 256) {
+    std::vector<SkIRect> rects;
+    for(int index = 0; index < state.range(); index++) {
+        int size = (index % 5 == 0) ? 3 * BENCHMARK_TILE_SIZE : BENCHMARK_TILE_SIZE;
+        rects.push_back(SkIRect::MakeXYWH((index * 97) % BENCHMARK_SURFACE_WIDTH, (index * 57) % BENCHMARK_SURFACE_HEIGHT, size, size));
+    }
+    FrameDamages damages;
+    while(state.keepRunning()) {
+        damages.clear();
+        for(auto& rect : rects)
+            Layer::addDamageRect(damages, rect);
+        Benchmark::doNotOptimize(damages.data());
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+    state.setCounter("damage_rects", damages.size());
+}
+#endif // USE(RNS_SHELL_PARTIAL_UPDATES)
+
+} // namespace
+} // namespace RnsShell
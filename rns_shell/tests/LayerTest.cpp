@@ -0,0 +1,253 @@
+/*
+* Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+*
+* Use of this source code is governed by a BSD-style license that can be
+* found in the LICENSE file.
+*/
+
+#include <algorithm>
+#include <map>
+
+#include "gtest/gtest.h"
+
+#include "include/core/SkRegion.h"
+#include "include/core/SkSurface.h"
+
+#include "rns_shell/compositor/layers/Layer.h"
+
+#define TEST_SURFACE_WIDTH 640
+#define TEST_SURFACE_HEIGHT 360
+
+namespace RnsShell {
+namespace {
+
+// Layer tree painted on a raster surface, the way the compositor paints the window
+class LayerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        surface_ = SkSurface::MakeRasterN32Premul(TEST_SURFACE_WIDTH, TEST_SURFACE_HEIGHT);
+        ASSERT_TRUE(surface_);
+        root_ = Layer::Create(Layer::EmptyClient::singleton(), LAYER_TYPE_VIRTUAL);
+        root_->setFrame(SkIRect::MakeWH(TEST_SURFACE_WIDTH, TEST_SURFACE_HEIGHT));
+    }
+
+    SharedLayer addLayer(const SkIRect& frame, SkColor color, SharedLayer parent = nullptr) {
+        SharedLayer layer = Layer::Create(Layer::EmptyClient::singleton(), LAYER_TYPE_DEFAULT);
+        Layer* rawLayer = layer.get();
+        layer->setFrame(frame);
+        layer->registerOnPaint([this, rawLayer, color](SkCanvas* canvas) {
+            SkPaint paint;
+            paint.setColor(color);
+            canvas->drawIRect(rawLayer->getFrame(), paint);
+            paintCount_[rawLayer]++;
+        });
+        (parent ? parent : root_)->appendChild(layer);
+        return layer;
+    }
+
+    FrameDamages prePaint() {
+        FrameDamages damages;
+        SkRect clipBound = SkRect::MakeEmpty();
+        PaintContext context = {
+            surface_->getCanvas(),
+            damages,
+#if USE(RNS_SHELL_PARTIAL_UPDATES)
+            true,
+#endif
+            clipBound,
+            nullptr,
+            {0,0}
+        };
+        root_->prePaint(context);
+        return damages;
+    }
+
+    void paint(FrameDamages& damages) {
+        SkCanvas* canvas = surface_->getCanvas();
+        SkAutoCanvasRestore save(canvas, true);
+        SkRegion clipRegion;
+        clipRegion.setRects(damages.data(), damages.size());
+        SkRect clipBound = SkRect::Make(clipRegion.getBounds());
+        if(!damages.empty())
+            canvas->clipRegion(clipRegion);
+        PaintContext context = {
+            canvas,
+            damages,
+#if USE(RNS_SHELL_PARTIAL_UPDATES)
+            true,
+#endif
+            clipBound,
+            nullptr,
+            {0,0}
+        };
+        root_->paint(context);
+    }
+
+    void renderFrame() {
+        FrameDamages damages = prePaint();
+        paint(damages);
+    }
+
+    SkColor pixelAt(int x, int y) {
+        SkBitmap bitmap;
+        bitmap.allocN32Pixels(1, 1);
+        EXPECT_TRUE(surface_->readPixels(bitmap, x, y));
+        return bitmap.getColor(0, 0);
+    }
+
+    static bool containsRect(const FrameDamages& damages, const SkIRect& rect) {
+        return std::any_of(damages.begin(), damages.end(), [&rect](const SkIRect& damage) { return damage.contains(rect); });
+    }
+
+    sk_sp<SkSurface> surface_;
+    SharedLayer root_;
+    std::map<Layer*, int> paintCount_;
+};
+
+TEST_F(LayerTest, ChildAbsoluteFrameIsOffsetByParent) {
+    SharedLayer parent = addLayer(SkIRect::MakeXYWH(100, 50, 200, 200), SK_ColorRED);
+    SharedLayer child = addLayer(SkIRect::MakeXYWH(10, 20, 30, 40), SK_ColorBLUE, parent);
+    prePaint();
+    EXPECT_EQ(child->absoluteFrame(), SkIRect::MakeXYWH(110, 70, 30, 40));
+    EXPECT_EQ(child->getBounds(), child->absoluteFrame());
+}
+
+TEST_F(LayerTest, PaintRendersLayersOnRasterSurface) {
+    surface_->getCanvas()->clear(SK_ColorWHITE);
+    addLayer(SkIRect::MakeXYWH(0, 0, 100, 100), SK_ColorRED);
+    SharedLayer parent = addLayer(SkIRect::MakeXYWH(200, 100, 100, 100), SK_ColorGREEN);
+    addLayer(SkIRect::MakeXYWH(50, 50, 20, 20), SK_ColorBLUE, parent);
+    renderFrame();
+
+    EXPECT_EQ(pixelAt(50, 50), SK_ColorRED);
+    EXPECT_EQ(pixelAt(210, 110), SK_ColorGREEN);
+    EXPECT_EQ(pixelAt(260, 160), SK_ColorBLUE);
+    EXPECT_EQ(pixelAt(500, 300), SK_ColorWHITE);
+}
+
+TEST_F(LayerTest, HiddenOrEmptyLayerIsNotPainted) {
+    SharedLayer empty = addLayer(SkIRect::MakeEmpty(), SK_ColorRED);
+    renderFrame();
+    EXPECT_EQ(paintCount_[empty.get()], 0);
+}
+
+#if USE(RNS_SHELL_PARTIAL_UPDATES)
+TEST_F(LayerTest, AddDamageRectSkipsCoveredRect) {
+    FrameDamages damages;
+    Layer::addDamageRect(damages, SkIRect::MakeXYWH(0, 0, 100, 100));
+    Layer::addDamageRect(damages, SkIRect::MakeXYWH(10, 10, 20, 20));
+    Layer::addDamageRect(damages, SkIRect::MakeXYWH(0, 0, 100, 100));
+    ASSERT_EQ(damages.size(), 1u);
+    EXPECT_EQ(damages[0], SkIRect::MakeXYWH(0, 0, 100, 100));
+}
+
+TEST_F(LayerTest, AddDamageRectReplacesRectsItCovers) {
+    FrameDamages damages;
+    Layer::addDamageRect(damages, SkIRect::MakeXYWH(10, 10, 20, 20));
+    Layer::addDamageRect(damages, SkIRect::MakeXYWH(50, 50, 20, 20));
+    Layer::addDamageRect(damages, SkIRect::MakeXYWH(300, 300, 10, 10));
+    Layer::addDamageRect(damages, SkIRect::MakeXYWH(0, 0, 100, 100));
+    ASSERT_EQ(damages.size(), 2u);
+    EXPECT_TRUE(containsRect(damages, SkIRect::MakeXYWH(0, 0, 100, 100)));
+    EXPECT_TRUE(containsRect(damages, SkIRect::MakeXYWH(300, 300, 10, 10)));
+}
+
+TEST_F(LayerTest, AddDamageRectKeepsOverlappingRects) {
+    FrameDamages damages;
+    Layer::addDamageRect(damages, SkIRect::MakeXYWH(0, 0, 100, 100));
+    Layer::addDamageRect(damages, SkIRect::MakeXYWH(50, 50, 100, 100));
+    EXPECT_EQ(damages.size(), 2u);
+}
+
+TEST_F(LayerTest, FirstFrameDamagesWholeTree) {
+    addLayer(SkIRect::MakeXYWH(0, 0, 100, 100), SK_ColorRED);
+    FrameDamages damages = prePaint();
+    ASSERT_EQ(damages.size(), 1u);
+    EXPECT_EQ(damages[0], root_->getBounds());
+}
+
+TEST_F(LayerTest, NoInvalidationNoDamage) {
+    addLayer(SkIRect::MakeXYWH(0, 0, 100, 100), SK_ColorRED);
+    renderFrame();
+    EXPECT_TRUE(prePaint().empty());
+}
+
+TEST_F(LayerTest, PaintInvalidateDamagesOnlyThatLayer) {
+    SharedLayer first = addLayer(SkIRect::MakeXYWH(0, 0, 100, 100), SK_ColorRED);
+    SharedLayer second = addLayer(SkIRect::MakeXYWH(300, 200, 100, 100), SK_ColorGREEN);
+    renderFrame();
+
+    second->invalidate(LayerPaintInvalidate);
+    FrameDamages damages = prePaint();
+    ASSERT_EQ(damages.size(), 1u);
+    EXPECT_EQ(damages[0], SkIRect::MakeXYWH(300, 200, 100, 100));
+}
+
+TEST_F(LayerTest, MovedLayerDamagesOldAndNewBounds) {
+    SharedLayer layer = addLayer(SkIRect::MakeXYWH(0, 0, 100, 100), SK_ColorRED);
+    renderFrame();
+
+    layer->setFrame(SkIRect::MakeXYWH(200, 200, 100, 100));
+    layer->invalidate(LayerLayoutInvalidate);
+    FrameDamages damages = prePaint();
+    EXPECT_EQ(damages.size(), 2u);
+    EXPECT_TRUE(containsRect(damages, SkIRect::MakeXYWH(0, 0, 100, 100)));
+    EXPECT_TRUE(containsRect(damages, SkIRect::MakeXYWH(200, 200, 100, 100)));
+}
+
+TEST_F(LayerTest, ParentLayoutChangeMovesChildDamage) {
+    SharedLayer parent = addLayer(SkIRect::MakeXYWH(0, 0, 200, 200), SK_ColorRED);
+    SharedLayer child = addLayer(SkIRect::MakeXYWH(10, 10, 20, 20), SK_ColorBLUE, parent);
+    renderFrame();
+
+    parent->setFrame(SkIRect::MakeXYWH(300, 100, 200, 200));
+    parent->invalidate(LayerLayoutInvalidate);
+    child->invalidate(LayerPaintInvalidate);
+    FrameDamages damages = prePaint();
+    EXPECT_EQ(child->absoluteFrame(), SkIRect::MakeXYWH(310, 110, 20, 20));
+    EXPECT_TRUE(containsRect(damages, SkIRect::MakeXYWH(0, 0, 200, 200)));
+    EXPECT_TRUE(containsRect(damages, child->getBounds()));
+}
+
+TEST_F(LayerTest, RemovedLayerDamagesItsBoundsAndIsDetached) {
+    SharedLayer layer = addLayer(SkIRect::MakeXYWH(50, 50, 100, 100), SK_ColorRED);
+    renderFrame();
+
+    layer->invalidate(LayerRemoveInvalidate);
+    FrameDamages damages = prePaint();
+    EXPECT_TRUE(containsRect(damages, SkIRect::MakeXYWH(50, 50, 100, 100)));
+    EXPECT_TRUE(root_->children().empty());
+    EXPECT_EQ(layer->parent(), nullptr);
+}
+
+TEST_F(LayerTest, PaintSkipsUndamagedLayers) {
+    SharedLayer first = addLayer(SkIRect::MakeXYWH(0, 0, 100, 100), SK_ColorRED);
+    SharedLayer second = addLayer(SkIRect::MakeXYWH(300, 200, 100, 100), SK_ColorGREEN);
+    renderFrame();
+    EXPECT_EQ(paintCount_[first.get()], 1);
+    EXPECT_EQ(paintCount_[second.get()], 1);
+
+    first->invalidate(LayerPaintInvalidate);
+    renderFrame();
+    EXPECT_EQ(paintCount_[first.get()], 2);
+    EXPECT_EQ(paintCount_[second.get()], 1);
+}
+
+TEST_F(LayerTest, PartialRepaintKeepsUndamagedPixels) {
+    SharedLayer first = addLayer(SkIRect::MakeXYWH(0, 0, 100, 100), SK_ColorRED);
+    addLayer(SkIRect::MakeXYWH(300, 200, 100, 100), SK_ColorGREEN);
+    renderFrame();
+
+    // Paint over the surface outside of any damage, partial repaint must not touch it
+    SkPaint paint;
+    paint.setColor(SK_ColorBLUE);
+    surface_->getCanvas()->drawIRect(SkIRect::MakeXYWH(300, 200, 10, 10), paint);
+    first->invalidate(LayerPaintInvalidate);
+    renderFrame();
+    EXPECT_EQ(pixelAt(50, 50), SK_ColorRED);
+    EXPECT_EQ(pixelAt(305, 205), SK_ColorBLUE);
+}
+#endif // USE(RNS_SHELL_PARTIAL_UPDATES)
+
+} // namespace
+} // namespace RnsShell
@@ -0,0 +1,212 @@
+/*
+* Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+*
+* Use of this source code is governed by a BSD-style license that can be
+* found in the LICENSE file.
+*/
+
+#include <time.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <sstream>
+
+#include "RnsBenchmark.h"
+
+#define RNS_BENCHMARK_DEFAULT_MIN_TIME_MS 500
+#define RNS_BENCHMARK_MAX_ITERATIONS 1000000000
+
+namespace RnsShell {
+namespace Benchmark {
+
+static double clockNs(clockid_t clockId) {
+    struct timespec ts;
+    clock_gettime(clockId, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+State::State(int64_t arg, double minTimeMs)
+    : arg_(arg)
+    , minTimeNs_(minTimeMs * 1e6) {}
+
+bool State::keepRunning() {
+    if(iterations_ == 0) {
+        resumeTiming();
+    } else if(realNs_ + (clockNs(CLOCK_MONOTONIC) - realStartNs_) >= minTimeNs_ || iterations_ >= RNS_BENCHMARK_MAX_ITERATIONS) {
+        pauseTiming();
+        return false;
+    }
+    iterations_++;
+    return true;
+}
+
+void State::pauseTiming() {
+    if(!running_)
+        return;
+    realNs_ += clockNs(CLOCK_MONOTONIC) - realStartNs_;
+    cpuNs_ += clockNs(CLOCK_THREAD_CPUTIME_ID) - cpuStartNs_;
+    running_ = false;
+}
+
+void State::resumeTiming() {
+    if(running_)
+        return;
+    realStartNs_ = clockNs(CLOCK_MONOTONIC);
+    cpuStartNs_ = clockNs(CLOCK_THREAD_CPUTIME_ID);
+    running_ = true;
+}
+
+struct Entry {
+    std::string name;
+    Function function;
+    std::vector<int64_t> args;
+};
+
+struct Result {
+    std::string name;
+    uint64_t iterations;
+    double realTimeNs; // Per iteration
+    double cpuTimeNs;
+    double itemsPerSecond;
+    std::string label;
+    std::map<std::string, double> counters;
+};
+
+struct Runner {
+    static Result run(const std::string& name, Function& function, int64_t arg, double minTimeMs) {
+        State state(arg, minTimeMs);
+        function(state);
+        state.pauseTiming();
+
+        Result result;
+        result.name = name;
+        result.iterations = state.iterations_;
+        double iterations = state.iterations_ ? state.iterations_ : 1;
+        result.realTimeNs = state.realNs_ / iterations;
+        result.cpuTimeNs = state.cpuNs_ / iterations;
+        result.itemsPerSecond = (state.itemsProcessed_ && state.realNs_ > 0) ? state.itemsProcessed_ * 1e9 / state.realNs_ : 0;
+        result.label = state.label_;
+        result.counters = state.counters_;
+        return result;
+    }
+};
+
+static std::vector<Entry>& registry() {
+    static std::vector<Entry> entries;
+    return entries;
+}
+
+bool registerBenchmark(const char* name, Function function, std::vector<int64_t> args) {
+    registry().push_back({name, function, args});
+    return true;
+}
+
+static std::string jsonEscape(const std::string& value) {
+    std::ostringstream escaped;
+    for(char c : value) {
+        switch(c) {
+            case '"': escaped << "\\\""; break;
+            case '\\': escaped << "\\\\"; break;
+            case '\n': escaped << "\\n"; break;
+            case '\t': escaped << "\\t"; break;
+            default:
+                if(static_cast<unsigned char>(c) < 0x20)
+                    escaped << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+                else
+                    escaped << c;
+        }
+    }
+    return escaped.str();
+}
+
+static bool writeJson(const std::string& path, const char* executable, const std::vector<Result>& results) {
+    std::ofstream out(path);
+    if(!out.is_open()) {
+        std::cerr << "Couldn't open " << path << " for the JSON output" << std::endl;
+        return false;
+    }
+    char date[64];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+
+    out << std::setprecision(12);
+    out << "{\n  \"context\": {\n";
+    out << "    \"date\": \"" << date << "\",\n";
+    out << "    \"executable\": \"" << jsonEscape(executable) << "\",\n";
+    out << "    \"num_cpus\": " << sysconf(_SC_NPROCESSORS_ONLN) << "\n";
+    out << "  },\n  \"benchmarks\": [";
+    for(size_t index = 0; index < results.size(); index++) {
+        auto& result = results[index];
+        out << (index ? ",\n" : "\n") << "    {\n";
+        out << "      \"name\": \"" << jsonEscape(result.name) << "\",\n";
+        out << "      \"iterations\": " << result.iterations << ",\n";
+        out << "      \"real_time\": " << result.realTimeNs << ",\n";
+        out << "      \"cpu_time\": " << result.cpuTimeNs << ",\n";
+        out << "      \"time_unit\": \"ns\"";
+        if(result.itemsPerSecond > 0)
+            out << ",\n      \"items_per_second\": " << result.itemsPerSecond;
+        if(!result.label.empty())
+            out << ",\n      \"label\": \"" << jsonEscape(result.label) << "\"";
+        for(auto& counter : result.counters)
+            out << ",\n      \"" << jsonEscape(counter.first) << "\": " << counter.second;
+        out << "\n    }";
+    }
+    out << "\n  ]\n}\n";
+    return out.good();
+}
+
+int runBenchmarks(int argc, char** argv) {
+    std::string filter = ".*";
+    std::string jsonOut;
+    double minTimeMs = RNS_BENCHMARK_DEFAULT_MIN_TIME_MS;
+
+    for(int index = 1; index < argc; index++) {
+        std::string flag(argv[index]);
+        if(flag.rfind("--filter=", 0) == 0) {
+            filter = flag.substr(strlen("--filter="));
+        } else if(flag.rfind("--json_out=", 0) == 0) {
+            jsonOut = flag.substr(strlen("--json_out="));
+        } else if(flag.rfind("--min_time_ms=", 0) == 0) {
+            minTimeMs = std::stod(flag.substr(strlen("--min_time_ms=")));
+        } else {
+            std::cerr << "Unknown flag " << flag << ", usage : " << argv[0] <<
+                         " [--filter=<regex>] [--json_out=<file>] [--min_time_ms=<ms>]" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::regex filterRegex(filter);
+    std::vector<Result> results;
+    std::printf("%-56s %14s %14s %12s\n", "Benchmark", "Time(ns)", "CPU(ns)", "Iterations");
+    for(auto& entry : registry()) {
+        std::vector<int64_t> args = entry.args.empty() ? std::vector<int64_t>{0} : entry.args;
+        for(auto arg : args) {
+            std::string name = entry.args.empty() ? entry.name : entry.name + "/" + std::to_string(arg);
+            if(!std::regex_search(name, filterRegex))
+                continue;
+            Result result = Runner::run(name, entry.function, arg, minTimeMs);
+            std::printf("%-56s %14.0f %14.0f %12lu", result.name.c_str(), result.realTimeNs, result.cpuTimeNs, result.iterations);
+            if(result.itemsPerSecond > 0)
+                std::printf(" items/s=%.0f", result.itemsPerSecond);
+            for(auto& counter : result.counters)
+                std::printf(" %s=%g", counter.first.c_str(), counter.second);
+            if(!result.label.empty())
+                std::printf(" %s", result.label.c_str());
+            std::printf("\n");
+            results.push_back(result);
+        }
+    }
+
+    if(!jsonOut.empty() && !writeJson(jsonOut, argv[0], results))
+        return EXIT_FAILURE;
+    return EXIT_SUCCESS;
+}
+
+} // namespace Benchmark
+} // namespace RnsShell
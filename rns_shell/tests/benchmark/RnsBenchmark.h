@@ -0,0 +1,80 @@
+/*
+* Copyright (C) 1994-2022 OpenTV, Inc. and Nagravision S.A.
+*
+* Use of this source code is governed by a BSD-style license that can be
+* found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace RnsShell {
+namespace Benchmark {
+
+/*
+ * Minimal micro benchmark harness, for the hot paths which can run headless (raster surfaces, no platform display).
+ * Body runs in a keepRunning() loop till the minimum time is spent. Results are printed as a table & written as JSON
+ * (google benchmark layout, so the same tooling can compare runs) with --json_out=<file>.
+ * Flags : --filter=<regex> --json_out=<file> --min_time_ms=<ms>
+ */
+class State {
+public:
+    State(int64_t arg, double minTimeMs);
+
+    bool keepRunning();
+    // Setup which must not be measured, has to be done between pause & resume
+    void pauseTiming();
+    void resumeTiming();
+
+    int64_t range() const { return arg_; }
+    uint64_t iterations() const { return iterations_; }
+    void setItemsProcessed(int64_t items) { itemsProcessed_ = items; }
+    void setCounter(const std::string& name, double value) { counters_[name] = value; }
+    void setLabel(const std::string& label) { label_ = label; }
+
+private:
+    friend struct Runner;
+
+    int64_t arg_;
+    double minTimeNs_;
+    uint64_t iterations_{0};
+    bool running_{false};
+    double realStartNs_{0};
+    double cpuStartNs_{0};
+    double realNs_{0};
+    double cpuNs_{0};
+    int64_t itemsProcessed_{0};
+    std::map<std::string, double> counters_;
+    std::string label_;
+};
+
+using Function = std::function<void(State&)>;
+
+// Registers a benchmark, run once for each of the args (once with 0 when there is none)
+bool registerBenchmark(const char* name, Function function, std::vector<int64_t> args = {});
+// Runs the registered benchmarks as per the flags, returns the process exit code
+int runBenchmarks(int argc, char** argv);
+
+// Keeps the compiler from eliding the computation of the value
+template <class T>
+inline void doNotOptimize(T const& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+} // namespace Benchmark
+} // namespace RnsShell
+
+#define RNS_BENCHMARK(name) \
+    static void name(RnsShell::Benchmark::State&); \
+    static bool name##Registered = RnsShell::Benchmark::registerBenchmark(#name, name); \
+    static void name(RnsShell::Benchmark::State& state)
+
+#define RNS_BENCHMARK_WITH_ARGS(name, ...) \
+    static void name(RnsShell::Benchmark::State&); \
+    static bool name##Registered = RnsShell::Benchmark::registerBenchmark(#name, name, {__VA_ARGS__}); \
+    static void name(RnsShell::Benchmark::State& state)